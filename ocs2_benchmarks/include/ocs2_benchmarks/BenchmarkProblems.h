@@ -0,0 +1,83 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_ddp/DDP_Settings.h>
+#include <ocs2_ipm/IpmSettings.h>
+#include <ocs2_mpc/MPC_Settings.h>
+#include <ocs2_mpc/SystemObservation.h>
+#include <ocs2_oc/rollout/RolloutBase.h>
+#include <ocs2_oc/synchronized_module/ReferenceManagerInterface.h>
+#include <ocs2_robotic_tools/common/RobotInterface.h>
+#include <ocs2_slp/SlpSettings.h>
+#include <ocs2_sqp/SqpSettings.h>
+
+namespace ocs2 {
+namespace mpc_benchmark {
+
+/**
+ * A closed-loop MPC problem built from one of the robotic examples. It owns the robot interface and carries the settings of all the
+ * solvers, such that the same problem can be solved by each of them.
+ */
+struct BenchmarkProblem {
+  std::string robotName;
+  std::unique_ptr<RobotInterface> robotInterfacePtr;
+  const RolloutBase* rolloutPtr = nullptr;
+  std::shared_ptr<ReferenceManagerInterface> referenceManagerPtr;
+
+  mpc::Settings mpcSettings;
+  ddp::Settings ddpSettings;
+  sqp::Settings sqpSettings;
+  ipm::Settings ipmSettings;
+  slp::Settings slpSettings;
+
+  SystemObservation initialObservation;
+  TargetTrajectories targetTrajectories;
+};
+
+/** The names of the robots for which a benchmark problem can be created. */
+const std::vector<std::string>& getRobotNames();
+
+/**
+ * Creates the benchmark problem of a robotic example. The task files of the examples are used. Solver settings which are not specified
+ * in the task file of a robot keep their default values.
+ *
+ * @param [in] robotName: One of getRobotNames().
+ * @return The benchmark problem.
+ */
+std::unique_ptr<BenchmarkProblem> createBenchmarkProblem(const std::string& robotName);
+
+}  // namespace mpc_benchmark
+}  // namespace ocs2
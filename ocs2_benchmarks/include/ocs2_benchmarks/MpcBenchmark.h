@@ -0,0 +1,143 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <map>
+#include <memory>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_mpc/MPC_BASE.h>
+
+#include "ocs2_benchmarks/BenchmarkProblems.h"
+
+namespace ocs2 {
+namespace mpc_benchmark {
+
+enum class SolverType { SQP, IPM, SLP, SLQ, ILQR };
+
+/** The names of the solvers, in the order of SolverType. */
+const std::vector<std::string>& getSolverNames();
+
+/** Parses a solver name, see getSolverNames(). */
+SolverType fromSolverName(const std::string& name);
+
+/** Returns the name of a solver type. */
+std::string toSolverName(SolverType solverType);
+
+struct Settings {
+  /** Simulated duration of the closed loop [s]. */
+  scalar_t duration = 5.0;
+  /** Frequency of the simulated control loop [Hz]. A non-positive value uses the mrtDesiredFrequency of the robot. */
+  scalar_t simulationFrequency = -1.0;
+  /** Frequency of the MPC updates [Hz]. A non-positive value uses the mpcDesiredFrequency of the robot. */
+  scalar_t mpcFrequency = -1.0;
+  /** Growth factor of the time steps of the multiple shooting solvers (sqp, ipm, slp). A non-positive value uses the robot settings. */
+  scalar_t dtGrowthFactor = -1.0;
+  /** Largest time step of the multiple shooting solvers [s]. A non-positive value uses the robot settings. */
+  scalar_t dtMax = -1.0;
+  /** Number of step sizes which sqp and ipm evaluate concurrently in their linesearch. A non-positive value uses the robot settings. */
+  int linesearchBatchSize = -1;
+};
+
+/**
+ * Creates the MPC of the requested solver type for the benchmark problem, using the given MPC settings. The time discretization of the
+ * multiple shooting solvers and the linesearch batch size of sqp and ipm are overridden by the benchmark settings.
+ */
+std::unique_ptr<MPC_BASE> createMpc(const BenchmarkProblem& problem, SolverType solverType, const mpc::Settings& mpcSettings,
+                                    const Settings& settings = Settings());
+
+/**
+ * Loads the benchmark settings from a given file.
+ *
+ * @param [in] filename: File name which contains the configuration data.
+ * @param [in] fieldName: Field name which contains the configuration data.
+ * @param [in] verbose: Flag to determine whether to print out the loaded settings or not.
+ * @return The settings
+ */
+Settings loadSettings(const std::string& filename, const std::string& fieldName = "benchmark", bool verbose = true);
+
+/** Order statistics of a set of samples. */
+struct SampleStatistics {
+  size_t count = 0;
+  scalar_t mean = 0.0;
+  scalar_t p50 = 0.0;
+  scalar_t p90 = 0.0;
+  scalar_t p99 = 0.0;
+  scalar_t max = 0.0;
+};
+
+/** Computes the statistics of the samples. The samples are sorted in place. */
+SampleStatistics computeStatistics(std::vector<scalar_t>& samples);
+
+struct BenchmarkResult {
+  std::string robotName;
+  std::string solverName;
+  scalar_t duration = 0.0;
+  scalar_t simulationFrequency = 0.0;
+  scalar_t mpcFrequency = 0.0;
+
+  /**
+   * Wall-clock latency of each phase of the loop [ms]. The first (cold-started) MPC solve is reported as "initialAdvanceMpc". The
+   * following MPC updates are broken down by the benchmarking timers of the solver ("advanceMpc/<phase>"), and, if the solver spans are
+   * compiled (OCS2_ENABLE_TRACING), by the total duration of the spans of each name ("advanceMpc/trace/<span>"), summed over threads.
+   */
+  std::map<std::string, SampleStatistics> phaseLatencies;
+  /** Solver iterations per MPC update */
+  SampleStatistics iterations;
+  /** Heap allocations per MPC update */
+  SampleStatistics allocations;
+  /** Time nodes of the optimized trajectory per MPC update */
+  SampleStatistics nodes;
+  /** Integral of the intermediate cost (including soft constraints) along the closed-loop trajectory */
+  scalar_t trackingCost = 0.0;
+  /** Number of MPC updates whose solution was not published (e.g. due to an exception of the solver) */
+  size_t numFailedUpdates = 0;
+};
+
+/**
+ * Runs the closed loop of the MPC with a simulated plant. The loop is run in simulated time and single threaded: every
+ * simulationFrequency/mpcFrequency control steps, the MPC is advanced with the latest observation and the policy is updated. The plant
+ * is simulated by the rollout of the problem under the MPC policy.
+ *
+ * @param [in] problem: The benchmark problem.
+ * @param [in] solverType: The solver to be used.
+ * @param [in] settings: The benchmark settings.
+ * @return The benchmark result.
+ */
+BenchmarkResult runClosedLoopBenchmark(const BenchmarkProblem& problem, SolverType solverType, const Settings& settings);
+
+/** Writes the results as a JSON array of objects. */
+void writeJson(std::ostream& stream, const std::vector<BenchmarkResult>& results);
+
+}  // namespace mpc_benchmark
+}  // namespace ocs2
@@ -0,0 +1,223 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_benchmarks/BenchmarkProblems.h"
+
+#include <stdexcept>
+
+#include <ocs2_oc/synchronized_module/ReferenceManager.h>
+#include <ocs2_robotic_assets/package_path.h>
+
+#include <ocs2_ballbot/BallbotInterface.h>
+#include <ocs2_ballbot/definitions.h>
+#include <ocs2_ballbot/package_path.h>
+#include <ocs2_cartpole/CartPoleInterface.h>
+#include <ocs2_cartpole/definitions.h>
+#include <ocs2_cartpole/package_path.h>
+#include <ocs2_legged_robot/LeggedRobotInterface.h>
+#include <ocs2_legged_robot/gait/MotionPhaseDefinition.h>
+#include <ocs2_legged_robot/package_path.h>
+#include <ocs2_mobile_manipulator/MobileManipulatorInterface.h>
+#include <ocs2_mobile_manipulator/package_path.h>
+#include <ocs2_quadrotor/QuadrotorInterface.h>
+#include <ocs2_quadrotor/definitions.h>
+#include <ocs2_quadrotor/package_path.h>
+
+namespace ocs2 {
+namespace mpc_benchmark {
+
+namespace {
+
+/** The settings of the solvers which are not exposed by a robot interface are loaded from its task file, if present. */
+void loadMissingSolverSettings(const std::string& taskFile, BenchmarkProblem& problem) {
+  constexpr bool verbose = false;
+  problem.sqpSettings = sqp::loadSettings(taskFile, "sqp", verbose);
+  problem.ipmSettings = ipm::loadSettings(taskFile, "ipm", verbose);
+  problem.slpSettings = slp::loadSettings(taskFile, "slp", verbose);
+}
+
+/** Fills in the initial observation and the target trajectories for a regulation task. */
+void setRegulationTask(const vector_t& initialState, const vector_t& targetState, size_t inputDim, BenchmarkProblem& problem) {
+  problem.initialObservation.time = 0.0;
+  problem.initialObservation.state = initialState;
+  problem.initialObservation.input = vector_t::Zero(inputDim);
+  problem.targetTrajectories = TargetTrajectories({0.0}, {targetState}, {vector_t::Zero(inputDim)});
+}
+
+std::unique_ptr<BenchmarkProblem> createCartPoleProblem() {
+  const std::string taskFile = cartpole::getPath() + "/config/mpc/task.info";
+  const std::string libFolder = cartpole::getPath() + "/auto_generated";
+  std::unique_ptr<cartpole::CartPoleInterface> interfacePtr(new cartpole::CartPoleInterface(taskFile, libFolder, false));
+
+  std::unique_ptr<BenchmarkProblem> problemPtr(new BenchmarkProblem);
+  problemPtr->mpcSettings = interfacePtr->mpcSettings();
+  problemPtr->ddpSettings = interfacePtr->ddpSettings();
+  loadMissingSolverSettings(taskFile, *problemPtr);
+  // swing-up from the hanging position
+  setRegulationTask(interfacePtr->getInitialState(), interfacePtr->getInitialTarget(), cartpole::INPUT_DIM, *problemPtr);
+  problemPtr->rolloutPtr = &interfacePtr->getRollout();
+  problemPtr->referenceManagerPtr = std::make_shared<ReferenceManager>(problemPtr->targetTrajectories);
+  problemPtr->robotInterfacePtr = std::move(interfacePtr);
+  return problemPtr;
+}
+
+std::unique_ptr<BenchmarkProblem> createBallbotProblem() {
+  const std::string taskFile = ballbot::getPath() + "/config/mpc/task.info";
+  const std::string libFolder = ballbot::getPath() + "/auto_generated";
+  std::unique_ptr<ballbot::BallbotInterface> interfacePtr(new ballbot::BallbotInterface(taskFile, libFolder));
+
+  std::unique_ptr<BenchmarkProblem> problemPtr(new BenchmarkProblem);
+  loadMissingSolverSettings(taskFile, *problemPtr);
+  problemPtr->mpcSettings = interfacePtr->mpcSettings();
+  problemPtr->ddpSettings = interfacePtr->ddpSettings();
+  problemPtr->sqpSettings = interfacePtr->sqpSettings();
+  problemPtr->slpSettings = interfacePtr->slpSettings();
+  // move the base by one meter along x
+  vector_t targetState = interfacePtr->getInitialState();
+  targetState(0) += 1.0;
+  setRegulationTask(interfacePtr->getInitialState(), targetState, ballbot::INPUT_DIM, *problemPtr);
+  problemPtr->rolloutPtr = &interfacePtr->getRollout();
+  problemPtr->referenceManagerPtr = interfacePtr->getReferenceManagerPtr();
+  problemPtr->robotInterfacePtr = std::move(interfacePtr);
+  return problemPtr;
+}
+
+std::unique_ptr<BenchmarkProblem> createQuadrotorProblem() {
+  const std::string taskFile = quadrotor::getPath() + "/config/mpc/task.info";
+  const std::string libFolder = quadrotor::getPath() + "/auto_generated";
+  std::unique_ptr<quadrotor::QuadrotorInterface> interfacePtr(new quadrotor::QuadrotorInterface(taskFile, libFolder));
+
+  std::unique_ptr<BenchmarkProblem> problemPtr(new BenchmarkProblem);
+  problemPtr->mpcSettings = interfacePtr->mpcSettings();
+  problemPtr->ddpSettings = interfacePtr->ddpSettings();
+  loadMissingSolverSettings(taskFile, *problemPtr);
+  // climb by one meter
+  vector_t targetState = interfacePtr->getInitialState();
+  targetState(2) += 1.0;
+  setRegulationTask(interfacePtr->getInitialState(), targetState, quadrotor::INPUT_DIM, *problemPtr);
+  problemPtr->rolloutPtr = &interfacePtr->getRollout();
+  problemPtr->referenceManagerPtr = interfacePtr->getReferenceManagerPtr();
+  problemPtr->robotInterfacePtr = std::move(interfacePtr);
+  return problemPtr;
+}
+
+std::unique_ptr<BenchmarkProblem> createMobileManipulatorProblem() {
+  const std::string taskFile = mobile_manipulator::getPath() + "/config/mabi_mobile/task.info";
+  const std::string libFolder = mobile_manipulator::getPath() + "/auto_generated/mabi_mobile";
+  const std::string urdfFile = robotic_assets::getPath() + "/resources/mobile_manipulator/mabi_mobile/urdf/mabi_mobile.urdf";
+  std::unique_ptr<mobile_manipulator::MobileManipulatorInterface> interfacePtr(
+      new mobile_manipulator::MobileManipulatorInterface(taskFile, libFolder, urdfFile));
+
+  std::unique_ptr<BenchmarkProblem> problemPtr(new BenchmarkProblem);
+  problemPtr->mpcSettings = interfacePtr->mpcSettings();
+  problemPtr->ddpSettings = interfacePtr->ddpSettings();
+  loadMissingSolverSettings(taskFile, *problemPtr);
+  // the target is an end-effector pose (position and quaternion coefficients)
+  const size_t inputDim = interfacePtr->getManipulatorModelInfo().inputDim;
+  const Eigen::Quaternion<scalar_t> goalOrientation = Eigen::Quaternion<scalar_t>(0.33, 0.0, 0.0, 0.95).normalized();
+  vector_t goalPose(7);
+  goalPose << -0.5, -0.8, 0.6, goalOrientation.coeffs();
+  setRegulationTask(interfacePtr->getInitialState(), goalPose, inputDim, *problemPtr);
+  problemPtr->rolloutPtr = &interfacePtr->getRollout();
+  problemPtr->referenceManagerPtr = interfacePtr->getReferenceManagerPtr();
+  problemPtr->robotInterfacePtr = std::move(interfacePtr);
+  return problemPtr;
+}
+
+std::unique_ptr<BenchmarkProblem> createLeggedRobotProblem() {
+  const std::string taskFile = legged_robot::getPath() + "/config/mpc/task.info";
+  const std::string referenceFile = legged_robot::getPath() + "/config/command/reference.info";
+  const std::string urdfFile = robotic_assets::getPath() + "/resources/anymal_c/urdf/anymal.urdf";
+  std::unique_ptr<legged_robot::LeggedRobotInterface> interfacePtr(
+      new legged_robot::LeggedRobotInterface(taskFile, urdfFile, referenceFile));
+
+  std::unique_ptr<BenchmarkProblem> problemPtr(new BenchmarkProblem);
+  loadMissingSolverSettings(taskFile, *problemPtr);
+  problemPtr->mpcSettings = interfacePtr->mpcSettings();
+  problemPtr->ddpSettings = interfacePtr->ddpSettings();
+  problemPtr->sqpSettings = interfacePtr->sqpSettings();
+  problemPtr->ipmSettings = interfacePtr->ipmSettings();
+  // stand in place with the gait of the reference file
+  const size_t inputDim = interfacePtr->getCentroidalModelInfo().inputDim;
+  setRegulationTask(interfacePtr->getInitialState(), interfacePtr->getInitialState(), inputDim, *problemPtr);
+  problemPtr->initialObservation.mode = legged_robot::ModeNumber::STANCE;
+  problemPtr->rolloutPtr = &interfacePtr->getRollout();
+  problemPtr->referenceManagerPtr = interfacePtr->getReferenceManagerPtr();
+  problemPtr->robotInterfacePtr = std::move(interfacePtr);
+  return problemPtr;
+}
+
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+const std::vector<std::string>& getRobotNames() {
+  static const std::vector<std::string> robotNames{"cartpole", "ballbot", "quadrotor", "mobile_manipulator", "legged_robot"};
+  return robotNames;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::unique_ptr<BenchmarkProblem> createBenchmarkProblem(const std::string& robotName) {
+  std::unique_ptr<BenchmarkProblem> problemPtr;
+  if (robotName == "cartpole") {
+    problemPtr = createCartPoleProblem();
+  } else if (robotName == "ballbot") {
+    problemPtr = createBallbotProblem();
+  } else if (robotName == "quadrotor") {
+    problemPtr = createQuadrotorProblem();
+  } else if (robotName == "mobile_manipulator") {
+    problemPtr = createMobileManipulatorProblem();
+  } else if (robotName == "legged_robot") {
+    problemPtr = createLeggedRobotProblem();
+  } else {
+    throw std::runtime_error("[createBenchmarkProblem] Unknown robot: " + robotName);
+  }
+
+  problemPtr->robotName = robotName;
+  // the benchmark runs headless
+  problemPtr->mpcSettings.debugPrint_ = false;
+  problemPtr->ddpSettings.displayInfo_ = false;
+  problemPtr->ddpSettings.displayShortSummary_ = false;
+  problemPtr->sqpSettings.printSolverStatus = false;
+  problemPtr->sqpSettings.printSolverStatistics = false;
+  problemPtr->sqpSettings.printLinesearch = false;
+  problemPtr->ipmSettings.printSolverStatus = false;
+  problemPtr->ipmSettings.printSolverStatistics = false;
+  problemPtr->ipmSettings.printLinesearch = false;
+  problemPtr->slpSettings.printSolverStatus = false;
+  problemPtr->slpSettings.printSolverStatistics = false;
+  problemPtr->slpSettings.printLinesearch = false;
+  return problemPtr;
+}
+
+}  // namespace mpc_benchmark
+}  // namespace ocs2
@@ -0,0 +1,383 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_benchmarks/MpcBenchmark.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <iomanip>
+#include <iostream>
+#include <numeric>
+#include <stdexcept>
+
+#include <boost/property_tree/info_parser.hpp>
+#include <boost/property_tree/ptree.hpp>
+
+#include <ocs2_core/misc/LoadData.h>
+#include <ocs2_core/misc/Trace.h>
+#include <ocs2_core/test/AllocationCounter.h>
+#include <ocs2_ddp/GaussNewtonDDP_MPC.h>
+#include <ocs2_ipm/IpmMpc.h>
+#include <ocs2_mpc/MPC_MRT_Interface.h>
+#include <ocs2_oc/approximate_model/LinearQuadraticApproximator.h>
+#include <ocs2_slp/SlpMpc.h>
+#include <ocs2_sqp/SqpMpc.h>
+
+namespace ocs2 {
+namespace mpc_benchmark {
+
+namespace {
+
+/** Measures the wall-clock time of a call in milliseconds. */
+template <typename Callable>
+scalar_t measureMilliseconds(Callable&& callable) {
+  const auto startTime = std::chrono::steady_clock::now();
+  callable();
+  const auto endTime = std::chrono::steady_clock::now();
+  return std::chrono::duration<scalar_t, std::milli>(endTime - startTime).count();
+}
+
+/** Applies the time discretization of the benchmark settings to the settings of a multiple shooting solver. */
+template <typename SolverSettings>
+SolverSettings overrideTimeDiscretization(SolverSettings solverSettings, const Settings& settings) {
+  if (settings.dtGrowthFactor > 0.0) {
+    solverSettings.dtGrowthFactor = settings.dtGrowthFactor;
+  }
+  if (settings.dtMax > 0.0) {
+    solverSettings.dtMax = settings.dtMax;
+  }
+  return solverSettings;
+}
+
+/** Applies the linesearch batch size of the benchmark settings to the settings of sqp or ipm. */
+template <typename SolverSettings>
+SolverSettings overrideLinesearchBatchSize(SolverSettings solverSettings, const Settings& settings) {
+  if (settings.linesearchBatchSize > 0) {
+    solverSettings.linesearchBatchSize = settings.linesearchBatchSize;
+  }
+  return solverSettings;
+}
+
+void writeJson(std::ostream& stream, const SampleStatistics& statistics) {
+  stream << "{\"count\": " << statistics.count << ", \"mean\": " << statistics.mean << ", \"p50\": " << statistics.p50
+         << ", \"p90\": " << statistics.p90 << ", \"p99\": " << statistics.p99 << ", \"max\": " << statistics.max << "}";
+}
+
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+const std::vector<std::string>& getSolverNames() {
+  static const std::vector<std::string> solverNames{"sqp", "ipm", "slp", "slq", "ilqr"};
+  return solverNames;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+SolverType fromSolverName(const std::string& name) {
+  const auto& solverNames = getSolverNames();
+  const auto it = std::find(solverNames.begin(), solverNames.end(), name);
+  if (it == solverNames.end()) {
+    throw std::runtime_error("[fromSolverName] Unknown solver: " + name);
+  }
+  return static_cast<SolverType>(std::distance(solverNames.begin(), it));
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::string toSolverName(SolverType solverType) {
+  return getSolverNames().at(static_cast<size_t>(solverType));
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::unique_ptr<MPC_BASE> createMpc(const BenchmarkProblem& problem, SolverType solverType, const mpc::Settings& mpcSettings,
+                                    const Settings& settings) {
+  const auto& optimalControlProblem = problem.robotInterfacePtr->getOptimalControlProblem();
+  const auto& initializer = problem.robotInterfacePtr->getInitializer();
+
+  std::unique_ptr<MPC_BASE> mpcPtr;
+  switch (solverType) {
+    case SolverType::SQP: {
+      auto sqpSettings = overrideLinesearchBatchSize(overrideTimeDiscretization(problem.sqpSettings, settings), settings);
+      mpcPtr.reset(new SqpMpc(mpcSettings, std::move(sqpSettings), optimalControlProblem, initializer));
+      break;
+    }
+    case SolverType::IPM: {
+      auto ipmSettings = overrideLinesearchBatchSize(overrideTimeDiscretization(problem.ipmSettings, settings), settings);
+      mpcPtr.reset(new IpmMpc(mpcSettings, std::move(ipmSettings), optimalControlProblem, initializer));
+      break;
+    }
+    case SolverType::SLP:
+      mpcPtr.reset(new SlpMpc(mpcSettings, overrideTimeDiscretization(problem.slpSettings, settings), optimalControlProblem, initializer));
+      break;
+    case SolverType::SLQ:
+    case SolverType::ILQR: {
+      auto ddpSettings = problem.ddpSettings;
+      ddpSettings.algorithm_ = (solverType == SolverType::SLQ) ? ddp::Algorithm::SLQ : ddp::Algorithm::ILQR;
+      mpcPtr.reset(new GaussNewtonDDP_MPC(mpcSettings, std::move(ddpSettings), *problem.rolloutPtr, optimalControlProblem, initializer));
+      break;
+    }
+    default:
+      throw std::runtime_error("[createMpc] Undefined solver type!");
+  }
+
+  mpcPtr->getSolverPtr()->setReferenceManager(problem.referenceManagerPtr);
+  return mpcPtr;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+Settings loadSettings(const std::string& filename, const std::string& fieldName, bool verbose) {
+  boost::property_tree::ptree pt;
+  boost::property_tree::read_info(filename, pt);
+
+  Settings settings;
+
+  if (verbose) {
+    std::cerr << "\n #### MPC Benchmark Settings:";
+    std::cerr << "\n #### =============================================================================\n";
+  }
+
+  loadData::loadPtreeValue(pt, settings.duration, fieldName + ".duration", verbose);
+  loadData::loadPtreeValue(pt, settings.simulationFrequency, fieldName + ".simulationFrequency", verbose);
+  loadData::loadPtreeValue(pt, settings.mpcFrequency, fieldName + ".mpcFrequency", verbose);
+  loadData::loadPtreeValue(pt, settings.dtGrowthFactor, fieldName + ".dtGrowthFactor", verbose);
+  loadData::loadPtreeValue(pt, settings.dtMax, fieldName + ".dtMax", verbose);
+  loadData::loadPtreeValue(pt, settings.linesearchBatchSize, fieldName + ".linesearchBatchSize", verbose);
+
+  if (verbose) {
+    std::cerr << " #### =============================================================================" << std::endl;
+  }
+
+  return settings;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+SampleStatistics computeStatistics(std::vector<scalar_t>& samples) {
+  SampleStatistics statistics;
+  statistics.count = samples.size();
+  if (samples.empty()) {
+    return statistics;
+  }
+
+  // nearest-rank percentiles
+  std::sort(samples.begin(), samples.end());
+  const auto percentile = [&](scalar_t p) {
+    const auto rank = static_cast<size_t>(std::ceil(p * static_cast<scalar_t>(samples.size())));
+    return samples[std::max<size_t>(rank, 1) - 1];
+  };
+
+  statistics.mean = std::accumulate(samples.begin(), samples.end(), scalar_t(0.0)) / static_cast<scalar_t>(samples.size());
+  statistics.p50 = percentile(0.5);
+  statistics.p90 = percentile(0.9);
+  statistics.p99 = percentile(0.99);
+  statistics.max = samples.back();
+  return statistics;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+BenchmarkResult runClosedLoopBenchmark(const BenchmarkProblem& problem, SolverType solverType, const Settings& settings) {
+  BenchmarkResult result;
+  result.robotName = problem.robotName;
+  result.solverName = toSolverName(solverType);
+  result.duration = settings.duration;
+  result.simulationFrequency =
+      (settings.simulationFrequency > 0.0) ? settings.simulationFrequency : problem.mpcSettings.mrtDesiredFrequency_;
+  result.mpcFrequency = (settings.mpcFrequency > 0.0) ? settings.mpcFrequency : problem.mpcSettings.mpcDesiredFrequency_;
+  if (result.simulationFrequency <= 0.0 || result.mpcFrequency <= 0.0) {
+    throw std::runtime_error("[runClosedLoopBenchmark] The simulation and MPC frequencies must be positive!");
+  }
+
+  // the MPC is triggered in simulated time, hence the desired frequency is only used to prepare the next solve
+  auto mpcSettings = problem.mpcSettings;
+  mpcSettings.mpcDesiredFrequency_ = result.mpcFrequency;
+  mpcSettings.mrtDesiredFrequency_ = result.simulationFrequency;
+  auto mpcPtr = createMpc(problem, solverType, mpcSettings, settings);
+  auto& solver = *mpcPtr->getSolverPtr();
+
+  MPC_MRT_Interface mpcMrtInterface(*mpcPtr);
+  mpcMrtInterface.initRollout(problem.rolloutPtr);
+  mpcMrtInterface.resetMpcNode(problem.targetTrajectories);
+
+  // a separate copy of the problem evaluates the cost of the closed-loop trajectory
+  OptimalControlProblem costProblem(problem.robotInterfacePtr->getOptimalControlProblem());
+  costProblem.targetTrajectoriesPtr = &mpcMrtInterface.getReferenceManager().getTargetTrajectories();
+
+  std::vector<scalar_t> advanceMpcLatencies, updatePolicyLatencies, rolloutPolicyLatencies;
+  std::vector<scalar_t> iterations, allocations, nodes;
+  std::map<std::string, std::vector<scalar_t>> solverPhaseLatencies;
+
+#ifdef OCS2_ENABLE_TRACING
+  trace::start();
+#endif
+
+  // runs one MPC update and records its statistics
+  const auto advanceMpc = [&](std::vector<scalar_t>& latencies) {
+    const auto timesBefore = solver.getBenchmarkingTimes();
+    trace::clear();
+    const size_t iterationsBefore = solver.getNumIterations();
+    const size_t allocationsBefore = getAllocationCount();
+    try {
+      latencies.push_back(measureMilliseconds([&]() { mpcMrtInterface.advanceMpc(); }));
+    } catch (const std::exception& e) {
+      std::cerr << "[runClosedLoopBenchmark] MPC update failed: " << e.what() << '\n';
+      ++result.numFailedUpdates;
+      return;
+    }
+    allocations.push_back(static_cast<scalar_t>(getAllocationCount() - allocationsBefore));
+    iterations.push_back(static_cast<scalar_t>(solver.getNumIterations() - iterationsBefore));
+    nodes.push_back(static_cast<scalar_t>(solver.primalSolution(solver.getFinalTime()).timeTrajectory_.size()));
+
+    // time spent in each phase of the solver during this update
+    for (const auto& phase : solver.getBenchmarkingTimes()) {
+      const auto it = timesBefore.find(phase.first);
+      const scalar_t timeBefore = (it != timesBefore.end() && it->second <= phase.second) ? it->second : 0.0;
+      solverPhaseLatencies["advanceMpc/" + phase.first].push_back(phase.second - timeBefore);
+    }
+    for (const auto& span : trace::getTotalDurations()) {
+      solverPhaseLatencies["advanceMpc/trace/" + span.first].push_back(span.second);
+    }
+  };
+
+  // initial (cold-started) solution
+  SystemObservation observation = problem.initialObservation;
+  std::vector<scalar_t> initialLatencies;
+  mpcMrtInterface.setCurrentObservation(observation);
+  advanceMpc(initialLatencies);
+  if (!mpcMrtInterface.updatePolicy()) {
+    throw std::runtime_error("[runClosedLoopBenchmark] The initial MPC policy could not be computed!");
+  }
+  iterations.clear();
+  allocations.clear();
+  nodes.clear();
+  solverPhaseLatencies.clear();
+
+  const scalar_t dt = 1.0 / result.simulationFrequency;
+  const auto mpcPeriodSteps = std::max<size_t>(std::lround(result.simulationFrequency / result.mpcFrequency), 1);
+  const auto numSteps = static_cast<size_t>(std::floor(settings.duration * result.simulationFrequency));
+
+  for (size_t step = 0; step < numSteps; ++step) {
+    mpcMrtInterface.setCurrentObservation(observation);
+    if (step > 0 && step % mpcPeriodSteps == 0) {
+      advanceMpc(advanceMpcLatencies);
+    }
+
+    updatePolicyLatencies.push_back(measureMilliseconds([&]() { mpcMrtInterface.updatePolicy(); }));
+
+    // simulate the plant under the current policy
+    SystemObservation nextObservation;
+    nextObservation.time = observation.time + dt;
+    rolloutPolicyLatencies.push_back(measureMilliseconds([&]() {
+      mpcMrtInterface.rolloutPolicy(observation.time, observation.state, dt, nextObservation.state, nextObservation.input,
+                                    nextObservation.mode);
+    }));
+    observation = std::move(nextObservation);
+
+    // tracking cost
+    costProblem.preComputationPtr->request(Request::Cost + Request::SoftConstraint, observation.time, observation.state,
+                                           observation.input);
+    result.trackingCost += dt * computeCost(costProblem, observation.time, observation.state, observation.input);
+  }
+
+#ifdef OCS2_ENABLE_TRACING
+  trace::stop();
+  trace::clear();
+#endif
+
+  result.phaseLatencies["initialAdvanceMpc"] = computeStatistics(initialLatencies);
+  result.phaseLatencies["advanceMpc"] = computeStatistics(advanceMpcLatencies);
+  result.phaseLatencies["updatePolicy"] = computeStatistics(updatePolicyLatencies);
+  result.phaseLatencies["rolloutPolicy"] = computeStatistics(rolloutPolicyLatencies);
+  for (auto& phase : solverPhaseLatencies) {
+    result.phaseLatencies[phase.first] = computeStatistics(phase.second);
+  }
+  result.iterations = computeStatistics(iterations);
+  result.allocations = computeStatistics(allocations);
+  result.nodes = computeStatistics(nodes);
+  return result;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void writeJson(std::ostream& stream, const std::vector<BenchmarkResult>& results) {
+  const auto flags = stream.flags();
+  const auto precision = stream.precision();
+  stream << std::setprecision(6);
+
+  stream << "[\n";
+  for (size_t i = 0; i < results.size(); ++i) {
+    const auto& result = results[i];
+    stream << "  {\n";
+    stream << "    \"robot\": \"" << result.robotName << "\",\n";
+    stream << "    \"solver\": \"" << result.solverName << "\",\n";
+    stream << "    \"duration\": " << result.duration << ",\n";
+    stream << "    \"simulationFrequency\": " << result.simulationFrequency << ",\n";
+    stream << "    \"mpcFrequency\": " << result.mpcFrequency << ",\n";
+    stream << "    \"latencyMs\": {";
+    for (auto it = result.phaseLatencies.begin(); it != result.phaseLatencies.end(); ++it) {
+      stream << (it == result.phaseLatencies.begin() ? "\n" : ",\n") << "      \"" << it->first << "\": ";
+      writeJson(stream, it->second);
+    }
+    stream << "\n    },\n";
+    stream << "    \"iterations\": ";
+    writeJson(stream, result.iterations);
+    stream << ",\n    \"allocations\": ";
+    writeJson(stream, result.allocations);
+    stream << ",\n    \"nodes\": ";
+    writeJson(stream, result.nodes);
+    stream << ",\n    \"trackingCost\": ";
+    if (std::isfinite(result.trackingCost)) {
+      stream << result.trackingCost;
+    } else {
+      stream << "null";  // diverged closed loop
+    }
+    stream << ",\n";
+    stream << "    \"numFailedUpdates\": " << result.numFailedUpdates << "\n";
+    stream << "  }" << (i + 1 < results.size() ? "," : "") << "\n";
+  }
+  stream << "]\n";
+
+  stream.flags(flags);
+  stream.precision(precision);
+}
+
+}  // namespace mpc_benchmark
+}  // namespace ocs2
@@ -0,0 +1,106 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+#include <vector>
+
+#include "ocs2_benchmarks/BenchmarkProblems.h"
+#include "ocs2_benchmarks/MpcBenchmark.h"
+
+using namespace ocs2;
+using namespace mpc_benchmark;
+
+namespace {
+
+/** Splits a comma separated list. "all" is expanded to the given list of all names. */
+std::vector<std::string> parseNames(const std::string& argument, const std::vector<std::string>& allNames) {
+  if (argument == "all") {
+    return allNames;
+  }
+  std::vector<std::string> names;
+  std::stringstream stream(argument);
+  std::string name;
+  while (std::getline(stream, name, ',')) {
+    names.push_back(name);
+  }
+  return names;
+}
+
+}  // unnamed namespace
+
+/**
+ * Usage: mpc_benchmark <robots> <solvers> [outputFile] [settingsFile]
+ *
+ * robots: comma separated list of {cartpole, ballbot, quadrotor, mobile_manipulator, legged_robot} or "all"
+ * solvers: comma separated list of {sqp, ipm, slp, slq, ilqr} or "all"
+ * outputFile: the JSON results are written to this file. Written to stdout if omitted or "-".
+ * settingsFile: the benchmark settings, see config/benchmark.info. Default settings are used if omitted.
+ *               config/benchmark_uniform_grid.info runs the multiple shooting solvers without growing time steps.
+ *               config/benchmark_linesearch_batch.info runs sqp and ipm with concurrent linesearch step sizes.
+ */
+int main(int argc, char** argv) {
+  if (argc < 3) {
+    std::cerr << "Usage: " << argv[0] << " <robots> <solvers> [outputFile] [settingsFile]\n";
+    return 1;
+  }
+  const auto robotNames = parseNames(argv[1], getRobotNames());
+  const auto solverNames = parseNames(argv[2], getSolverNames());
+  const std::string outputFile = (argc > 3) ? argv[3] : "-";
+  const Settings settings = (argc > 4) ? loadSettings(argv[4]) : Settings();
+
+  std::vector<BenchmarkResult> results;
+  for (const auto& robotName : robotNames) {
+    for (const auto& solverName : solverNames) {
+      std::cerr << "[mpc_benchmark] " << robotName << " / " << solverName << '\n';
+      // a fresh problem for each solver such that no state is shared between the runs (e.g. the gait schedule)
+      const auto problemPtr = createBenchmarkProblem(robotName);
+      try {
+        results.push_back(runClosedLoopBenchmark(*problemPtr, fromSolverName(solverName), settings));
+      } catch (const std::exception& e) {
+        std::cerr << "[mpc_benchmark] " << robotName << " / " << solverName << " failed: " << e.what() << '\n';
+      }
+    }
+  }
+
+  if (outputFile == "-") {
+    writeJson(std::cout, results);
+  } else {
+    std::ofstream file(outputFile);
+    if (!file) {
+      std::cerr << "[mpc_benchmark] Could not open " << outputFile << '\n';
+      return 1;
+    }
+    writeJson(file, results);
+  }
+
+  return 0;
+}
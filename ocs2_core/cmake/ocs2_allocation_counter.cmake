@@ -0,0 +1,11 @@
+# Heap allocation counter of the tests and benchmarks, see ocs2_core/test/AllocationCounter.h
+# It interposes malloc for the whole executable, therefore it is not part of ocs2_core_LIBRARIES and has to be linked explicitly:
+#   target_link_libraries(my_test ocs2_core_allocation_counter)
+# The target is the one of ocs2_core when it is configured in the same CMake project, otherwise it is imported from the lib folder
+# next to the package config. Both resolve at build time, hence ocs2_core does not need to be built before its dependents are configured.
+if(NOT TARGET ocs2_core_allocation_counter)
+  add_library(ocs2_core_allocation_counter STATIC IMPORTED)
+  set_target_properties(ocs2_core_allocation_counter PROPERTIES
+    IMPORTED_LOCATION ${ocs2_core_DIR}/../../../lib/${CMAKE_STATIC_LIBRARY_PREFIX}ocs2_core_allocation_counter${CMAKE_STATIC_LIBRARY_SUFFIX}
+  )
+endif()
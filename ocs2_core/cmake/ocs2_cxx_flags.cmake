@@ -21,6 +21,14 @@ list(APPEND OCS2_CXX_FLAGS
   ${OpenMP_CXX_FLAGS}
   )
 
+# Compile the tracing spans of the solvers, see ocs2_core/misc/Trace.h
+#   catkin config --cmake-args -DOCS2_ENABLE_TRACING=ON
+if (OCS2_ENABLE_TRACING)
+  list(APPEND OCS2_CXX_FLAGS
+    "-DOCS2_ENABLE_TRACING"
+    )
+endif (OCS2_ENABLE_TRACING)
+
 # Cpp standard version
 set(CMAKE_CXX_STANDARD 14)
 set(CMAKE_CXX_STANDARD_REQUIRED ON)
@@ -0,0 +1,99 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <Eigen/Dense>
+
+#include "ocs2_core/Types.h"
+
+namespace ocs2 {
+
+/** Fixed-size vector type. */
+template <int DIM>
+using fixed_vector_t = Eigen::Matrix<scalar_t, DIM, 1>;
+
+/** Fixed-size matrix type. */
+template <int ROWS, int COLS>
+using fixed_matrix_t = Eigen::Matrix<scalar_t, ROWS, COLS>;
+
+/**
+ * Fixed-size counterpart of ScalarFunctionQuadraticApproximation for problems whose dimensions are known at compile time. The members
+ * are stack allocated, which allows Eigen to unroll and vectorize the products of small problems.
+ *
+ * @tparam STATE_DIM: The state dimension.
+ * @tparam INPUT_DIM: The input dimension.
+ */
+template <int STATE_DIM, int INPUT_DIM>
+struct FixedSizeScalarFunctionQuadraticApproximation {
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  /** Second derivative w.r.t state */
+  fixed_matrix_t<STATE_DIM, STATE_DIM> dfdxx;
+  /** Second derivative w.r.t input (lhs) and state (rhs) */
+  fixed_matrix_t<INPUT_DIM, STATE_DIM> dfdux;
+  /** Second derivative w.r.t input */
+  fixed_matrix_t<INPUT_DIM, INPUT_DIM> dfduu;
+  /** First derivative w.r.t state */
+  fixed_vector_t<STATE_DIM> dfdx;
+  /** First derivative w.r.t input */
+  fixed_vector_t<INPUT_DIM> dfdu;
+  /** Constant term */
+  scalar_t f = 0.;
+
+  /** Checks whether the dimensions of the dynamic-size approximation match the fixed dimensions. */
+  static bool hasMatchingSize(const ScalarFunctionQuadraticApproximation& other) {
+    return other.dfdxx.rows() == STATE_DIM && other.dfdxx.cols() == STATE_DIM && other.dfdux.rows() == INPUT_DIM &&
+           other.dfdux.cols() == STATE_DIM && other.dfduu.rows() == INPUT_DIM && other.dfdx.size() == STATE_DIM &&
+           other.dfdu.size() == INPUT_DIM;
+  }
+
+  /** Copies the dynamic-size approximation. The dimensions must match, see hasMatchingSize(). */
+  FixedSizeScalarFunctionQuadraticApproximation& fromDynamic(const ScalarFunctionQuadraticApproximation& other) {
+    dfdxx = other.dfdxx;
+    dfdux = other.dfdux;
+    dfduu = other.dfduu;
+    dfdx = other.dfdx;
+    dfdu = other.dfdu;
+    f = other.f;
+    return *this;
+  }
+
+  /** Copies into the dynamic-size approximation. The members of dst are resized, if required. */
+  void toDynamic(ScalarFunctionQuadraticApproximation& dst) const {
+    dst.dfdxx = dfdxx;
+    dst.dfdux = dfdux;
+    dst.dfduu = dfduu;
+    dst.dfdx = dfdx;
+    dst.dfdu = dfdu;
+    dst.f = f;
+  }
+};
+
+}  // namespace ocs2
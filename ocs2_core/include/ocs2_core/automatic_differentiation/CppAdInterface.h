@@ -33,7 +33,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <Eigen/Core>
 
 // STL
+#include <memory>
 #include <string>
+#include <vector>
 
 // CppAD
 #include <cppad/cg.hpp>
@@ -56,6 +58,12 @@ class CppAdInterface {
   using ad_parameterized_function_t = std::function<void(const ad_vector_t&, const ad_vector_t&, ad_vector_t&)>;
   using ad_fun_t = CppAD::ADFun<ad_base_t>;
 
+  /** Row and column indices of the nonzero entries of a sparse matrix, in the order in which the generated model writes them. */
+  struct SparsityIndices {
+    std::vector<size_t> rows;
+    std::vector<size_t> cols;
+  };
+
   /**
    * Constructor for parameterized functions
    *
@@ -85,7 +93,8 @@ class CppAdInterface {
   ~CppAdInterface() = default;
 
   /**
-   * Copy constructor. Models are reloaded if available.
+   * Copy constructor. The loaded library is shared with rhs, only the model evaluation buffers are created for the copy. If rhs has no
+   * models loaded, the models are loaded from disk if available.
    */
   CppAdInterface(const CppAdInterface& rhs);
 
@@ -108,13 +117,37 @@ class CppAdInterface {
   void createModels(ApproximationOrder approximationOrder = ApproximationOrder::Second, bool verbose = true);
 
   /**
-   * Load models if they are available on disk. Creates a new library otherwise.
+   * Load models if they are available on disk and were generated from the same function. Creates a new library otherwise.
+   * The function is taped in both cases. A library is reused only if the hash of the taped operation sequence, the approximation
+   * order, and the compile flags matches the one stored next to it, hence a modified function is never evaluated with a stale
+   * library. The sources are only generated if the library is compiled.
    *
    * @param approximationOrder : Order of derivatives to generate
    * @param verbose : Print out extra information
    */
   void loadModelsIfAvailable(ApproximationOrder approximationOrder = ApproximationOrder::Second, bool verbose = true);
 
+  /**
+   * Creates the models of several interfaces. The functions are taped one after the other, their libraries are compiled concurrently.
+   *
+   * @param interfaces : The interfaces whose models are created
+   * @param approximationOrder : Order of derivatives to generate
+   * @param verbose : Print out extra information
+   */
+  static void createModels(const std::vector<CppAdInterface*>& interfaces,
+                           ApproximationOrder approximationOrder = ApproximationOrder::Second, bool verbose = true);
+
+  /**
+   * Loads the models of several interfaces if they are available, see loadModelsIfAvailable(). The libraries which have to be created
+   * are compiled concurrently.
+   *
+   * @param interfaces : The interfaces whose models are loaded or created
+   * @param approximationOrder : Order of derivatives to generate
+   * @param verbose : Print out extra information
+   */
+  static void loadModelsIfAvailable(const std::vector<CppAdInterface*>& interfaces,
+                                    ApproximationOrder approximationOrder = ApproximationOrder::Second, bool verbose = true);
+
   /**
    * @param x : input vector of size variableDim
    * @param p : parameter vector of size parameterDim
@@ -131,6 +164,27 @@ class CppAdInterface {
    */
   matrix_t getJacobian(const vector_t& x, const vector_t& p = vector_t(0)) const;
 
+  /**
+   * Jacobian written into a preallocated output. The output is only reallocated if its size does not match.
+   *
+   * @param x : input vector of size variableDim
+   * @param p : parameter vector of size parameterDim
+   * @param [out] jacobian : d/dx( f(x,p) )
+   */
+  void getJacobian(const vector_t& x, const vector_t& p, matrix_t& jacobian) const;
+
+  /**
+   * Values of the nonzero Jacobian entries, ordered as in getJacobianSparsity().
+   *
+   * @param x : input vector of size variableDim
+   * @param p : parameter vector of size parameterDim
+   * @param [out] values : nonzero entries of d/dx( f(x,p) )
+   */
+  void getSparseJacobianValues(const vector_t& x, const vector_t& p, vector_t& values) const;
+
+  /** Fixed sparsity pattern of the Jacobian w.r.t. the variables. */
+  const SparsityIndices& getJacobianSparsity() const { return jacobianSparsity_; }
+
   /**
    * Returns the full Gauss-Newton approximation of the function.
    * With auto differentiated function y = f(x,p), the following approximation is made:
@@ -165,6 +219,29 @@ class CppAdInterface {
    */
   matrix_t getHessian(const vector_t& w, const vector_t& x, const vector_t& p = vector_t(0)) const;
 
+  /**
+   * Weighted hessian written into a preallocated output. The output is only reallocated if its size does not match.
+   *
+   * @param w: vector of weights of size rangeDim
+   * @param x : input vector of size variableDim
+   * @param p : parameter vector of size parameterDim
+   * @param [out] hessian : dd/dxdx(sum_i  w_i*f_i(x,p) )
+   */
+  void getHessian(const vector_t& w, const vector_t& x, const vector_t& p, matrix_t& hessian) const;
+
+  /**
+   * Values of the nonzero entries of the upper triangular part of the weighted hessian, ordered as in getHessianSparsity().
+   *
+   * @param w: vector of weights of size rangeDim
+   * @param x : input vector of size variableDim
+   * @param p : parameter vector of size parameterDim
+   * @param [out] values : upper triangular nonzero entries of dd/dxdx(sum_i  w_i*f_i(x,p) )
+   */
+  void getSparseHessianValues(const vector_t& w, const vector_t& x, const vector_t& p, vector_t& values) const;
+
+  /** Fixed sparsity pattern of the upper triangular part of the hessian w.r.t. the variables, i.e. rows[i] <= cols[i]. */
+  const SparsityIndices& getHessianSparsity() const { return hessianSparsity_; }
+
  private:
   /**
    * Defines library folder names
@@ -176,6 +253,51 @@ class CppAdInterface {
    */
   void createFolderStructure() const;
 
+  /** Taped function and the generators of its library, which are kept until the library is compiled. */
+  struct ModelGeneration;
+
+  /**
+   * Creates or loads the models of several interfaces. The libraries which have to be created are compiled concurrently.
+   *
+   * @param interfaces : The interfaces whose models are created
+   * @param approximationOrder : Order of derivatives to generate
+   * @param reuseLibrary : Whether an existing library on disk may be reused
+   * @param verbose : Print out extra information
+   */
+  static void createOrLoadModels(const std::vector<CppAdInterface*>& interfaces, ApproximationOrder approximationOrder, bool reuseLibrary,
+                                 bool verbose);
+
+  /**
+   * Tapes the function and hashes its operation sequence. Loads the library from disk if reuseLibrary is set and the library was
+   * compiled from an identical tape, otherwise generates the sources of the library.
+   *
+   * @param approximationOrder : Order of derivatives to generate
+   * @param reuseLibrary : Whether an existing library on disk may be reused
+   * @param verbose : Print out extra information
+   * @return The generation to compile, nullptr if the library was loaded
+   */
+  std::unique_ptr<ModelGeneration> tapeModels(ApproximationOrder approximationOrder, bool reuseLibrary, bool verbose);
+
+  /**
+   * Compiles the generated sources, loads the library and saves it together with its tape hash.
+   *
+   * @param generation : The generation returned by tapeModels()
+   * @param verbose : Print out extra information
+   */
+  void compileModels(ModelGeneration& generation, bool verbose);
+
+  /**
+   * Reads the hash of the tape from which the library on disk was compiled.
+   * @return tape hash, empty if not available
+   */
+  std::string readTapeHash() const;
+
+  /**
+   * Saves the hash of the tape from which the library was compiled next to it.
+   * @param tapeHash : tape hash
+   */
+  void writeTapeHash(const std::string& tapeHash) const;
+
   /**
    * Checks if library can already be found on disk.
    * @return isLibraryAvailable
@@ -203,9 +325,9 @@ class CppAdInterface {
   void setApproximationOrder(ApproximationOrder approximationOrder, CppAD::cg::ModelCSourceGen<scalar_t>& sourceGen, ad_fun_t& fun) const;
 
   /**
-   * Stores the sparisty nonzeros
+   * Stores the sparsity patterns of the generated model
    */
-  void setSparsityNonzeros();
+  void setSparsityPatterns();
 
   /**
    * Creates sparsity pattern for the Jacobian that will be generated
@@ -221,8 +343,24 @@ class CppAdInterface {
    */
   cppad_sparsity::SparsityPattern createHessianSparsity(ad_fun_t& fun) const;
 
-  std::unique_ptr<CppAD::cg::DynamicLib<scalar_t>> dynamicLib_;
-  std::unique_ptr<CppAD::cg::GenericModel<scalar_t>> model_;
+  /** Loaded dynamic library, shared read-only by all copies of an interface. */
+  struct SharedLibrary;
+
+  /** Deletes a model of the shared library, which unregisters the model from the library. */
+  struct ModelDeleter {
+    std::shared_ptr<SharedLibrary> libraryPtr;
+    void operator()(CppAD::cg::GenericModel<scalar_t>* model) const;
+  };
+
+  /**
+   * Creates the model of this interface from a loaded library.
+   * @param libraryPtr : the library
+   */
+  void setModel(std::shared_ptr<SharedLibrary> libraryPtr);
+
+  std::shared_ptr<SharedLibrary> libraryPtr_;
+  // The generated model holds mutable evaluation buffers, hence every copy has its own instance.
+  std::unique_ptr<CppAD::cg::GenericModel<scalar_t>, ModelDeleter> model_;
   ad_parameterized_function_t adFunction_;
   std::vector<std::string> compileFlags_;
 
@@ -230,8 +368,8 @@ class CppAdInterface {
   size_t variableDim_;
   size_t parameterDim_;
   size_t rangeDim_ = 0;
-  size_t nnzJacobian_ = 0;
-  size_t nnzHessian_ = 0;
+  SparsityIndices jacobianSparsity_;
+  SparsityIndices hessianSparsity_;
 
   // Names
   std::string modelName_;
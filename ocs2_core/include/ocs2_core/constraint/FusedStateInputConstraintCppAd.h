@@ -0,0 +1,98 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/automatic_differentiation/CppAdInterface.h>
+#include <ocs2_core/constraint/StateInputConstraint.h>
+#include <ocs2_core/constraint/StateInputConstraintCppAd.h>
+
+namespace ocs2 {
+
+/**
+ * Fuses several CppAD state-input constraint terms into a single generated model which evaluates their stacked constraint
+ * vectors. Subexpressions which are shared among the terms (e.g. the kinematics) are evaluated once.
+ *
+ * The model always evaluates all the terms. The rows of the inactive terms are dropped from the result, such that the output
+ * matches the one of a StateInputConstraintCollection holding the same terms. The parameters of the inactive terms are set to
+ * zero. The fused constraint is quadratic if any of the terms is quadratic.
+ */
+class FusedStateInputConstraintCppAd final : public StateInputConstraint {
+ public:
+  /**
+   * Constructor
+   * @param terms : The CppAD constraint terms to fuse. Their own models are not evaluated, hence they may be initialized without one,
+   *                see StateInputConstraintCppAd::initializeWithoutModel().
+   * @param stateDim : state vector dimension.
+   * @param inputDim : input vector dimension.
+   * @param modelName : Name of the generate model library.
+   * @param modelFolder : Folder where the model library files are saved.
+   * @param recompileLibraries : If true, always compile the model library, else try to load existing library if available.
+   * @param verbose : Print information.
+   */
+  FusedStateInputConstraintCppAd(std::vector<std::unique_ptr<StateInputConstraintCppAd>> terms, size_t stateDim, size_t inputDim,
+                                 const std::string& modelName, const std::string& modelFolder = "/tmp/ocs2", bool recompileLibraries = true,
+                                 bool verbose = true);
+
+  ~FusedStateInputConstraintCppAd() override = default;
+  FusedStateInputConstraintCppAd* clone() const override { return new FusedStateInputConstraintCppAd(*this); }
+
+  /** Active if any of the fused terms is active */
+  bool isActive(scalar_t time) const override;
+
+  /** Sum of the sizes of the active terms */
+  size_t getNumConstraints(scalar_t time) const override;
+
+  vector_t getValue(scalar_t time, const vector_t& state, const vector_t& input, const PreComputation& preComputation) const override;
+  VectorFunctionLinearApproximation getLinearApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                           const PreComputation& preComputation) const override;
+  VectorFunctionQuadraticApproximation getQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                                 const PreComputation& preComputation) const override;
+
+ private:
+  FusedStateInputConstraintCppAd(const FusedStateInputConstraintCppAd& rhs);
+
+  /** Concatenates the parameters of the active terms */
+  vector_t getParameters(scalar_t time, const PreComputation& preComputation) const;
+
+  /** The {first row, number of rows} of the active terms in the stacked model output */
+  std::vector<std::pair<size_t, size_t>> getActiveRows(scalar_t time) const;
+
+  std::vector<std::unique_ptr<StateInputConstraintCppAd>> terms_;
+  size_t parameterDim_ = 0;
+  std::unique_ptr<ocs2::CppAdInterface> adInterfacePtr_;
+};
+
+}  // namespace ocs2
@@ -56,6 +56,13 @@ class StateInputConstraintCppAd : public StateInputConstraint {
   void initialize(size_t stateDim, size_t inputDim, size_t parameterDim, const std::string& modelName,
                   const std::string& modelFolder = "/tmp/ocs2", bool recompileLibraries = true, bool verbose = true);
 
+  /**
+   * Initialize the term without generating its own model. Such a term can only be evaluated as part of a
+   * FusedStateInputConstraintCppAd. Terms without parameters need not be initialized at all in that case.
+   * @param parameterDim : parameter vector dimension, set to 0 if getParameters() is not used.
+   */
+  void initializeWithoutModel(size_t parameterDim);
+
   /** Get the parameter vector */
   virtual vector_t getParameters(scalar_t time, const PreComputation& /* preComputation */) const { return vector_t(0); };
 
@@ -74,7 +81,10 @@ class StateInputConstraintCppAd : public StateInputConstraint {
                                          const ad_vector_t& parameters) const = 0;
 
  private:
+  friend class FusedStateInputConstraintCppAd;
+
   std::unique_ptr<ocs2::CppAdInterface> adInterfacePtr_;
+  size_t parameterDim_ = 0;
 };
 
 }  // namespace ocs2
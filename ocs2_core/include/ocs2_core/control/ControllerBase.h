@@ -109,6 +109,15 @@ class ControllerBase {
    */
   virtual ControllerBase* clone() const = 0;
 
+  /**
+   * @brief Copies the control law of another controller into this one, reusing the memory of this controller.
+   * Controllers which do not support this, or a controller of a different type, leave this controller unchanged.
+   *
+   * @param[in] other: The controller to copy.
+   * @return true if the control law was copied.
+   */
+  virtual bool copyFrom(const ControllerBase& other) { return false; }
+
   /**
    * Displays controller's data.
    */
@@ -97,6 +97,8 @@ class FeedforwardController final : public ControllerBase {
 
   FeedforwardController* clone() const override;
 
+  bool copyFrom(const ControllerBase& other) override;
+
   void display() const override;
 
   void flatten(const scalar_array_t& timeArray, const std::vector<std::vector<float>*>& flatArray2) const override;
@@ -110,6 +112,9 @@ class FeedforwardController final : public ControllerBase {
   scalar_array_t timeStamp_;
   vector_array_t uffArray_;
 
+ private:
+  LinearInterpolation::TimeSegmentCursor timeSegmentCursor_;
+
   friend void swap(FeedforwardController& a, FeedforwardController& b) noexcept;
 };
 
@@ -31,6 +31,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/Types.h>
 #include <ocs2_core/control/ControllerBase.h>
+#include <ocs2_core/misc/ContiguousTrajectory.h>
 #include <ocs2_core/misc/LinearInterpolation.h>
 
 namespace ocs2 {
@@ -38,6 +39,8 @@ namespace ocs2 {
 /**
  * LinearController implements a time and state dependent controller of the
  * form u[x,t] = k[t] * x + uff[t]
+ *
+ * The bias and gain trajectories are each held in a single contiguous buffer, see ContiguousTrajectory.
  */
 class LinearController final : public ControllerBase {
  public:
@@ -51,8 +54,8 @@ class LinearController final : public ControllerBase {
    * @param [in] controllerBias: The bias array.
    * @param [in] controllerGain: The feedback gain array.
    */
-  LinearController(scalar_array_t controllerTime, vector_array_t controllerBias, matrix_array_t controllerGain)
-      : timeStamp_(std::move(controllerTime)), biasArray_(std::move(controllerBias)), gainArray_(std::move(controllerGain)) {}
+  LinearController(scalar_array_t controllerTime, const vector_array_t& controllerBias, const matrix_array_t& controllerGain)
+      : timeStamp_(std::move(controllerTime)), biasArray_(controllerBias), gainArray_(controllerGain) {}
 
   /** Copy constructor */
   LinearController(const LinearController& other);
@@ -69,6 +72,8 @@ class LinearController final : public ControllerBase {
   /** Clone */
   LinearController* clone() const override;
 
+  bool copyFrom(const ControllerBase& other) override;
+
   /**
    * @brief setController Assign control law
    * @param [in] controllerTime: Time stamp array of the controller
@@ -107,9 +112,12 @@ class LinearController final : public ControllerBase {
 
  public:
   scalar_array_t timeStamp_;
-  vector_array_t biasArray_;
-  vector_array_t deltaBiasArray_;
-  matrix_array_t gainArray_;
+  ContiguousTrajectory<vector_t> biasArray_;
+  ContiguousTrajectory<vector_t> deltaBiasArray_;
+  ContiguousTrajectory<matrix_t> gainArray_;
+
+ private:
+  LinearInterpolation::TimeSegmentCursor timeSegmentCursor_;
 
   friend void swap(LinearController& a, LinearController& b) noexcept;
 };
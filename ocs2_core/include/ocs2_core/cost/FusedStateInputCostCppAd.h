@@ -0,0 +1,95 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/automatic_differentiation/CppAdInterface.h>
+#include <ocs2_core/cost/StateInputCost.h>
+#include <ocs2_core/cost/StateInputCostCppAd.h>
+
+namespace ocs2 {
+
+/**
+ * Fuses several CppAD state-input cost terms into a single generated model which evaluates their sum. Subexpressions which are
+ * shared among the terms (e.g. the kinematics) are evaluated once, and the summed quadratic approximation is obtained in a
+ * single call instead of one call per term.
+ *
+ * The parameter vector of the fused model is the concatenation of the parameters of the terms followed by one activity flag
+ * per term. An inactive term is masked out by its flag and its parameters are set to zero, hence its cost function should
+ * remain finite for zero parameters.
+ */
+class FusedStateInputCostCppAd final : public StateInputCost {
+ public:
+  /**
+   * Constructor
+   * @param terms : The CppAD cost terms to fuse. Their own models are not evaluated, hence they may be initialized without one, see
+   *                StateInputCostCppAd::initializeWithoutModel().
+   * @param stateDim : state vector dimension.
+   * @param inputDim : input vector dimension.
+   * @param modelName : Name of the generate model library.
+   * @param modelFolder : Folder where the model library files are saved.
+   * @param recompileLibraries : If true, always compile the model library, else try to load existing library if available.
+   * @param verbose : Print information.
+   */
+  FusedStateInputCostCppAd(std::vector<std::unique_ptr<StateInputCostCppAd>> terms, size_t stateDim, size_t inputDim,
+                           const std::string& modelName, const std::string& modelFolder = "/tmp/ocs2", bool recompileLibraries = true,
+                           bool verbose = true);
+
+  ~FusedStateInputCostCppAd() override = default;
+  FusedStateInputCostCppAd* clone() const override { return new FusedStateInputCostCppAd(*this); }
+
+  /** Active if any of the fused terms is active */
+  bool isActive(scalar_t time) const override;
+
+  scalar_t getValue(scalar_t time, const vector_t& state, const vector_t& input, const TargetTrajectories& targetTrajectories,
+                    const PreComputation& preComputation) const override;
+  ScalarFunctionQuadraticApproximation getQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                                 const TargetTrajectories& targetTrajectories,
+                                                                 const PreComputation& preComputation) const override;
+  void accumulateQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                        const TargetTrajectories& targetTrajectories, const PreComputation& preComputation,
+                                        ScalarFunctionQuadraticApproximation& approximation) const override;
+
+ private:
+  FusedStateInputCostCppAd(const FusedStateInputCostCppAd& rhs);
+
+  /** Concatenates the parameters of the active terms and appends the activity flags */
+  vector_t getParameters(scalar_t time, const TargetTrajectories& targetTrajectories, const PreComputation& preComputation) const;
+
+  std::vector<std::unique_ptr<StateInputCostCppAd>> terms_;
+  size_t termsParameterDim_ = 0;
+  std::unique_ptr<ocs2::CppAdInterface> adInterfacePtr_;
+};
+
+}  // namespace ocs2
@@ -30,6 +30,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #pragma once
 
 #include <ocs2_core/cost/StateCost.h>
+#include <ocs2_core/misc/LinearInterpolation.h>
 
 namespace ocs2 {
 
@@ -62,6 +63,7 @@ class QuadraticStateCost : public StateCost {
 
  private:
   matrix_t Q_;
+  mutable LinearInterpolation::TimeSegmentCursor targetTrajectoriesCursor_;
 };
 
 }  // namespace ocs2
@@ -32,6 +32,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <utility>
 
 #include <ocs2_core/cost/StateInputCost.h>
+#include <ocs2_core/misc/LinearInterpolation.h>
 
 namespace ocs2 {
 
@@ -70,6 +71,7 @@ class QuadraticStateInputCost : public StateInputCost {
   matrix_t Q_;
   matrix_t R_;
   matrix_t P_;
+  mutable LinearInterpolation::TimeSegmentCursor targetTrajectoriesCursor_;
 };
 
 }  // namespace ocs2
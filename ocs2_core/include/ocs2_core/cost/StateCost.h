@@ -56,6 +56,19 @@ class StateCost {
                                                                          const TargetTrajectories& targetTrajectories,
                                                                          const PreComputation& preComp) const = 0;
 
+  /**
+   * Adds the cost term quadratic approximation to f, dfdx and dfdxx of approximation, which can also be a state-input approximation.
+   * Terms with sparse derivatives can override this to accumulate their nonzero entries without forming the dense approximation of the
+   * term.
+   */
+  virtual void accumulateQuadraticApproximation(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories,
+                                                const PreComputation& preComp, ScalarFunctionQuadraticApproximation& approximation) const {
+    const auto termApproximation = getQuadraticApproximation(time, state, targetTrajectories, preComp);
+    approximation.f += termApproximation.f;
+    approximation.dfdx += termApproximation.dfdx;
+    approximation.dfdxx += termApproximation.dfdxx;
+  }
+
  protected:
   StateCost(const StateCost& rhs) = default;
 };
@@ -59,6 +59,10 @@ class StateCostCollection : public Collection<StateCost> {
                                                                          const TargetTrajectories& targetTrajectories,
                                                                          const PreComputation& preComp) const;
 
+  /** Add the state-only cost quadratic approximation to f, dfdx and dfdxx of approximation */
+  virtual void accumulateQuadraticApproximation(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories,
+                                                const PreComputation& preComp, ScalarFunctionQuadraticApproximation& approximation) const;
+
  protected:
   /** Copy constructor */
   StateCostCollection(const StateCostCollection& other);
@@ -67,6 +67,8 @@ class StateCostCppAd : public StateCost {
   ScalarFunctionQuadraticApproximation getQuadraticApproximation(scalar_t time, const vector_t& state,
                                                                  const TargetTrajectories& targetTrajectories,
                                                                  const PreComputation& preComp) const override;
+  void accumulateQuadraticApproximation(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories,
+                                        const PreComputation& preComp, ScalarFunctionQuadraticApproximation& approximation) const override;
 
  protected:
   StateCostCppAd(const StateCostCppAd& rhs);
@@ -56,6 +56,16 @@ class StateInputCost {
                                                                          const TargetTrajectories& targetTrajectories,
                                                                          const PreComputation& preComp) const = 0;
 
+  /**
+   * Adds the cost term quadratic approximation to approximation. Terms with sparse derivatives can override this to accumulate their
+   * nonzero entries without forming the dense approximation of the term.
+   */
+  virtual void accumulateQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                const TargetTrajectories& targetTrajectories, const PreComputation& preComp,
+                                                ScalarFunctionQuadraticApproximation& approximation) const {
+    approximation += getQuadraticApproximation(time, state, input, targetTrajectories, preComp);
+  }
+
  protected:
   StateInputCost(const StateInputCost& rhs) = default;
 };
@@ -59,6 +59,25 @@ class StateInputCostCollection : public Collection<StateInputCost> {
                                                                          const TargetTrajectories& targetTrajectories,
                                                                          const PreComputation& preComp) const;
 
+  /** Add the state-input cost quadratic approximation to approximation */
+  virtual void accumulateQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                const TargetTrajectories& targetTrajectories, const PreComputation& preComp,
+                                                ScalarFunctionQuadraticApproximation& approximation) const;
+
+  /**
+   * Replaces all the StateInputCostCppAd terms of the collection by a single FusedStateInputCostCppAd term, which evaluates
+   * them in one generated model. The fused term is added under the name modelName. Does nothing if there are no such terms.
+   *
+   * @param stateDim : state vector dimension.
+   * @param inputDim : input vector dimension.
+   * @param modelName : Name of the fused term and of its generated model library.
+   * @param modelFolder : Folder where the model library files are saved.
+   * @param recompileLibraries : If true, always compile the model library, else try to load existing library if available.
+   * @param verbose : Print information.
+   */
+  void fuseCppAdTerms(size_t stateDim, size_t inputDim, const std::string& modelName, const std::string& modelFolder = "/tmp/ocs2",
+                      bool recompileLibraries = true, bool verbose = true);
+
  protected:
   /** Copy constructor */
   StateInputCostCollection(const StateInputCostCollection& other);
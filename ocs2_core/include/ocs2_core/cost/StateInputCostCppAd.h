@@ -56,6 +56,13 @@ class StateInputCostCppAd : public StateInputCost {
   void initialize(size_t stateDim, size_t inputDim, size_t parameterDim, const std::string& modelName,
                   const std::string& modelFolder = "/tmp/ocs2", bool recompileLibraries = true, bool verbose = true);
 
+  /**
+   * Initialize the term without generating its own model. Such a term can only be evaluated as part of a FusedStateInputCostCppAd.
+   * Terms without parameters need not be initialized at all in that case.
+   * @param parameterDim : parameter vector dimension, set to 0 if getParameters() is not used.
+   */
+  void initializeWithoutModel(size_t parameterDim);
+
   /** Get the parameter vector */
   virtual vector_t getParameters(scalar_t time, const TargetTrajectories& targetTrajectories,
                                  const PreComputation& /* preComputation */) const {
@@ -68,6 +75,9 @@ class StateInputCostCppAd : public StateInputCost {
   ScalarFunctionQuadraticApproximation getQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
                                                                  const TargetTrajectories& targetTrajectories,
                                                                  const PreComputation& preComputation) const override;
+  void accumulateQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                        const TargetTrajectories& targetTrajectories, const PreComputation& preComputation,
+                                        ScalarFunctionQuadraticApproximation& approximation) const override;
 
  protected:
   StateInputCostCppAd(const StateInputCostCppAd& rhs);
@@ -77,7 +87,17 @@ class StateInputCostCppAd : public StateInputCost {
                                    const ad_vector_t& parameters) const = 0;
 
  private:
+  friend class FusedStateInputCostCppAd;
+
+  /**
+   * Adds the quadratic approximation of a cost taped as a function of (time, state, input) to approximation. The nonzero derivative
+   * entries are added directly, the derivatives w.r.t. time are dropped.
+   */
+  static void accumulateTapedApproximation(const CppAdInterface& adInterface, const vector_t& tapedTimeStateInput,
+                                           const vector_t& parameters, ScalarFunctionQuadraticApproximation& approximation);
+
   std::unique_ptr<ocs2::CppAdInterface> adInterfacePtr_;
+  size_t parameterDim_ = 0;
 };
 
 }  // namespace ocs2
@@ -47,6 +47,11 @@ class LoopshapingStateInputCost : public StateInputCostCollection {
   scalar_t getValue(scalar_t t, const vector_t& x, const vector_t& u, const TargetTrajectories& targetTrajectories,
                     const PreComputation& preComp) const final;
 
+  void accumulateQuadraticApproximation(scalar_t t, const vector_t& x, const vector_t& u, const TargetTrajectories& targetTrajectories,
+                                        const PreComputation& preComp, ScalarFunctionQuadraticApproximation& approximation) const final {
+    approximation += getQuadraticApproximation(t, x, u, targetTrajectories, preComp);
+  }
+
  protected:
   /** Constructor */
   LoopshapingStateInputCost(const StateInputCostCollection& systemCost, std::shared_ptr<LoopshapingDefinition> loopshapingDefinition)
@@ -79,6 +79,15 @@ class Collection {
    */
   std::unique_ptr<T> extract(const std::string& name);
 
+  /**
+   * Removes all terms of type Derived from the Collection. The remaining terms keep their order.
+   *
+   * @tparam Derived: derived class of base type T to extract.
+   * @return The extracted terms in the order they were added.
+   */
+  template <typename Derived>
+  std::vector<std::unique_ptr<Derived>> extractAll();
+
   /**
    * Use to modify a term.
    * @tparam Derived: derived class of base type T to cast to. Casts to the base class by default
@@ -164,6 +173,32 @@ std::unique_ptr<T> Collection<T>::extract(const std::string& name) {
   return term;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+template <typename T>
+template <typename Derived>
+std::vector<std::unique_ptr<Derived>> Collection<T>::extractAll() {
+  static_assert(std::is_base_of<T, Derived>::value, "Template argument must derive from the base type of this collection");
+
+  // names of the matching terms in the order they were added
+  std::vector<std::string> names;
+  for (const auto& nameIndex : termNameMap_) {
+    if (dynamic_cast<const Derived*>(terms_[nameIndex.second].get()) != nullptr) {
+      names.push_back(nameIndex.first);
+    }
+  }
+  std::sort(names.begin(), names.end(),
+            [this](const std::string& lhs, const std::string& rhs) { return termNameMap_.at(lhs) < termNameMap_.at(rhs); });
+
+  std::vector<std::unique_ptr<Derived>> extractedTerms;
+  extractedTerms.reserve(names.size());
+  for (const auto& name : names) {
+    extractedTerms.emplace_back(static_cast<Derived*>(extract(name).release()));
+  }
+  return extractedTerms;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -0,0 +1,209 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <algorithm>
+#include <cassert>
+#include <utility>
+#include <vector>
+
+#include "ocs2_core/Types.h"
+
+namespace ocs2 {
+
+/**
+ * A trajectory of Eigen matrices stored in one contiguous buffer with a fixed stride per node. The nodes are accessed through
+ * Eigen::Map views, such that a trajectory of N nodes is held by a single allocation instead of N separate ones. Nodes may be
+ * smaller than the stride (e.g. the empty inputs at event times), in which case the tail of their slot is unused.
+ *
+ * It is used for the gain trajectories of the controllers, which are copied with every policy update. The state and input
+ * trajectories of PrimalSolution and the per-node data of the multiple shooting transcription are kept as arrays of nodes, since
+ * their access pattern does not benefit measurably from the contiguous layout.
+ *
+ * @note Growing the stride (through set() or push_back() with a larger node) re-lays out the buffer and invalidates all views.
+ *
+ * @tparam Matrix: A dynamic-size, column-major Eigen type such as vector_t or matrix_t.
+ */
+template <typename Matrix>
+class ContiguousTrajectory {
+ public:
+  using Scalar = typename Matrix::Scalar;
+  using map_t = Eigen::Map<Matrix>;
+  using const_map_t = Eigen::Map<const Matrix>;
+
+  /** Default constructor, creates an empty trajectory. */
+  ContiguousTrajectory() = default;
+
+  /** Constructor which copies the nodes of the given array. */
+  explicit ContiguousTrajectory(const std::vector<Matrix>& array) { assign(array); }
+
+  /** Replaces the content with a copy of the nodes of the given array. */
+  void assign(const std::vector<Matrix>& array) {
+    size_t stride = 0;
+    for (const auto& m : array) {
+      stride = std::max(stride, static_cast<size_t>(m.size()));
+    }
+    stride_ = stride;
+    buffer_.resize(array.size() * stride_);
+    dims_.resize(array.size());
+    for (size_t i = 0; i < array.size(); i++) {
+      dims_[i] = {array[i].rows(), array[i].cols()};
+      (*this)[i] = array[i];
+    }
+  }
+
+  /**
+   * Resizes the trajectory to numNodes nodes of identical size. The buffer is reused if its capacity suffices.
+   * @note The node values are unspecified afterwards.
+   */
+  void resize(size_t numNodes, Eigen::Index rows, Eigen::Index cols = 1) {
+    stride_ = static_cast<size_t>(rows * cols);
+    buffer_.resize(numNodes * stride_);
+    dims_.assign(numNodes, {rows, cols});
+  }
+
+  /**
+   * Changes the size of node i without moving any data. The new size must fit into the stride.
+   * @note The node value is unspecified afterwards.
+   */
+  void resizeNode(size_t i, Eigen::Index rows, Eigen::Index cols = 1) {
+    assert(i < size());
+    assert(static_cast<size_t>(rows * cols) <= stride_);
+    dims_[i] = {rows, cols};
+  }
+
+  /** Removes the nodes from index numNodes onwards, keeping the values of the remaining nodes. */
+  void truncate(size_t numNodes) {
+    if (numNodes < size()) {
+      dims_.resize(numNodes);
+      buffer_.resize(numNodes * stride_);
+    }
+  }
+
+  /** Removes all the nodes. The buffer capacity is kept. */
+  void clear() {
+    stride_ = 0;
+    buffer_.clear();
+    dims_.clear();
+  }
+
+  /** Sets node i to the given value. Its size may differ from the current one. */
+  template <typename Derived>
+  void set(size_t i, const Eigen::MatrixBase<Derived>& value) {
+    assert(i < size());
+    growStride(static_cast<size_t>(value.size()));
+    dims_[i] = {value.rows(), value.cols()};
+    (*this)[i] = value;
+  }
+
+  /** Appends a node with the given value. */
+  template <typename Derived>
+  void push_back(const Eigen::MatrixBase<Derived>& value) {
+    growStride(static_cast<size_t>(value.size()));
+    dims_.emplace_back(value.rows(), value.cols());
+    buffer_.resize(dims_.size() * stride_);
+    (*this)[size() - 1] = value;
+  }
+
+  /** Appends the nodes [index, index + length) of another trajectory. */
+  void append(const ContiguousTrajectory& other, size_t index, size_t length) {
+    assert(index + length <= other.size());
+    if (length > 0) {
+      growStride(other.stride_);
+      buffer_.resize((size() + length) * stride_);
+      for (size_t k = index; k < index + length; k++) {
+        dims_.push_back(other.dims_[k]);
+        (*this)[size() - 1] = other[k];
+      }
+    }
+  }
+
+  /** Returns a copy of the nodes as an array. */
+  std::vector<Matrix> toArray() const {
+    std::vector<Matrix> array;
+    array.reserve(size());
+    for (size_t i = 0; i < size(); i++) {
+      array.emplace_back((*this)[i]);
+    }
+    return array;
+  }
+
+  map_t operator[](size_t i) {
+    assert(i < size());
+    return map_t(buffer_.data() + i * stride_, dims_[i].first, dims_[i].second);
+  }
+
+  const_map_t operator[](size_t i) const {
+    assert(i < size());
+    return const_map_t(buffer_.data() + i * stride_, dims_[i].first, dims_[i].second);
+  }
+
+  map_t back() { return (*this)[size() - 1]; }
+  const_map_t back() const { return (*this)[size() - 1]; }
+
+  size_t size() const { return dims_.size(); }
+  bool empty() const { return dims_.empty(); }
+
+  /** The number of scalars reserved for each node. */
+  size_t stride() const { return stride_; }
+
+  void swap(ContiguousTrajectory& other) noexcept {
+    std::swap(stride_, other.stride_);
+    buffer_.swap(other.buffer_);
+    dims_.swap(other.dims_);
+  }
+
+ private:
+  /** Increases the stride to at least newStride and moves the existing nodes to their new slots. */
+  void growStride(size_t newStride) {
+    if (newStride <= stride_) {
+      return;
+    }
+    buffer_.resize(size() * newStride);
+    // Slots only move towards the end, hence going backwards never overwrites a node which is yet to be moved.
+    for (size_t i = size(); i-- > 0;) {
+      const auto first = buffer_.begin() + i * stride_;
+      const auto numScalars = dims_[i].first * dims_[i].second;
+      std::copy_backward(first, first + numScalars, buffer_.begin() + i * newStride + numScalars);
+    }
+    stride_ = newStride;
+  }
+
+  size_t stride_ = 0;
+  std::vector<Scalar> buffer_;
+  std::vector<std::pair<Eigen::Index, Eigen::Index>> dims_;
+};
+
+template <typename Matrix>
+void swap(ContiguousTrajectory<Matrix>& a, ContiguousTrajectory<Matrix>& b) noexcept {
+  a.swap(b);
+}
+
+}  // namespace ocs2
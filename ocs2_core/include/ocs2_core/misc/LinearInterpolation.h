@@ -34,6 +34,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <vector>
 
 #include "ocs2_core/Types.h"
+#include "ocs2_core/misc/ContiguousTrajectory.h"
 
 namespace ocs2 {
 namespace LinearInterpolation {
@@ -53,6 +54,43 @@ using remove_cvref_t = typename std::remove_cv<typename std::remove_reference<T>
  */
 index_alpha_t timeSegment(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray);
 
+/**
+ * Stateful version of timeSegment() for sequences of lookups. The cursor remembers the interval of the last lookup and walks from
+ * there, such that lookups at monotonically increasing (or decreasing) times take amortized constant time instead of a binary search
+ * each. Lookups far from the last one fall back to a binary search, hence arbitrary enquiry times are still supported. The result is
+ * always identical to timeSegment().
+ *
+ * The cursor does not store the time array. It stays valid if the array changes, but only speeds up consecutive lookups in the same
+ * array. A cursor is not thread-safe, use one cursor per thread.
+ */
+class TimeSegmentCursor {
+ public:
+  /**
+   * Get the interval index and interpolation coefficient alpha, see timeSegment().
+   *
+   * @param [in] enquiryTime: The enquiry time for interpolation.
+   * @param [in] timeArray: interpolation time array.
+   * @return {index, alpha}
+   */
+  index_alpha_t timeSegment(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray);
+
+  /** Forgets the last lookup */
+  void reset() { lowerBound_ = 0; }
+
+ private:
+  // Index of the first time which is not smaller than the last enquiry time
+  size_t lowerBound_ = 0;
+};
+
+/**
+ * Get the interval indices and interpolation coefficients for a sorted array of enquiry times in a single pass over the time array.
+ *
+ * @param [in] enquiryTimes: The sorted enquiry times for interpolation.
+ * @param [in] timeArray: interpolation time array.
+ * @return {index, alpha} for each enquiry time
+ */
+std::vector<index_alpha_t> timeSegments(const std::vector<scalar_t>& enquiryTimes, const std::vector<scalar_t>& timeArray);
+
 /**
  * Directly uses the index and interpolation coefficient provided by the user
  * @note If sizes in data array are not equal, the interpolation will snap to the data
@@ -92,6 +130,22 @@ Data interpolate(index_alpha_t indexAlpha, const std::vector<Data, Alloc>& dataA
 template <typename Data, class Alloc>
 Data interpolate(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray, const std::vector<Data, Alloc>& dataArray);
 
+/**
+ * Linearly interpolates at each of the sorted enquiry times in a single pass over the time array. The result is identical to
+ * interpolating at each enquiry time separately.
+ *
+ * @param [in] enquiryTimes: The sorted enquiry times for interpolation.
+ * @param [in] timeArray: Times vector
+ * @param [in] dataArray: Data vector
+ * @return The interpolation result for each enquiry time
+ *
+ * @tparam Data: Data type
+ * @tparam Alloc: Specialized allocation class
+ */
+template <typename Data, class Alloc>
+std::vector<Data, Alloc> interpolate(const std::vector<scalar_t>& enquiryTimes, const std::vector<scalar_t>& timeArray,
+                                     const std::vector<Data, Alloc>& dataArray);
+
 /**
  * Directly uses the index and interpolation coefficient provided by the user
  * @note If sizes in data array are not equal, the interpolation will snap to the data
@@ -139,6 +193,29 @@ template <typename Data, class Alloc, class AccessFun>
 auto interpolate(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray, const std::vector<Data, Alloc>& dataArray,
                  AccessFun accessFun) -> remove_cvref_t<typename std::result_of<AccessFun(const std::vector<Data, Alloc>&, size_t)>::type>;
 
+/**
+ * Directly uses the index and interpolation coefficient provided by the user. Same as the std::vector overload, but for
+ * trajectories stored in a ContiguousTrajectory.
+ *
+ * @param [in] indexAlpha : index and interpolation coefficient (alpha) pair
+ * @param [in] trajectory: contiguous trajectory of data
+ * @return The interpolation result
+ */
+template <typename Matrix>
+Matrix interpolate(index_alpha_t indexAlpha, const ContiguousTrajectory<Matrix>& trajectory);
+
+/**
+ * Linearly interpolates at the given time. Same as the std::vector overload, but for trajectories stored in a
+ * ContiguousTrajectory.
+ *
+ * @param [in] enquiryTime: The enquiry time for interpolation.
+ * @param [in] timeArray: Times vector
+ * @param [in] trajectory: contiguous trajectory of data
+ * @return The interpolation result
+ */
+template <typename Matrix>
+Matrix interpolate(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray, const ContiguousTrajectory<Matrix>& trajectory);
+
 }  // namespace LinearInterpolation
 }  // namespace ocs2
 
@@ -0,0 +1,121 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <cstdint>
+#include <map>
+#include <ostream>
+#include <string>
+
+namespace ocs2 {
+namespace trace {
+
+/**
+ * Hierarchical tracing of solver phases.
+ *
+ * Spans are recorded with OCS2_TRACE_SCOPE("name"), which measures the enclosing scope. Nested spans of a thread form the hierarchy.
+ * Each thread writes its spans to its own ring buffer without locking; when a buffer is full the oldest spans are overwritten. The
+ * recorded spans are exported in the Chrome trace event format, which can be opened with chrome://tracing or https://ui.perfetto.dev.
+ *
+ * The spans are compiled only if OCS2_ENABLE_TRACING is defined (cmake option OCS2_ENABLE_TRACING), otherwise the macro expands to
+ * nothing. In addition, recording has to be started at runtime with start().
+ *
+ * Usage:
+ *   trace::start();
+ *   mpc.run(...);
+ *   trace::stop();
+ *   trace::exportChromeTrace("mpc_trace.json");
+ */
+
+/**
+ * Starts recording. The ring buffer of each thread holds the given number of spans. The capacity only applies to the buffers of threads
+ * which have not recorded before.
+ */
+void start(size_t bufferCapacity = 16384);
+
+/** Stops recording. The recorded spans are kept. */
+void stop();
+
+/** Whether spans are being recorded. */
+bool isEnabled();
+
+/** Discards all recorded spans. */
+void clear();
+
+/** Sets the name under which the spans of the calling thread are displayed. */
+void setThreadName(const std::string& name);
+
+/**
+ * Writes the recorded spans in the Chrome trace event format. The spans which are overwritten while writing are skipped, hence it is
+ * best to stop() recording before.
+ */
+void writeChromeTrace(std::ostream& stream);
+
+/** Writes the recorded spans to a JSON file in the Chrome trace event format, see writeChromeTrace(). */
+void exportChromeTrace(const std::string& filePath);
+
+/**
+ * Returns the total duration [ms] of the recorded spans of each name. The durations of the spans of different threads are added, e.g.
+ * the spans of the worker threads may sum up to more than the wall-clock time of their parent span.
+ */
+std::map<std::string, double> getTotalDurations();
+
+/**
+ * Records the time between its construction and destruction as a span of the calling thread.
+ */
+class ScopedSpan {
+ public:
+  /**
+   * Constructor
+   * @param [in] name: The name of the span. It has to outlive the export of the trace, e.g. a string literal.
+   */
+  explicit ScopedSpan(const char* name);
+  ~ScopedSpan();
+
+  ScopedSpan(const ScopedSpan&) = delete;
+  ScopedSpan& operator=(const ScopedSpan&) = delete;
+
+ private:
+  const char* name_;
+  int64_t beginTime_;
+};
+
+}  // namespace trace
+}  // namespace ocs2
+
+#define OCS2_TRACE_CONCAT_IMPL(a, b) a##b
+#define OCS2_TRACE_CONCAT(a, b) OCS2_TRACE_CONCAT_IMPL(a, b)
+
+#ifdef OCS2_ENABLE_TRACING
+/** Records the enclosing scope as a span with the given name (a string literal). */
+#define OCS2_TRACE_SCOPE(name) const ::ocs2::trace::ScopedSpan OCS2_TRACE_CONCAT(ocs2TraceSpan, __LINE__)(name)
+#else
+#define OCS2_TRACE_SCOPE(name)
+#endif
@@ -66,13 +66,11 @@ const Data& stdAccessFun(const std::vector<Data, Alloc>& vec, size_t ind) {
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-inline index_alpha_t timeSegment(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray) {
-  // corner cases (no time set OR single time element)
-  if (timeArray.size() <= 1) {
-    return {0, scalar_t(1.0)};
-  }
-
-  const int index = lookup::findIntervalInTimeArray(timeArray, enquiryTime);
+/**
+ * Computes the interpolation coefficient in a given interval of the time array, see findIntervalInTimeArray() for the numbering of the
+ * intervals.
+ */
+inline index_alpha_t timeSegmentInInterval(int index, scalar_t enquiryTime, const std::vector<scalar_t>& timeArray) {
   const auto lastInterval = static_cast<int>(timeArray.size() - 1);
   if (index >= 0) {
     if (index < lastInterval) {
@@ -104,6 +102,63 @@ inline index_alpha_t timeSegment(scalar_t enquiryTime, const std::vector<scalar_
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+inline index_alpha_t timeSegment(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray) {
+  // corner cases (no time set OR single time element)
+  if (timeArray.size() <= 1) {
+    return {0, scalar_t(1.0)};
+  }
+
+  return timeSegmentInInterval(lookup::findIntervalInTimeArray(timeArray, enquiryTime), enquiryTime, timeArray);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+inline index_alpha_t TimeSegmentCursor::timeSegment(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray) {
+  // corner cases (no time set OR single time element)
+  if (timeArray.size() <= 1) {
+    return {0, scalar_t(1.0)};
+  }
+
+  // Walk a few steps from the last lookup, which finds the next interval of a monotone sequence of lookups.
+  constexpr size_t maxNumSteps = 4;
+  const size_t size = timeArray.size();
+  size_t lowerBound = std::min(lowerBound_, size);
+  size_t numSteps = 0;
+  while (lowerBound < size && timeArray[lowerBound] < enquiryTime && numSteps++ < maxNumSteps) {
+    ++lowerBound;
+  }
+  while (lowerBound > 0 && timeArray[lowerBound - 1] >= enquiryTime && numSteps++ < maxNumSteps) {
+    --lowerBound;
+  }
+
+  // Binary search in the remaining part of the array if the walk did not reach the lower bound
+  if (lowerBound < size && timeArray[lowerBound] < enquiryTime) {
+    lowerBound = std::lower_bound(timeArray.begin() + lowerBound + 1, timeArray.end(), enquiryTime) - timeArray.begin();
+  } else if (lowerBound > 0 && timeArray[lowerBound - 1] >= enquiryTime) {
+    lowerBound = std::lower_bound(timeArray.begin(), timeArray.begin() + lowerBound - 1, enquiryTime) - timeArray.begin();
+  }
+
+  lowerBound_ = lowerBound;
+  return timeSegmentInInterval(static_cast<int>(lowerBound) - 1, enquiryTime, timeArray);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+inline std::vector<index_alpha_t> timeSegments(const std::vector<scalar_t>& enquiryTimes, const std::vector<scalar_t>& timeArray) {
+  TimeSegmentCursor cursor;
+  std::vector<index_alpha_t> indexAlphas;
+  indexAlphas.reserve(enquiryTimes.size());
+  for (const auto enquiryTime : enquiryTimes) {
+    indexAlphas.push_back(cursor.timeSegment(enquiryTime, timeArray));
+  }
+  return indexAlphas;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -120,6 +175,21 @@ Data interpolate(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray, c
   return interpolate(enquiryTime, timeArray, dataArray, stdAccessFun<Data, Alloc>);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+template <typename Data, class Alloc>
+std::vector<Data, Alloc> interpolate(const std::vector<scalar_t>& enquiryTimes, const std::vector<scalar_t>& timeArray,
+                                     const std::vector<Data, Alloc>& dataArray) {
+  TimeSegmentCursor cursor;
+  std::vector<Data, Alloc> result;
+  result.reserve(enquiryTimes.size());
+  for (const auto enquiryTime : enquiryTimes) {
+    result.push_back(interpolate(cursor.timeSegment(enquiryTime, timeArray), dataArray));
+  }
+  return result;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -153,5 +223,36 @@ auto interpolate(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray, c
   return interpolate(timeSegment(enquiryTime, timeArray), dataArray, accessFun);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+template <typename Matrix>
+Matrix interpolate(index_alpha_t indexAlpha, const ContiguousTrajectory<Matrix>& trajectory) {
+  assert(trajectory.size() > 0);
+  if (trajectory.size() > 1) {
+    // Normal interpolation case
+    const int index = indexAlpha.first;
+    const scalar_t alpha = indexAlpha.second;
+    const auto lhs = trajectory[index];
+    const auto rhs = trajectory[index + 1];
+    if (lhs.rows() == rhs.rows() && lhs.cols() == rhs.cols()) {
+      return alpha * lhs + (scalar_t(1.0) - alpha) * rhs;
+    } else {
+      return (alpha > 0.5) ? Matrix(lhs) : Matrix(rhs);
+    }
+  } else {  // trajectory.size() == 1
+    // Time vector has only 1 element -> Constant function
+    return trajectory[0];
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+template <typename Matrix>
+Matrix interpolate(scalar_t enquiryTime, const std::vector<scalar_t>& timeArray, const ContiguousTrajectory<Matrix>& trajectory) {
+  return interpolate(timeSegment(enquiryTime, timeArray), trajectory);
+}
+
 }  // namespace LinearInterpolation
 }  // namespace ocs2
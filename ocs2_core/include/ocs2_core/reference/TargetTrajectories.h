@@ -32,6 +32,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ostream>
 
 #include "ocs2_core/Types.h"
+#include "ocs2_core/misc/LinearInterpolation.h"
 
 namespace ocs2 {
 
@@ -52,6 +53,13 @@ struct TargetTrajectories {
   vector_t getDesiredState(scalar_t time) const;
   vector_t getDesiredInput(scalar_t time) const;
 
+  /**
+   * Same as the overloads above, but with a cursor which speeds up sequences of lookups at increasing times. The target trajectories
+   * are shared between threads, hence the caller owns the cursor.
+   */
+  vector_t getDesiredState(scalar_t time, LinearInterpolation::TimeSegmentCursor& cursor) const;
+  vector_t getDesiredInput(scalar_t time, LinearInterpolation::TimeSegmentCursor& cursor) const;
+
   scalar_array_t timeTrajectory;
   vector_array_t stateTrajectory;
   vector_array_t inputTrajectory;
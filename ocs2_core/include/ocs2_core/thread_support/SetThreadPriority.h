@@ -73,4 +73,39 @@ inline void setThisThreadPriority(int priority) {
   setThreadPriority(priority, pthread_self());
 }
 
+/**
+ * Pins the input thread to a CPU.
+ *
+ * @param cpu: The index of the CPU.
+ * @param thread: A reference to the tread.
+ */
+inline void setThreadAffinity(int cpu, pthread_t thread) {
+  cpu_set_t cpuSet;
+  CPU_ZERO(&cpuSet);
+  CPU_SET(cpu, &cpuSet);
+
+  if (pthread_setaffinity_np(thread, sizeof(cpu_set_t), &cpuSet) != 0) {
+    std::cerr << "WARNING: Failed to set the affinity of a thread to CPU " << cpu << "." << std::endl;
+  }
+}
+
+/**
+ * Pins the input thread to a CPU.
+ *
+ * @param cpu: The index of the CPU.
+ * @param thread: A reference to the tread.
+ */
+inline void setThreadAffinity(int cpu, std::thread& thread) {
+  setThreadAffinity(cpu, thread.native_handle());
+}
+
+/**
+ * Pins the thread this function is called from to a CPU.
+ *
+ * @param cpu: The index of the CPU.
+ */
+inline void setThisThreadAffinity(int cpu) {
+  setThreadAffinity(cpu, pthread_self());
+}
+
 }  // namespace ocs2
@@ -29,20 +29,47 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <algorithm>
+#include <atomic>
 #include <condition_variable>
+#include <cstdint>
+#include <exception>
 #include <future>
+#include <memory>
 #include <mutex>
 #include <queue>
 #include <thread>
+#include <type_traits>
 #include <vector>
 
 namespace ocs2 {
 
 /**
  * Thread pool class to execute tasks on multiple threads.
+ *
+ * The parallel loops (runParallel() and parallelFor()) are executed as fork-join jobs which do not allocate: the index range of a job is
+ * split into one contiguous range per participating thread (the workers and the calling thread). Each thread consumes its own range from
+ * the front and, once it is empty, steals half of the remaining range of another thread from the back. The ranges are lock-free and the
+ * idle workers are woken up once per job. Tasks launched by run() are executed from a shared queue.
  */
 class ThreadPool {
  public:
+  /** Configuration of the worker threads. */
+  struct Settings {
+    /**
+     * Time in microseconds for which an idle worker keeps polling for new work before it goes to sleep. Spinning avoids the wake-up
+     * latency between the parallel phases of a hot loop (e.g. the iterations of an MPC solver) at the cost of CPU time. Zero makes idle
+     * workers sleep immediately.
+     */
+    int spinDuration = 0;
+
+    /**
+     * The CPUs to which the workers are pinned: worker i runs on cpuAffinity[i % cpuAffinity.size()]. An empty list does not pin the
+     * workers. A set of cores which is isolated from the scheduler (isolcpus) avoids preemption of the workers, see getIsolatedCpus().
+     */
+    std::vector<int> cpuAffinity;
+  };
+
   /**
    * Constructor
    *
@@ -51,6 +78,15 @@ class ThreadPool {
    */
   explicit ThreadPool(size_t nThreads = 1, int priority = 0);
 
+  /**
+   * Constructor
+   *
+   * @param [in] nThreads: Number of threads to launch in the pool
+   * @param [in] priority: The worker thread priority
+   * @param [in] settings: The configuration of the worker threads.
+   */
+  ThreadPool(size_t nThreads, int priority, Settings settings);
+
   /**
    * Destructor
    */
@@ -69,16 +105,30 @@ class ThreadPool {
 
   /**
    * Helper function to run a task N times parallel with the help of the pool.
-   * - 1 task will run in the calling thread with ID = nThreads.
-   * - N-1 tasks will run on the threadpool with ID in [0, nThreads-1].
+   * - The calling thread participates with ID = nThreads.
+   * - The threadpool workers participate with ID in [0, nThreads-1].
    *
-   * @note This is a blocking operation, returns when all tasks are completed.
-   * @warning Calling runParallel(task, nThreads) does not guarantee that each task will be executed with a different workerIndex.
+   * @note This is a blocking operation, returns when all tasks are completed. The first exception thrown by a task is rethrown.
+   * @warning Calling runParallel(task, nThreads) does not guarantee that each task will be executed with a different workerIndex. Tasks
+   * which run concurrently always have different worker indices.
    *
    * @param [in] taskFunction: task function to run in the pool.
-   * @param [in] N: number of times to run taskFunction in parallel.
+   * @param [in] N: number of times to run taskFunction in parallel. At least one task is run.
    */
-  void runParallel(std::function<void(int)> taskFunction, int N);
+  template <typename Functor>
+  void runParallel(Functor&& taskFunction, int N);
+
+  /**
+   * Fork-join parallel loop: calls function(workerIndex, index) for each index in [0, N) on the workers and the calling thread.
+   * The worker indices are as for runParallel().
+   *
+   * @note This is a blocking operation, returns when all indices are processed. The first exception thrown by a task is rethrown.
+   *
+   * @param [in] N: The number of indices.
+   * @param [in] function: The loop body with signature void(int workerIndex, size_t index).
+   */
+  template <typename Function>
+  void parallelFor(size_t N, Function&& function);
 
   /** Get the number of threads. */
   size_t numThreads() const { return workerThreads_.size(); }
@@ -89,6 +139,31 @@ class ThreadPool {
   template <typename Functor>
   struct Task;
 
+  /** A fork-join job. It lives on the stack of the calling thread for the duration of the parallel loop. */
+  struct Job {
+    void (*invoke)(void* function, int workerIndex, size_t index);
+    void* function;
+    std::atomic_size_t remaining;
+    std::mutex exceptionMutex;
+    std::exception_ptr exception;
+  };
+
+  /** The remaining index range [begin, end) of a participating thread, packed into a single word to be updated atomically. */
+  struct alignas(64) IndexRange {
+    std::atomic<uint64_t> range{0};
+  };
+
+  /**
+   * Frees the index ranges. They are allocated with posix_memalign, since operator new does not honor the alignment of IndexRange before
+   * C++17 and two ranges sharing a cache line would bounce it between the threads.
+   */
+  struct IndexRangeDeleter {
+    void operator()(IndexRange* indexRanges) const;
+  };
+
+  /** Allocates the given number of cache line aligned index ranges. */
+  static std::unique_ptr<IndexRange[], IndexRangeDeleter> allocateIndexRanges(size_t numRanges);
+
   /**
    * Thread worker loop
    *
@@ -103,15 +178,54 @@ class ThreadPool {
    */
   void runTask(std::unique_ptr<TaskBase> taskPtr);
 
-  bool stop_{false};  //!< flag telling all threads to stop, protected by taskQueueLock_
+  /** Runs a fork-join job over the indices [0, N) and waits for its completion. */
+  void runJob(Job& job, size_t N);
+
+  /** Processes indices of the job until there is none left: first the own range of the thread, then the stolen ones. */
+  void executeJob(Job& job, int workerIndex);
 
+  /** Joins the current fork-join job, if any. */
+  void joinJob(int workerIndex);
+
+  /** Runs one queued task, if any. Returns true if a task was run. */
+  bool runQueuedTask(int workerIndex);
+
+  /** Makes the idle workers look for new work. */
+  void notifyWorkers();
+
+  /** Spins and then sleeps until the work epoch differs from the given one. */
+  void waitForWork(uint64_t epoch);
+
+  const Settings settings_;
+
+  std::atomic_bool stop_{false};  //!< flag telling all threads to stop
+
+  // Fork-join jobs
+  std::mutex jobMutex_;                  //!< serializes the jobs of different calling threads
+  std::atomic<Job*> job_{nullptr};       //!< the current job
+  std::atomic_int numActiveWorkers_{0};  //!< number of workers which may access the current job
+  std::unique_ptr<IndexRange[], IndexRangeDeleter> indexRanges_;
+
+  // Idle workers
+  std::atomic<uint64_t> epoch_{0};  //!< incremented whenever there is new work
+  std::atomic_int numSleepingWorkers_{0};
+  std::mutex sleepMutex_;
+  std::condition_variable sleepCondition_;
+
+  // Queued tasks
   std::queue<std::unique_ptr<TaskBase>> taskQueue_;  // protected by taskQueueLock_
-  std::condition_variable taskQueueCondition_;
+  std::atomic_size_t numQueuedTasks_{0};
   std::mutex taskQueueLock_;
 
   std::vector<std::thread> workerThreads_;
 };
 
+/**
+ * Returns the CPUs which are isolated from the general scheduler (kernel parameter isolcpus), as reported by
+ * /sys/devices/system/cpu/isolated. Returns an empty list if there are none or if the information is not available.
+ */
+std::vector<int> getIsolatedCpus();
+
 /**
  * Task callback interface class.
  */
@@ -154,4 +268,24 @@ std::future<typename std::result_of<Functor(int)>::type> ThreadPool::run(Functor
   return future;
 }
 
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+template <typename Functor>
+void ThreadPool::runParallel(Functor&& taskFunction, int N) {
+  parallelFor(static_cast<size_t>(std::max(N, 1)), [&](int workerIndex, size_t) { taskFunction(workerIndex); });
+}
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+template <typename Function>
+void ThreadPool::parallelFor(size_t N, Function&& function) {
+  using function_t = typename std::remove_reference<Function>::type;
+  Job job;
+  job.invoke = [](void* f, int workerIndex, size_t index) { (*static_cast<function_t*>(f))(workerIndex, index); };
+  job.function = const_cast<void*>(static_cast<const void*>(&function));
+  runJob(job, N);
+}
+
 }  // namespace ocs2
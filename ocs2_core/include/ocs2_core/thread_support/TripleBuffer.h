@@ -0,0 +1,97 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+
+#pragma once
+
+#include <array>
+#include <atomic>
+
+namespace ocs2 {
+
+/**
+ * Wait-free exchange of values between a single producer thread and a single consumer thread. The three slots are allocated once and
+ * reused, such that the producer and consumer only exchange slot indices:
+ *      - The producer writes to the slot returned by getWriteBuffer() and hands it over with publish().
+ *      - The consumer reads the active value with get() and takes the latest published value with updateFromBuffer().
+ *
+ * The producer never waits for the consumer and vice versa. Values that are published while the consumer does not update are
+ * overwritten by the next publish, the consumer always receives the latest one. Since the slots are reused, a type with
+ * capacity-preserving assignment (e.g. std::vector) does not allocate once its slots have grown to the size of the exchanged values.
+ *
+ * Only a single thread may call getWriteBuffer() and publish(), and only a single (possibly other) thread may call get(),
+ * updateFromBuffer() and discardBuffer().
+ *
+ * @tparam T : wrapped type
+ */
+template <typename T>
+class TripleBuffer {
+ public:
+  /** Constructor initializes all slots with the given value. */
+  explicit TripleBuffer(const T& value = T()) : slots_{value, value, value} {}
+
+  /** Read the currently active value. */
+  const T& get() const { return slots_[activeIndex_]; }
+
+  /** Read/write the currently active value. */
+  T& get() { return slots_[activeIndex_]; }
+
+  /** Access the slot that is handed over by the next call to publish(). It holds an old value whose memory can be reused. */
+  T& getWriteBuffer() { return slots_[writeIndex_]; }
+
+  /** Hands over the write buffer to the consumer, the producer gets a free slot in return. */
+  void publish() { writeIndex_ = buffer_.exchange(writeIndex_ | newValueFlag_, std::memory_order_acq_rel) & indexMask_; }
+
+  /**
+   * Replaces the active value with the latest published value.
+   * @return True: the active value was updated, False: nothing new was published.
+   */
+  bool updateFromBuffer() {
+    if ((buffer_.load(std::memory_order_relaxed) & newValueFlag_) == 0) {
+      return false;
+    }
+    // Only the producer modifies the buffer in the meantime, it always leaves a new value.
+    activeIndex_ = buffer_.exchange(activeIndex_, std::memory_order_acq_rel) & indexMask_;
+    return true;
+  }
+
+  /** Drops a published value that has not been taken by updateFromBuffer() yet. */
+  void discardBuffer() { buffer_.fetch_and(indexMask_, std::memory_order_relaxed); }
+
+ private:
+  static constexpr int indexMask_ = 0b011;
+  static constexpr int newValueFlag_ = 0b100;
+
+  std::array<T, 3> slots_;
+  int activeIndex_ = 0;        // Owned by the consumer
+  int writeIndex_ = 1;         // Owned by the producer
+  std::atomic_int buffer_{2};  // Index of the slot in between, with a flag if it holds a value that has not been consumed.
+};
+
+}  // namespace ocs2
@@ -29,21 +29,360 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/automatic_differentiation/CppAdInterface.h>
 
+#include <atomic>
+#include <cerrno>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <exception>
+#include <fstream>
+#include <iomanip>
+#include <limits>
+#include <mutex>
+#include <sstream>
+#include <thread>
+
+#include <spawn.h>
+#include <sys/wait.h>
+#include <unistd.h>
+
 #include <boost/filesystem.hpp>
 
+#include <ocs2_core/misc/Benchmark.h>
+
 namespace ocs2 {
 
+namespace {
+
+/** FNV-1a hash, accumulated over strings and integral values. */
+class Fnv1aHash {
+ public:
+  void add(const std::string& str) {
+    for (const char c : str) {
+      addByte(static_cast<unsigned char>(c));
+    }
+    // separator, such that the concatenation of different strings does not collide
+    addByte(0xFF);
+  }
+
+  void add(uint64_t value) {
+    for (size_t i = 0; i < sizeof(value); i++) {
+      addByte(static_cast<unsigned char>(value >> (8 * i)));
+    }
+  }
+
+  void add(scalar_t value) {
+    uint64_t bits;
+    std::memcpy(&bits, &value, sizeof(bits));
+    add(bits);
+  }
+
+  /** The hash as a hex string */
+  std::string toString() const {
+    std::ostringstream hashStream;
+    hashStream << std::hex << std::setw(16) << std::setfill('0') << hash_;
+    return hashStream.str();
+  }
+
+ private:
+  void addByte(unsigned char byte) {
+    hash_ ^= byte;
+    hash_ *= 1099511628211ULL;
+  }
+
+  uint64_t hash_ = 14695981039346656037ULL;
+};
+
+/**
+ * Hashes the operation sequence of a taped function. The tape is evaluated once with symbolic arguments, which records its
+ * operations in the order of the tape. Their types, arguments and constants, together with the dependent variables, identify the
+ * function.
+ */
+void hashOperationSequence(CppAdInterface::ad_fun_t& fun, Fnv1aHash& hash) {
+  using cg_t = CppAD::cg::CG<scalar_t>;
+  CppAD::cg::CodeHandler<scalar_t> handler;
+  std::vector<cg_t> x(fun.Domain());
+  handler.makeVariables(x);
+  const std::vector<cg_t> y = fun.Forward(0, x);
+
+  hash.add(static_cast<uint64_t>(x.size()));
+  for (const auto* node : handler.getManagedNodes()) {
+    hash.add(static_cast<uint64_t>(node->getOperationType()));
+    hash.add(static_cast<uint64_t>(node->getInfo().size()));
+    for (const size_t info : node->getInfo()) {
+      hash.add(static_cast<uint64_t>(info));
+    }
+    hash.add(static_cast<uint64_t>(node->getArguments().size()));
+    for (const auto& argument : node->getArguments()) {
+      if (argument.getOperation() != nullptr) {
+        hash.add(static_cast<uint64_t>(argument.getOperation()->getHandlerPosition()));
+      } else {
+        hash.add(std::numeric_limits<uint64_t>::max());
+        hash.add(*argument.getParameter());
+      }
+    }
+  }
+
+  hash.add(static_cast<uint64_t>(y.size()));
+  for (const auto& yi : y) {
+    if (yi.isParameter()) {
+      hash.add(std::numeric_limits<uint64_t>::max());
+      hash.add(yi.getValue());
+    } else {
+      hash.add(static_cast<uint64_t>(yi.getOperationNode()->getHandlerPosition()));
+    }
+  }
+
+  // drop the symbolic Taylor coefficients, they are not valid values for a later fun.optimize()
+  fun.capacity_order(0);
+}
+
+/**
+ * Runs a compiler process and waits for it to exit. The process is spawned without pipes, hence compilers which are started
+ * concurrently by other threads do not inherit any descriptor of it. Its output goes to the inherited stdout and stderr.
+ */
+void runCompiler(const std::string& executable, const std::vector<std::string>& args) {
+  std::vector<char*> argv;
+  argv.reserve(args.size() + 2);
+  std::string executableName = CppAD::cg::system::filenameFromPath(executable);
+  argv.push_back(&executableName[0]);
+  std::vector<std::string> argsCopy(args);
+  for (auto& arg : argsCopy) {
+    argv.push_back(&arg[0]);
+  }
+  argv.push_back(nullptr);
+
+  pid_t pid;
+  const int spawnError = posix_spawn(&pid, executable.c_str(), nullptr, nullptr, argv.data(), environ);
+  if (spawnError != 0) {
+    throw CppAD::cg::CGException("Failed to start '", executable, "': ", std::strerror(spawnError));
+  }
+
+  int status;
+  while (waitpid(pid, &status, 0) < 0) {
+    if (errno != EINTR) {
+      throw CppAD::cg::CGException("Waitpid failed for pid ", pid, ": ", std::strerror(errno));
+    }
+  }
+  if (WIFSIGNALED(status)) {
+    throw CppAD::cg::CGException("Executable '", executable, "' (pid ", pid, ") terminated by signal ", WTERMSIG(status));
+  } else if (WEXITSTATUS(status) != EXIT_SUCCESS) {
+    throw CppAD::cg::CGException("Executable '", executable, "' (pid ", pid, ") exited with code ", WEXITSTATUS(status));
+  }
+}
+
+/**
+ * Limits the number of compiler processes of all libraries which are compiled concurrently to the number of hardware threads.
+ */
+class CompilerSlots {
+ public:
+  /** Occupies a slot for its lifetime */
+  struct Lock {
+    Lock() { instance().acquire(); }
+    ~Lock() { instance().release(); }
+  };
+
+  static size_t size() { return std::max(1U, std::thread::hardware_concurrency()); }
+
+ private:
+  CompilerSlots() : numAvailable_(size()) {}
+
+  static CompilerSlots& instance() {
+    static CompilerSlots slots;
+    return slots;
+  }
+
+  void acquire() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    slotAvailable_.wait(lock, [this]() { return numAvailable_ > 0; });
+    --numAvailable_;
+  }
+
+  void release() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      ++numAvailable_;
+    }
+    slotAvailable_.notify_one();
+  }
+
+  std::mutex mutex_;
+  std::condition_variable slotAvailable_;
+  size_t numAvailable_;
+};
+
+/**
+ * GccCompiler which compiles the source files of a library concurrently, one compiler process per file. The sources are written
+ * to the temporary folder and compiled from there. Every compiler and linker process occupies one of the CompilerSlots.
+ */
+class ParallelGccCompiler : public CppAD::cg::GccCompiler<scalar_t> {
+ public:
+  using CppAD::cg::GccCompiler<scalar_t>::compileSources;
+
+  void compileSources(const std::map<std::string, std::string>& sources, bool posIndepCode, CppAD::cg::JobTimer* timer,
+                      const std::string& outputExtension, std::set<std::string>& outputFiles) override {
+    if (sources.empty()) {
+      return;
+    }
+    CppAD::cg::system::createFolder(this->_tmpFolder);
+    if (this->_saveToDiskFirst) {
+      CppAD::cg::system::createFolder(this->_sourcesFolder);
+    }
+
+    // {source file, object file}
+    std::vector<std::pair<std::string, std::string>> jobs;
+    jobs.reserve(sources.size());
+    for (const auto& source : sources) {
+      this->_sfiles.insert(source.first);
+      jobs.emplace_back(CppAD::cg::system::createPath(this->_tmpFolder, source.first),
+                        CppAD::cg::system::createPath(this->_tmpFolder, source.first + outputExtension));
+      outputFiles.insert(jobs.back().second);
+      writeFile(jobs.back().first, source.second);
+      if (this->_saveToDiskFirst) {
+        writeFile(CppAD::cg::system::createPath(this->_sourcesFolder, source.first), source.second);
+      }
+    }
+
+    std::atomic_size_t nextJob{0};
+    std::exception_ptr error;
+    std::mutex errorMutex;
+    auto worker = [&]() {
+      size_t i;
+      while ((i = nextJob++) < jobs.size()) {
+        try {
+          this->compileFile(jobs[i].first, jobs[i].second, posIndepCode);
+        } catch (...) {
+          std::lock_guard<std::mutex> lock(errorMutex);
+          if (error == nullptr) {
+            error = std::current_exception();
+          }
+        }
+      }
+    };
+
+    const size_t numThreads = std::min(jobs.size(), CompilerSlots::size());
+    std::vector<std::thread> threads;
+    threads.reserve(numThreads - 1);
+    for (size_t i = 1; i < numThreads; i++) {
+      threads.emplace_back(worker);
+    }
+    worker();
+    for (auto& thread : threads) {
+      thread.join();
+    }
+
+    for (const auto& job : jobs) {
+      std::remove(job.first.c_str());
+    }
+    if (error != nullptr) {
+      std::rethrow_exception(error);
+    }
+  }
+
+  void buildDynamic(const std::string& library, CppAD::cg::JobTimer* /* timer */) override {
+    std::string linkerFlags = "-Wl,-soname," + CppAD::cg::system::filenameFromPath(library);
+    for (const auto& flag : this->_linkFlags) {
+      linkerFlags += "," + flag;
+    }
+
+    std::vector<std::string> args(this->_compileLibFlags.begin(), this->_compileLibFlags.end());
+    args.push_back(linkerFlags);
+    args.push_back("-o");
+    args.push_back(library);
+    args.insert(args.end(), this->_ofiles.begin(), this->_ofiles.end());
+    run(args);
+  }
+
+ protected:
+  void compileFile(const std::string& path, const std::string& output, bool posIndepCode) override {
+    std::vector<std::string> args{"-x", "c"};  // C source files
+    args.insert(args.end(), this->_compileFlags.begin(), this->_compileFlags.end());
+    if (posIndepCode) {
+      args.push_back("-fPIC");  // position-independent code for dynamic linking
+    }
+    args.push_back("-c");
+    args.push_back(path);
+    args.push_back("-o");
+    args.push_back(output);
+    run(args);
+  }
+
+ private:
+  void run(const std::vector<std::string>& args) const {
+    CompilerSlots::Lock slot;
+    runCompiler(this->_path, args);
+  }
+
+  static void writeFile(const std::string& path, const std::string& content) {
+    std::ofstream file(path);
+    file << content;
+    if (!file) {
+      throw std::runtime_error("[CppAdInterface] Failed to write the source file " + path);
+    }
+  }
+};
+
+/**
+ * DynamicModelLibraryProcessor whose sources can be generated ahead of the compilation. The sources are cached by the generators,
+ * hence they are not generated again when the library is compiled.
+ */
+class SourceGeneratingLibraryProcessor : public CppAD::cg::DynamicModelLibraryProcessor<scalar_t> {
+ public:
+  using CppAD::cg::DynamicModelLibraryProcessor<scalar_t>::DynamicModelLibraryProcessor;
+
+  void generateSources() {
+    for (const auto& model : this->modelLibraryHelper_->getModels()) {
+      this->getSources(*model.second);
+    }
+    this->getLibrarySources();
+  }
+};
+
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+struct CppAdInterface::SharedLibrary {
+  explicit SharedLibrary(std::unique_ptr<CppAD::cg::DynamicLib<scalar_t>> lib) : dynamicLib(std::move(lib)) {}
+
+  const std::unique_ptr<CppAD::cg::DynamicLib<scalar_t>> dynamicLib;
+  // The library keeps a registry of its models, hence creating and deleting models has to be serialized.
+  std::mutex mutex;
+};
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+struct CppAdInterface::ModelGeneration {
+  benchmark::RepeatedTimer timer;
+  ad_fun_t fun;
+  std::string tapeHash;
+  std::unique_ptr<CppAD::cg::ModelCSourceGen<scalar_t>> sourceGen;
+  std::unique_ptr<CppAD::cg::ModelLibraryCSourceGen<scalar_t>> libraryCSourceGen;
+  std::unique_ptr<SourceGeneratingLibraryProcessor> libraryProcessor;
+};
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::ModelDeleter::operator()(CppAD::cg::GenericModel<scalar_t>* model) const {
+  std::lock_guard<std::mutex> lock(libraryPtr->mutex);
+  delete model;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 CppAdInterface::CppAdInterface(ad_parameterized_function_t adFunction, size_t variableDim, size_t parameterDim, std::string modelName,
                                std::string folderName, std::vector<std::string> compileFlags)
     : adFunction_(std::move(adFunction)),
+      compileFlags_(std::move(compileFlags)),
       variableDim_(variableDim),
       parameterDim_(parameterDim),
       modelName_(std::move(modelName)),
-      folderName_(std::move(folderName)),
-      compileFlags_(std::move(compileFlags)) {
+      folderName_(std::move(folderName)) {
   setFolderNames();
 }
 
@@ -60,16 +399,92 @@ CppAdInterface::CppAdInterface(ad_function_t adFunction, size_t variableDim, std
 /******************************************************************************************************/
 CppAdInterface::CppAdInterface(const CppAdInterface& rhs)
     : CppAdInterface(rhs.adFunction_, rhs.variableDim_, rhs.parameterDim_, rhs.modelName_, rhs.folderName_, rhs.compileFlags_) {
-  if (isLibraryAvailable()) {
+  if (rhs.libraryPtr_ != nullptr) {
+    setModel(rhs.libraryPtr_);
+    rangeDim_ = rhs.rangeDim_;
+    jacobianSparsity_ = rhs.jacobianSparsity_;
+    hessianSparsity_ = rhs.hessianSparsity_;
+  } else if (isLibraryAvailable()) {
     loadModels(false);
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::setModel(std::shared_ptr<SharedLibrary> libraryPtr) {
+  std::unique_ptr<CppAD::cg::GenericModel<scalar_t>> model;
+  {
+    std::lock_guard<std::mutex> lock(libraryPtr->mutex);
+    model = libraryPtr->dynamicLib->model(modelName_);
+  }
+  model_ = std::unique_ptr<CppAD::cg::GenericModel<scalar_t>, ModelDeleter>(model.release(), ModelDeleter{libraryPtr});
+  libraryPtr_ = std::move(libraryPtr);
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 void CppAdInterface::createModels(ApproximationOrder approximationOrder, bool verbose) {
-  createFolderStructure();
+  createOrLoadModels({this}, approximationOrder, false, verbose);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::createModels(const std::vector<CppAdInterface*>& interfaces, ApproximationOrder approximationOrder, bool verbose) {
+  createOrLoadModels(interfaces, approximationOrder, false, verbose);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::createOrLoadModels(const std::vector<CppAdInterface*>& interfaces, ApproximationOrder approximationOrder,
+                                        bool reuseLibrary, bool verbose) {
+  // CppAD is not set up for parallel taping, hence the functions are taped and their sources are generated sequentially
+  std::vector<std::pair<CppAdInterface*, std::unique_ptr<ModelGeneration>>> generations;
+  for (auto* adInterface : interfaces) {
+    auto generation = adInterface->tapeModels(approximationOrder, reuseLibrary, verbose);
+    if (generation != nullptr) {
+      generations.emplace_back(adInterface, std::move(generation));
+    }
+  }
+
+  // The libraries are compiled concurrently, the compiler processes of all libraries share the CompilerSlots
+  std::vector<std::exception_ptr> errors(generations.size());
+  auto compile = [&](size_t i) {
+    try {
+      generations[i].first->compileModels(*generations[i].second, verbose);
+    } catch (...) {
+      errors[i] = std::current_exception();
+    }
+  };
+  std::vector<std::thread> threads;
+  threads.reserve(generations.size());
+  for (size_t i = 1; i < generations.size(); i++) {
+    threads.emplace_back(compile, i);
+  }
+  if (!generations.empty()) {
+    compile(0);
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (const auto& error : errors) {
+    if (error != nullptr) {
+      std::rethrow_exception(error);
+    }
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::unique_ptr<CppAdInterface::ModelGeneration> CppAdInterface::tapeModels(ApproximationOrder approximationOrder, bool reuseLibrary,
+                                                                              bool verbose) {
+  std::unique_ptr<ModelGeneration> generation(new ModelGeneration);
+  generation->timer.startTimer();
 
   // set and declare independent variables and start tape recording
   ad_vector_t xp(variableDim_ + parameterDim_);
@@ -85,18 +500,53 @@ void CppAdInterface::createModels(ApproximationOrder approximationOrder, bool ve
   adFunction_(x, p, y);
   rangeDim_ = y.rows();
   // create f: xp -> y and stop tape recording
-  ad_fun_t fun(xp, y);
+  auto& fun = generation->fun;
+  fun.Dependent(xp, y);
+
+  // The library is identified by the operation sequence and by everything else which enters its generation
+  Fnv1aHash hash;
+  hashOperationSequence(fun, hash);
+  hash.add(modelName_);
+  hash.add(static_cast<uint64_t>(variableDim_));
+  hash.add(static_cast<uint64_t>(parameterDim_));
+  hash.add(static_cast<uint64_t>(approximationOrder));
+  for (const auto& flag : compileFlags_) {
+    hash.add(flag);
+  }
+  generation->tapeHash = hash.toString();
+
+  // The library is reused only if it was compiled from an identical tape, the sources are not generated then
+  if (reuseLibrary && isLibraryAvailable() && readTapeHash() == generation->tapeHash) {
+    loadModels(verbose);
+    generation->timer.endTimer();
+    if (verbose) {
+      std::cerr << "[CppAdInterface] Reused the library of " << modelName_ << " with tape hash " << generation->tapeHash
+                << ". Warm start took " << generation->timer.getLastIntervalInMilliseconds() << " [ms]." << std::endl;
+    }
+    return nullptr;
+  }
+
   // Optimize the operation sequence
   fun.optimize();
 
   // generates source code
-  CppAD::cg::ModelCSourceGen<scalar_t> sourceGen(fun, modelName_);
-  setApproximationOrder(approximationOrder, sourceGen, fun);
+  generation->sourceGen.reset(new CppAD::cg::ModelCSourceGen<scalar_t>(fun, modelName_));
+  setApproximationOrder(approximationOrder, *generation->sourceGen, fun);
 
   // Compiler objects, compile to temporary shared library file to avoid interference between processes
-  CppAD::cg::ModelLibraryCSourceGen<scalar_t> libraryCSourceGen(sourceGen);
-  CppAD::cg::GccCompiler<scalar_t> gccCompiler;
-  CppAD::cg::DynamicModelLibraryProcessor<scalar_t> libraryProcessor(libraryCSourceGen, libraryName_ + tmpName_);
+  generation->libraryCSourceGen.reset(new CppAD::cg::ModelLibraryCSourceGen<scalar_t>(*generation->sourceGen));
+  generation->libraryProcessor.reset(new SourceGeneratingLibraryProcessor(*generation->libraryCSourceGen, libraryName_ + tmpName_));
+  generation->libraryProcessor->generateSources();
+
+  return generation;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::compileModels(ModelGeneration& generation, bool verbose) {
+  createFolderStructure();
+  ParallelGccCompiler gccCompiler;
   setCompilerOptions(gccCompiler);
 
   if (verbose) {
@@ -105,10 +555,9 @@ void CppAdInterface::createModels(ApproximationOrder approximationOrder, bool ve
   }
 
   // Compile and store the library
-  dynamicLib_ = libraryProcessor.createDynamicLibrary(gccCompiler);
-  model_ = dynamicLib_->model(modelName_);
+  setModel(std::make_shared<SharedLibrary>(generation.libraryProcessor->createDynamicLibrary(gccCompiler)));
 
-  setSparsityNonzeros();
+  setSparsityPatterns();
 
   // Rename generated library after loading
   if (verbose) {
@@ -117,6 +566,13 @@ void CppAdInterface::createModels(ApproximationOrder approximationOrder, bool ve
   }
   boost::filesystem::rename(libraryName_ + tmpName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION,
                             libraryName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION);
+  writeTapeHash(generation.tapeHash);
+
+  generation.timer.endTimer();
+  if (verbose) {
+    std::cerr << "[CppAdInterface] Compiled the library of " << modelName_ << " with tape hash " << generation.tapeHash
+              << ". Cold start took " << generation.timer.getLastIntervalInMilliseconds() << " [ms]." << std::endl;
+  }
 }
 
 /******************************************************************************************************/
@@ -127,22 +583,26 @@ void CppAdInterface::loadModels(bool verbose) {
     std::cerr << "[CppAdInterface] Loading Shared Library: " << libraryName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION
               << std::endl;
   }
-  dynamicLib_.reset(new CppAD::cg::LinuxDynamicLib<scalar_t>(libraryName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION));
-  model_ = dynamicLib_->model(modelName_);
+  setModel(std::make_shared<SharedLibrary>(std::unique_ptr<CppAD::cg::DynamicLib<scalar_t>>(
+      new CppAD::cg::LinuxDynamicLib<scalar_t>(libraryName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION))));
   rangeDim_ = model_->Range();
 
-  setSparsityNonzeros();
+  setSparsityPatterns();
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 void CppAdInterface::loadModelsIfAvailable(ApproximationOrder approximationOrder, bool verbose) {
-  if (isLibraryAvailable()) {
-    loadModels(verbose);
-  } else {
-    createModels(approximationOrder, verbose);
-  }
+  createOrLoadModels({this}, approximationOrder, true, verbose);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::loadModelsIfAvailable(const std::vector<CppAdInterface*>& interfaces, ApproximationOrder approximationOrder,
+                                           bool verbose) {
+  createOrLoadModels(interfaces, approximationOrder, true, verbose);
 }
 
 /******************************************************************************************************/
@@ -163,27 +623,45 @@ vector_t CppAdInterface::getFunctionValue(const vector_t& x, const vector_t& p)
 /******************************************************************************************************/
 /******************************************************************************************************/
 matrix_t CppAdInterface::getJacobian(const vector_t& x, const vector_t& p) const {
-  // Concatenate input
-  vector_t xp(variableDim_ + parameterDim_);
-  xp << x, p;
-  CppAD::cg::ArrayView<scalar_t> xpArrayView(xp.data(), xp.size());
+  matrix_t jacobian;
+  getJacobian(x, p, jacobian);
+  return jacobian;
+}
 
-  std::vector<scalar_t> sparseJacobian(nnzJacobian_);
-  CppAD::cg::ArrayView<scalar_t> sparseJacobianArrayView(sparseJacobian);
-  size_t const* rows;
-  size_t const* cols;
-  // Call this particular SparseJacobian. Other CppAd functions allocate internal vectors that are incompatible with multithreading.
-  model_->SparseJacobian(xpArrayView, sparseJacobianArrayView, &rows, &cols);
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::getJacobian(const vector_t& x, const vector_t& p, matrix_t& jacobian) const {
+  vector_t sparseJacobian;
+  getSparseJacobianValues(x, p, sparseJacobian);
 
   // Write sparse elements into Eigen type. Only jacobian w.r.t. variables was requested, so cols should not contain elements corresponding
   // to parameters.
-  matrix_t jacobian = matrix_t::Zero(model_->Range(), variableDim_);
-  for (size_t i = 0; i < nnzJacobian_; i++) {
+  jacobian.setZero(rangeDim_, variableDim_);
+  const auto& rows = jacobianSparsity_.rows;
+  const auto& cols = jacobianSparsity_.cols;
+  for (size_t i = 0; i < rows.size(); i++) {
     jacobian(rows[i], cols[i]) = sparseJacobian[i];
   }
 
   assert(jacobian.allFinite());
-  return jacobian;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::getSparseJacobianValues(const vector_t& x, const vector_t& p, vector_t& values) const {
+  // Concatenate input
+  vector_t xp(variableDim_ + parameterDim_);
+  xp << x, p;
+  CppAD::cg::ArrayView<const scalar_t> xpArrayView(xp.data(), xp.size());
+
+  values.resize(jacobianSparsity_.rows.size());
+  CppAD::cg::ArrayView<scalar_t> valuesArrayView(values.data(), values.size());
+  size_t const* rows;
+  size_t const* cols;
+  // Call this particular SparseJacobian. Other CppAd functions allocate internal vectors that are incompatible with multithreading.
+  model_->SparseJacobian(xpArrayView, valuesArrayView, &rows, &cols);
 }
 
 /******************************************************************************************************/
@@ -203,15 +681,15 @@ ScalarFunctionQuadraticApproximation CppAdInterface::getGaussNewtonApproximation
   gnApprox.f = 0.5 * valueVector.squaredNorm();
 
   // Jacobian
-  std::vector<scalar_t> sparseJacobian(nnzJacobian_);
-  CppAD::cg::ArrayView<scalar_t> sparseJacobianArrayView(sparseJacobian);
-  size_t const* rows;
-  size_t const* cols;
-  model_->SparseJacobian(xpArrayView, sparseJacobianArrayView, &rows, &cols);
+  vector_t sparseJacobian;
+  getSparseJacobianValues(x, p, sparseJacobian);
+  const auto& rows = jacobianSparsity_.rows;
+  const auto& cols = jacobianSparsity_.cols;
+  const size_t nnzJacobian = rows.size();
 
   // Sparse evaluation of J' * f
   gnApprox.dfdx.setZero(variableDim_);
-  for (size_t i = 0; i < nnzJacobian_; i++) {
+  for (size_t i = 0; i < nnzJacobian; i++) {
     gnApprox.dfdx(cols[i]) += sparseJacobian[i] * valueVector(rows[i]);
   }
 
@@ -222,19 +700,17 @@ ScalarFunctionQuadraticApproximation CppAdInterface::getGaussNewtonApproximation
    * For each row of J, we add the non-zero pairs (i, j) to H(i, j).
    */
   gnApprox.dfdxx.setZero(variableDim_, variableDim_);
-  for (size_t i = 0; i < nnzJacobian_; ++i) {
+  for (size_t i = 0; i < nnzJacobian; ++i) {
     const size_t row_i = rows[i];
     const size_t col_i = cols[i];
     const scalar_t v_i = sparseJacobian[i];
     // Diagonal element always exists:
     gnApprox.dfdxx(col_i, col_i) += v_i * v_i;
     // Process off-diagonals
-    size_t j = i + 1;
-    while (rows[j] == row_i) {
+    for (size_t j = i + 1; j < nnzJacobian && rows[j] == row_i; ++j) {
       const size_t col_j = cols[j];
       gnApprox.dfdxx(col_j, col_i) += v_i * sparseJacobian[j];
       gnApprox.dfdxx(col_i, col_j) = gnApprox.dfdxx(col_j, col_i);  // Maintain symmetry as we go.
-      ++j;
     }
   }
 
@@ -257,24 +733,23 @@ matrix_t CppAdInterface::getHessian(size_t outputIndex, const vector_t& x, const
 /******************************************************************************************************/
 /******************************************************************************************************/
 matrix_t CppAdInterface::getHessian(const vector_t& w, const vector_t& x, const vector_t& p) const {
-  // Concatenate input
-  vector_t xp(variableDim_ + parameterDim_);
-  xp << x, p;
-  CppAD::cg::ArrayView<const scalar_t> xpArrayView(xp.data(), xp.size());
-
-  std::vector<scalar_t> sparseHessian(nnzHessian_);
-  CppAD::cg::ArrayView<scalar_t> sparseHessianArrayView(sparseHessian);
-  size_t const* rows;
-  size_t const* cols;
-
-  CppAD::cg::ArrayView<const scalar_t> wArrayView(w.data(), w.size());
+  matrix_t hessian;
+  getHessian(w, x, p, hessian);
+  return hessian;
+}
 
-  // Call this particular SparseHessian. Other CppAd functions allocate internal vectors that are incompatible with multithreading.
-  model_->SparseHessian(xpArrayView, wArrayView, sparseHessianArrayView, &rows, &cols);
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::getHessian(const vector_t& w, const vector_t& x, const vector_t& p, matrix_t& hessian) const {
+  vector_t sparseHessian;
+  getSparseHessianValues(w, x, p, sparseHessian);
 
   // Fills upper triangular sparsity of hessian w.r.t variables.
-  matrix_t hessian = matrix_t::Zero(variableDim_, variableDim_);
-  for (size_t i = 0; i < nnzHessian_; i++) {
+  hessian.setZero(variableDim_, variableDim_);
+  const auto& rows = hessianSparsity_.rows;
+  const auto& cols = hessianSparsity_.cols;
+  for (size_t i = 0; i < rows.size(); i++) {
     hessian(rows[i], cols[i]) = sparseHessian[i];
   }
 
@@ -282,7 +757,24 @@ matrix_t CppAdInterface::getHessian(const vector_t& w, const vector_t& x, const
   hessian.template triangularView<Eigen::StrictlyLower>() = hessian.template triangularView<Eigen::StrictlyUpper>().transpose();
 
   assert(hessian.allFinite());
-  return hessian;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::getSparseHessianValues(const vector_t& w, const vector_t& x, const vector_t& p, vector_t& values) const {
+  // Concatenate input
+  vector_t xp(variableDim_ + parameterDim_);
+  xp << x, p;
+  CppAD::cg::ArrayView<const scalar_t> xpArrayView(xp.data(), xp.size());
+  CppAD::cg::ArrayView<const scalar_t> wArrayView(w.data(), w.size());
+
+  values.resize(hessianSparsity_.rows.size());
+  CppAD::cg::ArrayView<scalar_t> valuesArrayView(values.data(), values.size());
+  size_t const* rows;
+  size_t const* cols;
+  // Call this particular SparseHessian. Other CppAd functions allocate internal vectors that are incompatible with multithreading.
+  model_->SparseHessian(xpArrayView, wArrayView, valuesArrayView, &rows, &cols);
 }
 
 /******************************************************************************************************/
@@ -306,6 +798,26 @@ bool CppAdInterface::isLibraryAvailable() const {
   return boost::filesystem::exists(libraryName_ + CppAD::cg::system::SystemInfo<>::DYNAMIC_LIB_EXTENSION);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::string CppAdInterface::readTapeHash() const {
+  std::string tapeHash;
+  std::ifstream hashFile(libraryName_ + ".hash");
+  hashFile >> tapeHash;
+  return tapeHash;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void CppAdInterface::writeTapeHash(const std::string& tapeHash) const {
+  // Write to a temporary file first, such that other processes never read a partially written hash
+  const std::string tmpHashFile = libraryName_ + tmpName_ + ".hash";
+  std::ofstream(tmpHashFile) << tapeHash << std::endl;
+  boost::filesystem::rename(tmpHashFile, libraryName_ + ".hash");
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -366,12 +878,12 @@ void CppAdInterface::setApproximationOrder(ApproximationOrder approximationOrder
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-void CppAdInterface::setSparsityNonzeros() {
+void CppAdInterface::setSparsityPatterns() {
   if (model_->isJacobianSparsityAvailable()) {
-    nnzJacobian_ = cppad_sparsity::getNumberOfNonZeros(model_->JacobianSparsitySet());
+    model_->JacobianSparsity(jacobianSparsity_.rows, jacobianSparsity_.cols);
   }
   if (model_->isHessianSparsityAvailable()) {
-    nnzHessian_ = cppad_sparsity::getNumberOfNonZeros(model_->HessianSparsitySet());
+    model_->HessianSparsity(hessianSparsity_.rows, hessianSparsity_.cols);
   }
 }
 
@@ -0,0 +1,245 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <ocs2_core/constraint/FusedStateInputConstraintCppAd.h>
+
+#include <algorithm>
+
+namespace ocs2 {
+
+namespace {
+ConstraintOrder fusedConstraintOrder(const std::vector<std::unique_ptr<StateInputConstraintCppAd>>& terms) {
+  const bool hasQuadraticTerm = std::any_of(terms.begin(), terms.end(), [](const std::unique_ptr<StateInputConstraintCppAd>& term) {
+    return term->getOrder() == ConstraintOrder::Quadratic;
+  });
+  return hasQuadraticTerm ? ConstraintOrder::Quadratic : ConstraintOrder::Linear;
+}
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+FusedStateInputConstraintCppAd::FusedStateInputConstraintCppAd(std::vector<std::unique_ptr<StateInputConstraintCppAd>> terms,
+                                                               size_t stateDim, size_t inputDim, const std::string& modelName,
+                                                               const std::string& modelFolder, bool recompileLibraries, bool verbose)
+    : StateInputConstraint(fusedConstraintOrder(terms)), terms_(std::move(terms)) {
+  for (const auto& term : terms_) {
+    parameterDim_ += term->parameterDim_;
+  }
+
+  auto constraintAd = [=](const ad_vector_t& x, const ad_vector_t& p, ad_vector_t& y) {
+    assert(x.rows() == 1 + stateDim + inputDim);
+    const ad_scalar_t time = x(0);
+    const ad_vector_t state = x.segment(1, stateDim);
+    const ad_vector_t input = x.tail(inputDim);
+    y.resize(0);
+    size_t parameterIndex = 0;
+    for (const auto& term : terms_) {
+      const ad_vector_t termParameters = p.segment(parameterIndex, term->parameterDim_);
+      const ad_vector_t termConstraint = term->constraintFunction(time, state, input, termParameters);
+      ad_vector_t stackedConstraint(y.size() + termConstraint.size());
+      stackedConstraint << y, termConstraint;
+      y.swap(stackedConstraint);
+      parameterIndex += term->parameterDim_;
+    }
+  };
+  adInterfacePtr_.reset(new ocs2::CppAdInterface(constraintAd, 1 + stateDim + inputDim, parameterDim_, modelName, modelFolder));
+
+  ocs2::CppAdInterface::ApproximationOrder orderCppAd;
+  if (getOrder() == ConstraintOrder::Linear) {
+    orderCppAd = ocs2::CppAdInterface::ApproximationOrder::First;
+  } else {
+    orderCppAd = ocs2::CppAdInterface::ApproximationOrder::Second;
+  }
+
+  if (recompileLibraries) {
+    adInterfacePtr_->createModels(orderCppAd, verbose);
+  } else {
+    adInterfacePtr_->loadModelsIfAvailable(orderCppAd, verbose);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+FusedStateInputConstraintCppAd::FusedStateInputConstraintCppAd(const FusedStateInputConstraintCppAd& rhs)
+    : StateInputConstraint(rhs), parameterDim_(rhs.parameterDim_), adInterfacePtr_(new ocs2::CppAdInterface(*rhs.adInterfacePtr_)) {
+  terms_.reserve(rhs.terms_.size());
+  for (const auto& term : rhs.terms_) {
+    terms_.emplace_back(static_cast<StateInputConstraintCppAd*>(term->clone()));
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool FusedStateInputConstraintCppAd::isActive(scalar_t time) const {
+  return std::any_of(terms_.begin(), terms_.end(),
+                     [time](const std::unique_ptr<StateInputConstraintCppAd>& term) { return term->isActive(time); });
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t FusedStateInputConstraintCppAd::getNumConstraints(scalar_t time) const {
+  size_t numConstraints = 0;
+  for (const auto& term : terms_) {
+    if (term->isActive(time)) {
+      numConstraints += term->getNumConstraints(time);
+    }
+  }
+  return numConstraints;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_t FusedStateInputConstraintCppAd::getParameters(scalar_t time, const PreComputation& preComputation) const {
+  vector_t parameters(parameterDim_);
+  size_t parameterIndex = 0;
+  for (const auto& term : terms_) {
+    if (term->isActive(time)) {
+      parameters.segment(parameterIndex, term->parameterDim_) = term->getParameters(time, preComputation);
+    } else {
+      parameters.segment(parameterIndex, term->parameterDim_).setZero();
+    }
+    parameterIndex += term->parameterDim_;
+  }
+  return parameters;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::vector<std::pair<size_t, size_t>> FusedStateInputConstraintCppAd::getActiveRows(scalar_t time) const {
+  std::vector<std::pair<size_t, size_t>> activeRows;
+  activeRows.reserve(terms_.size());
+  size_t firstRow = 0;
+  for (const auto& term : terms_) {
+    // the size of a CppAD term is fixed by its tape, hence it is counted regardless of the activity
+    const size_t numRows = term->getNumConstraints(time);
+    if (term->isActive(time)) {
+      activeRows.emplace_back(firstRow, numRows);
+    }
+    firstRow += numRows;
+  }
+  return activeRows;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_t FusedStateInputConstraintCppAd::getValue(scalar_t time, const vector_t& state, const vector_t& input,
+                                                  const PreComputation& preComputation) const {
+  vector_t tapedTimeStateInput(1 + state.rows() + input.rows());
+  tapedTimeStateInput << time, state, input;
+  const vector_t stackedValue = adInterfacePtr_->getFunctionValue(tapedTimeStateInput, getParameters(time, preComputation));
+
+  vector_t value(getNumConstraints(time));
+  size_t i = 0;
+  for (const auto& rows : getActiveRows(time)) {
+    value.segment(i, rows.second) = stackedValue.segment(rows.first, rows.second);
+    i += rows.second;
+  }
+  return value;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+VectorFunctionLinearApproximation FusedStateInputConstraintCppAd::getLinearApproximation(scalar_t time, const vector_t& state,
+                                                                                         const vector_t& input,
+                                                                                         const PreComputation& preComputation) const {
+  const size_t stateDim = state.rows();
+  const size_t inputDim = input.rows();
+  const vector_t params = getParameters(time, preComputation);
+  vector_t tapedTimeStateInput(1 + stateDim + inputDim);
+  tapedTimeStateInput << time, state, input;
+
+  const vector_t stackedValue = adInterfacePtr_->getFunctionValue(tapedTimeStateInput, params);
+  const matrix_t J = adInterfacePtr_->getJacobian(tapedTimeStateInput, params);
+
+  VectorFunctionLinearApproximation constraint(getNumConstraints(time), stateDim, inputDim);
+  size_t i = 0;
+  for (const auto& rows : getActiveRows(time)) {
+    constraint.f.segment(i, rows.second) = stackedValue.segment(rows.first, rows.second);
+    constraint.dfdx.middleRows(i, rows.second) = J.block(rows.first, 1, rows.second, stateDim);
+    constraint.dfdu.middleRows(i, rows.second) = J.block(rows.first, 1 + stateDim, rows.second, inputDim);
+    i += rows.second;
+  }
+
+  return constraint;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+VectorFunctionQuadraticApproximation FusedStateInputConstraintCppAd::getQuadraticApproximation(scalar_t time, const vector_t& state,
+                                                                                               const vector_t& input,
+                                                                                               const PreComputation& preComputation) const {
+  if (getOrder() != ConstraintOrder::Quadratic) {
+    throw std::runtime_error("[FusedStateInputConstraintCppAd] Quadratic approximation not supported!");
+  }
+
+  const size_t stateDim = state.rows();
+  const size_t inputDim = input.rows();
+  const vector_t params = getParameters(time, preComputation);
+  vector_t tapedTimeStateInput(1 + stateDim + inputDim);
+  tapedTimeStateInput << time, state, input;
+
+  const vector_t stackedValue = adInterfacePtr_->getFunctionValue(tapedTimeStateInput, params);
+  const matrix_t J = adInterfacePtr_->getJacobian(tapedTimeStateInput, params);
+
+  const size_t numConstraints = getNumConstraints(time);
+  VectorFunctionQuadraticApproximation constraint;
+  constraint.f.resize(numConstraints);
+  constraint.dfdx.resize(numConstraints, stateDim);
+  constraint.dfdu.resize(numConstraints, inputDim);
+  constraint.dfdxx.reserve(numConstraints);
+  constraint.dfdux.reserve(numConstraints);
+  constraint.dfduu.reserve(numConstraints);
+
+  size_t i = 0;
+  for (const auto& rows : getActiveRows(time)) {
+    constraint.f.segment(i, rows.second) = stackedValue.segment(rows.first, rows.second);
+    constraint.dfdx.middleRows(i, rows.second) = J.block(rows.first, 1, rows.second, stateDim);
+    constraint.dfdu.middleRows(i, rows.second) = J.block(rows.first, 1 + stateDim, rows.second, inputDim);
+    for (size_t k = rows.first; k < rows.first + rows.second; k++) {
+      const matrix_t H = adInterfacePtr_->getHessian(k, tapedTimeStateInput, params);
+      constraint.dfdxx.emplace_back(H.block(1, 1, stateDim, stateDim));
+      constraint.dfdux.emplace_back(H.block(1 + stateDim, 1, inputDim, stateDim));
+      constraint.dfduu.emplace_back(H.bottomRightCorner(inputDim, inputDim));
+    }
+    i += rows.second;
+  }
+
+  return constraint;
+}
+
+}  // namespace ocs2
@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/constraint/StateInputConstraintCollection.h>
 
+#include <ocs2_core/constraint/FusedStateInputConstraintCppAd.h>
+
 namespace ocs2 {
 
 /******************************************************************************************************/
@@ -143,4 +145,17 @@ VectorFunctionQuadraticApproximation StateInputConstraintCollection::getQuadrati
   return quadraticApproximation;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void StateInputConstraintCollection::fuseCppAdTerms(size_t stateDim, size_t inputDim, const std::string& modelName,
+                                                    const std::string& modelFolder, bool recompileLibraries, bool verbose) {
+  auto cppAdTerms = this->extractAll<StateInputConstraintCppAd>();
+  if (!cppAdTerms.empty()) {
+    std::unique_ptr<FusedStateInputConstraintCppAd> fusedTerm(
+        new FusedStateInputConstraintCppAd(std::move(cppAdTerms), stateDim, inputDim, modelName, modelFolder, recompileLibraries, verbose));
+    this->add(modelName, std::move(fusedTerm));
+  }
+}
+
 }  // namespace ocs2
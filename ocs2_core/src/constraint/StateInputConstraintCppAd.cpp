@@ -36,6 +36,7 @@ namespace ocs2 {
 /******************************************************************************************************/
 void StateInputConstraintCppAd::initialize(size_t stateDim, size_t inputDim, size_t parameterDim, const std::string& modelName,
                                            const std::string& modelFolder, bool recompileLibraries, bool verbose) {
+  parameterDim_ = parameterDim;
   auto constraintAd = [=](const ad_vector_t& x, const ad_vector_t& p, ad_vector_t& y) {
     assert(x.rows() == 1 + stateDim + inputDim);
     const ad_scalar_t time = x(0);
@@ -59,11 +60,21 @@ void StateInputConstraintCppAd::initialize(size_t stateDim, size_t inputDim, siz
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void StateInputConstraintCppAd::initializeWithoutModel(size_t parameterDim) {
+  parameterDim_ = parameterDim;
+  adInterfacePtr_.reset();
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 StateInputConstraintCppAd::StateInputConstraintCppAd(const StateInputConstraintCppAd& rhs)
-    : StateInputConstraint(rhs), adInterfacePtr_(new ocs2::CppAdInterface(*rhs.adInterfacePtr_)) {}
+    : StateInputConstraint(rhs),
+      adInterfacePtr_(rhs.adInterfacePtr_ != nullptr ? new ocs2::CppAdInterface(*rhs.adInterfacePtr_) : nullptr),
+      parameterDim_(rhs.parameterDim_) {}
 
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -87,7 +87,7 @@ void FeedforwardController::setController(const scalar_array_t& controllerTime,
 /******************************************************************************************************/
 /******************************************************************************************************/
 vector_t FeedforwardController::computeInput(scalar_t t, const vector_t& x) {
-  return LinearInterpolation::interpolate(t, timeStamp_, uffArray_);
+  return LinearInterpolation::interpolate(timeSegmentCursor_.timeSegment(t, timeStamp_), uffArray_);
 }
 
 /******************************************************************************************************/
@@ -190,6 +190,20 @@ FeedforwardController* FeedforwardController::clone() const {
   return new FeedforwardController(*this);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool FeedforwardController::copyFrom(const ControllerBase& other) {
+  const auto* otherFeedforwardController = dynamic_cast<const FeedforwardController*>(&other);
+  if (otherFeedforwardController == nullptr) {
+    return false;
+  }
+  timeStamp_ = otherFeedforwardController->timeStamp_;
+  uffArray_ = otherFeedforwardController->uffArray_;
+  timeSegmentCursor_.reset();
+  return true;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
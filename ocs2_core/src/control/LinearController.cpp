@@ -37,9 +37,12 @@ namespace ocs2 {
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-LinearController::LinearController(const LinearController& other) : LinearController(other.timeStamp_, other.biasArray_, other.gainArray_) {
-  deltaBiasArray_ = other.deltaBiasArray_;
-}
+LinearController::LinearController(const LinearController& other)
+    : ControllerBase(other),
+      timeStamp_(other.timeStamp_),
+      biasArray_(other.biasArray_),
+      deltaBiasArray_(other.deltaBiasArray_),
+      gainArray_(other.gainArray_) {}
 
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -63,21 +66,37 @@ LinearController* LinearController::clone() const {
   return new LinearController(*this);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool LinearController::copyFrom(const ControllerBase& other) {
+  const auto* otherLinearController = dynamic_cast<const LinearController*>(&other);
+  if (otherLinearController == nullptr) {
+    return false;
+  }
+  timeStamp_ = otherLinearController->timeStamp_;
+  biasArray_ = otherLinearController->biasArray_;
+  deltaBiasArray_ = otherLinearController->deltaBiasArray_;
+  gainArray_ = otherLinearController->gainArray_;
+  timeSegmentCursor_.reset();
+  return true;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 void LinearController::setController(const scalar_array_t& controllerTime, const vector_array_t& controllerBias,
                                      const matrix_array_t& controllerGain) {
   timeStamp_ = controllerTime;
-  biasArray_ = controllerBias;
-  gainArray_ = controllerGain;
+  biasArray_.assign(controllerBias);
+  gainArray_.assign(controllerGain);
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 vector_t LinearController::computeInput(scalar_t t, const vector_t& x) {
-  const auto indexAlpha = LinearInterpolation::timeSegment(t, timeStamp_);
+  const auto indexAlpha = timeSegmentCursor_.timeSegment(t, timeStamp_);
 
   vector_t uff = LinearInterpolation::interpolate(indexAlpha, biasArray_);
   const matrix_t k = LinearInterpolation::interpolate(indexAlpha, gainArray_);
@@ -151,27 +170,20 @@ void LinearController::flattenSingle(scalar_t time, std::vector<float>& flatArra
 /******************************************************************************************************/
 LinearController LinearController::unFlatten(const size_array_t& stateDim, const size_array_t& inputDim, const scalar_array_t& timeArray,
                                              const std::vector<std::vector<float> const*>& flatArray2) {
-  vector_array_t bias;
-  matrix_array_t gain;
-
-  bias.reserve(flatArray2.size());
-  gain.reserve(flatArray2.size());
+  LinearController controller;
+  controller.timeStamp_ = timeArray;
 
   for (int k = 0; k < timeArray.size(); k++) {  // loop through time
     if (flatArray2[k]->size() != inputDim[k] + inputDim[k] * stateDim[k]) {
       throw std::runtime_error("LinearController::unFlatten received array of wrong length.");
     }
 
-    bias.emplace_back(vector_t(inputDim[k]));
-    gain.emplace_back(matrix_t(inputDim[k], stateDim[k]));
-
     const auto& arr = *flatArray2[k];
-    for (int i = 0; i < inputDim[k]; i++) {  // loop through input dim
-      bias.back()(i) = static_cast<scalar_t>(arr[i * (stateDim[k] + 1) + 0]);
-      gain.back().row(i) = Eigen::Map<const Eigen::VectorXf>(&(arr[i * (stateDim[k] + 1) + 1]), stateDim[k]).cast<scalar_t>();
-    }
+    const Eigen::Map<const Eigen::MatrixXf> flatNode(arr.data(), stateDim[k] + 1, inputDim[k]);
+    controller.biasArray_.push_back(flatNode.row(0).transpose().cast<scalar_t>());
+    controller.gainArray_.push_back(flatNode.bottomRows(stateDim[k]).transpose().cast<scalar_t>());
   }
-  return LinearController(timeArray, std::move(bias), std::move(gain));
+  return controller;
 }
 
 /******************************************************************************************************/
@@ -184,13 +196,12 @@ void LinearController::concatenate(const ControllerBase* nextController, int ind
     }
     int last = index + length;
     timeStamp_.insert(timeStamp_.end(), nextLinCtrl->timeStamp_.begin() + index, nextLinCtrl->timeStamp_.begin() + last);
-    biasArray_.insert(biasArray_.end(), nextLinCtrl->biasArray_.begin() + index, nextLinCtrl->biasArray_.begin() + last);
-    gainArray_.insert(gainArray_.end(), nextLinCtrl->gainArray_.begin() + index, nextLinCtrl->gainArray_.begin() + last);
+    biasArray_.append(nextLinCtrl->biasArray_, index, length);
+    gainArray_.append(nextLinCtrl->gainArray_, index, length);
 
     // deltaBiasArray can be of different, incompatible size.
     if (last < nextLinCtrl->deltaBiasArray_.size()) {
-      deltaBiasArray_.insert(deltaBiasArray_.end(), nextLinCtrl->deltaBiasArray_.begin() + index,
-                             nextLinCtrl->deltaBiasArray_.begin() + last);
+      deltaBiasArray_.append(nextLinCtrl->deltaBiasArray_, index, length);
     } else {
       deltaBiasArray_.clear();
     }
@@ -285,9 +296,9 @@ scalar_array_t LinearController::controllerEventTimes() const {
 /******************************************************************************************************/
 void swap(LinearController& a, LinearController& b) noexcept {
   std::swap(a.timeStamp_, b.timeStamp_);
-  std::swap(a.biasArray_, b.biasArray_);
-  std::swap(a.deltaBiasArray_, b.deltaBiasArray_);
-  std::swap(a.gainArray_, b.gainArray_);
+  a.biasArray_.swap(b.biasArray_);
+  a.deltaBiasArray_.swap(b.deltaBiasArray_);
+  a.gainArray_.swap(b.gainArray_);
 }
 
 /******************************************************************************************************/
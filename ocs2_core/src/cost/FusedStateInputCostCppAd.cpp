@@ -0,0 +1,148 @@
+/******************************************************************************
+Copyright (c) 2021, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <ocs2_core/cost/FusedStateInputCostCppAd.h>
+
+#include <algorithm>
+
+namespace ocs2 {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+FusedStateInputCostCppAd::FusedStateInputCostCppAd(std::vector<std::unique_ptr<StateInputCostCppAd>> terms, size_t stateDim,
+                                                   size_t inputDim, const std::string& modelName, const std::string& modelFolder,
+                                                   bool recompileLibraries, bool verbose)
+    : terms_(std::move(terms)) {
+  for (const auto& term : terms_) {
+    termsParameterDim_ += term->parameterDim_;
+  }
+
+  auto costAd = [=](const ad_vector_t& x, const ad_vector_t& p, ad_vector_t& y) {
+    assert(x.rows() == 1 + stateDim + inputDim);
+    const ad_scalar_t time = x(0);
+    const ad_vector_t state = x.segment(1, stateDim);
+    const ad_vector_t input = x.tail(inputDim);
+    const ad_vector_t activity = p.tail(terms_.size());
+    y = ad_vector_t(1);
+    y(0) = ad_scalar_t(0.0);
+    size_t parameterIndex = 0;
+    for (size_t i = 0; i < terms_.size(); i++) {
+      const auto& term = *terms_[i];
+      const ad_vector_t termParameters = p.segment(parameterIndex, term.parameterDim_);
+      y(0) += activity(i) * term.costFunction(time, state, input, termParameters);
+      parameterIndex += term.parameterDim_;
+    }
+  };
+  const size_t parameterDim = termsParameterDim_ + terms_.size();
+  adInterfacePtr_.reset(new ocs2::CppAdInterface(costAd, 1 + stateDim + inputDim, parameterDim, modelName, modelFolder));
+
+  if (recompileLibraries) {
+    adInterfacePtr_->createModels(ocs2::CppAdInterface::ApproximationOrder::Second, verbose);
+  } else {
+    adInterfacePtr_->loadModelsIfAvailable(ocs2::CppAdInterface::ApproximationOrder::Second, verbose);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+FusedStateInputCostCppAd::FusedStateInputCostCppAd(const FusedStateInputCostCppAd& rhs)
+    : StateInputCost(rhs), termsParameterDim_(rhs.termsParameterDim_), adInterfacePtr_(new ocs2::CppAdInterface(*rhs.adInterfacePtr_)) {
+  terms_.reserve(rhs.terms_.size());
+  for (const auto& term : rhs.terms_) {
+    terms_.emplace_back(static_cast<StateInputCostCppAd*>(term->clone()));
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool FusedStateInputCostCppAd::isActive(scalar_t time) const {
+  return std::any_of(terms_.begin(), terms_.end(),
+                     [time](const std::unique_ptr<StateInputCostCppAd>& term) { return term->isActive(time); });
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_t FusedStateInputCostCppAd::getParameters(scalar_t time, const TargetTrajectories& targetTrajectories,
+                                                 const PreComputation& preComputation) const {
+  vector_t parameters(termsParameterDim_ + terms_.size());
+  size_t parameterIndex = 0;
+  for (size_t i = 0; i < terms_.size(); i++) {
+    const auto& term = *terms_[i];
+    const bool isActive = term.isActive(time);
+    if (isActive) {
+      parameters.segment(parameterIndex, term.parameterDim_) = term.getParameters(time, targetTrajectories, preComputation);
+    } else {
+      parameters.segment(parameterIndex, term.parameterDim_).setZero();
+    }
+    parameters(termsParameterDim_ + i) = isActive ? 1.0 : 0.0;
+    parameterIndex += term.parameterDim_;
+  }
+  return parameters;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+scalar_t FusedStateInputCostCppAd::getValue(scalar_t time, const vector_t& state, const vector_t& input,
+                                            const TargetTrajectories& targetTrajectories, const PreComputation& preComputation) const {
+  vector_t tapedTimeStateInput(1 + state.rows() + input.rows());
+  tapedTimeStateInput << time, state, input;
+  return adInterfacePtr_->getFunctionValue(tapedTimeStateInput, getParameters(time, targetTrajectories, preComputation))(0);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ScalarFunctionQuadraticApproximation FusedStateInputCostCppAd::getQuadraticApproximation(scalar_t time, const vector_t& state,
+                                                                                         const vector_t& input,
+                                                                                         const TargetTrajectories& targetTrajectories,
+                                                                                         const PreComputation& preComputation) const {
+  auto cost = ScalarFunctionQuadraticApproximation::Zero(state.rows(), input.rows());
+  accumulateQuadraticApproximation(time, state, input, targetTrajectories, preComputation, cost);
+  return cost;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void FusedStateInputCostCppAd::accumulateQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                                const TargetTrajectories& targetTrajectories,
+                                                                const PreComputation& preComputation,
+                                                                ScalarFunctionQuadraticApproximation& approximation) const {
+  vector_t tapedTimeStateInput(1 + state.rows() + input.rows());
+  tapedTimeStateInput << time, state, input;
+  StateInputCostCppAd::accumulateTapedApproximation(*adInterfacePtr_, tapedTimeStateInput,
+                                                    getParameters(time, targetTrajectories, preComputation), approximation);
+}
+
+}  // namespace ocs2
@@ -71,7 +71,7 @@ ScalarFunctionQuadraticApproximation QuadraticStateCost::getQuadraticApproximati
 /******************************************************************************************************/
 /******************************************************************************************************/
 vector_t QuadraticStateCost::getStateDeviation(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories) const {
-  return state - targetTrajectories.getDesiredState(time);
+  return state - targetTrajectories.getDesiredState(time, targetTrajectoriesCursor_);
 }
 
 }  // namespace ocs2
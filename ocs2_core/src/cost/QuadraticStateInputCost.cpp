@@ -101,8 +101,8 @@ ScalarFunctionQuadraticApproximation QuadraticStateInputCost::getQuadraticApprox
 /******************************************************************************************************/
 std::pair<vector_t, vector_t> QuadraticStateInputCost::getStateInputDeviation(scalar_t time, const vector_t& state, const vector_t& input,
                                                                               const TargetTrajectories& targetTrajectories) const {
-  const vector_t stateDeviation = state - targetTrajectories.getDesiredState(time);
-  const vector_t inputDeviation = input - targetTrajectories.getDesiredInput(time);
+  const vector_t stateDeviation = state - targetTrajectories.getDesiredState(time, targetTrajectoriesCursor_);
+  const vector_t inputDeviation = input - targetTrajectories.getDesiredInput(time, targetTrajectoriesCursor_);
   return {stateDeviation, inputDeviation};
 }
 
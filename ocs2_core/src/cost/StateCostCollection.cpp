@@ -66,31 +66,22 @@ scalar_t StateCostCollection::getValue(scalar_t time, const vector_t& state, con
 ScalarFunctionQuadraticApproximation StateCostCollection::getQuadraticApproximation(scalar_t time, const vector_t& state,
                                                                                     const TargetTrajectories& targetTrajectories,
                                                                                     const PreComputation& preComp) const {
-  const auto firstActive =
-      std::find_if(terms_.begin(), terms_.end(), [time](const std::unique_ptr<StateCost>& costTerm) { return costTerm->isActive(time); });
-
-  // No active terms (or terms is empty).
-  if (firstActive == terms_.end()) {
-    return ScalarFunctionQuadraticApproximation::Zero(state.rows());
-  }
+  auto cost = ScalarFunctionQuadraticApproximation::Zero(state.rows());
+  StateCostCollection::accumulateQuadraticApproximation(time, state, targetTrajectories, preComp, cost);
+  return cost;
+}
 
-  // Initialize with first active term, accumulate potentially other active terms.
-  auto cost = (*firstActive)->getQuadraticApproximation(time, state, targetTrajectories, preComp);
-  std::for_each(std::next(firstActive), terms_.end(), [&](const std::unique_ptr<StateCost>& costTerm) {
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void StateCostCollection::accumulateQuadraticApproximation(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories,
+                                                           const PreComputation& preComp,
+                                                           ScalarFunctionQuadraticApproximation& approximation) const {
+  for (const auto& costTerm : this->terms_) {
     if (costTerm->isActive(time)) {
-      const auto costTermApproximation = costTerm->getQuadraticApproximation(time, state, targetTrajectories, preComp);
-      cost.f += costTermApproximation.f;
-      cost.dfdx += costTermApproximation.dfdx;
-      cost.dfdxx += costTermApproximation.dfdxx;
+      costTerm->accumulateQuadraticApproximation(time, state, targetTrajectories, preComp, approximation);
     }
-  });
-
-  // Make sure that input derivatives are empty
-  cost.dfdu = vector_t();
-  cost.dfduu = matrix_t();
-  cost.dfdux = matrix_t();
-
-  return cost;
+  }
 }
 
 }  // namespace ocs2
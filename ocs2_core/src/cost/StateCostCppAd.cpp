@@ -74,22 +74,48 @@ scalar_t StateCostCppAd::getValue(scalar_t time, const vector_t& state, const Ta
 ScalarFunctionQuadraticApproximation StateCostCppAd::getQuadraticApproximation(scalar_t time, const vector_t& state,
                                                                                const TargetTrajectories& targetTrajectories,
                                                                                const PreComputation& preComputation) const {
-  ScalarFunctionQuadraticApproximation cost;
+  auto cost = ScalarFunctionQuadraticApproximation::Zero(state.rows());
+  accumulateQuadraticApproximation(time, state, targetTrajectories, preComputation, cost);
+  return cost;
+}
 
-  const size_t stateDim = state.rows();
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void StateCostCppAd::accumulateQuadraticApproximation(scalar_t time, const vector_t& state, const TargetTrajectories& targetTrajectories,
+                                                      const PreComputation& preComputation,
+                                                      ScalarFunctionQuadraticApproximation& approximation) const {
+  // Taped variables are ordered as (time, state)
   const vector_t params = getParameters(time, targetTrajectories, preComputation);
-  vector_t tapedTimeState(1 + stateDim);
+  vector_t tapedTimeState(1 + state.rows());
   tapedTimeState << time, state;
 
-  cost.f = adInterfacePtr_->getFunctionValue(tapedTimeState, params)(0);
-
-  const matrix_t J = adInterfacePtr_->getJacobian(tapedTimeState, params);
-  cost.dfdx = J.rightCols(stateDim).transpose();
+  approximation.f += adInterfacePtr_->getFunctionValue(tapedTimeState, params)(0);
 
-  const matrix_t H = adInterfacePtr_->getHessian(0, tapedTimeState, params);
-  cost.dfdxx = H.bottomRightCorner(stateDim, stateDim);
+  // The cost is scalar, hence all Jacobian entries are in row 0
+  vector_t values;
+  adInterfacePtr_->getSparseJacobianValues(tapedTimeState, params, values);
+  const auto& jacobianCols = adInterfacePtr_->getJacobianSparsity().cols;
+  for (size_t i = 0; i < jacobianCols.size(); i++) {
+    if (jacobianCols[i] > 0) {
+      approximation.dfdx(jacobianCols[i] - 1) += values(i);
+    }
+  }
 
-  return cost;
+  // Only the upper triangular part of the Hessian is generated, i.e. row <= col
+  adInterfacePtr_->getSparseHessianValues(vector_t::Ones(1), tapedTimeState, params, values);
+  const auto& hessianRows = adInterfacePtr_->getHessianSparsity().rows;
+  const auto& hessianCols = adInterfacePtr_->getHessianSparsity().cols;
+  for (size_t i = 0; i < hessianRows.size(); i++) {
+    const size_t row = hessianRows[i];
+    const size_t col = hessianCols[i];
+    if (row > 0) {
+      approximation.dfdxx(row - 1, col - 1) += values(i);
+      if (row != col) {
+        approximation.dfdxx(col - 1, row - 1) += values(i);
+      }
+    }
+  }
 }
 
 }  // namespace ocs2
@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/cost/StateInputCostCollection.h>
 
+#include <ocs2_core/cost/FusedStateInputCostCppAd.h>
+
 namespace ocs2 {
 
 /******************************************************************************************************/
@@ -67,23 +69,35 @@ ScalarFunctionQuadraticApproximation StateInputCostCollection::getQuadraticAppro
                                                                                          const vector_t& input,
                                                                                          const TargetTrajectories& targetTrajectories,
                                                                                          const PreComputation& preComp) const {
-  const auto firstActive = std::find_if(terms_.begin(), terms_.end(),
-                                        [time](const std::unique_ptr<StateInputCost>& costTerm) { return costTerm->isActive(time); });
-
-  // No active terms (or terms is empty).
-  if (firstActive == terms_.end()) {
-    return ScalarFunctionQuadraticApproximation::Zero(state.rows(), input.rows());
-  }
+  auto cost = ScalarFunctionQuadraticApproximation::Zero(state.rows(), input.rows());
+  StateInputCostCollection::accumulateQuadraticApproximation(time, state, input, targetTrajectories, preComp, cost);
+  return cost;
+}
 
-  // Initialize with first active term, accumulate potentially other active terms.
-  auto cost = (*firstActive)->getQuadraticApproximation(time, state, input, targetTrajectories, preComp);
-  std::for_each(std::next(firstActive), terms_.end(), [&](const std::unique_ptr<StateInputCost>& costTerm) {
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void StateInputCostCollection::accumulateQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                                const TargetTrajectories& targetTrajectories, const PreComputation& preComp,
+                                                                ScalarFunctionQuadraticApproximation& approximation) const {
+  for (const auto& costTerm : this->terms_) {
     if (costTerm->isActive(time)) {
-      cost += costTerm->getQuadraticApproximation(time, state, input, targetTrajectories, preComp);
+      costTerm->accumulateQuadraticApproximation(time, state, input, targetTrajectories, preComp, approximation);
     }
-  });
+  }
+}
 
-  return cost;
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void StateInputCostCollection::fuseCppAdTerms(size_t stateDim, size_t inputDim, const std::string& modelName,
+                                              const std::string& modelFolder, bool recompileLibraries, bool verbose) {
+  auto cppAdTerms = this->extractAll<StateInputCostCppAd>();
+  if (!cppAdTerms.empty()) {
+    std::unique_ptr<FusedStateInputCostCppAd> fusedTerm(
+        new FusedStateInputCostCppAd(std::move(cppAdTerms), stateDim, inputDim, modelName, modelFolder, recompileLibraries, verbose));
+    this->add(modelName, std::move(fusedTerm));
+  }
 }
 
 }  // namespace ocs2
@@ -36,6 +36,7 @@ namespace ocs2 {
 /******************************************************************************************************/
 void StateInputCostCppAd::initialize(size_t stateDim, size_t inputDim, size_t parameterDim, const std::string& modelName,
                                      const std::string& modelFolder, bool recompileLibraries, bool verbose) {
+  parameterDim_ = parameterDim;
   auto costAd = [=](const ad_vector_t& x, const ad_vector_t& p, ad_vector_t& y) {
     assert(x.rows() == 1 + stateDim + inputDim);
     const ad_scalar_t time = x(0);
@@ -53,11 +54,21 @@ void StateInputCostCppAd::initialize(size_t stateDim, size_t inputDim, size_t pa
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void StateInputCostCppAd::initializeWithoutModel(size_t parameterDim) {
+  parameterDim_ = parameterDim;
+  adInterfacePtr_.reset();
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 StateInputCostCppAd::StateInputCostCppAd(const StateInputCostCppAd& rhs)
-    : StateInputCost(rhs), adInterfacePtr_(new ocs2::CppAdInterface(*rhs.adInterfacePtr_)) {}
+    : StateInputCost(rhs),
+      adInterfacePtr_(rhs.adInterfacePtr_ != nullptr ? new ocs2::CppAdInterface(*rhs.adInterfacePtr_) : nullptr),
+      parameterDim_(rhs.parameterDim_) {}
 
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -76,26 +87,71 @@ ScalarFunctionQuadraticApproximation StateInputCostCppAd::getQuadraticApproximat
                                                                                     const vector_t& input,
                                                                                     const TargetTrajectories& targetTrajectories,
                                                                                     const PreComputation& preComputation) const {
-  ScalarFunctionQuadraticApproximation cost;
+  auto cost = ScalarFunctionQuadraticApproximation::Zero(state.rows(), input.rows());
+  accumulateQuadraticApproximation(time, state, input, targetTrajectories, preComputation, cost);
+  return cost;
+}
 
-  const size_t stateDim = state.rows();
-  const size_t inputDim = input.rows();
-  const vector_t params = getParameters(time, targetTrajectories, preComputation);
-  vector_t tapedTimeStateInput(1 + stateDim + inputDim);
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void StateInputCostCppAd::accumulateQuadraticApproximation(scalar_t time, const vector_t& state, const vector_t& input,
+                                                           const TargetTrajectories& targetTrajectories,
+                                                           const PreComputation& preComputation,
+                                                           ScalarFunctionQuadraticApproximation& approximation) const {
+  vector_t tapedTimeStateInput(1 + state.rows() + input.rows());
   tapedTimeStateInput << time, state, input;
+  accumulateTapedApproximation(*adInterfacePtr_, tapedTimeStateInput, getParameters(time, targetTrajectories, preComputation),
+                               approximation);
+}
 
-  cost.f = adInterfacePtr_->getFunctionValue(tapedTimeStateInput, params)(0);
-
-  const matrix_t J = adInterfacePtr_->getJacobian(tapedTimeStateInput, params);
-  cost.dfdx = J.middleCols(1, stateDim).transpose();
-  cost.dfdu = J.rightCols(inputDim).transpose();
-
-  const matrix_t H = adInterfacePtr_->getHessian(0, tapedTimeStateInput, params);
-  cost.dfdxx = H.block(1, 1, stateDim, stateDim);
-  cost.dfdux = H.block(1 + stateDim, 1, inputDim, stateDim);
-  cost.dfduu = H.bottomRightCorner(inputDim, inputDim);
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void StateInputCostCppAd::accumulateTapedApproximation(const CppAdInterface& adInterface, const vector_t& tapedTimeStateInput,
+                                                       const vector_t& parameters, ScalarFunctionQuadraticApproximation& approximation) {
+  // Taped variables are ordered as (time, state, input)
+  const size_t stateDim = approximation.dfdx.rows();
+  const size_t inputOffset = 1 + stateDim;
+
+  approximation.f += adInterface.getFunctionValue(tapedTimeStateInput, parameters)(0);
+
+  // The cost is scalar, hence all Jacobian entries are in row 0
+  vector_t values;
+  adInterface.getSparseJacobianValues(tapedTimeStateInput, parameters, values);
+  const auto& jacobianCols = adInterface.getJacobianSparsity().cols;
+  for (size_t i = 0; i < jacobianCols.size(); i++) {
+    const size_t col = jacobianCols[i];
+    if (col >= inputOffset) {
+      approximation.dfdu(col - inputOffset) += values(i);
+    } else if (col > 0) {
+      approximation.dfdx(col - 1) += values(i);
+    }
+  }
 
-  return cost;
+  // Only the upper triangular part of the Hessian is generated, i.e. row <= col
+  adInterface.getSparseHessianValues(vector_t::Ones(1), tapedTimeStateInput, parameters, values);
+  const auto& hessianRows = adInterface.getHessianSparsity().rows;
+  const auto& hessianCols = adInterface.getHessianSparsity().cols;
+  for (size_t i = 0; i < hessianRows.size(); i++) {
+    const size_t row = hessianRows[i];
+    const size_t col = hessianCols[i];
+    if (row == 0) {
+      continue;
+    } else if (row >= inputOffset) {
+      approximation.dfduu(row - inputOffset, col - inputOffset) += values(i);
+      if (row != col) {
+        approximation.dfduu(col - inputOffset, row - inputOffset) += values(i);
+      }
+    } else if (col >= inputOffset) {
+      approximation.dfdux(col - inputOffset, row - 1) += values(i);
+    } else {
+      approximation.dfdxx(row - 1, col - 1) += values(i);
+      if (row != col) {
+        approximation.dfdxx(col - 1, row - 1) += values(i);
+      }
+    }
+  }
 }
 
 }  // namespace ocs2
@@ -82,14 +82,12 @@ void SystemDynamicsBaseAD::initialize(size_t stateDim, size_t inputDim, const st
   guardSurfacesADInterfacePtr_.reset(
       new CppAdInterface(guardSurfaces, 1 + stateDim, getNumGuardSurfacesParameters(), modelName + "_guard_surfaces", modelFolder));
 
+  const std::vector<CppAdInterface*> adInterfaces{flowMapADInterfacePtr_.get(), jumpMapADInterfacePtr_.get(),
+                                                  guardSurfacesADInterfacePtr_.get()};
   if (recompileLibraries) {
-    flowMapADInterfacePtr_->createModels(CppAdInterface::ApproximationOrder::First, verbose);
-    jumpMapADInterfacePtr_->createModels(CppAdInterface::ApproximationOrder::First, verbose);
-    guardSurfacesADInterfacePtr_->createModels(CppAdInterface::ApproximationOrder::First, verbose);
+    CppAdInterface::createModels(adInterfaces, CppAdInterface::ApproximationOrder::First, verbose);
   } else {
-    flowMapADInterfacePtr_->loadModelsIfAvailable(CppAdInterface::ApproximationOrder::First, verbose);
-    jumpMapADInterfacePtr_->loadModelsIfAvailable(CppAdInterface::ApproximationOrder::First, verbose);
-    guardSurfacesADInterfacePtr_->loadModelsIfAvailable(CppAdInterface::ApproximationOrder::First, verbose);
+    CppAdInterface::loadModelsIfAvailable(adInterfaces, CppAdInterface::ApproximationOrder::First, verbose);
   }
 }
 
@@ -70,4 +70,13 @@ ScalarFunctionQuadraticApproximation LoopshapingStateCost::getQuadraticApproxima
   return Phi;
 }
 
+void LoopshapingStateCost::accumulateQuadraticApproximation(scalar_t t, const vector_t& x, const TargetTrajectories& targetTrajectories,
+                                                            const PreComputation& preComp,
+                                                            ScalarFunctionQuadraticApproximation& approximation) const {
+  const auto Phi = getQuadraticApproximation(t, x, targetTrajectories, preComp);
+  approximation.f += Phi.f;
+  approximation.dfdx += Phi.dfdx;
+  approximation.dfdxx += Phi.dfdxx;
+}
+
 }  // namespace ocs2
@@ -0,0 +1,267 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_core/misc/Trace.h"
+
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <iomanip>
+#include <memory>
+#include <mutex>
+#include <stdexcept>
+#include <vector>
+
+namespace ocs2 {
+namespace trace {
+
+namespace {
+
+struct Span {
+  const char* name;
+  int64_t beginTime;
+  int64_t endTime;
+};
+
+/**
+ * Ring buffer of the spans of a single thread. Only the owning thread writes to it. It has one slot more than its capacity, which is the
+ * slot that may be written during an export.
+ */
+struct ThreadBuffer {
+  ThreadBuffer(size_t capacity, int id, std::string name) : spans(capacity + 1), threadId(id), threadName(std::move(name)) {}
+
+  void push(const Span& span) {
+    const auto index = head.load(std::memory_order_relaxed);
+    // Orders the overwrite of the slot after the head store of the previous push, pairs with the acquire fence in copySpans()
+    std::atomic_thread_fence(std::memory_order_release);
+    spans[index % spans.size()] = span;
+    head.store(index + 1, std::memory_order_release);
+  }
+
+  std::vector<Span> spans;
+  std::atomic<uint64_t> head{0};   //!< number of spans pushed so far
+  std::atomic<uint64_t> begin{0};  //!< spans before this index are cleared
+  const int threadId;
+  std::string threadName;  // protected by Registry::mutex
+};
+
+struct Registry {
+  std::atomic_bool enabled{false};
+  std::atomic_size_t bufferCapacity{16384};
+  const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+
+  std::mutex mutex;
+  std::vector<std::shared_ptr<ThreadBuffer>> buffers;  // protected by mutex
+};
+
+Registry& registry() {
+  static Registry instance;
+  return instance;
+}
+
+thread_local std::shared_ptr<ThreadBuffer> threadBuffer;
+thread_local std::string threadName;
+
+ThreadBuffer& getThreadBuffer() {
+  if (threadBuffer == nullptr) {
+    auto& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    const int threadId = static_cast<int>(reg.buffers.size());
+    threadBuffer = std::make_shared<ThreadBuffer>(std::max(reg.bufferCapacity.load(), size_t(1)), threadId,
+                                                  threadName.empty() ? "thread " + std::to_string(threadId) : threadName);
+    reg.buffers.push_back(threadBuffer);
+  }
+  return *threadBuffer;
+}
+
+int64_t now() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - registry().startTime).count();
+}
+
+/** Copies the recorded spans of a buffer, skipping those which are overwritten while copying. */
+void copySpans(const ThreadBuffer& buffer, std::vector<Span>& spans) {
+  const uint64_t numSlots = buffer.spans.size();
+  const uint64_t capacity = numSlots - 1;
+  const auto head = buffer.head.load(std::memory_order_acquire);
+  const auto first = std::max(buffer.begin.load(), head > capacity ? head - capacity : 0);
+  spans.clear();
+  for (auto i = first; i < head; i++) {
+    spans.push_back(buffer.spans[i % numSlots]);
+  }
+  // The spans up to index headAfterCopy may have been written in the meantime. The fence keeps the copies above before the load of the
+  // head, such that a slot which was overwritten while it was copied is seen by the head.
+  std::atomic_thread_fence(std::memory_order_acquire);
+  const auto headAfterCopy = buffer.head.load(std::memory_order_relaxed);
+  const auto numOverwritten = headAfterCopy + 1 > numSlots + first ? headAfterCopy + 1 - numSlots - first : 0;
+  spans.erase(spans.begin(), spans.begin() + std::min<size_t>(numOverwritten, spans.size()));
+}
+
+void writeEscaped(std::ostream& stream, const std::string& str) {
+  for (const char c : str) {
+    if (c == '"' || c == '\\') {
+      stream << '\\';
+    }
+    stream << c;
+  }
+}
+
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void start(size_t bufferCapacity) {
+  registry().bufferCapacity = bufferCapacity;
+  registry().enabled = true;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void stop() {
+  registry().enabled = false;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool isEnabled() {
+  return registry().enabled.load(std::memory_order_relaxed);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void clear() {
+  auto& reg = registry();
+  std::lock_guard<std::mutex> lock(reg.mutex);
+  for (auto& buffer : reg.buffers) {
+    buffer->begin = buffer->head.load();
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void setThreadName(const std::string& name) {
+  threadName = name;
+  if (threadBuffer != nullptr) {
+    std::lock_guard<std::mutex> lock(registry().mutex);
+    threadBuffer->threadName = name;
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void writeChromeTrace(std::ostream& stream) {
+  auto& reg = registry();
+  std::lock_guard<std::mutex> lock(reg.mutex);
+
+  // Timestamps are in microseconds with nanosecond resolution
+  auto toMicroseconds = [](int64_t time) { return static_cast<double>(time) * 1e-3; };
+  const auto flags = stream.flags();
+  const auto precision = stream.precision();
+  stream << std::fixed << std::setprecision(3);
+
+  stream << "{\"traceEvents\":[";
+  bool isFirst = true;
+  auto separator = [&]() -> std::ostream& {
+    if (!isFirst) {
+      stream << ",\n";
+    }
+    isFirst = false;
+    return stream;
+  };
+
+  std::vector<Span> spans;
+  for (const auto& buffer : reg.buffers) {
+    separator() << R"({"name":"thread_name","ph":"M","pid":0,"tid":)" << buffer->threadId << R"(,"args":{"name":")";
+    writeEscaped(stream, buffer->threadName);
+    stream << "\"}}";
+
+    copySpans(*buffer, spans);
+    for (const auto& span : spans) {
+      separator() << "{\"name\":\"";
+      writeEscaped(stream, span.name);
+      stream << R"(","ph":"X","pid":0,"tid":)" << buffer->threadId << ",\"ts\":" << toMicroseconds(span.beginTime)
+             << ",\"dur\":" << toMicroseconds(span.endTime - span.beginTime) << "}";
+    }
+  }
+  stream << "],\n\"displayTimeUnit\":\"ms\"}\n";
+
+  stream.flags(flags);
+  stream.precision(precision);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void exportChromeTrace(const std::string& filePath) {
+  std::ofstream file(filePath);
+  if (!file) {
+    throw std::runtime_error("[trace::exportChromeTrace] Could not open file: " + filePath);
+  }
+  writeChromeTrace(file);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::map<std::string, double> getTotalDurations() {
+  auto& reg = registry();
+  std::lock_guard<std::mutex> lock(reg.mutex);
+
+  std::map<std::string, double> totalDurations;
+  std::vector<Span> spans;
+  for (const auto& buffer : reg.buffers) {
+    copySpans(*buffer, spans);
+    for (const auto& span : spans) {
+      totalDurations[span.name] += static_cast<double>(span.endTime - span.beginTime) * 1e-6;
+    }
+  }
+  return totalDurations;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ScopedSpan::ScopedSpan(const char* name) : name_(isEnabled() ? name : nullptr), beginTime_(name_ != nullptr ? now() : 0) {}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+ScopedSpan::~ScopedSpan() {
+  if (name_ != nullptr) {
+    getThreadBuffer().push({name_, beginTime_, now()});
+  }
+}
+
+}  // namespace trace
+}  // namespace ocs2
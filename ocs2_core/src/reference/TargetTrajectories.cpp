@@ -94,6 +94,30 @@ vector_t TargetTrajectories::getDesiredInput(scalar_t time) const {
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/***************************************************************************************************** */
+vector_t TargetTrajectories::getDesiredState(scalar_t time, LinearInterpolation::TimeSegmentCursor& cursor) const {
+  if (this->empty()) {
+    throw std::runtime_error("[TargetTrajectories] TargetTrajectories is empty!");
+  } else {
+    return LinearInterpolation::interpolate(cursor.timeSegment(time, timeTrajectory), stateTrajectory);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/***************************************************************************************************** */
+vector_t TargetTrajectories::getDesiredInput(scalar_t time, LinearInterpolation::TimeSegmentCursor& cursor) const {
+  if (this->empty()) {
+    throw std::runtime_error("[TargetTrajectories] TargetTrajectories is empty!");
+  } else if (inputTrajectory.empty()) {
+    throw std::runtime_error("[TargetTrajectories] TargetTrajectories does not have inputTrajectory!");
+  } else {
+    return LinearInterpolation::interpolate(cursor.timeSegment(time, timeTrajectory), inputTrajectory);
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /***************************************************************************************************** */
@@ -27,19 +27,55 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
+#include <cstdlib>
+#include <fstream>
+#include <new>
+#include <sstream>
+
+#include <ocs2_core/misc/Trace.h>
 #include <ocs2_core/thread_support/SetThreadPriority.h>
 #include <ocs2_core/thread_support/ThreadPool.h>
 
 namespace ocs2 {
 
+namespace {
+
+/** The pool whose job is executed by the current thread and the thread's worker index, used to run nested parallel loops serially. */
+thread_local const ThreadPool* currentJobPool = nullptr;
+thread_local int currentJobWorkerIndex = 0;
+
+/** Packs the index range [begin, end) into a single word. */
+inline uint64_t packRange(uint64_t begin, uint64_t end) {
+  return (begin << 32U) | end;
+}
+
+inline uint64_t rangeBegin(uint64_t range) {
+  return range >> 32U;
+}
+
+inline uint64_t rangeEnd(uint64_t range) {
+  return range & 0xFFFFFFFFU;
+}
+
+}  // unnamed namespace
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+ThreadPool::ThreadPool(size_t nThreads, int priority) : ThreadPool(nThreads, priority, Settings()) {}
+
 /**************************************************************************************************/
 /**************************************************************************************************/
 /**************************************************************************************************/
-ThreadPool::ThreadPool(size_t nThreads, int priority) {
+ThreadPool::ThreadPool(size_t nThreads, int priority, Settings settings)
+    : settings_(std::move(settings)), indexRanges_(allocateIndexRanges(nThreads + 1)) {
   workerThreads_.reserve(nThreads);
   for (size_t i = 0; i < nThreads; i++) {
     workerThreads_.emplace_back(&ThreadPool::worker, this, i);
     setThreadPriority(priority, workerThreads_.back());
+    if (!settings_.cpuAffinity.empty()) {
+      setThreadAffinity(settings_.cpuAffinity[i % settings_.cpuAffinity.size()], workerThreads_.back());
+    }
   }
 }
 
@@ -47,11 +83,9 @@ ThreadPool::ThreadPool(size_t nThreads, int priority) {
 /**************************************************************************************************/
 /**************************************************************************************************/
 ThreadPool::~ThreadPool() {
-  {  // set exit flag, wake up threads and join
-    std::lock_guard<std::mutex> lock(taskQueueLock_);
-    stop_ = true;
-  }
-  taskQueueCondition_.notify_all();
+  // set exit flag, wake up threads and join
+  stop_ = true;
+  notifyWorkers();
   for (auto& thread : workerThreads_) {
     if (thread.joinable()) {
       thread.join();
@@ -59,31 +93,49 @@ ThreadPool::~ThreadPool() {
   }
 }
 
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+std::unique_ptr<ThreadPool::IndexRange[], ThreadPool::IndexRangeDeleter> ThreadPool::allocateIndexRanges(size_t numRanges) {
+  void* memory = nullptr;
+  if (posix_memalign(&memory, alignof(IndexRange), numRanges * sizeof(IndexRange)) != 0) {
+    throw std::bad_alloc();
+  }
+  auto* indexRanges = static_cast<IndexRange*>(memory);
+  for (size_t i = 0; i < numRanges; i++) {
+    new (indexRanges + i) IndexRange();
+  }
+  return std::unique_ptr<IndexRange[], IndexRangeDeleter>(indexRanges);
+}
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+void ThreadPool::IndexRangeDeleter::operator()(IndexRange* indexRanges) const {
+  static_assert(std::is_trivially_destructible<IndexRange>::value, "The index ranges are freed without calling their destructors.");
+  std::free(indexRanges);
+}
+
 /**************************************************************************************************/
 /**************************************************************************************************/
 /**************************************************************************************************/
 void ThreadPool::worker(int workerIndex) {
+  trace::setThreadName("ThreadPool worker " + std::to_string(workerIndex));
   while (true) {
-    std::unique_ptr<ThreadPool::TaskBase> taskPtr;
-    {
-      std::unique_lock<std::mutex> lock(taskQueueLock_);
-      taskQueueCondition_.wait(lock, [this] { return !taskQueue_.empty() || stop_; });
+    // Read the epoch before looking for work, such that work which is added in the meantime is not missed
+    const auto epoch = epoch_.load();
 
-      // exit condition
-      if (stop_) {
-        break;
-      }
-
-      // pop the first task
-      if (!taskQueue_.empty()) {
-        taskPtr = std::move(taskQueue_.front());
-        taskQueue_.pop();
-      }
+    // exit condition
+    if (stop_) {
+      break;
     }
 
-    if (taskPtr) {
-      taskPtr->operator()(workerIndex);
+    joinJob(workerIndex);
+    if (runQueuedTask(workerIndex)) {
+      continue;
     }
+
+    waitForWork(epoch);
   }
 }
 
@@ -94,32 +146,215 @@ void ThreadPool::runTask(std::unique_ptr<TaskBase> taskPtr) {
   {
     std::lock_guard<std::mutex> lock(taskQueueLock_);
     taskQueue_.push(std::move(taskPtr));
+    ++numQueuedTasks_;
   }
-  taskQueueCondition_.notify_one();
+  notifyWorkers();
 }
 
 /**************************************************************************************************/
 /**************************************************************************************************/
 /**************************************************************************************************/
-void ThreadPool::runParallel(std::function<void(int)> taskFunction, int N) {
-  // Launch tasks in helper threads
-  std::vector<std::future<void>> futures;
-  if (N > 1) {
-    const int numHelpers = N - 1;
-    futures.reserve(numHelpers);
-    for (int i = 0; i < numHelpers; ++i) {
-      futures.emplace_back(run(taskFunction));
+bool ThreadPool::runQueuedTask(int workerIndex) {
+  if (numQueuedTasks_ == 0) {
+    return false;
+  }
+
+  std::unique_ptr<TaskBase> taskPtr;
+  {
+    std::lock_guard<std::mutex> lock(taskQueueLock_);
+    if (taskQueue_.empty()) {
+      return false;
     }
+    taskPtr = std::move(taskQueue_.front());
+    taskQueue_.pop();
+    --numQueuedTasks_;
+  }
+
+  taskPtr->operator()(workerIndex);
+  return true;
+}
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+void ThreadPool::notifyWorkers() {
+  ++epoch_;
+  // A worker increments numSleepingWorkers_ before it checks the epoch for the last time, hence it either sees the new epoch or is woken up
+  if (numSleepingWorkers_ > 0) {
+    { std::lock_guard<std::mutex> lock(sleepMutex_); }
+    sleepCondition_.notify_all();
   }
+}
 
-  // Execute one instance in this thread.
-  const auto workerId = static_cast<int>(numThreads());  // threadpool workers use ID 0 -> nThreads - 1
-  taskFunction(workerId);
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+void ThreadPool::waitForWork(uint64_t epoch) {
+  if (settings_.spinDuration > 0) {
+    const auto spinEnd = std::chrono::steady_clock::now() + std::chrono::microseconds(settings_.spinDuration);
+    while (epoch_ == epoch) {
+      if (std::chrono::steady_clock::now() > spinEnd) {
+        break;
+      }
+      std::this_thread::yield();
+    }
+  }
 
-  // Wait for helpers to finish.
-  for (auto&& fut : futures) {
-    fut.get();
+  ++numSleepingWorkers_;
+  {
+    std::unique_lock<std::mutex> lock(sleepMutex_);
+    sleepCondition_.wait(lock, [&] { return epoch_ != epoch; });
+  }
+  --numSleepingWorkers_;
+}
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+void ThreadPool::runJob(Job& job, size_t N) {
+  const auto callerIndex = static_cast<int>(numThreads());  // threadpool workers use ID 0 -> nThreads - 1
+
+  // Without helpers, or when called from within a job of this pool, the loop runs in the calling thread
+  const bool isNested = (currentJobPool == this);
+  if (N == 1 || workerThreads_.empty() || isNested) {
+    const int workerIndex = isNested ? currentJobWorkerIndex : callerIndex;
+    for (size_t i = 0; i < N; i++) {
+      job.invoke(job.function, workerIndex, i);
+    }
+    return;
+  }
+
+  std::lock_guard<std::mutex> jobLock(jobMutex_);
+
+  // Split the indices into one range per thread and publish the job
+  const size_t numParticipants = numThreads() + 1;
+  for (size_t p = 0; p < numParticipants; p++) {
+    indexRanges_[p].range = packRange(p * N / numParticipants, (p + 1) * N / numParticipants);
+  }
+  job.remaining = N;
+  job_ = &job;
+  notifyWorkers();
+
+  executeJob(job, callerIndex);
+
+  // Wait for the indices that are processed by the workers
+  while (job.remaining != 0) {
+    std::this_thread::yield();
+  }
+
+  // Retract the job. Workers increment numActiveWorkers_ before they read job_, hence none of them accesses the job afterwards.
+  job_ = nullptr;
+  while (numActiveWorkers_ != 0) {
+    std::this_thread::yield();
+  }
+
+  if (job.exception) {
+    std::rethrow_exception(job.exception);
+  }
+}
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+void ThreadPool::joinJob(int workerIndex) {
+  if (job_ == nullptr) {
+    return;
+  }
+
+  ++numActiveWorkers_;
+  Job* job = job_;
+  if (job != nullptr) {
+    executeJob(*job, workerIndex);
+  }
+  --numActiveWorkers_;
+}
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+void ThreadPool::executeJob(Job& job, int workerIndex) {
+  OCS2_TRACE_SCOPE("ThreadPool::executeJob");
+  const size_t numParticipants = numThreads() + 1;
+  auto& ownRange = indexRanges_[workerIndex].range;
+
+  // Takes the first index of the own range
+  auto popFront = [&](size_t& index) {
+    auto range = ownRange.load();
+    while (rangeBegin(range) < rangeEnd(range)) {
+      if (ownRange.compare_exchange_weak(range, packRange(rangeBegin(range) + 1, rangeEnd(range)))) {
+        index = rangeBegin(range);
+        return true;
+      }
+    }
+    return false;
+  };
+
+  // Takes the upper half of the range of another thread. The first stolen index is returned, the others are moved to the own range.
+  auto steal = [&](size_t& index) {
+    for (size_t offset = 1; offset < numParticipants; offset++) {
+      auto& victimRange = indexRanges_[(workerIndex + offset) % numParticipants].range;
+      auto range = victimRange.load();
+      while (rangeBegin(range) < rangeEnd(range)) {
+        const auto begin = rangeBegin(range);
+        const auto end = rangeEnd(range);
+        const auto split = end - (end - begin + 1) / 2;
+        if (victimRange.compare_exchange_weak(range, packRange(begin, split))) {
+          // The own range is empty, hence no other thread modifies it concurrently
+          ownRange = packRange(split + 1, end);
+          index = split;
+          return true;
+        }
+      }
+    }
+    return false;
+  };
+
+  const auto* previousJobPool = currentJobPool;
+  const auto previousJobWorkerIndex = currentJobWorkerIndex;
+  currentJobPool = this;
+  currentJobWorkerIndex = workerIndex;
+  size_t index;
+  while (popFront(index) || steal(index)) {
+    try {
+      job.invoke(job.function, workerIndex, index);
+    } catch (...) {
+      std::lock_guard<std::mutex> lock(job.exceptionMutex);
+      if (!job.exception) {
+        job.exception = std::current_exception();
+      }
+    }
+    --job.remaining;
+  }
+  currentJobPool = previousJobPool;
+  currentJobWorkerIndex = previousJobWorkerIndex;
+}
+
+/**************************************************************************************************/
+/**************************************************************************************************/
+/**************************************************************************************************/
+std::vector<int> getIsolatedCpus() {
+  std::vector<int> cpus;
+  std::ifstream file("/sys/devices/system/cpu/isolated");
+  std::string list;
+  if (!file || !std::getline(file, list)) {
+    return cpus;
+  }
+
+  // The list has the format "1,3-5"
+  std::stringstream listStream(list);
+  std::string item;
+  while (std::getline(listStream, item, ',')) {
+    if (item.empty()) {
+      continue;
+    }
+    const auto dash = item.find('-');
+    const int first = std::stoi(item.substr(0, dash));
+    const int last = (dash == std::string::npos) ? first : std::stoi(item.substr(dash + 1));
+    for (int cpu = first; cpu <= last; cpu++) {
+      cpus.push_back(cpu);
+    }
   }
+  return cpus;
 }
 
 }  // namespace ocs2
@@ -30,6 +30,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <gtest/gtest.h>
 
 #include <ocs2_core/constraint/StateConstraintCppAd.h>
+#include <ocs2_core/constraint/StateInputConstraintCollection.h>
 #include <ocs2_core/constraint/StateInputConstraintCppAd.h>
 
 class TestStateConstraint : public ocs2::StateConstraintCppAd {
@@ -122,3 +123,100 @@ TEST(TestStateInputConstraintCppAd, getValue) {
   EXPECT_TRUE(quad.dfduu[0].isZero());
   EXPECT_TRUE(quad.dfduu[1].isApprox((ocs2::matrix_t(1, 1) << -2).finished()));
 }
+
+class TestSwitchedStateInputConstraint : public ocs2::StateInputConstraintCppAd {
+ public:
+  explicit TestSwitchedStateInputConstraint(ocs2::scalar_t activeUntil, bool createModel = true)
+      : ocs2::StateInputConstraintCppAd(ocs2::ConstraintOrder::Quadratic), activeUntil_(activeUntil) {
+    if (createModel) {
+      initialize(2, 1, 1, "TestSwitchedStateInputConstraint", "/tmp/ocs2", true, false);
+    } else {
+      initializeWithoutModel(1);
+    }
+  }
+  ~TestSwitchedStateInputConstraint() override = default;
+  TestSwitchedStateInputConstraint* clone() const override { return new TestSwitchedStateInputConstraint(*this); }
+
+  bool isActive(ocs2::scalar_t time) const override { return time < activeUntil_; }
+  size_t getNumConstraints(ocs2::scalar_t time) const override { return 1; }
+
+  ocs2::vector_t getParameters(ocs2::scalar_t time, const ocs2::PreComputation& preComputation) const override {
+    return (ocs2::vector_t(1) << 2.0).finished();
+  }
+
+  ocs2::ad_vector_t constraintFunction(ocs2::ad_scalar_t time, const ocs2::ad_vector_t& state, const ocs2::ad_vector_t& input,
+                                       const ocs2::ad_vector_t& parameters) const override {
+    ocs2::ad_vector_t constraint(1);
+    constraint(0) = parameters(0) * state(0) * input(0) - state(1);
+    return constraint;
+  }
+
+ private:
+  TestSwitchedStateInputConstraint(const TestSwitchedStateInputConstraint& other) = default;
+  ocs2::scalar_t activeUntil_;
+};
+
+TEST(TestFusedStateInputConstraintCppAd, fuseCollection) {
+  ocs2::StateInputConstraintCollection collection;
+  collection.add("switched", std::unique_ptr<ocs2::StateInputConstraint>(new TestSwitchedStateInputConstraint(0.5)));
+  collection.add("quadratic", std::unique_ptr<ocs2::StateInputConstraint>(new TestStateInputConstraint()));
+
+  std::unique_ptr<ocs2::StateInputConstraintCollection> fusedCollection(collection.clone());
+  fusedCollection->fuseCppAdTerms(2, 1, "TestFusedStateInputConstraint", "/tmp/ocs2", true, false);
+
+  size_t index;
+  EXPECT_TRUE(fusedCollection->getTermIndex("TestFusedStateInputConstraint", index));
+  EXPECT_FALSE(fusedCollection->getTermIndex("switched", index));
+  EXPECT_FALSE(fusedCollection->getTermIndex("quadratic", index));
+
+  const ocs2::vector_t x = (ocs2::vector_t(2) << 0.3, -0.7).finished();
+  const ocs2::vector_t u = (ocs2::vector_t(1) << 1.2).finished();
+
+  // the switched term is active at t = 0.0 and inactive at t = 1.0
+  for (const ocs2::scalar_t t : {0.0, 1.0}) {
+    ASSERT_EQ(fusedCollection->getNumConstraints(t), collection.getNumConstraints(t));
+    const auto expected = collection.getQuadraticApproximation(t, x, u, ocs2::PreComputation());
+    const auto fused = fusedCollection->getQuadraticApproximation(t, x, u, ocs2::PreComputation());
+    const auto fusedLinear = fusedCollection->getLinearApproximation(t, x, u, ocs2::PreComputation());
+    EXPECT_TRUE(fused.f.isApprox(expected.f));
+    EXPECT_TRUE(fused.dfdx.isApprox(expected.dfdx));
+    EXPECT_TRUE(fused.dfdu.isApprox(expected.dfdu));
+    EXPECT_TRUE(fusedLinear.f.isApprox(expected.f));
+    EXPECT_TRUE(fusedLinear.dfdx.isApprox(expected.dfdx));
+    EXPECT_TRUE(fusedLinear.dfdu.isApprox(expected.dfdu));
+    ASSERT_EQ(fused.dfdxx.size(), expected.dfdxx.size());
+    for (size_t i = 0; i < expected.dfdxx.size(); i++) {
+      EXPECT_TRUE(fused.dfdxx[i].isApprox(expected.dfdxx[i]) || (fused.dfdxx[i].isZero() && expected.dfdxx[i].isZero()));
+      EXPECT_TRUE(fused.dfdux[i].isApprox(expected.dfdux[i]) || (fused.dfdux[i].isZero() && expected.dfdux[i].isZero()));
+      EXPECT_TRUE(fused.dfduu[i].isApprox(expected.dfduu[i]) || (fused.dfduu[i].isZero() && expected.dfduu[i].isZero()));
+    }
+  }
+}
+
+TEST(TestFusedStateInputConstraintCppAd, fuseTermsWithoutModels) {
+  const TestSwitchedStateInputConstraint reference(0.5);
+
+  // The terms to fuse do not compile models of their own
+  ocs2::StateInputConstraintCollection uninitializedCollection;
+  uninitializedCollection.add("first", std::unique_ptr<ocs2::StateInputConstraint>(new TestSwitchedStateInputConstraint(0.5, false)));
+  uninitializedCollection.add("second", std::unique_ptr<ocs2::StateInputConstraint>(new TestSwitchedStateInputConstraint(2.0, false)));
+  uninitializedCollection.fuseCppAdTerms(2, 1, "TestFusedUninitializedStateInputConstraint", "/tmp/ocs2", true, false);
+  std::unique_ptr<ocs2::StateInputConstraintCollection> fusedCollection(uninitializedCollection.clone());
+
+  const ocs2::vector_t x = (ocs2::vector_t(2) << 0.3, -0.7).finished();
+  const ocs2::vector_t u = (ocs2::vector_t(1) << 1.2).finished();
+  const auto expected = reference.getLinearApproximation(0.0, x, u, ocs2::PreComputation());
+
+  // the first term is active until t = 0.5 and the second one until t = 2.0
+  for (const ocs2::scalar_t t : {0.0, 1.0}) {
+    const size_t numActive = (t < 0.5) ? 2 : 1;
+    ASSERT_EQ(fusedCollection->getNumConstraints(t), numActive);
+    const auto fused = fusedCollection->getLinearApproximation(t, x, u, ocs2::PreComputation());
+    ASSERT_EQ(fused.f.size(), numActive);
+    for (size_t i = 0; i < numActive; i++) {
+      EXPECT_NEAR(fused.f(i), expected.f(0), 1e-9);
+      EXPECT_TRUE(fused.dfdx.row(i).isApprox(expected.dfdx.row(0)));
+      EXPECT_TRUE(fused.dfdu.row(i).isApprox(expected.dfdu.row(0)));
+    }
+  }
+}
@@ -1,6 +1,7 @@
 #include <gtest/gtest.h>
 
 #include <ocs2_core/control/FeedforwardController.h>
+#include <ocs2_core/control/LinearController.h>
 
 using namespace ocs2;
 
@@ -22,3 +23,18 @@ TEST(testFeedforwardController, testSerialization) {
     EXPECT_TRUE(controller.uffArray_[k].isApprox(controllerOut.uffArray_[k], 1e-6));
   }
 }
+
+TEST(testFeedforwardController, testCopyFrom) {
+  scalar_array_t time = {0.0, 1.0};
+  vector_array_t uff = {vector_t::Random(2), vector_t::Random(2)};
+  FeedforwardController controller(time, uff);
+
+  FeedforwardController controllerOut;
+  ASSERT_TRUE(controllerOut.copyFrom(controller));
+  const vector_t x = vector_t::Random(3);
+  EXPECT_TRUE(controller.computeInput(0.5, x).isApprox(controllerOut.computeInput(0.5, x)));
+
+  // Controllers of another type are not copied
+  LinearController linearController(time, uff, {matrix_t::Zero(2, 3), matrix_t::Zero(2, 3)});
+  EXPECT_FALSE(controllerOut.copyFrom(linearController));
+}
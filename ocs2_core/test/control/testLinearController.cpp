@@ -24,3 +24,24 @@ TEST(testLinearController, testSerialization) {
     EXPECT_TRUE(controller.biasArray_[k].isApprox(controllerOut.biasArray_[k], 1e-6));
   }
 }
+
+TEST(testLinearController, testCopyFrom) {
+  scalar_array_t time = {0.0, 1.0};
+  vector_array_t bias = {vector_t::Random(2), vector_t::Random(2)};
+  matrix_array_t gain = {matrix_t::Random(2, 3), matrix_t::Random(2, 3)};
+  LinearController controller(time, bias, gain);
+
+  // A controller of the same size is overwritten in its own memory
+  LinearController controllerOut({1.0, 2.0}, {vector_t::Zero(2), vector_t::Zero(2)}, {matrix_t::Zero(2, 3), matrix_t::Zero(2, 3)});
+  const scalar_t* gainData = controllerOut.gainArray_[0].data();
+  ASSERT_TRUE(controllerOut.copyFrom(controller));
+  EXPECT_EQ(gainData, controllerOut.gainArray_[0].data());
+
+  for (int k = 0; k < time.size(); k++) {
+    EXPECT_EQ(controller.timeStamp_[k], controllerOut.timeStamp_[k]);
+    EXPECT_TRUE(controller.gainArray_[k].isApprox(controllerOut.gainArray_[k]));
+    EXPECT_TRUE(controller.biasArray_[k].isApprox(controllerOut.biasArray_[k]));
+  }
+  const vector_t x = vector_t::Random(3);
+  EXPECT_TRUE(controller.computeInput(0.5, x).isApprox(controllerOut.computeInput(0.5, x)));
+}
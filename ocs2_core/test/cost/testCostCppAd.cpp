@@ -29,7 +29,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <gtest/gtest.h>
 
+#include <ocs2_core/cost/QuadraticStateInputCost.h>
 #include <ocs2_core/cost/StateCostCppAd.h>
+#include <ocs2_core/cost/StateInputCostCollection.h>
 #include <ocs2_core/cost/StateInputCostCppAd.h>
 #include <ocs2_core/cost/StateInputGaussNewtonCostAd.h>
 
@@ -67,6 +69,29 @@ TEST(TestStateCostCppAd, getValue) {
   EXPECT_TRUE(approx.dfdxx.isApprox((ocs2::matrix_t(2, 2) << 1, 0, 0, 2).finished()));
 }
 
+TEST(TestStateCostCppAd, accumulateIntoStateInputApproximation) {
+  TestStateCost cost;
+  const ocs2::TargetTrajectories desiredTrajectory;
+
+  const ocs2::scalar_t t = 0.0;
+  const ocs2::vector_t x = (ocs2::vector_t(2) << 0.3, -0.7).finished();
+
+  auto approx = ocs2::ScalarFunctionQuadraticApproximation::Zero(2, 1);
+  approx.f = 1.0;
+  approx.dfdx.setOnes();
+  approx.dfdxx.setIdentity();
+  approx.dfdu.setOnes();
+  cost.accumulateQuadraticApproximation(t, x, desiredTrajectory, ocs2::PreComputation(), approx);
+
+  const auto stateApprox = cost.getQuadraticApproximation(t, x, desiredTrajectory, ocs2::PreComputation());
+  EXPECT_NEAR(approx.f, 1.0 + stateApprox.f, 1e-9);
+  EXPECT_TRUE(approx.dfdx.isApprox(ocs2::vector_t::Ones(2) + stateApprox.dfdx));
+  EXPECT_TRUE(approx.dfdxx.isApprox(ocs2::matrix_t::Identity(2, 2) + stateApprox.dfdxx));
+  EXPECT_TRUE(approx.dfdu.isApprox(ocs2::vector_t::Ones(1)));
+  EXPECT_TRUE(approx.dfduu.isZero());
+  EXPECT_TRUE(approx.dfdux.isZero());
+}
+
 class TestStateInputCost : public ocs2::StateInputCostCppAd {
  public:
   TestStateInputCost() { initialize(2, 1, 0, "TestStateInputCost", "/tmp/ocs2", true, false); }
@@ -159,3 +184,105 @@ TEST(TestGNStateInputCostCppAd, getValue) {
   ASSERT_DOUBLE_EQ(approx.dfdux(0, 1), 0.0);
   ASSERT_DOUBLE_EQ(approx.dfduu(0, 0), (t * t + 1.0));
 }
+
+class TestParameterizedStateInputCost : public ocs2::StateInputCostCppAd {
+ public:
+  explicit TestParameterizedStateInputCost(ocs2::scalar_t activeUntil, bool createModel = true) : activeUntil_(activeUntil) {
+    if (createModel) {
+      initialize(2, 1, 2, "TestParameterizedStateInputCost", "/tmp/ocs2", true, false);
+    } else {
+      initializeWithoutModel(2);
+    }
+  }
+  ~TestParameterizedStateInputCost() override = default;
+  TestParameterizedStateInputCost* clone() const override { return new TestParameterizedStateInputCost(*this); }
+
+  bool isActive(ocs2::scalar_t time) const override { return time < activeUntil_; }
+
+  ocs2::vector_t getParameters(ocs2::scalar_t time, const ocs2::TargetTrajectories& targetTrajectories,
+                               const ocs2::PreComputation& preComputation) const override {
+    return (ocs2::vector_t(2) << 0.5, -1.0).finished();
+  }
+
+  ocs2::ad_scalar_t costFunction(ocs2::ad_scalar_t time, const ocs2::ad_vector_t& state, const ocs2::ad_vector_t& input,
+                                 const ocs2::ad_vector_t& parameters) const override {
+    const ocs2::ad_vector_t stateError = state - parameters;
+    return ocs2::ad_scalar_t(0.5) * stateError.squaredNorm() * input(0) * input(0) + sin(state(0) * state(1));
+  }
+
+ private:
+  TestParameterizedStateInputCost(const TestParameterizedStateInputCost& other) = default;
+  ocs2::scalar_t activeUntil_;
+};
+
+TEST(TestFusedStateInputCostCppAd, fuseCollection) {
+  ocs2::StateInputCostCollection collection;
+  collection.add("quadratic", std::unique_ptr<ocs2::StateInputCost>(new ocs2::QuadraticStateInputCost(ocs2::matrix_t::Identity(2, 2),
+                                                                                                       ocs2::matrix_t::Identity(1, 1))));
+  collection.add("cppAd", std::unique_ptr<ocs2::StateInputCost>(new TestStateInputCost()));
+  collection.add("parameterized", std::unique_ptr<ocs2::StateInputCost>(new TestParameterizedStateInputCost(0.5)));
+
+  std::unique_ptr<ocs2::StateInputCostCollection> fusedCollection(collection.clone());
+  fusedCollection->fuseCppAdTerms(2, 1, "TestFusedStateInputCost", "/tmp/ocs2", true, false);
+
+  // only the non-AD term and the fused term remain
+  size_t index;
+  EXPECT_TRUE(fusedCollection->getTermIndex("quadratic", index));
+  EXPECT_TRUE(fusedCollection->getTermIndex("TestFusedStateInputCost", index));
+  EXPECT_FALSE(fusedCollection->getTermIndex("cppAd", index));
+  EXPECT_FALSE(fusedCollection->getTermIndex("parameterized", index));
+
+  const ocs2::TargetTrajectories targetTrajectories(ocs2::scalar_array_t{0.0}, ocs2::vector_array_t{ocs2::vector_t::Zero(2)},
+                                                    ocs2::vector_array_t{ocs2::vector_t::Zero(1)});
+  const ocs2::vector_t x = (ocs2::vector_t(2) << 0.3, -0.7).finished();
+  const ocs2::vector_t u = (ocs2::vector_t(1) << 1.2).finished();
+
+  // the parameterized term is active at t = 0.0 and inactive at t = 1.0
+  for (const ocs2::scalar_t t : {0.0, 1.0}) {
+    const auto expected = collection.getQuadraticApproximation(t, x, u, targetTrajectories, ocs2::PreComputation());
+    const auto fused = fusedCollection->getQuadraticApproximation(t, x, u, targetTrajectories, ocs2::PreComputation());
+    EXPECT_NEAR(fusedCollection->getValue(t, x, u, targetTrajectories, ocs2::PreComputation()), expected.f, 1e-9);
+    EXPECT_NEAR(fused.f, expected.f, 1e-9);
+    EXPECT_TRUE(fused.dfdx.isApprox(expected.dfdx));
+    EXPECT_TRUE(fused.dfdu.isApprox(expected.dfdu));
+    EXPECT_TRUE(fused.dfdxx.isApprox(expected.dfdxx));
+    EXPECT_TRUE(fused.dfdux.isApprox(expected.dfdux));
+    EXPECT_TRUE(fused.dfduu.isApprox(expected.dfduu));
+  }
+}
+
+TEST(TestFusedStateInputCostCppAd, fuseTermsWithoutModels) {
+  ocs2::StateInputCostCollection collection;
+  collection.add("parameterized", std::unique_ptr<ocs2::StateInputCost>(new TestParameterizedStateInputCost(0.5)));
+
+  // The terms to fuse do not compile models of their own
+  ocs2::StateInputCostCollection uninitializedCollection;
+  uninitializedCollection.add("parameterized", std::unique_ptr<ocs2::StateInputCost>(new TestParameterizedStateInputCost(0.5, false)));
+  uninitializedCollection.add("other", std::unique_ptr<ocs2::StateInputCost>(new TestParameterizedStateInputCost(2.0, false)));
+  uninitializedCollection.fuseCppAdTerms(2, 1, "TestFusedUninitializedStateInputCost", "/tmp/ocs2", true, false);
+  std::unique_ptr<ocs2::StateInputCostCollection> fusedCollection(uninitializedCollection.clone());
+
+  const ocs2::TargetTrajectories targetTrajectories;
+  const ocs2::vector_t x = (ocs2::vector_t(2) << 0.3, -0.7).finished();
+  const ocs2::vector_t u = (ocs2::vector_t(1) << 1.2).finished();
+
+  // the first term is active until t = 0.5 and the second one until t = 2.0
+  for (const ocs2::scalar_t t : {0.0, 1.0}) {
+    auto expected = collection.getQuadraticApproximation(0.0, x, u, targetTrajectories, ocs2::PreComputation());
+    if (t < 0.5) {
+      expected.f *= 2.0;
+      expected.dfdx *= 2.0;
+      expected.dfdu *= 2.0;
+      expected.dfdxx *= 2.0;
+      expected.dfdux *= 2.0;
+      expected.dfduu *= 2.0;
+    }
+    const auto fused = fusedCollection->getQuadraticApproximation(t, x, u, targetTrajectories, ocs2::PreComputation());
+    EXPECT_NEAR(fused.f, expected.f, 1e-9);
+    EXPECT_TRUE(fused.dfdx.isApprox(expected.dfdx));
+    EXPECT_TRUE(fused.dfdu.isApprox(expected.dfdu));
+    EXPECT_TRUE(fused.dfdxx.isApprox(expected.dfdxx));
+    EXPECT_TRUE(fused.dfdux.isApprox(expected.dfdux));
+    EXPECT_TRUE(fused.dfduu.isApprox(expected.dfduu));
+  }
+}
@@ -2,6 +2,11 @@
 
 #include <gtest/gtest.h>
 
+#include <memory>
+#include <thread>
+
+#include <boost/filesystem.hpp>
+
 #include "commonFixture.h"
 
 using namespace ocs2;
@@ -43,6 +48,45 @@ TEST_F(CppAdInterfaceParameterizedFixture, testModelGeneration) {
   ASSERT_TRUE(gnApproximation.dfdxx.isApprox(testJacobian(x, p).transpose() * testJacobian(x, p)));
 }
 
+TEST_F(CppAdInterfaceParameterizedFixture, sparseAndPreallocatedOutputs) {
+  const vector_t x = vector_t::Random(variableDim_);
+  const vector_t p = vector_t::Random(parameterDim_);
+  const vector_t w = vector_t::Random(rangeDim_);
+
+  ocs2::CppAdInterface adInterface(funImpl, variableDim_, parameterDim_, "testModelWithParametersSparse");
+  adInterface.createModels(ocs2::CppAdInterface::ApproximationOrder::Second, false);
+
+  // Preallocated outputs are overwritten
+  matrix_t jacobian = matrix_t::Constant(rangeDim_, variableDim_, 1e3);
+  adInterface.getJacobian(x, p, jacobian);
+  ASSERT_TRUE(jacobian.isApprox(testJacobian(x, p)));
+  matrix_t hessian = matrix_t::Constant(variableDim_, variableDim_, 1e3);
+  adInterface.getHessian(w, x, p, hessian);
+  ASSERT_TRUE(hessian.isApprox(adInterface.getHessian(w, x, p)));
+
+  // Sparse values scatter into the dense derivatives
+  vector_t values;
+  adInterface.getSparseJacobianValues(x, p, values);
+  const auto& jacobianSparsity = adInterface.getJacobianSparsity();
+  ASSERT_EQ(values.size(), jacobianSparsity.rows.size());
+  matrix_t sparseJacobian = matrix_t::Zero(rangeDim_, variableDim_);
+  for (size_t i = 0; i < jacobianSparsity.rows.size(); i++) {
+    sparseJacobian(jacobianSparsity.rows[i], jacobianSparsity.cols[i]) = values(i);
+  }
+  ASSERT_TRUE(sparseJacobian.isApprox(testJacobian(x, p)));
+
+  adInterface.getSparseHessianValues(w, x, p, values);
+  const auto& hessianSparsity = adInterface.getHessianSparsity();
+  ASSERT_EQ(values.size(), hessianSparsity.rows.size());
+  matrix_t sparseHessian = matrix_t::Zero(variableDim_, variableDim_);
+  for (size_t i = 0; i < hessianSparsity.rows.size(); i++) {
+    ASSERT_LE(hessianSparsity.rows[i], hessianSparsity.cols[i]);
+    sparseHessian(hessianSparsity.rows[i], hessianSparsity.cols[i]) = values(i);
+    sparseHessian(hessianSparsity.cols[i], hessianSparsity.rows[i]) = values(i);
+  }
+  ASSERT_TRUE(sparseHessian.isApprox(w(0) * testHessian(0, x, p) + w(1) * testHessian(1, x, p)));
+}
+
 TEST_F(CppAdInterfaceParameterizedFixture, loadIfAvailable) {
   ocs2::CppAdInterface adInterface(funImpl, variableDim_, parameterDim_, "testModelLoadIfAvailable");
 
@@ -60,3 +104,116 @@ TEST_F(CppAdInterfaceParameterizedFixture, loadIfAvailable) {
   ASSERT_TRUE(gnApproximation.dfdx.isApprox(testJacobian(x, p).transpose() * testFun(x, p)));
   ASSERT_TRUE(gnApproximation.dfdxx.isApprox(testJacobian(x, p).transpose() * testJacobian(x, p)));
 }
+
+TEST_F(CppAdInterfaceParameterizedFixture, loadIfAvailableReusesUnchangedLibrary) {
+  const std::string modelName = "testModelLibraryCache";
+  const std::string libraryPath = "/tmp/ocs2/" + modelName + "/cppad_generated/" + modelName + "_lib.so";
+  const vector_t x = vector_t::Random(variableDim_);
+  const vector_t p = vector_t::Random(parameterDim_);
+
+  ocs2::CppAdInterface adInterface(funImpl, variableDim_, parameterDim_, modelName);
+  adInterface.createModels(ocs2::CppAdInterface::ApproximationOrder::Second, true);
+  const auto compileTime = boost::filesystem::last_write_time(libraryPath);
+
+  // The same function is loaded from the library on disk
+  ocs2::CppAdInterface sameInterface(funImpl, variableDim_, parameterDim_, modelName);
+  sameInterface.loadModelsIfAvailable(ocs2::CppAdInterface::ApproximationOrder::Second, true);
+  ASSERT_EQ(boost::filesystem::last_write_time(libraryPath), compileTime);
+  ASSERT_TRUE(sameInterface.getFunctionValue(x, p).isApprox(testFun(x, p)));
+
+  // A modified function under the same name replaces the stale library
+  auto scaledFun = [](const ad_vector_t& x, const ad_vector_t& p, ad_vector_t& y) {
+    funImpl(x, p, y);
+    y = y + y;
+  };
+  ocs2::CppAdInterface modifiedInterface(scaledFun, variableDim_, parameterDim_, modelName);
+  modifiedInterface.loadModelsIfAvailable(ocs2::CppAdInterface::ApproximationOrder::Second, true);
+  ASSERT_TRUE(modifiedInterface.getFunctionValue(x, p).isApprox(2.0 * testFun(x, p)));
+  ASSERT_TRUE(modifiedInterface.getJacobian(x, p).isApprox(2.0 * testJacobian(x, p)));
+  ASSERT_TRUE(modifiedInterface.getHessian(1, x, p).isApprox(2.0 * testHessian(1, x, p)));
+}
+
+TEST_F(CppAdInterfaceParameterizedFixture, copiesShareLibrary) {
+  constexpr size_t numCopies = 4;
+
+  std::unique_ptr<ocs2::CppAdInterface> adInterfacePtr(
+      new ocs2::CppAdInterface(funImpl, variableDim_, parameterDim_, "testModelWithParametersCopies"));
+  adInterfacePtr->createModels(ocs2::CppAdInterface::ApproximationOrder::Second, false);
+
+  std::vector<std::unique_ptr<ocs2::CppAdInterface>> copies;
+  for (size_t i = 0; i < numCopies; i++) {
+    copies.emplace_back(new ocs2::CppAdInterface(*adInterfacePtr));
+  }
+  // The copies keep the library loaded after the original is destroyed
+  adInterfacePtr.reset();
+  copies.emplace_back(new ocs2::CppAdInterface(*copies.front()));
+
+  std::vector<vector_t> xs, ps;
+  for (size_t i = 0; i < copies.size(); i++) {
+    xs.push_back(vector_t::Random(variableDim_));
+    ps.push_back(vector_t::Random(parameterDim_));
+  }
+
+  // Each copy is evaluated concurrently in its own thread
+  std::vector<vector_t> values(copies.size());
+  std::vector<matrix_t> jacobians(copies.size());
+  std::vector<matrix_t> hessians(copies.size());
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < copies.size(); i++) {
+    threads.emplace_back([&, i]() {
+      for (int iter = 0; iter < 100; iter++) {
+        values[i] = copies[i]->getFunctionValue(xs[i], ps[i]);
+        jacobians[i] = copies[i]->getJacobian(xs[i], ps[i]);
+        hessians[i] = copies[i]->getHessian(0, xs[i], ps[i]);
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  for (size_t i = 0; i < copies.size(); i++) {
+    ASSERT_TRUE(values[i].isApprox(testFun(xs[i], ps[i])));
+    ASSERT_TRUE(jacobians[i].isApprox(testJacobian(xs[i], ps[i])));
+    ASSERT_TRUE(hessians[i].isApprox(testHessian(0, xs[i], ps[i])));
+  }
+}
+
+TEST_F(CppAdInterfaceParameterizedFixture, createSeveralModelsConcurrently) {
+  constexpr size_t numInterfaces = 3;
+  const vector_t x = vector_t::Random(variableDim_);
+  const vector_t p = vector_t::Random(parameterDim_);
+
+  auto createInterfaces = [&]() {
+    std::vector<std::unique_ptr<ocs2::CppAdInterface>> adInterfaces;
+    for (size_t i = 0; i < numInterfaces; i++) {
+      auto scaledFun = [i](const ad_vector_t& x, const ad_vector_t& p, ad_vector_t& y) {
+        funImpl(x, p, y);
+        y *= ad_scalar_t(i + 1);
+      };
+      adInterfaces.emplace_back(new ocs2::CppAdInterface(scaledFun, variableDim_, parameterDim_, "testModelBatch" + std::to_string(i)));
+    }
+    return adInterfaces;
+  };
+  auto getPointers = [](const std::vector<std::unique_ptr<ocs2::CppAdInterface>>& adInterfaces) {
+    std::vector<ocs2::CppAdInterface*> pointers;
+    for (const auto& adInterface : adInterfaces) {
+      pointers.push_back(adInterface.get());
+    }
+    return pointers;
+  };
+
+  const auto adInterfaces = createInterfaces();
+  ocs2::CppAdInterface::createModels(getPointers(adInterfaces), ocs2::CppAdInterface::ApproximationOrder::Second, false);
+  const auto loadedInterfaces = createInterfaces();
+  ocs2::CppAdInterface::loadModelsIfAvailable(getPointers(loadedInterfaces), ocs2::CppAdInterface::ApproximationOrder::Second, false);
+
+  for (size_t i = 0; i < numInterfaces; i++) {
+    const scalar_t scaling = i + 1;
+    for (const auto* adInterface : {adInterfaces[i].get(), loadedInterfaces[i].get()}) {
+      ASSERT_TRUE(adInterface->getFunctionValue(x, p).isApprox(scaling * testFun(x, p)));
+      ASSERT_TRUE(adInterface->getJacobian(x, p).isApprox(scaling * testJacobian(x, p)));
+      ASSERT_TRUE(adInterface->getHessian(1, x, p).isApprox(scaling * testHessian(1, x, p)));
+    }
+  }
+}
@@ -0,0 +1,87 @@
+#include <chrono>
+#include <iomanip>
+#include <iostream>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/misc/LinearInterpolation.h>
+#include <ocs2_core/reference/TargetTrajectories.h>
+
+using namespace ocs2;
+
+namespace {
+
+/** Returns the average time in nanoseconds of evaluating the function for all query times. */
+template <typename Function>
+double averageTime(const scalar_array_t& queryTimes, int numRepetitions, Function&& function) {
+  scalar_t checksum = 0.0;
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < numRepetitions; i++) {
+    for (const auto t : queryTimes) {
+      checksum += function(t);
+    }
+  }
+  const std::chrono::duration<double, std::nano> duration = std::chrono::steady_clock::now() - start;
+  // keeps the evaluations from being optimized away
+  if (checksum == 42.0) {
+    std::cerr << "";
+  }
+  return duration.count() / (numRepetitions * queryTimes.size());
+}
+
+}  // unnamed namespace
+
+/**
+ * Prints the time per lookup of the binary search against the cursor, for queries at the nodes of a new solution that are shifted
+ * against the nodes of the previous solution, as when interpolating the previous solution or the target trajectories in MPC.
+ */
+int main() {
+  constexpr size_t stateDim = 24;
+  constexpr size_t inputDim = 12;
+  constexpr int numQueriesPerSize = 1000000;
+
+  std::cerr << "Time per query [ns], state dimension " << stateDim << "\n";
+  std::cerr << std::setw(8) << "nodes" << std::setw(24) << "lookup: search/cursor" << std::setw(28) << "interpolate: search/cursor"
+            << std::setw(36) << "target state+input: search/cursor" << '\n';
+
+  for (const size_t numNodes : {100, 1000, 10000}) {
+    TargetTrajectories trajectories;
+    for (size_t i = 0; i < numNodes; i++) {
+      trajectories.timeTrajectory.push_back(static_cast<scalar_t>(i) / (numNodes - 1));
+      trajectories.stateTrajectory.push_back(vector_t::Random(stateDim));
+      trajectories.inputTrajectory.push_back(vector_t::Random(inputDim));
+    }
+    const auto& timeArray = trajectories.timeTrajectory;
+    const auto& stateArray = trajectories.stateTrajectory;
+
+    // the nodes of the new solution lie between the nodes of the previous one
+    scalar_array_t queryTimes;
+    for (size_t i = 0; i + 1 < numNodes; i++) {
+      queryTimes.push_back(0.5 * (timeArray[i] + timeArray[i + 1]));
+    }
+    const int numRepetitions = static_cast<int>(numQueriesPerSize / queryTimes.size());
+
+    LinearInterpolation::TimeSegmentCursor cursor;
+    const auto searchLookup =
+        averageTime(queryTimes, numRepetitions, [&](scalar_t t) { return LinearInterpolation::timeSegment(t, timeArray).second; });
+    const auto cursorLookup = averageTime(queryTimes, numRepetitions, [&](scalar_t t) { return cursor.timeSegment(t, timeArray).second; });
+
+    const auto searchInterpolate = averageTime(queryTimes, numRepetitions, [&](scalar_t t) {
+      return LinearInterpolation::interpolate(LinearInterpolation::timeSegment(t, timeArray), stateArray)(0);
+    });
+    const auto cursorInterpolate = averageTime(queryTimes, numRepetitions, [&](scalar_t t) {
+      return LinearInterpolation::interpolate(cursor.timeSegment(t, timeArray), stateArray)(0);
+    });
+
+    const auto searchTarget = averageTime(queryTimes, numRepetitions, [&](scalar_t t) {
+      return trajectories.getDesiredState(t)(0) + trajectories.getDesiredInput(t)(0);
+    });
+    const auto cursorTarget = averageTime(queryTimes, numRepetitions, [&](scalar_t t) {
+      return trajectories.getDesiredState(t, cursor)(0) + trajectories.getDesiredInput(t, cursor)(0);
+    });
+
+    std::cerr << std::fixed << std::setprecision(1) << std::setw(8) << numNodes << std::setw(15) << searchLookup << " /" << std::setw(7)
+              << cursorLookup << std::setw(19) << searchInterpolate << " /" << std::setw(7) << cursorInterpolate << std::setw(27)
+              << searchTarget << " /" << std::setw(7) << cursorTarget << '\n';
+  }
+  return 0;
+}
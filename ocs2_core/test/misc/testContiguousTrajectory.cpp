@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+
+#include <ocs2_core/misc/ContiguousTrajectory.h>
+#include <ocs2_core/misc/LinearInterpolation.h>
+
+using namespace ocs2;
+
+TEST(testContiguousTrajectory, assign) {
+  const matrix_array_t array{matrix_t::Random(2, 3), matrix_t::Random(2, 3), matrix_t(0, 3), matrix_t::Random(3, 3)};
+  const ContiguousTrajectory<matrix_t> trajectory(array);
+
+  ASSERT_EQ(trajectory.size(), array.size());
+  EXPECT_EQ(trajectory.stride(), 9);
+  for (size_t i = 0; i < array.size(); i++) {
+    ASSERT_EQ(trajectory[i].rows(), array[i].rows());
+    ASSERT_EQ(trajectory[i].cols(), array[i].cols());
+    EXPECT_TRUE(trajectory[i].isApprox(array[i]));
+  }
+
+  const auto copy = trajectory.toArray();
+  ASSERT_EQ(copy.size(), array.size());
+  for (size_t i = 0; i < array.size(); i++) {
+    EXPECT_TRUE(copy[i].isApprox(array[i]));
+  }
+}
+
+TEST(testContiguousTrajectory, growStride) {
+  const vector_array_t array{vector_t::Random(2), vector_t(0), vector_t::Random(2)};
+  ContiguousTrajectory<vector_t> trajectory(array);
+
+  // a larger node re-lays out the buffer, keeping the other nodes intact
+  const vector_t largeNode = vector_t::Random(5);
+  trajectory.set(1, largeNode);
+  trajectory.push_back(vector_t::Ones(7));
+
+  ASSERT_EQ(trajectory.size(), 4);
+  EXPECT_EQ(trajectory.stride(), 7);
+  EXPECT_TRUE(trajectory[0].isApprox(array[0]));
+  EXPECT_TRUE(trajectory[1].isApprox(largeNode));
+  EXPECT_TRUE(trajectory[2].isApprox(array[2]));
+  EXPECT_TRUE(trajectory.back().isApprox(vector_t::Ones(7)));
+
+  trajectory.truncate(2);
+  ASSERT_EQ(trajectory.size(), 2);
+  EXPECT_TRUE(trajectory[0].isApprox(array[0]));
+  EXPECT_TRUE(trajectory[1].isApprox(largeNode));
+}
+
+TEST(testContiguousTrajectory, resizeNode) {
+  ContiguousTrajectory<matrix_t> trajectory;
+  trajectory.resize(3, 2, 4);
+  trajectory.resizeNode(1, 0, 4);
+  trajectory.resizeNode(2, 1, 3);
+
+  // the nodes keep their slots, only their sizes change
+  ASSERT_EQ(trajectory.size(), 3);
+  EXPECT_EQ(trajectory.stride(), 8);
+  EXPECT_EQ(trajectory[0].rows(), 2);
+  EXPECT_EQ(trajectory[1].rows(), 0);
+  EXPECT_EQ(trajectory[2].rows(), 1);
+  EXPECT_EQ(trajectory[2].cols(), 3);
+
+  const matrix_t value = matrix_t::Random(1, 3);
+  trajectory[2] = value;
+  EXPECT_TRUE(trajectory[2].isApprox(value));
+}
+
+TEST(testContiguousTrajectory, append) {
+  const vector_array_t first{vector_t::Random(2), vector_t::Random(2)};
+  const vector_array_t second{vector_t::Random(4), vector_t::Random(4), vector_t::Random(4)};
+  ContiguousTrajectory<vector_t> trajectory(first);
+  trajectory.append(ContiguousTrajectory<vector_t>(second), 1, 2);
+
+  ASSERT_EQ(trajectory.size(), 4);
+  EXPECT_TRUE(trajectory[0].isApprox(first[0]));
+  EXPECT_TRUE(trajectory[1].isApprox(first[1]));
+  EXPECT_TRUE(trajectory[2].isApprox(second[1]));
+  EXPECT_TRUE(trajectory[3].isApprox(second[2]));
+}
+
+TEST(testContiguousTrajectory, interpolate) {
+  const scalar_array_t timeArray{0.0, 1.0, 1.0, 2.0};
+  const vector_array_t array{vector_t::Random(3), vector_t::Random(3), vector_t::Random(2), vector_t::Random(2)};
+  const ContiguousTrajectory<vector_t> trajectory(array);
+
+  // must agree with the std::vector interpolation, including the snapping between nodes of different size
+  for (const scalar_t t : {-1.0, 0.0, 0.3, 1.0, 1.5, 2.0, 3.0}) {
+    const vector_t expected = LinearInterpolation::interpolate(t, timeArray, array);
+    const vector_t result = LinearInterpolation::interpolate(t, timeArray, trajectory);
+    ASSERT_EQ(result.size(), expected.size()) << "t = " << t;
+    EXPECT_TRUE(result.isApprox(expected)) << "t = " << t;
+  }
+
+  // single node implies a constant function
+  const ContiguousTrajectory<vector_t> single(vector_array_t{array.front()});
+  EXPECT_TRUE(LinearInterpolation::interpolate(5.0, scalar_array_t{0.0}, single).isApprox(array.front()));
+}
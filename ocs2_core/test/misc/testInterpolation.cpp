@@ -1,5 +1,7 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <cstdlib>
 #include <iostream>
 
 #include <ocs2_core/misc/LinearInterpolation.h>
@@ -132,3 +134,64 @@ TEST(testLinearInterpolation, testDifferentEigenSizes) {
   result = ocs2::LinearInterpolation::interpolate(1.1, times, data);
   EXPECT_TRUE(result.isApprox(data[1]));
 }
+
+TEST(testLinearInterpolation, testTimeSegmentCursor) {
+  // Includes duplicate event times and a short interval
+  const std::vector<double> t = {0.0, 0.1, 0.2, 0.2, 0.5, 0.5 + 1e-12, 1.0, 1.5, 1.5, 2.0};
+
+  std::vector<double> enquiryTimes;
+  for (int i = -5; i <= 105; i++) {
+    enquiryTimes.push_back(0.02 * i);
+  }
+  enquiryTimes.insert(enquiryTimes.end(), t.begin(), t.end());
+  std::sort(enquiryTimes.begin(), enquiryTimes.end());
+
+  auto expectSameSegment = [&](const ocs2::LinearInterpolation::index_alpha_t& indexAlpha, double time) {
+    const auto expected = ocs2::LinearInterpolation::timeSegment(time, t);
+    EXPECT_EQ(indexAlpha.first, expected.first) << "time: " << time;
+    EXPECT_DOUBLE_EQ(indexAlpha.second, expected.second) << "time: " << time;
+  };
+
+  // Increasing times
+  ocs2::LinearInterpolation::TimeSegmentCursor cursor;
+  for (const auto time : enquiryTimes) {
+    expectSameSegment(cursor.timeSegment(time, t), time);
+  }
+
+  // Decreasing times
+  for (auto it = enquiryTimes.rbegin(); it != enquiryTimes.rend(); ++it) {
+    expectSameSegment(cursor.timeSegment(*it, t), *it);
+  }
+
+  // Arbitrary times
+  std::srand(0);
+  for (int i = 0; i < 200; i++) {
+    const double time = enquiryTimes[std::rand() % enquiryTimes.size()];
+    expectSameSegment(cursor.timeSegment(time, t), time);
+  }
+
+  // Another time array
+  const std::vector<double> shortTime = {0.3, 0.6};
+  EXPECT_EQ(cursor.timeSegment(0.4, {}), ocs2::LinearInterpolation::timeSegment(0.4, {}));
+  EXPECT_EQ(cursor.timeSegment(0.4, shortTime), ocs2::LinearInterpolation::timeSegment(0.4, shortTime));
+
+  // Batch lookup
+  const auto indexAlphas = ocs2::LinearInterpolation::timeSegments(enquiryTimes, t);
+  ASSERT_EQ(indexAlphas.size(), enquiryTimes.size());
+  for (size_t i = 0; i < enquiryTimes.size(); i++) {
+    expectSameSegment(indexAlphas[i], enquiryTimes[i]);
+  }
+}
+
+TEST(testLinearInterpolation, testTrajectoryInterpolation) {
+  const std::vector<double> t = {0.0, 1.0, 2.0, 2.0, 3.0};
+  const ocs2::vector_array_t data = {ocs2::vector_t::Zero(2), ocs2::vector_t::Ones(2), ocs2::vector_t::Constant(2, 3.0),
+                                     ocs2::vector_t::Constant(2, -1.0), ocs2::vector_t::Constant(2, 2.0)};
+  const std::vector<double> enquiryTimes = {-1.0, 0.0, 0.3, 1.0, 1.5, 2.0, 2.5, 3.0, 4.0};
+
+  const auto result = ocs2::LinearInterpolation::interpolate(enquiryTimes, t, data);
+  ASSERT_EQ(result.size(), enquiryTimes.size());
+  for (size_t i = 0; i < enquiryTimes.size(); i++) {
+    EXPECT_TRUE(result[i].isApprox(ocs2::LinearInterpolation::interpolate(enquiryTimes[i], t, data))) << "time: " << enquiryTimes[i];
+  }
+}
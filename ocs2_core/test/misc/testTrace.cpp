@@ -0,0 +1,136 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <chrono>
+#include <sstream>
+#include <string>
+#include <thread>
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/misc/Trace.h>
+
+using namespace ocs2;
+
+namespace {
+size_t countOccurrences(const std::string& str, const std::string& pattern) {
+  size_t count = 0;
+  for (auto pos = str.find(pattern); pos != std::string::npos; pos = str.find(pattern, pos + pattern.size())) {
+    ++count;
+  }
+  return count;
+}
+
+std::string getChromeTrace() {
+  std::stringstream stream;
+  trace::writeChromeTrace(stream);
+  return stream.str();
+}
+}  // unnamed namespace
+
+TEST(testTrace, recordNestedSpans) {
+  trace::clear();
+  trace::start();
+  {
+    trace::ScopedSpan outer("testTrace::outer");
+    for (int i = 0; i < 3; i++) {
+      trace::ScopedSpan inner("testTrace::inner");
+    }
+  }
+  trace::stop();
+  { trace::ScopedSpan notRecorded("testTrace::notRecorded"); }
+
+  const auto chromeTrace = getChromeTrace();
+  EXPECT_EQ(chromeTrace.find("{\"traceEvents\":["), 0);
+  EXPECT_EQ(countOccurrences(chromeTrace, "\"testTrace::outer\""), 1);
+  EXPECT_EQ(countOccurrences(chromeTrace, "\"testTrace::inner\""), 3);
+  EXPECT_EQ(countOccurrences(chromeTrace, "\"testTrace::notRecorded\""), 0);
+
+  trace::clear();
+  EXPECT_EQ(countOccurrences(getChromeTrace(), "\"ph\":\"X\""), 0);
+}
+
+TEST(testTrace, recordThreads) {
+  trace::clear();
+  trace::start();
+  auto task = [](const std::string& name) {
+    trace::setThreadName(name);
+    for (int i = 0; i < 10; i++) {
+      trace::ScopedSpan span("testTrace::task");
+    }
+  };
+  std::thread thread1(task, "worker 1");
+  std::thread thread2(task, "worker 2");
+  thread1.join();
+  thread2.join();
+  trace::stop();
+
+  // the spans of the threads are kept after the threads exit
+  const auto chromeTrace = getChromeTrace();
+  EXPECT_EQ(countOccurrences(chromeTrace, "\"testTrace::task\""), 20);
+  EXPECT_EQ(countOccurrences(chromeTrace, "\"worker 1\""), 1);
+  EXPECT_EQ(countOccurrences(chromeTrace, "\"worker 2\""), 1);
+}
+
+TEST(testTrace, ringBufferOverflow) {
+  trace::clear();
+  trace::start(8);
+  std::thread thread([]() {
+    for (int i = 0; i < 20; i++) {
+      trace::ScopedSpan span("testTrace::overflow");
+    }
+  });
+  thread.join();
+  trace::stop();
+
+  // only the newest spans fit into the buffer of the new thread
+  EXPECT_EQ(countOccurrences(getChromeTrace(), "\"testTrace::overflow\""), 8);
+}
+
+TEST(testTrace, totalDurations) {
+  trace::clear();
+  trace::start();
+  {
+    trace::ScopedSpan outer("testTrace::outer");
+    for (int i = 0; i < 2; i++) {
+      trace::ScopedSpan inner("testTrace::inner");
+      std::this_thread::sleep_for(std::chrono::milliseconds(5));
+    }
+  }
+  trace::stop();
+
+  const auto totalDurations = trace::getTotalDurations();
+  ASSERT_EQ(totalDurations.count("testTrace::outer"), 1);
+  ASSERT_EQ(totalDurations.count("testTrace::inner"), 1);
+  EXPECT_GE(totalDurations.at("testTrace::inner"), 10.0);
+  EXPECT_GE(totalDurations.at("testTrace::outer"), totalDurations.at("testTrace::inner"));
+
+  trace::clear();
+  EXPECT_TRUE(trace::getTotalDurations().empty());
+}
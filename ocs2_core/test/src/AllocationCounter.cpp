@@ -0,0 +1,104 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_core/test/AllocationCounter.h"
+
+#include <atomic>
+#include <cerrno>
+
+/*
+ * The heap allocations are counted by interposing the C allocation functions of glibc. Both the global operator new and the aligned
+ * allocator of Eigen forward to malloc, hence counting there captures the allocations of the std containers as well as of the dynamic
+ * size Eigen matrices. The aligned allocation functions are counted as well, they are used by the over-aligned operator new and by
+ * Eigen when it is configured to allocate through posix_memalign.
+ */
+extern "C" {
+void* __libc_malloc(size_t size);
+void* __libc_calloc(size_t num, size_t size);
+void* __libc_realloc(void* ptr, size_t size);
+void* __libc_memalign(size_t alignment, size_t size);
+}
+
+namespace {
+std::atomic<size_t> allocationCount{0};
+}  // unnamed namespace
+
+namespace ocs2 {
+
+size_t getAllocationCount() {
+  return allocationCount.load(std::memory_order_relaxed);
+}
+
+}  // namespace ocs2
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+extern "C" {
+
+void* malloc(size_t size) noexcept {
+  allocationCount.fetch_add(1, std::memory_order_relaxed);
+  return __libc_malloc(size);
+}
+
+void* calloc(size_t num, size_t size) noexcept {
+  allocationCount.fetch_add(1, std::memory_order_relaxed);
+  return __libc_calloc(num, size);
+}
+
+void* realloc(void* ptr, size_t size) noexcept {
+  allocationCount.fetch_add(1, std::memory_order_relaxed);
+  return __libc_realloc(ptr, size);
+}
+
+void* memalign(size_t alignment, size_t size) noexcept {
+  allocationCount.fetch_add(1, std::memory_order_relaxed);
+  return __libc_memalign(alignment, size);
+}
+
+void* aligned_alloc(size_t alignment, size_t size) noexcept {
+  allocationCount.fetch_add(1, std::memory_order_relaxed);
+  return __libc_memalign(alignment, size);
+}
+
+int posix_memalign(void** memptr, size_t alignment, size_t size) noexcept {
+  // the alignment has to be a power of two multiple of sizeof(void*)
+  if (alignment == 0 || alignment % sizeof(void*) != 0 || (alignment & (alignment - 1)) != 0) {
+    return EINVAL;
+  }
+  allocationCount.fetch_add(1, std::memory_order_relaxed);
+  void* ptr = __libc_memalign(alignment, size);
+  if (ptr == nullptr) {
+    return ENOMEM;
+  }
+  *memptr = ptr;
+  return 0;
+}
+
+}  // extern "C"
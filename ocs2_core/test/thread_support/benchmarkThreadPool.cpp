@@ -0,0 +1,123 @@
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <iomanip>
+#include <iostream>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include <ocs2_core/thread_support/ThreadPool.h>
+
+using namespace ocs2;
+
+namespace {
+
+/** Dispatch through a mutex-protected queue with one packaged_task per task, as a reference for the fork-join dispatch. */
+class QueueDispatch {
+ public:
+  explicit QueueDispatch(size_t nThreads) {
+    for (size_t i = 0; i < nThreads; i++) {
+      threads_.emplace_back([this, i] {
+        while (true) {
+          std::unique_ptr<std::packaged_task<void(int)>> task;
+          {
+            std::unique_lock<std::mutex> lock(mutex_);
+            condition_.wait(lock, [this] { return !queue_.empty() || stop_; });
+            if (stop_) {
+              return;
+            }
+            task = std::move(queue_.front());
+            queue_.pop();
+          }
+          (*task)(static_cast<int>(i));
+        }
+      });
+    }
+  }
+
+  ~QueueDispatch() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stop_ = true;
+    }
+    condition_.notify_all();
+    for (auto& thread : threads_) {
+      thread.join();
+    }
+  }
+
+  void runParallel(std::function<void(int)> taskFunction, int N) {
+    std::vector<std::future<void>> futures;
+    for (int i = 0; i < N - 1; i++) {
+      auto task = std::make_unique<std::packaged_task<void(int)>>(taskFunction);
+      futures.push_back(task->get_future());
+      {
+        std::lock_guard<std::mutex> lock(mutex_);
+        queue_.push(std::move(task));
+      }
+      condition_.notify_one();
+    }
+    taskFunction(static_cast<int>(threads_.size()));
+    for (auto& future : futures) {
+      future.get();
+    }
+  }
+
+ private:
+  bool stop_ = false;
+  std::queue<std::unique_ptr<std::packaged_task<void(int)>>> queue_;
+  std::mutex mutex_;
+  std::condition_variable condition_;
+  std::vector<std::thread> threads_;
+};
+
+/** Returns the average time in microseconds of dispatching an empty parallel phase. */
+template <typename Pool>
+double dispatchLatency(Pool& pool, int N, int numRepetitions) {
+  std::atomic_int counter{0};
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < numRepetitions; i++) {
+    pool.runParallel([&](int) { counter++; }, N);
+  }
+  const std::chrono::duration<double, std::micro> duration = std::chrono::steady_clock::now() - start;
+  if (counter != N * numRepetitions) {
+    throw std::runtime_error("[benchmarkThreadPool] Not all tasks were executed.");
+  }
+  return duration.count() / numRepetitions;
+}
+
+}  // unnamed namespace
+
+/** Prints the dispatch latency of the fork-join thread pool, sleeping and spinning, against a task queue. */
+int main() {
+  constexpr int numRepetitions = 2000;
+  std::cerr << "Dispatch latency of an empty runParallel(task, nThreads + 1) [us], " << std::thread::hardware_concurrency()
+            << " hardware threads\n";
+  std::cerr << std::setw(10) << "nThreads" << std::setw(12) << "queue" << std::setw(12) << "fork-join" << std::setw(12) << "spinning"
+            << '\n';
+
+  for (const size_t nThreads : {1, 3, 7}) {
+    const int N = static_cast<int>(nThreads) + 1;
+
+    QueueDispatch queueDispatch(nThreads);
+    const auto queueLatency = dispatchLatency(queueDispatch, N, numRepetitions);
+
+    ThreadPool sleepingPool(nThreads);
+    const auto sleepingLatency = dispatchLatency(sleepingPool, N, numRepetitions);
+
+    ThreadPool::Settings settings;
+    settings.spinDuration = 1000;
+    ThreadPool spinningPool(nThreads, 0, settings);
+    const auto spinningLatency = dispatchLatency(spinningPool, N, numRepetitions);
+
+    std::cerr << std::setw(10) << nThreads << std::setw(12) << queueLatency << std::setw(12) << sleepingLatency << std::setw(12)
+              << spinningLatency << '\n';
+  }
+  return 0;
+}
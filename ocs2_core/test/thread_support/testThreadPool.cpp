@@ -121,3 +121,90 @@ TEST(testThreadPool, testMoveOnlyTask) {
 
   EXPECT_EQ(result.get(), 3.14);
 }
+
+TEST(testThreadPool, testParallelFor) {
+  for (const size_t nThreads : {0, 1, 3}) {
+    ThreadPool pool(nThreads);
+    for (const size_t N : {0, 1, 2, 5, 1000}) {
+      // each index is processed exactly once, concurrent tasks have different worker indices
+      std::vector<std::atomic_int> counts(N);
+      std::vector<std::atomic_int> workerBusy(nThreads + 1);
+      std::atomic_bool workerClash{false};
+      pool.parallelFor(N, [&](int workerIndex, size_t index) {
+        if (workerBusy[workerIndex]++ != 0) {
+          workerClash = true;
+        }
+        counts[index]++;
+        workerBusy[workerIndex]--;
+      });
+      EXPECT_FALSE(workerClash);
+      for (size_t i = 0; i < N; i++) {
+        ASSERT_EQ(counts[i], 1) << "nThreads: " << nThreads << ", N: " << N << ", index: " << i;
+      }
+    }
+  }
+}
+
+TEST(testThreadPool, testParallelForRepeated) {
+  // many short consecutive jobs, as in the parallel phases of a solver iteration
+  ThreadPool::Settings settings;
+  settings.spinDuration = 100;
+  ThreadPool pool(3, 0, settings);
+  std::atomic_int counter{0};
+  for (int i = 0; i < 1000; i++) {
+    pool.runParallel([&](int) { counter++; }, 4);
+  }
+  EXPECT_EQ(counter, 4000);
+}
+
+TEST(testThreadPool, testParallelForException) {
+  ThreadPool pool(2);
+  std::atomic_int counter{0};
+  auto task = [&](int, size_t index) {
+    counter++;
+    if (index == 7) {
+      throw std::runtime_error("exception");
+    }
+  };
+  EXPECT_THROW(pool.parallelFor(20, task), std::runtime_error);
+  EXPECT_EQ(counter, 20);
+
+  // the pool is usable afterwards
+  counter = 0;
+  pool.runParallel([&](int) { counter++; }, 3);
+  EXPECT_EQ(counter, 3);
+}
+
+TEST(testThreadPool, testNestedParallelFor) {
+  ThreadPool pool(2);
+  std::atomic_int counter{0};
+  pool.parallelFor(4, [&](int outerWorkerIndex, size_t) {
+    pool.parallelFor(5, [&](int innerWorkerIndex, size_t) {
+      EXPECT_EQ(innerWorkerIndex, outerWorkerIndex);
+      counter++;
+    });
+  });
+  EXPECT_EQ(counter, 20);
+}
+
+TEST(testThreadPool, testAsyncTasksAndParallelFor) {
+  ThreadPool pool(2);
+  auto future = pool.run([](int) { return 42; });
+  std::atomic_int counter{0};
+  pool.runParallel([&](int) { counter++; }, 3);
+  EXPECT_EQ(future.get(), 42);
+  EXPECT_EQ(counter, 3);
+}
+
+TEST(testThreadPool, testCpuAffinity) {
+  ThreadPool::Settings settings;
+  settings.cpuAffinity = {0};
+  ThreadPool pool(2, 0, settings);
+  std::atomic_int counter{0};
+  pool.runParallel([&](int) { counter++; }, 3);
+  EXPECT_EQ(counter, 3);
+
+  for (const int cpu : getIsolatedCpus()) {
+    EXPECT_GE(cpu, 0);
+  }
+}
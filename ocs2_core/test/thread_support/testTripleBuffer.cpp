@@ -0,0 +1,97 @@
+#include <gtest/gtest.h>
+#include <ocs2_core/thread_support/TripleBuffer.h>
+
+#include <string>
+#include <thread>
+#include <vector>
+
+TEST(testTripleBuffer, basicPublishUpdate) {
+  // initialize
+  const std::string initialValue{"init"};
+  ocs2::TripleBuffer<std::string> tripleBuffer(initialValue);
+  ASSERT_EQ(tripleBuffer.get(), initialValue);
+
+  // nothing published
+  ASSERT_FALSE(tripleBuffer.updateFromBuffer());
+  ASSERT_EQ(tripleBuffer.get(), initialValue);
+
+  // publish
+  tripleBuffer.getWriteBuffer() = "update";
+  tripleBuffer.publish();
+  ASSERT_EQ(tripleBuffer.get(), initialValue);
+
+  // update
+  ASSERT_TRUE(tripleBuffer.updateFromBuffer());
+  ASSERT_EQ(tripleBuffer.get(), "update");
+
+  // The value is only taken once
+  ASSERT_FALSE(tripleBuffer.updateFromBuffer());
+  ASSERT_EQ(tripleBuffer.get(), "update");
+}
+
+TEST(testTripleBuffer, latestValue) {
+  ocs2::TripleBuffer<int> tripleBuffer(0);
+
+  // publish several values before updating, only the latest is received
+  for (int i = 1; i <= 5; i++) {
+    tripleBuffer.getWriteBuffer() = i;
+    tripleBuffer.publish();
+  }
+  ASSERT_TRUE(tripleBuffer.updateFromBuffer());
+  ASSERT_EQ(tripleBuffer.get(), 5);
+
+  // discarded values are not received
+  tripleBuffer.getWriteBuffer() = 6;
+  tripleBuffer.publish();
+  tripleBuffer.discardBuffer();
+  ASSERT_FALSE(tripleBuffer.updateFromBuffer());
+  ASSERT_EQ(tripleBuffer.get(), 5);
+}
+
+TEST(testTripleBuffer, reuseSlots) {
+  ocs2::TripleBuffer<std::vector<double>> tripleBuffer;
+
+  // After each slot has been written once, the capacity is reused
+  for (int i = 0; i < 3; i++) {
+    tripleBuffer.getWriteBuffer().assign(100, i);
+    tripleBuffer.publish();
+    tripleBuffer.updateFromBuffer();
+  }
+  for (int i = 0; i < 10; i++) {
+    auto& writeBuffer = tripleBuffer.getWriteBuffer();
+    const auto* data = writeBuffer.data();
+    writeBuffer.assign(100, i);
+    ASSERT_EQ(writeBuffer.data(), data);
+    tripleBuffer.publish();
+    ASSERT_TRUE(tripleBuffer.updateFromBuffer());
+    ASSERT_EQ(tripleBuffer.get().front(), i);
+  }
+}
+
+TEST(testTripleBuffer, concurrentProducerConsumer) {
+  constexpr int numValues = 100000;
+  constexpr size_t valueSize = 16;
+  ocs2::TripleBuffer<std::vector<int>> tripleBuffer(std::vector<int>(valueSize, -1));
+
+  // The producer writes vectors with identical entries. A consumer that reads a slot while it is written would see mixed entries.
+  std::thread producer([&]() {
+    for (int i = 0; i < numValues; i++) {
+      tripleBuffer.getWriteBuffer().assign(valueSize, i);
+      tripleBuffer.publish();
+    }
+  });
+
+  int lastValue = -1;
+  while (lastValue < numValues - 1) {
+    if (tripleBuffer.updateFromBuffer()) {
+      const auto& value = tripleBuffer.get();
+      ASSERT_EQ(value.size(), valueSize);
+      for (const auto entry : value) {
+        ASSERT_EQ(entry, value.front());
+      }
+      ASSERT_GT(value.front(), lastValue);  // values arrive in order
+      lastValue = value.front();
+    }
+  }
+  producer.join();
+}
@@ -30,6 +30,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #pragma once
 
 #include <string>
+#include <vector>
 
 #include <ocs2_core/Types.h>
 #include <ocs2_core/integration/Integrator.h>
@@ -68,6 +69,10 @@ struct Settings {
   size_t nThreads_ = 1;
   /** Priority of threads used in the multi-threading scheme. */
   int threadPriority_ = 99;
+  /** Time in microseconds for which idle threads poll for new work before sleeping, see ThreadPool::Settings. */
+  int threadSpinDuration_ = 0;
+  /** The CPUs to which the threads are pinned. An empty list does not pin them. */
+  std::vector<int> threadCpuAffinity_;
 
   /** Maximum number of iterations of DDP. */
   size_t maxNumIterations_ = 15;
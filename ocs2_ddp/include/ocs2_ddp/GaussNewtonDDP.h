@@ -109,6 +109,8 @@ class GaussNewtonDDP : public SolverBase {
 
   std::string getBenchmarkingInfo() const override;
 
+  std::map<std::string, scalar_t> getBenchmarkingTimes() const override;
+
   /**
    * Const access to ddp settings
    */
@@ -34,6 +34,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "GaussNewtonDDP.h"
 #include "riccati_equations/DiscreteTimeRiccatiEquations.h"
+#include "riccati_equations/FixedSizeDiscreteTimeRiccatiEquations.h"
 
 namespace ocs2 {
 
@@ -58,6 +59,22 @@ class ILQR : public GaussNewtonDDP {
    */
   ~ILQR() override = default;
 
+  /**
+   * Replaces the dynamic-size Riccati equations by the fixed-size ones. This is an opt-in for small problems whose dimensions are known
+   * at compile time, e.g. the cartpole. The fixed-size kernel falls back to the dynamic-size one for the time steps whose dimensions do
+   * not match, see FixedSizeDiscreteTimeRiccatiEquations.
+   *
+   * @tparam STATE_DIM: The state dimension.
+   * @tparam INPUT_DIM: The input dimension.
+   */
+  template <int STATE_DIM, int INPUT_DIM>
+  void useFixedSizeRiccatiEquations() {
+    for (auto& riccatiEquationsPtr : riccatiEquationsPtrStock_) {
+      riccatiEquationsPtr.reset(new FixedSizeDiscreteTimeRiccatiEquations<STATE_DIM, INPUT_DIM>(isReducedFormRiccati(), isRiskSensitive()));
+      riccatiEquationsPtr->setRiskSensitiveCoefficient(settings().riskSensitiveCoeff_);
+    }
+  }
+
  protected:
   scalar_t solveSequentialRiccatiEquations(const ScalarFunctionQuadraticApproximation& finalValueFunction) override;
 
@@ -85,6 +102,12 @@ class ILQR : public GaussNewtonDDP {
   void discreteLQWorker(SystemDynamicsBase& system, scalar_t time, const vector_t& state, const vector_t& input, scalar_t timeStep,
                         const ModelData& continuousTimeModelData, ModelData& modelData);
 
+  /** Whether the reduced form of the Riccati equations is used. */
+  bool isReducedFormRiccati() const;
+
+  /** Whether the risk sensitive variant of the Riccati equations is used. */
+  bool isRiskSensitive() const;
+
   /****************
    *** Variables **
    ****************/
@@ -82,7 +82,7 @@ class DiscreteTimeRiccatiEquations {
   /**
    * Default destructor.
    */
-  ~DiscreteTimeRiccatiEquations() = default;
+  virtual ~DiscreteTimeRiccatiEquations() = default;
 
   /**
    * Sets risk-sensitive coefficient.
@@ -103,11 +103,11 @@ class DiscreteTimeRiccatiEquations {
    * @param [out] Sv: The current Riccati vector.
    * @param [out] s: The current Riccati scalar.
    */
-  void computeMap(const ModelData& projectedModelData, const riccati_modification::Data& riccatiModification, const matrix_t& SmNext,
-                  const vector_t& SvNext, const scalar_t& sNext, matrix_t& projectedKm, vector_t& projectedLv, matrix_t& Sm, vector_t& Sv,
-                  scalar_t& s);
+  virtual void computeMap(const ModelData& projectedModelData, const riccati_modification::Data& riccatiModification,
+                          const matrix_t& SmNext, const vector_t& SvNext, const scalar_t& sNext, matrix_t& projectedKm,
+                          vector_t& projectedLv, matrix_t& Sm, vector_t& Sv, scalar_t& s);
 
- private:
+ protected:
   /**
    * Computes one step Riccati difference equations for ILQR formulation.
    *
@@ -146,7 +146,6 @@ class DiscreteTimeRiccatiEquations {
                       const vector_t& SvNext, const scalar_t& sNext, DiscreteTimeRiccatiData& dreCache, matrix_t& projectedKm,
                       vector_t& projectedLv, matrix_t& Sm, vector_t& Sv, scalar_t& s) const;
 
- private:
   bool reducedFormRiccati_;
   bool isRiskSensitive_;
   scalar_t riskSensitiveCoeff_ = 0.0;
@@ -0,0 +1,112 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <ocs2_core/FixedSizeTypes.h>
+
+#include "ocs2_ddp/riccati_equations/DiscreteTimeRiccatiEquations.h"
+
+namespace ocs2 {
+
+/**
+ * Discrete-time Riccati difference equations for problems whose state and input dimensions are known at compile time. All
+ * intermediate terms are fixed-size Eigen types, hence the products are stack allocated, unrolled and vectorized.
+ *
+ * The fixed-size kernel is used when the projected input dimension equals INPUT_DIM, i.e., when there are no active state-input
+ * equality constraints. Otherwise, and for the risk sensitive variant, it falls back to the dynamic-size DiscreteTimeRiccatiEquations.
+ *
+ * @tparam STATE_DIM: The state dimension.
+ * @tparam INPUT_DIM: The input dimension.
+ */
+template <int STATE_DIM, int INPUT_DIM>
+class FixedSizeDiscreteTimeRiccatiEquations final : public DiscreteTimeRiccatiEquations {
+ public:
+  EIGEN_MAKE_ALIGNED_OPERATOR_NEW
+
+  using state_vector_t = fixed_vector_t<STATE_DIM>;
+  using input_vector_t = fixed_vector_t<INPUT_DIM>;
+  using state_matrix_t = fixed_matrix_t<STATE_DIM, STATE_DIM>;
+  using input_matrix_t = fixed_matrix_t<INPUT_DIM, INPUT_DIM>;
+  using input_state_matrix_t = fixed_matrix_t<INPUT_DIM, STATE_DIM>;
+  using state_input_matrix_t = fixed_matrix_t<STATE_DIM, INPUT_DIM>;
+
+  /**
+   * Constructor.
+   *
+   * @param [in] reducedFormRiccati: The reduced form of the Riccati equation is yield by assuming that Hessein of
+   * the Hamiltonian is positive definite. In this case, the computation of Riccati equation is more efficient.
+   * @param [in] isRiskSensitive: Neither the risk sensitive variant is used or not.
+   */
+  explicit FixedSizeDiscreteTimeRiccatiEquations(bool reducedFormRiccati, bool isRiskSensitive = false)
+      : DiscreteTimeRiccatiEquations(reducedFormRiccati, isRiskSensitive) {}
+
+  ~FixedSizeDiscreteTimeRiccatiEquations() override = default;
+
+  void computeMap(const ModelData& projectedModelData, const riccati_modification::Data& riccatiModification, const matrix_t& SmNext,
+                  const vector_t& SvNext, const scalar_t& sNext, matrix_t& projectedKm, vector_t& projectedLv, matrix_t& Sm, vector_t& Sv,
+                  scalar_t& s) override;
+
+ private:
+  /** Checks whether the fixed-size kernel applies to the given data. */
+  bool hasMatchingSize(const ModelData& projectedModelData, const riccati_modification::Data& riccatiModification) const;
+
+  /** Data cache of the fixed-size kernel */
+  struct Data {
+    // inputs
+    state_matrix_t Am;
+    state_input_matrix_t Bm;
+    state_vector_t Hv;
+    FixedSizeScalarFunctionQuadraticApproximation<STATE_DIM, INPUT_DIM> cost;
+    state_matrix_t SmNext;
+    state_vector_t SvNext;
+    // intermediate terms
+    state_vector_t Sm_projectedHv;
+    state_matrix_t Sm_projectedAm;
+    state_input_matrix_t Sm_projectedBm;
+    state_vector_t Sv_plus_Sm_projectedHv;
+    input_matrix_t projectedHm;
+    input_state_matrix_t projectedGm;
+    input_vector_t projectedGv;
+    state_matrix_t projectedKm_T_projectedGm;
+    input_state_matrix_t projectedHm_projectedKm;
+    input_vector_t projectedHm_projectedLv;
+    // outputs
+    input_state_matrix_t projectedKm;
+    input_vector_t projectedLv;
+    state_matrix_t Sm;
+    state_vector_t Sv;
+  };
+
+  Data data_;
+};
+
+}  // namespace ocs2
+
+#include "implementation/FixedSizeDiscreteTimeRiccatiEquations.h"
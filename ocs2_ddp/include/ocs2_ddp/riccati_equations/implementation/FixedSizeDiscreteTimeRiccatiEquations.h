@@ -0,0 +1,158 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+namespace ocs2 {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+template <int STATE_DIM, int INPUT_DIM>
+bool FixedSizeDiscreteTimeRiccatiEquations<STATE_DIM, INPUT_DIM>::hasMatchingSize(
+    const ModelData& projectedModelData, const riccati_modification::Data& riccatiModification) const {
+  const auto& dynamics = projectedModelData.dynamics;
+  return dynamics.dfdx.rows() == STATE_DIM && dynamics.dfdx.cols() == STATE_DIM && dynamics.dfdu.rows() == STATE_DIM &&
+         dynamics.dfdu.cols() == INPUT_DIM && projectedModelData.dynamicsBias.size() == STATE_DIM &&
+         FixedSizeScalarFunctionQuadraticApproximation<STATE_DIM, INPUT_DIM>::hasMatchingSize(projectedModelData.cost) &&
+         riccatiModification.deltaQm_.rows() == STATE_DIM && riccatiModification.deltaGm_.rows() == INPUT_DIM &&
+         riccatiModification.deltaGv_.size() == INPUT_DIM;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+template <int STATE_DIM, int INPUT_DIM>
+void FixedSizeDiscreteTimeRiccatiEquations<STATE_DIM, INPUT_DIM>::computeMap(const ModelData& projectedModelData,
+                                                                              const riccati_modification::Data& riccatiModification,
+                                                                              const matrix_t& SmNext, const vector_t& SvNext,
+                                                                              const scalar_t& sNext, matrix_t& projectedKm,
+                                                                              vector_t& projectedLv, matrix_t& Sm, vector_t& Sv,
+                                                                              scalar_t& s) {
+  if (isRiskSensitive_ || !hasMatchingSize(projectedModelData, riccatiModification)) {
+    DiscreteTimeRiccatiEquations::computeMap(projectedModelData, riccatiModification, SmNext, SvNext, sNext, projectedKm, projectedLv, Sm,
+                                             Sv, s);
+    return;
+  }
+
+  auto& d = data_;
+  d.Am = projectedModelData.dynamics.dfdx;
+  d.Bm = projectedModelData.dynamics.dfdu;
+  d.Hv = projectedModelData.dynamicsBias;
+  d.cost.fromDynamic(projectedModelData.cost);
+  d.SmNext = SmNext;
+  d.SvNext = SvNext;
+
+  // precomputation (1)
+  d.Sm_projectedHv.noalias() = d.SmNext * d.Hv;
+  d.Sm_projectedAm.noalias() = d.SmNext * d.Am;
+  d.Sm_projectedBm.noalias() = d.SmNext * d.Bm;
+  d.Sv_plus_Sm_projectedHv = d.SvNext + d.Sm_projectedHv;
+
+  // projectedGm = projectedPm + projectedBm^T * Sm * projectedAm
+  d.projectedGm = d.cost.dfdux;
+  d.projectedGm.noalias() += d.Bm.transpose() * d.Sm_projectedAm;
+
+  // projectedGv = projectedRv + projectedBm^T * (Sv + Sm * projectedHv)
+  d.projectedGv = d.cost.dfdu;
+  d.projectedGv.noalias() += d.Bm.transpose() * d.Sv_plus_Sm_projectedHv;
+
+  // projected feedback
+  d.projectedKm = -d.projectedGm - riccatiModification.deltaGm_;
+  // projected feedforward
+  d.projectedLv = -d.projectedGv - riccatiModification.deltaGv_;
+
+  // precomputation (2)
+  d.projectedKm_T_projectedGm.noalias() = d.projectedKm.transpose() * d.projectedGm;
+  if (!reducedFormRiccati_) {
+    // projectedHm
+    d.projectedHm = d.cost.dfduu;
+    d.projectedHm.noalias() += d.Sm_projectedBm.transpose() * d.Bm;
+
+    d.projectedHm_projectedKm.noalias() = d.projectedHm * d.projectedKm;
+    d.projectedHm_projectedLv.noalias() = d.projectedHm * d.projectedLv;
+  }
+
+  /*
+   * Sm
+   */
+  // = Qm + deltaQm
+  d.Sm = d.cost.dfdxx + riccatiModification.deltaQm_;
+  // += Am^T * Sm * Am
+  d.Sm.noalias() += d.Sm_projectedAm.transpose() * d.Am;
+  if (reducedFormRiccati_) {
+    // += Km^T * Gm + Gm^T * Km
+    d.Sm += d.projectedKm_T_projectedGm;
+  } else {
+    // += Km^T * Gm + Gm^T * Km
+    d.Sm += d.projectedKm_T_projectedGm + d.projectedKm_T_projectedGm.transpose();
+    // += Km^T * Hm * Km
+    d.Sm.noalias() += d.projectedKm.transpose() * d.projectedHm_projectedKm;
+  }
+
+  /*
+   * Sv
+   */
+  // = Qv
+  d.Sv = d.cost.dfdx;
+  // += Am^T * (Sv + Sm * Hv)
+  d.Sv.noalias() += d.Am.transpose() * d.Sv_plus_Sm_projectedHv;
+  // += Gm^T * Lv
+  d.Sv.noalias() += d.projectedGm.transpose() * d.projectedLv;
+  if (!reducedFormRiccati_) {
+    // += Km^T * Gv
+    d.Sv.noalias() += d.projectedKm.transpose() * d.projectedGv;
+    // Km^T * Hm * Lv
+    d.Sv.noalias() += d.projectedHm_projectedKm.transpose() * d.projectedLv;
+  }
+
+  /*
+   * s
+   */
+  // = s + q
+  s = sNext + d.cost.f;
+  // += Hv^T * (Sv + Sm * Hv)
+  s += d.Hv.dot(d.Sv_plus_Sm_projectedHv);
+  // -= 0.5 Hv^T * Sm * Hv
+  s -= 0.5 * d.Hv.dot(d.Sm_projectedHv);
+  if (reducedFormRiccati_) {
+    // += 0.5 Lv^T Gv
+    s += 0.5 * d.projectedLv.dot(d.projectedGv);
+  } else {
+    // += Lv^T Gv
+    s += d.projectedLv.dot(d.projectedGv);
+    // += 0.5 Lv^T Hm Lv
+    s += 0.5 * d.projectedLv.dot(d.projectedHm_projectedLv);
+  }
+
+  projectedKm = d.projectedKm;
+  projectedLv = d.projectedLv;
+  Sm = d.Sm;
+  Sv = d.Sv;
+}
+
+}  // namespace ocs2
@@ -273,8 +273,8 @@ void extractPrimalSolution(const std::pair<scalar_t, scalar_t>& timePeriod, cons
 /******************************************************************************************************/
 scalar_t maxControllerUpdateNorm(const LinearController& controller) {
   scalar_t maxDeltaUffNorm = 0.0;
-  for (const auto& deltaBias : controller.deltaBiasArray_) {
-    maxDeltaUffNorm = std::max(maxDeltaUffNorm, deltaBias.norm());
+  for (size_t k = 0; k < controller.deltaBiasArray_.size(); k++) {
+    maxDeltaUffNorm = std::max(maxDeltaUffNorm, controller.deltaBiasArray_[k].norm());
   }
   return maxDeltaUffNorm;
 }
@@ -284,8 +284,9 @@ scalar_t maxControllerUpdateNorm(const LinearController& controller) {
 /******************************************************************************************************/
 scalar_t computeControllerUpdateIS(const LinearController& controller) {
   scalar_array_t biasArraySquaredNorm(controller.timeStamp_.size());
-  std::transform(controller.deltaBiasArray_.begin(), controller.deltaBiasArray_.end(), biasArraySquaredNorm.begin(),
-                 [](const vector_t& b) { return b.squaredNorm(); });
+  for (size_t k = 0; k < controller.deltaBiasArray_.size(); k++) {
+    biasArraySquaredNorm[k] = controller.deltaBiasArray_[k].squaredNorm();
+  }
   // integrates using the trapezoidal approximation method
   return trapezoidalIntegration(controller.timeStamp_, biasArraySquaredNorm, 0.0);
 }
@@ -297,9 +298,9 @@ void incrementController(scalar_t stepLength, const LinearController& unoptimize
   controller.clear();
   controller.timeStamp_ = unoptimizedController.timeStamp_;
   controller.gainArray_ = unoptimizedController.gainArray_;
-  controller.biasArray_.resize(unoptimizedController.size());
+  controller.biasArray_ = unoptimizedController.biasArray_;
   for (size_t k = 0; k < unoptimizedController.size(); k++) {
-    controller.biasArray_[k] = unoptimizedController.biasArray_[k] + stepLength * unoptimizedController.deltaBiasArray_[k];
+    controller.biasArray_[k] += stepLength * unoptimizedController.deltaBiasArray_[k];
   }
 }
 
@@ -69,6 +69,8 @@ Settings loadSettings(const std::string& filename, const std::string& fieldName,
 
   loadData::loadPtreeValue(pt, settings.nThreads_, fieldName + ".nThreads", verbose);
   loadData::loadPtreeValue(pt, settings.threadPriority_, fieldName + ".threadPriority", verbose);
+  loadData::loadPtreeValue(pt, settings.threadSpinDuration_, fieldName + ".threadSpinDuration", verbose);
+  loadData::loadStdVector(filename, fieldName + ".threadCpuAffinity", settings.threadCpuAffinity_, verbose);
 
   loadData::loadPtreeValue(pt, settings.maxNumIterations_, fieldName + ".maxNumIterations", verbose);
   loadData::loadPtreeValue(pt, settings.minRelCost_, fieldName + ".minRelCost", verbose);
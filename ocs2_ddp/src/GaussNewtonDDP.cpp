@@ -35,6 +35,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/control/FeedforwardController.h>
 #include <ocs2_core/integration/TrapezoidalIntegration.h>
 #include <ocs2_core/misc/LinearAlgebra.h>
+#include <ocs2_core/misc/Trace.h>
 
 #include <ocs2_oc/oc_problem/OptimalControlProblemHelperFunction.h>
 #include <ocs2_oc/rollout/InitializerRollout.h>
@@ -53,7 +54,9 @@ namespace ocs2 {
 /******************************************************************************************************/
 GaussNewtonDDP::GaussNewtonDDP(ddp::Settings ddpSettings, const RolloutBase& rollout, const OptimalControlProblem& optimalControlProblem,
                                const Initializer& initializer)
-    : ddpSettings_(std::move(ddpSettings)), threadPool_(std::max(ddpSettings_.nThreads_, size_t(1)) - 1, ddpSettings_.threadPriority_) {
+    : ddpSettings_(std::move(ddpSettings)),
+      threadPool_(std::max(ddpSettings_.nThreads_, size_t(1)) - 1, ddpSettings_.threadPriority_,
+                  ThreadPool::Settings{ddpSettings_.threadSpinDuration_, ddpSettings_.threadCpuAffinity_}) {
   Eigen::setNbThreads(1);  // no multithreading within Eigen.
   Eigen::initParallel();
 
@@ -166,6 +169,18 @@ std::string GaussNewtonDDP::getBenchmarkingInfo() const {
   return infoStream.str();
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::map<std::string, scalar_t> GaussNewtonDDP::getBenchmarkingTimes() const {
+  return {{"initialization", initializationTimer_.getTotalInMilliseconds()},
+          {"lqApproximation", linearQuadraticApproximationTimer_.getTotalInMilliseconds()},
+          {"backwardPass", backwardPassTimer_.getTotalInMilliseconds()},
+          {"computeController", computeControllerTimer_.getTotalInMilliseconds()},
+          {"searchStrategy", searchStrategyTimer_.getTotalInMilliseconds()},
+          {"dualSolution", totalDualSolutionTimer_.getTotalInMilliseconds()}};
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -514,6 +529,7 @@ scalar_t GaussNewtonDDP::calculateRolloutMerit(const PerformanceIndex& performan
 /******************************************************************************************************/
 /******************************************************************************************************/
 scalar_t GaussNewtonDDP::solveSequentialRiccatiEquationsImpl(const ScalarFunctionQuadraticApproximation& finalValueFunction) {
+  OCS2_TRACE_SCOPE("GaussNewtonDDP::solveRiccatiEquations");
   // pre-allocate memory for dual solution
   const size_t outputN = nominalPrimalData_.primalSolution.timeTrajectory_.size();
   nominalDualData_.valueFunctionTrajectory.clear();
@@ -545,6 +561,7 @@ scalar_t GaussNewtonDDP::solveSequentialRiccatiEquationsImpl(const ScalarFunctio
 
     nextTaskId_ = 0;
     auto task = [this, &partitionIntervals, &finalValueFunctionOfEachPartition]() {
+      OCS2_TRACE_SCOPE("GaussNewtonDDP::riccatiEquationsWorker");
       const size_t taskId = nextTaskId_++;  // assign task ID (atomic)
       riccatiEquationsWorker(taskId, partitionIntervals[taskId], finalValueFunctionOfEachPartition[taskId]);
     };
@@ -586,13 +603,30 @@ scalar_t GaussNewtonDDP::solveSequentialRiccatiEquationsImpl(const ScalarFunctio
 /******************************************************************************************************/
 /******************************************************************************************************/
 void GaussNewtonDDP::calculateController() {
+  OCS2_TRACE_SCOPE("GaussNewtonDDP::calculateController");
   const size_t N = nominalPrimalData_.primalSolution.timeTrajectory_.size();
 
   unoptimizedController_.clear();
   unoptimizedController_.timeStamp_ = nominalPrimalData_.primalSolution.timeTrajectory_;
-  unoptimizedController_.gainArray_.resize(N);
-  unoptimizedController_.biasArray_.resize(N);
-  unoptimizedController_.deltaBiasArray_.resize(N);
+  // the nodes are written in parallel by the workers, hence they are sized beforehand. The dimensions may change along the trajectory,
+  // hence the stride fits the largest node and each node takes the size of its own state and input.
+  const auto& primalSolution = nominalPrimalData_.primalSolution;
+  Eigen::Index maxStateDim = 0;
+  Eigen::Index maxInputDim = 0;
+  for (size_t k = 0; k < N; k++) {
+    maxStateDim = std::max(maxStateDim, primalSolution.stateTrajectory_[k].size());
+    maxInputDim = std::max(maxInputDim, primalSolution.inputTrajectory_[k].size());
+  }
+  unoptimizedController_.gainArray_.resize(N, maxInputDim, maxStateDim);
+  unoptimizedController_.biasArray_.resize(N, maxInputDim);
+  unoptimizedController_.deltaBiasArray_.resize(N, maxInputDim);
+  for (size_t k = 0; k < N; k++) {
+    const auto stateDim = primalSolution.stateTrajectory_[k].size();
+    const auto inputDim = primalSolution.inputTrajectory_[k].size();
+    unoptimizedController_.gainArray_.resizeNode(k, inputDim, stateDim);
+    unoptimizedController_.biasArray_.resizeNode(k, inputDim);
+    unoptimizedController_.deltaBiasArray_.resizeNode(k, inputDim);
+  }
 
   nextTimeIndex_ = 0;
   auto task = [this, N] {
@@ -645,6 +679,7 @@ void GaussNewtonDDP::calculateController() {
 /******************************************************************************************************/
 /******************************************************************************************************/
 void GaussNewtonDDP::approximateOptimalControlProblem() {
+  OCS2_TRACE_SCOPE("GaussNewtonDDP::approximateOptimalControlProblem");
   /*
    * compute and augment the LQ approximation of intermediate times
    */
@@ -901,6 +936,7 @@ void GaussNewtonDDP::initializeDualSolutionAndMetrics() {
 /******************************************************************************************************/
 /******************************************************************************************************/
 void GaussNewtonDDP::takePrimalDualStep(scalar_t lqModelExpectedCost) {
+  OCS2_TRACE_SCOPE("GaussNewtonDDP::searchStrategy");
   // update primal: run search strategy and find the optimal stepLength
   searchStrategyTimer_.startTimer();
   scalar_t avgTimeStep;
@@ -978,6 +1014,7 @@ void GaussNewtonDDP::runImpl(scalar_t initTime, const vector_t& initState, scala
 /******************************************************************************************************/
 /******************************************************************************************************/
 void GaussNewtonDDP::runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime) {
+  OCS2_TRACE_SCOPE("GaussNewtonDDP::run");
   if (ddpSettings_.displayInfo_) {
     std::cerr << "\n++++++++++++++++++++++++++++++++++++++++++++++++++++++";
     std::cerr << "\n+++++++++++++ " + ddp::toAlgorithmName(ddpSettings_.algorithm_) + " solver is initialized ++++++++++++++";
@@ -1024,10 +1061,12 @@ void GaussNewtonDDP::runImpl(scalar_t initTime, const vector_t& initState, scala
 
   // convergence variables of the main loop
   bool isConverged = false;
+  bool isTimeBudgetExhausted = false;
   std::string convergenceInfo;
 
   // DDP main loop
   while (true) {
+    OCS2_TRACE_SCOPE("GaussNewtonDDP::iteration");
     if (ddpSettings_.displayInfo_) {
       std::cerr << "\n###################";
       std::cerr << "\n#### Iteration " << (totalNumIterations_ - initIteration);
@@ -1069,7 +1108,15 @@ void GaussNewtonDDP::runImpl(scalar_t initTime, const vector_t& initState, scala
         !initialSolutionExists, *std::prev(performanceIndexHistory_.end(), 2), performanceIndexHistory_.back());
     initialSolutionExists = true;
 
-    if (isConverged || (totalNumIterations_ - initIteration) == ddpSettings_.maxNumIterations_) {
+    // stop early if another iteration is not expected to fit in the time budget. The latest optimized solution is returned in that case.
+    const bool isMaxNumIterations = (totalNumIterations_ - initIteration) == ddpSettings_.maxNumIterations_;
+    const scalar_t expectedIterationTime =
+        linearQuadraticApproximationTimer_.getLastIntervalInMilliseconds() + backwardPassTimer_.getLastIntervalInMilliseconds() +
+        computeControllerTimer_.getLastIntervalInMilliseconds() + searchStrategyTimer_.getLastIntervalInMilliseconds() +
+        totalDualSolutionTimer_.getLastIntervalInMilliseconds();
+    isTimeBudgetExhausted = !isConverged && !isMaxNumIterations && exceedsTimeBudget(expectedIterationTime);
+
+    if (isConverged || isMaxNumIterations || isTimeBudgetExhausted) {
       break;
 
     } else {
@@ -1085,6 +1132,10 @@ void GaussNewtonDDP::runImpl(scalar_t initTime, const vector_t& initState, scala
     }
   }  // end of while loop
 
+  // time budget report
+  performanceIndex_.earlyExit = isTimeBudgetExhausted;
+  performanceIndex_.deadlineMissed = exceedsTimeBudget(0.0);
+
   // display
   if (ddpSettings_.displayInfo_ || ddpSettings_.displayShortSummary_) {
     std::cerr << "\n++++++++++++++++++++++++++++++++++++++++++++++++++++++";
@@ -1100,6 +1151,9 @@ void GaussNewtonDDP::runImpl(scalar_t initTime, const vector_t& initState, scala
     } else if (totalNumIterations_ - initIteration == ddpSettings_.maxNumIterations_) {
       std::cerr << "The algorithm has terminated as: \n";
       std::cerr << "    * The maximum number of iterations (i.e., " << ddpSettings_.maxNumIterations_ << ") has reached." << std::endl;
+    } else if (isTimeBudgetExhausted) {
+      std::cerr << "The algorithm has terminated as: \n";
+      std::cerr << "    * The time budget (i.e., " << getTimeBudget() << " [s]) does not allow for another iteration." << std::endl;
     } else {
       std::cerr << "The algorithm has terminated for an unknown reason!" << std::endl;
     }
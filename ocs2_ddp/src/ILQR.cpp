@@ -28,6 +28,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
 #include "ocs2_ddp/ILQR.h"
+
+#include <ocs2_core/misc/Trace.h>
 #include <ocs2_ddp/riccati_equations/RiccatiTransversalityConditions.h>
 
 namespace ocs2 {
@@ -64,15 +66,27 @@ ILQR::ILQR(ddp::Settings ddpSettings, const RolloutBase& rollout, const OptimalC
   riccatiEquationsPtrStock_.clear();
   riccatiEquationsPtrStock_.reserve(settings().nThreads_);
   for (size_t i = 0; i < settings().nThreads_; i++) {
-    const bool isRiskSensitive = !numerics::almost_eq(settings().riskSensitiveCoeff_, 0.0);
-    const bool preComputeRiccatiTerms = settings().preComputeRiccatiTerms_ && (settings().strategy_ == search_strategy::Type::LINE_SEARCH);
-    riccatiEquationsPtrStock_.emplace_back(new DiscreteTimeRiccatiEquations(preComputeRiccatiTerms, isRiskSensitive));
+    riccatiEquationsPtrStock_.emplace_back(new DiscreteTimeRiccatiEquations(isReducedFormRiccati(), isRiskSensitive()));
     riccatiEquationsPtrStock_.back()->setRiskSensitiveCoefficient(settings().riskSensitiveCoeff_);
   }  // end of i loop
 
   Eigen::initParallel();
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool ILQR::isReducedFormRiccati() const {
+  return settings().preComputeRiccatiTerms_ && (settings().strategy_ == search_strategy::Type::LINE_SEARCH);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool ILQR::isRiskSensitive() const {
+  return !numerics::almost_eq(settings().riskSensitiveCoeff_, 0.0);
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -98,6 +112,7 @@ void ILQR::approximateIntermediateLQ(const DualSolution& dualSolution, PrimalDat
     // get next time index is atomic
     size_t timeIndex;
     while ((timeIndex = nextTimeIndex_++) < timeTrajectory.size()) {
+      OCS2_TRACE_SCOPE("ILQR::approximateNode");
       // approximate continuous LQ for the given time index
       ocs2::approximateIntermediateLQ(optimalControlProblemStock_[taskId], timeTrajectory[timeIndex], stateTrajectory[timeIndex],
                                       inputTrajectory[timeIndex], multiplierTrajectory[timeIndex], continuousTimeModelData);
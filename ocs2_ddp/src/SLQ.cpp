@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_ddp/SLQ.h"
 
+#include <ocs2_core/misc/Trace.h>
+
 #include "ocs2_ddp/DDP_HelperFunctions.h"
 #include "ocs2_ddp/riccati_equations/RiccatiModificationInterpolation.h"
 
@@ -95,6 +97,7 @@ void SLQ::approximateIntermediateLQ(const DualSolution& dualSolution, PrimalData
     // get next time index is atomic
     size_t timeIndex;
     while ((timeIndex = nextTimeIndex_++) < timeTrajectory.size()) {
+      OCS2_TRACE_SCOPE("SLQ::approximateNode");
       // approximate LQ for the given time index
       ocs2::approximateIntermediateLQ(optimalControlProblemStock_[taskId], timeTrajectory[timeIndex], stateTrajectory[timeIndex],
                                       inputTrajectory[timeIndex], multiplierTrajectory[timeIndex], modelDataTrajectory[timeIndex]);
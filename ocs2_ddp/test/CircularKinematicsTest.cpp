@@ -210,6 +210,35 @@ TEST_P(CircularKinematicsTest, ILQR) {
   performanceIndexTest(ddpSettings, performanceIndex);
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST_P(CircularKinematicsTest, SLQ_timeBudget) {
+  const auto algorithm = ocs2::ddp::Algorithm::SLQ;
+
+  // ddp settings
+  const auto ddpSettings = getSettings(algorithm, getNumThreads(), getSearchStrategy());
+
+  // dynamics and rollout
+  const ocs2::CircularKinematicsSystem systemDynamics;
+  const ocs2::TimeTriggeredRollout rollout(systemDynamics, rolloutSettings(algorithm));
+
+  // instantiate with a time budget that is exhausted after the first iteration
+  ocs2::SLQ ddp(ddpSettings, rollout, problem, *initializerPtr);
+  ddp.setTimeBudget(1e-9);
+
+  // run ddp: the initial rollout and a single iteration
+  ddp.run(startTime, initState, finalTime);
+  EXPECT_EQ(ddp.getIterationsLog().size(), 2);
+  EXPECT_TRUE(ddp.getPerformanceIndeces().earlyExit);
+  EXPECT_TRUE(ddp.getPerformanceIndeces().deadlineMissed);
+
+  // the solution is the latest optimized one
+  const auto primalSolution = ddp.primalSolution(finalTime);
+  EXPECT_TRUE(primalSolution.stateTrajectory_.front().isApprox(initState));
+  EXPECT_DOUBLE_EQ(primalSolution.timeTrajectory_.back(), finalTime);
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -294,6 +294,42 @@ TEST_F(Exp0, ddp_hamiltonian) {
   EXPECT_FALSE(dHdu3.isZero(precision)) << "MESSAGE for test 3: Derivative of Hamiltonian w.r.t. to u is zero: " << dHdu3.transpose();
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+TEST_F(Exp0, ilqr_fixed_size_riccati) {
+  // ddp settings
+  constexpr size_t numThreads = 2;
+  const auto ddpSettings = getSettings(ocs2::ddp::Algorithm::ILQR, numThreads, ocs2::search_strategy::Type::LINE_SEARCH);
+
+  // dynamics and rollout
+  ocs2::EXP0_System systemDynamics(referenceManagerPtr);
+  ocs2::TimeTriggeredRollout rollout(systemDynamics, rolloutSettings());
+
+  // instantiate ILQR with the dynamic-size and the fixed-size Riccati equations
+  ocs2::ILQR dynamicSizeDdp(ddpSettings, rollout, problem, *initializerPtr);
+  dynamicSizeDdp.setReferenceManager(referenceManagerPtr);
+  ocs2::ILQR fixedSizeDdp(ddpSettings, rollout, problem, *initializerPtr);
+  fixedSizeDdp.setReferenceManager(referenceManagerPtr);
+  fixedSizeDdp.useFixedSizeRiccatiEquations<STATE_DIM, INPUT_DIM>();
+
+  // run ddp
+  dynamicSizeDdp.run(startTime, initState, finalTime);
+  fixedSizeDdp.run(startTime, initState, finalTime);
+
+  // both take the same iterations to the same solution
+  constexpr ocs2::scalar_t tol = 1e-9;
+  EXPECT_EQ(fixedSizeDdp.getIterationsLog().size(), dynamicSizeDdp.getIterationsLog().size());
+  EXPECT_NEAR(fixedSizeDdp.getPerformanceIndeces().cost, dynamicSizeDdp.getPerformanceIndeces().cost, tol);
+  const auto dynamicSizeSolution = dynamicSizeDdp.primalSolution(finalTime);
+  const auto fixedSizeSolution = fixedSizeDdp.primalSolution(finalTime);
+  ASSERT_EQ(fixedSizeSolution.timeTrajectory_.size(), dynamicSizeSolution.timeTrajectory_.size());
+  for (size_t i = 0; i < fixedSizeSolution.timeTrajectory_.size(); i++) {
+    EXPECT_TRUE(fixedSizeSolution.stateTrajectory_[i].isApprox(dynamicSizeSolution.stateTrajectory_[i], tol)) << "i = " << i;
+    EXPECT_TRUE(fixedSizeSolution.inputTrajectory_[i].isApprox(dynamicSizeSolution.inputTrajectory_[i], tol)) << "i = " << i;
+  }
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
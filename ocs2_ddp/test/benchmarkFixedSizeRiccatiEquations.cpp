@@ -0,0 +1,111 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <chrono>
+#include <iostream>
+
+#include <ocs2_core/misc/LinearAlgebra.h>
+#include <ocs2_core/misc/randomMatrices.h>
+#include <ocs2_ddp/riccati_equations/FixedSizeDiscreteTimeRiccatiEquations.h>
+
+using namespace ocs2;
+
+namespace {
+
+struct RiccatiData {
+  ModelData projectedModelData;
+  riccati_modification::Data riccatiModification;
+  ScalarFunctionQuadraticApproximation valueFunctionNext;
+};
+
+RiccatiData getRandomRiccatiData(int stateDim, int inputDim) {
+  RiccatiData data;
+  auto& projectedModelData = data.projectedModelData;
+  projectedModelData.stateDim = stateDim;
+  projectedModelData.inputDim = inputDim;
+  projectedModelData.dynamicsBias = vector_t::Random(stateDim);
+  projectedModelData.dynamics.dfdx = matrix_t::Random(stateDim, stateDim);
+  projectedModelData.dynamics.dfdu = matrix_t::Random(stateDim, inputDim);
+  projectedModelData.cost.f = vector_t::Random(1)(0);
+  projectedModelData.cost.dfdx = vector_t::Random(stateDim);
+  projectedModelData.cost.dfdxx = LinearAlgebra::generateSPDmatrix<matrix_t>(stateDim);
+  projectedModelData.cost.dfdu = vector_t::Random(inputDim);
+  projectedModelData.cost.dfduu.setIdentity(inputDim, inputDim);
+  projectedModelData.cost.dfdux = matrix_t::Random(inputDim, stateDim);
+
+  data.riccatiModification.deltaQm_ = 0.1 * LinearAlgebra::generateSPDmatrix<matrix_t>(stateDim);
+  data.riccatiModification.deltaGm_ = matrix_t::Zero(inputDim, stateDim);
+  data.riccatiModification.deltaGv_ = vector_t::Zero(inputDim);
+
+  data.valueFunctionNext.dfdxx = LinearAlgebra::generateSPDmatrix<matrix_t>(stateDim);
+  data.valueFunctionNext.dfdx = vector_t::Random(stateDim);
+  data.valueFunctionNext.f = 0.5;
+  return data;
+}
+
+/** Returns the average time in microseconds of one Riccati step. */
+scalar_t timeComputeMap(DiscreteTimeRiccatiEquations& riccatiEquations, const RiccatiData& data, int numRepetitions) {
+  matrix_t Km;
+  vector_t Lv;
+  ScalarFunctionQuadraticApproximation valueFunction;
+  const auto computeMap = [&]() {
+    riccatiEquations.computeMap(data.projectedModelData, data.riccatiModification, data.valueFunctionNext.dfdxx,
+                                data.valueFunctionNext.dfdx, data.valueFunctionNext.f, Km, Lv, valueFunction.dfdxx,
+                                valueFunction.dfdx, valueFunction.f);
+  };
+  computeMap();  // warm up and allocate the outputs
+
+  const auto start = std::chrono::steady_clock::now();
+  for (int i = 0; i < numRepetitions; i++) {
+    computeMap();
+  }
+  const std::chrono::duration<scalar_t, std::micro> duration = std::chrono::steady_clock::now() - start;
+  return duration.count() / numRepetitions;
+}
+
+template <int STATE_DIM, int INPUT_DIM>
+void benchmark(const std::string& name) {
+  constexpr int numRepetitions = 20000;
+  const auto data = getRandomRiccatiData(STATE_DIM, INPUT_DIM);
+  DiscreteTimeRiccatiEquations dynamicSizeRiccati(false);
+  FixedSizeDiscreteTimeRiccatiEquations<STATE_DIM, INPUT_DIM> fixedSizeRiccati(false);
+  const auto dynamicSizeTime = timeComputeMap(dynamicSizeRiccati, data, numRepetitions);
+  const auto fixedSizeTime = timeComputeMap(fixedSizeRiccati, data, numRepetitions);
+  std::cerr << name << " (" << STATE_DIM << "x" << INPUT_DIM << "): dynamic-size " << dynamicSizeTime << " [us], fixed-size "
+            << fixedSizeTime << " [us]\n";
+}
+
+}  // unnamed namespace
+
+int main() {
+  benchmark<4, 1>("cartpole");
+  benchmark<10, 3>("ballbot");
+  benchmark<12, 4>("quadrotor");
+  return 0;
+}
@@ -46,6 +46,7 @@ struct Settings {
   // Linesearch - step size rules
   scalar_t alpha_decay = 0.5;  // multiply the step size by this factor every time a linesearch step is rejected.
   scalar_t alpha_min = 1e-4;   // terminate linesearch if the attempted step size is below this threshold
+  size_t linesearchBatchSize = 1;  // number of step sizes of the backtracking sequence that are evaluated concurrently.
 
   // Linesearch - step acceptance criteria with c = costs, g = the norm of constraint violation, and w = [x; u]
   scalar_t g_max = 1e6;          // (1): IF g{i+1} > g_max REQUIRE g{i+1} < (1-gamma_c) * g{i}
@@ -62,8 +63,13 @@ struct Settings {
   // QP subproblem solver settings
   hpipm_interface::Settings hpipmSettings = hpipm_interface::Settings();
 
+  // Solve the QP subproblem with a parallel-in-time Riccati recursion on the solver threads instead of HPIPM.
+  bool useParallelRiccati = false;
+
   // Discretization method
-  scalar_t dt = 0.01;  // user-defined time discretization
+  scalar_t dt = 0.01;             // user-defined time discretization, the step at the start of the horizon and after events
+  scalar_t dtGrowthFactor = 1.0;  // ratio between consecutive steps (>= 1). Use 1.0 for a uniform discretization
+  scalar_t dtMax = 0.1;           // the steps do not grow beyond this value
   SensitivityIntegratorType integratorType = SensitivityIntegratorType::RK2;
 
   // Barrier strategy of the primal-dual interior point method. Conventions follows Ipopt.
@@ -95,6 +101,8 @@ struct Settings {
   // Threading
   size_t nThreads = 4;
   int threadPriority = 50;
+  int threadSpinDuration = 0;          // Time [us] for which idle workers poll for new work before sleeping, see ThreadPool::Settings
+  std::vector<int> threadCpuAffinity;  // CPUs to pin the workers to, empty to not pin them
 };
 
 /**
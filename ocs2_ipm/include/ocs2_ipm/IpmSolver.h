@@ -34,6 +34,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/misc/Benchmark.h>
 #include <ocs2_core/thread_support/ThreadPool.h>
 
+#include <ocs2_oc/multiple_shooting/ParallelRiccatiSolver.h>
 #include <ocs2_oc/multiple_shooting/ProjectionMultiplierCoefficients.h>
 #include <ocs2_oc/multiple_shooting/Transcription.h>
 #include <ocs2_oc/oc_data/TimeDiscretization.h>
@@ -89,6 +90,8 @@ class IpmSolver : public SolverBase {
 
   MultiplierCollection getIntermediateDualSolution(scalar_t time) const override;
 
+  std::map<std::string, scalar_t> getBenchmarkingTimes() const override;
+
  private:
   void runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime) override;
 
@@ -136,10 +139,15 @@ class IpmSolver : public SolverBase {
                                             const vector_array_t& slackStateInputIneq, const vector_array_t& dualStateIneq,
                                             const vector_array_t& dualStateInputIneq, std::vector<Metrics>& metrics);
 
-  /** Computes only the performance metrics at the current {t, x(t), u(t)} */
-  PerformanceIndex computePerformance(const std::vector<AnnotatedTime>& time, const vector_t& initState, const vector_array_t& x,
-                                      const vector_array_t& u, scalar_t barrierParam, const vector_array_t& slackStateIneq,
-                                      const vector_array_t& slackStateInputIneq, std::vector<Metrics>& metrics);
+  /**
+   * Computes only the performance metrics for a batch of trajectories {t, x_k(t), u_k(t)}. The nodes of all trajectories are evaluated
+   * concurrently by the workers. Returns the performance index of each trajectory.
+   */
+  std::vector<PerformanceIndex> computePerformance(const std::vector<AnnotatedTime>& time, const vector_t& initState,
+                                                   const std::vector<vector_array_t>& x, const std::vector<vector_array_t>& u,
+                                                   scalar_t barrierParam, const std::vector<vector_array_t>& slackStateIneq,
+                                                   const std::vector<vector_array_t>& slackStateInputIneq,
+                                                   std::vector<std::vector<Metrics>>& metrics);
 
   /** Returns solution of the QP subproblem in delta coordinates: */
   struct OcpSubproblemSolution {
@@ -194,6 +202,7 @@ class IpmSolver : public SolverBase {
 
   // Solver interface
   HpipmInterface hpipmInterface_;
+  ParallelRiccatiSolver parallelRiccatiSolver_;
 
   // Threading
   ThreadPool threadPool_;
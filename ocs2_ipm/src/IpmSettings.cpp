@@ -54,12 +54,15 @@ Settings loadSettings(const std::string& filename, const std::string& fieldName,
   loadData::loadPtreeValue(pt, settings.deltaTol, fieldName + ".deltaTol", verbose);
   loadData::loadPtreeValue(pt, settings.alpha_decay, fieldName + ".alpha_decay", verbose);
   loadData::loadPtreeValue(pt, settings.alpha_min, fieldName + ".alpha_min", verbose);
+  loadData::loadPtreeValue(pt, settings.linesearchBatchSize, fieldName + ".linesearchBatchSize", verbose);
   loadData::loadPtreeValue(pt, settings.gamma_c, fieldName + ".gamma_c", verbose);
   loadData::loadPtreeValue(pt, settings.g_max, fieldName + ".g_max", verbose);
   loadData::loadPtreeValue(pt, settings.g_min, fieldName + ".g_min", verbose);
   loadData::loadPtreeValue(pt, settings.armijoFactor, fieldName + ".armijoFactor", verbose);
   loadData::loadPtreeValue(pt, settings.costTol, fieldName + ".costTol", verbose);
   loadData::loadPtreeValue(pt, settings.dt, fieldName + ".dt", verbose);
+  loadData::loadPtreeValue(pt, settings.dtGrowthFactor, fieldName + ".dtGrowthFactor", verbose);
+  loadData::loadPtreeValue(pt, settings.dtMax, fieldName + ".dtMax", verbose);
   loadData::loadPtreeValue(pt, settings.useFeedbackPolicy, fieldName + ".useFeedbackPolicy", verbose);
   loadData::loadPtreeValue(pt, settings.createValueFunction, fieldName + ".createValueFunction", verbose);
   loadData::loadPtreeValue(pt, settings.computeLagrangeMultipliers, fieldName + ".computeLagrangeMultipliers", verbose);
@@ -78,11 +81,21 @@ Settings loadSettings(const std::string& filename, const std::string& fieldName,
   loadData::loadPtreeValue(pt, settings.initialDualLowerBound, fieldName + ".initialDualLowerBound", verbose);
   loadData::loadPtreeValue(pt, settings.initialSlackMarginRate, fieldName + ".initialSlackMarginRate", verbose);
   loadData::loadPtreeValue(pt, settings.initialDualMarginRate, fieldName + ".initialDualMarginRate", verbose);
+  loadData::loadPtreeValue(pt, settings.useParallelRiccati, fieldName + ".useParallelRiccati", verbose);
   loadData::loadPtreeValue(pt, settings.printSolverStatus, fieldName + ".printSolverStatus", verbose);
   loadData::loadPtreeValue(pt, settings.printSolverStatistics, fieldName + ".printSolverStatistics", verbose);
   loadData::loadPtreeValue(pt, settings.printLinesearch, fieldName + ".printLinesearch", verbose);
   loadData::loadPtreeValue(pt, settings.nThreads, fieldName + ".nThreads", verbose);
   loadData::loadPtreeValue(pt, settings.threadPriority, fieldName + ".threadPriority", verbose);
+  loadData::loadPtreeValue(pt, settings.threadSpinDuration, fieldName + ".threadSpinDuration", verbose);
+  loadData::loadStdVector(filename, fieldName + ".threadCpuAffinity", settings.threadCpuAffinity, verbose);
+
+  if (settings.dtGrowthFactor < 1.0) {
+    throw std::invalid_argument("[MultipleShootingIpmSettings] dtGrowthFactor must be at least 1.0!");
+  }
+  if (settings.dtMax < settings.dt) {
+    throw std::invalid_argument("[MultipleShootingIpmSettings] dtMax must be at least dt!");
+  }
 
   if (settings.initialSlackLowerBound <= 0.0) {
     throw std::runtime_error("[MultipleShootingIpmSettings] initialSlackLowerBound must be positive!");
@@ -33,6 +33,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <iostream>
 #include <numeric>
 
+#include <ocs2_core/misc/Trace.h>
 #include <ocs2_oc/approximate_model/LinearQuadraticApproximator.h>
 #include <ocs2_oc/multiple_shooting/Helpers.h>
 #include <ocs2_oc/multiple_shooting/Initialization.h>
@@ -66,7 +67,8 @@ ipm::Settings rectifySettings(const OptimalControlProblem& ocp, ipm::Settings&&
 IpmSolver::IpmSolver(ipm::Settings settings, const OptimalControlProblem& optimalControlProblem, const Initializer& initializer)
     : settings_(rectifySettings(optimalControlProblem, std::move(settings))),
       hpipmInterface_(OcpSize(), settings_.hpipmSettings),
-      threadPool_(std::max(settings_.nThreads, size_t(1)) - 1, settings_.threadPriority) {
+      threadPool_(std::max(settings_.nThreads, size_t(1)) - 1, settings_.threadPriority,
+                  ThreadPool::Settings{settings_.threadSpinDuration, settings_.threadCpuAffinity}) {
   Eigen::setNbThreads(1);  // No multithreading within Eigen.
   Eigen::initParallel();
 
@@ -144,6 +146,14 @@ std::string IpmSolver::getBenchmarkingInformation() const {
   return infoStream.str();
 }
 
+std::map<std::string, scalar_t> IpmSolver::getBenchmarkingTimes() const {
+  return {{"initialization", initializationTimer_.getTotalInMilliseconds()},
+          {"lqApproximation", linearQuadraticApproximationTimer_.getTotalInMilliseconds()},
+          {"solveQp", solveQpTimer_.getTotalInMilliseconds()},
+          {"linesearch", linesearchTimer_.getTotalInMilliseconds()},
+          {"computeController", computeControllerTimer_.getTotalInMilliseconds()}};
+}
+
 const std::vector<PerformanceIndex>& IpmSolver::getIterationsLog() const {
   if (performanceIndeces_.empty()) {
     throw std::runtime_error("[IpmSolver]: No performance log yet, no problem solved yet?");
@@ -201,6 +211,7 @@ MultiplierCollection IpmSolver::getIntermediateDualSolution(scalar_t time) const
 }
 
 void IpmSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime) {
+  OCS2_TRACE_SCOPE("IpmSolver::run");
   if (settings_.printSolverStatus || settings_.printLinesearch) {
     std::cerr << "\n++++++++++++++++++++++++++++++++++++++++++++++++++++++";
     std::cerr << "\n+++++++++++++ IPM solver is initialized ++++++++++++++";
@@ -209,7 +220,8 @@ void IpmSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
 
   // Determine time discretization, taking into account event times.
   const auto& eventTimes = this->getReferenceManager().getModeSchedule().eventTimes;
-  const auto timeDiscretization = timeDiscretizationWithEvents(initTime, finalTime, settings_.dt, eventTimes);
+  const auto timeDiscretization =
+      timeDiscretizationWithEvents(initTime, finalTime, settings_.dt, settings_.dtGrowthFactor, settings_.dtMax, eventTimes);
 
   // Initialize references
   for (auto& ocpDefinition : ocpDefinitions_) {
@@ -254,6 +266,7 @@ void IpmSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
   int iter = 0;
   ipm::Convergence convergence = ipm::Convergence::FALSE;
   while (convergence == ipm::Convergence::FALSE) {
+    OCS2_TRACE_SCOPE("IpmSolver::iteration");
     if (settings_.printSolverStatus || settings_.printLinesearch) {
       std::cerr << "\nIPM iteration: " << iter << " (barrier parameter: " << barrierParam << ")\n";
     }
@@ -286,6 +299,15 @@ void IpmSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
     // Check convergence
     convergence = checkConvergence(iter, barrierParam, baselinePerformance, stepInfo);
 
+    // Stop early if another iteration and the controller computation are not expected to fit in the time budget. The last accepted
+    // iterate is returned in that case.
+    const scalar_t expectedIterationTime =
+        linearQuadraticApproximationTimer_.getLastIntervalInMilliseconds() + solveQpTimer_.getLastIntervalInMilliseconds() +
+        linesearchTimer_.getLastIntervalInMilliseconds() + computeControllerTimer_.getLastIntervalInMilliseconds();
+    if (convergence == ipm::Convergence::FALSE && exceedsTimeBudget(expectedIterationTime)) {
+      convergence = ipm::Convergence::TIMEBUDGET;
+    }
+
     // Update the barrier parameter
     barrierParam = updateBarrierParameter(barrierParam, baselinePerformance, stepInfo);
 
@@ -303,6 +325,10 @@ void IpmSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
   problemMetrics_ = multiple_shooting::toProblemMetrics(timeDiscretization, std::move(metrics));
   computeControllerTimer_.endTimer();
 
+  // Time budget report
+  performanceIndeces_.back().earlyExit = (convergence == ipm::Convergence::TIMEBUDGET);
+  performanceIndeces_.back().deadlineMissed = exceedsTimeBudget(0.0);
+
   if (settings_.printSolverStatus || settings_.printLinesearch) {
     std::cerr << "\nConvergence : " << toString(convergence) << "\n";
     std::cerr << "\n++++++++++++++++++++++++++++++++++++++++++++++++++++++";
@@ -324,9 +350,11 @@ void IpmSolver::initializeCostateTrajectory(const std::vector<AnnotatedTime>& ti
   const auto interpolateTill =
       primalSolution_.timeTrajectory_.size() < 2 ? timeDiscretization.front().time : primalSolution_.timeTrajectory_.back();
 
+  LinearInterpolation::TimeSegmentCursor cursor;
   const scalar_t initTime = getIntervalStart(timeDiscretization[0]);
   if (initTime < interpolateTill) {
-    costateTrajectory.push_back(LinearInterpolation::interpolate(initTime, primalSolution_.timeTrajectory_, costateTrajectory_));
+    costateTrajectory.push_back(
+        LinearInterpolation::interpolate(cursor.timeSegment(initTime, primalSolution_.timeTrajectory_), costateTrajectory_));
   } else {
     costateTrajectory.push_back(vector_t::Zero(stateTrajectory[0].size()));
   }
@@ -334,7 +362,8 @@ void IpmSolver::initializeCostateTrajectory(const std::vector<AnnotatedTime>& ti
   for (int i = 1; i < stateTrajectory.size(); i++) {
     const auto time = getIntervalEnd(timeDiscretization[i]);
     if (time < interpolateTill) {  // interpolate previous solution
-      costateTrajectory.push_back(LinearInterpolation::interpolate(time, primalSolution_.timeTrajectory_, costateTrajectory_));
+      costateTrajectory.push_back(
+          LinearInterpolation::interpolate(cursor.timeSegment(time, primalSolution_.timeTrajectory_), costateTrajectory_));
     } else {  // Initialize with zero
       costateTrajectory.push_back(vector_t::Zero(stateTrajectory[i].size()));
     }
@@ -353,13 +382,15 @@ void IpmSolver::initializeProjectionMultiplierTrajectory(const std::vector<Annot
       primalSolution_.timeTrajectory_.size() < 2 ? timeDiscretization.front().time : *std::prev(primalSolution_.timeTrajectory_.end(), 2);
 
   // @todo Fix this using trajectory spreading
+  LinearInterpolation::TimeSegmentCursor cursor;
   auto interpolateProjectionMultiplierTrajectory = [&](scalar_t time) -> vector_t {
     const size_t numConstraints = ocpDefinition.equalityConstraintPtr->getNumConstraints(time);
-    const size_t index = LinearInterpolation::timeSegment(time, primalSolution_.timeTrajectory_).first;
+    const auto indexAlpha = cursor.timeSegment(time, primalSolution_.timeTrajectory_);
+    const size_t index = indexAlpha.first;
     if (projectionMultiplierTrajectory_.size() > index + 1) {
       if (projectionMultiplierTrajectory_[index].size() == numConstraints &&
           projectionMultiplierTrajectory_[index].size() == projectionMultiplierTrajectory_[index + 1].size()) {
-        return LinearInterpolation::interpolate(time, primalSolution_.timeTrajectory_, projectionMultiplierTrajectory_);
+        return LinearInterpolation::interpolate(indexAlpha, projectionMultiplierTrajectory_);
       }
     }
     if (projectionMultiplierTrajectory_.size() > index) {
@@ -471,16 +502,19 @@ IpmSolver::OcpSubproblemSolution IpmSolver::getOCPSolution(const vector_t& delta
                                                            const vector_array_t& slackStateIneq, const vector_array_t& dualStateIneq,
                                                            const vector_array_t& slackStateInputIneq,
                                                            const vector_array_t& dualStateInputIneq) {
+  OCS2_TRACE_SCOPE("IpmSolver::solveQp");
   // Solve the QP
   OcpSubproblemSolution solution;
   auto& deltaXSol = solution.deltaXSol;
   auto& deltaUSol = solution.deltaUSol;
-  hpipm_status status;
-  hpipmInterface_.resize(extractSizesFromProblem(dynamics_, lagrangian_, nullptr));
-  status = hpipmInterface_.solve(delta_x0, dynamics_, lagrangian_, nullptr, deltaXSol, deltaUSol, settings_.printSolverStatus);
-
-  if (status != hpipm_status::SUCCESS) {
-    throw std::runtime_error("[IpmSolver] Failed to solve QP");
+  if (settings_.useParallelRiccati) {
+    parallelRiccatiSolver_.solve(threadPool_, delta_x0, dynamics_, lagrangian_, deltaXSol, deltaUSol);
+  } else {
+    hpipmInterface_.resize(extractSizesFromProblem(dynamics_, lagrangian_, nullptr));
+    const auto status = hpipmInterface_.solve(delta_x0, dynamics_, lagrangian_, nullptr, deltaXSol, deltaUSol, settings_.printSolverStatus);
+    if (status != hpipm_status::SUCCESS) {
+      throw std::runtime_error("[IpmSolver] Failed to solve QP");
+    }
   }
 
   // to determine if the solution is a descent direction for the cost: compute gradient(cost)' * [dx; du]
@@ -488,7 +522,8 @@ IpmSolver::OcpSubproblemSolution IpmSolver::getOCPSolution(const vector_t& delta
 
   // Extract value function
   if (settings_.createValueFunction) {
-    valueFunction_ = hpipmInterface_.getRiccatiCostToGo(dynamics_[0], lagrangian_[0]);
+    valueFunction_ = settings_.useParallelRiccati ? parallelRiccatiSolver_.getRiccatiCostToGo()
+                                                  : hpipmInterface_.getRiccatiCostToGo(dynamics_[0], lagrangian_[0]);
   }
 
   // Problem horizon
@@ -580,7 +615,8 @@ IpmSolver::OcpSubproblemSolution IpmSolver::getOCPSolution(const vector_t& delta
 void IpmSolver::extractValueFunction(const std::vector<AnnotatedTime>& time, const vector_array_t& x, const vector_array_t& lmd,
                                      const vector_array_t& deltaXSol) {
   if (settings_.createValueFunction) {
-    // Correct for linearization state. Naive value function of hpipm is already extracted and stored in valueFunction_ in getOCPSolution().
+    // Correct for linearization state. Naive value function of the QP solver is already extracted and stored in valueFunction_ in
+    // getOCPSolution().
     for (int i = 0; i < time.size(); ++i) {
       valueFunction_[i].dfdx.noalias() -= valueFunction_[i].dfdxx * x[i];
       if (settings_.computeLagrangeMultipliers) {
@@ -591,9 +627,11 @@ void IpmSolver::extractValueFunction(const std::vector<AnnotatedTime>& time, con
 }
 
 PrimalSolution IpmSolver::toPrimalSolution(const std::vector<AnnotatedTime>& time, vector_array_t&& x, vector_array_t&& u) {
+  OCS2_TRACE_SCOPE("IpmSolver::computeController");
   if (settings_.useFeedbackPolicy) {
     ModeSchedule modeSchedule = this->getReferenceManager().getModeSchedule();
-    matrix_array_t KMatrices = hpipmInterface_.getRiccatiFeedback(dynamics_[0], lagrangian_[0]);
+    matrix_array_t KMatrices = settings_.useParallelRiccati ? parallelRiccatiSolver_.getRiccatiFeedback()
+                                                            : hpipmInterface_.getRiccatiFeedback(dynamics_[0], lagrangian_[0]);
     multiple_shooting::remapProjectedGain(constraintsProjection_, KMatrices);
     return multiple_shooting::toPrimalSolution(time, std::move(modeSchedule), std::move(x), std::move(u), std::move(KMatrices));
 
@@ -608,6 +646,7 @@ PerformanceIndex IpmSolver::setupQuadraticSubproblem(const std::vector<Annotated
                                                      const vector_array_t& nu, scalar_t barrierParam, const vector_array_t& slackStateIneq,
                                                      const vector_array_t& slackStateInputIneq, const vector_array_t& dualStateIneq,
                                                      const vector_array_t& dualStateInputIneq, std::vector<Metrics>& metrics) {
+  OCS2_TRACE_SCOPE("IpmSolver::setupQuadraticSubproblem");
   // Problem horizon
   const int N = static_cast<int>(time.size()) - 1;
 
@@ -629,6 +668,7 @@ PerformanceIndex IpmSolver::setupQuadraticSubproblem(const std::vector<Annotated
 
     int i = timeIndex++;
     while (i < N) {
+      OCS2_TRACE_SCOPE("IpmSolver::approximateNode");
       if (time[i].event == AnnotatedTime::Event::PreEvent) {
         // Event node
         auto result = multiple_shooting::setupEventNode(ocpDefinition, time[i].time, x[i], x[i + 1]);
@@ -723,57 +763,76 @@ PerformanceIndex IpmSolver::setupQuadraticSubproblem(const std::vector<Annotated
   return totalPerformance;
 }
 
-PerformanceIndex IpmSolver::computePerformance(const std::vector<AnnotatedTime>& time, const vector_t& initState, const vector_array_t& x,
-                                               const vector_array_t& u, scalar_t barrierParam, const vector_array_t& slackStateIneq,
-                                               const vector_array_t& slackStateInputIneq, std::vector<Metrics>& metrics) {
+std::vector<PerformanceIndex> IpmSolver::computePerformance(const std::vector<AnnotatedTime>& time, const vector_t& initState,
+                                                            const std::vector<vector_array_t>& x, const std::vector<vector_array_t>& u,
+                                                            scalar_t barrierParam, const std::vector<vector_array_t>& slackStateIneq,
+                                                            const std::vector<vector_array_t>& slackStateInputIneq,
+                                                            std::vector<std::vector<Metrics>>& metrics) {
+  OCS2_TRACE_SCOPE("IpmSolver::computePerformance");
   // Problem horizon
   const int N = static_cast<int>(time.size()) - 1;
-  metrics.resize(N + 1);
+  const int numTrajectories = static_cast<int>(x.size());
+  metrics.resize(numTrajectories);
+  for (auto& trajectoryMetrics : metrics) {
+    trajectoryMetrics.resize(N + 1);
+  }
 
-  std::vector<PerformanceIndex> performance(settings_.nThreads, PerformanceIndex());
-  std::atomic_int timeIndex{0};
+  // performance[workerId * numTrajectories + k] accumulates the contribution of a worker to trajectory k
+  std::vector<PerformanceIndex> performance(settings_.nThreads * numTrajectories, PerformanceIndex());
+  std::atomic_int nodeIndex{0};
   auto parallelTask = [&](int workerId) {
     // Get worker specific resources
     OptimalControlProblem& ocpDefinition = ocpDefinitions_[workerId];
 
-    int i = timeIndex++;
-    while (i < N) {
-      if (time[i].event == AnnotatedTime::Event::PreEvent) {
+    int j = nodeIndex++;
+    while (j < numTrajectories * (N + 1)) {
+      const int k = j / (N + 1);
+      const int i = j % (N + 1);
+      auto& workerPerformance = performance[workerId * numTrajectories + k];
+      if (i == N) {
+        // Terminal node
+        const scalar_t tN = getIntervalStart(time[N]);
+        metrics[k][N] = multiple_shooting::computeTerminalMetrics(ocpDefinition, tN, x[k][N]);
+        workerPerformance += ipm::toPerformanceIndex(metrics[k][N], barrierParam, slackStateIneq[k][N]);
+      } else if (time[i].event == AnnotatedTime::Event::PreEvent) {
         // Event node
-        metrics[i] = multiple_shooting::computeEventMetrics(ocpDefinition, time[i].time, x[i], x[i + 1]);
-        performance[workerId] += ipm::toPerformanceIndex(metrics[i], barrierParam, slackStateIneq[i]);
+        metrics[k][i] = multiple_shooting::computeEventMetrics(ocpDefinition, time[i].time, x[k][i], x[k][i + 1]);
+        workerPerformance += ipm::toPerformanceIndex(metrics[k][i], barrierParam, slackStateIneq[k][i]);
       } else {
         // Normal, intermediate node
         const scalar_t ti = getIntervalStart(time[i]);
         const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
-        const bool enableStateInequalityConstraints = (i > 0);
-        metrics[i] = multiple_shooting::computeIntermediateMetrics(ocpDefinition, discretizer_, ti, dt, x[i], x[i + 1], u[i]);
+        metrics[k][i] = multiple_shooting::computeIntermediateMetrics(ocpDefinition, discretizer_, ti, dt, x[k][i], x[k][i + 1], u[k][i]);
         // Disable the state-only inequality constraints at the initial node
         if (i == 0) {
-          metrics[i].stateIneqConstraint.clear();
+          metrics[k][i].stateIneqConstraint.clear();
         }
-        performance[workerId] += ipm::toPerformanceIndex(metrics[i], dt, barrierParam, slackStateIneq[i], slackStateInputIneq[i]);
+        workerPerformance +=
+            ipm::toPerformanceIndex(metrics[k][i], dt, barrierParam, slackStateIneq[k][i], slackStateInputIneq[k][i]);
       }
 
-      i = timeIndex++;
-    }
-
-    if (i == N) {  // Only one worker will execute this
-      const scalar_t tN = getIntervalStart(time[N]);
-      metrics[N] = multiple_shooting::computeTerminalMetrics(ocpDefinition, tN, x[N]);
-      performance[workerId] += ipm::toPerformanceIndex(metrics[N], barrierParam, slackStateIneq[N]);
+      j = nodeIndex++;
     }
   };
   runParallel(std::move(parallelTask));
 
-  // Account for initial state in performance
-  const vector_t initDynamicsViolation = initState - x.front();
-  metrics.front().dynamicsViolation += initDynamicsViolation;
-  performance.front().dynamicsViolationSSE += initDynamicsViolation.squaredNorm();
+  std::vector<PerformanceIndex> totalPerformance(numTrajectories);
+  for (int k = 0; k < numTrajectories; ++k) {
+    auto& trajectoryPerformance = totalPerformance[k];
 
-  // Sum performance of the threads
-  PerformanceIndex totalPerformance = std::accumulate(std::next(performance.begin()), performance.end(), performance.front());
-  totalPerformance.merit = totalPerformance.cost + totalPerformance.equalityLagrangian + totalPerformance.inequalityLagrangian;
+    // Sum performance of the threads
+    for (int w = 0; w < settings_.nThreads; ++w) {
+      trajectoryPerformance += performance[w * numTrajectories + k];
+    }
+
+    // Account for initial state in performance
+    const vector_t initDynamicsViolation = initState - x[k].front();
+    metrics[k].front().dynamicsViolation += initDynamicsViolation;
+    trajectoryPerformance.dynamicsViolationSSE += initDynamicsViolation.squaredNorm();
+
+    trajectoryPerformance.merit =
+        trajectoryPerformance.cost + trajectoryPerformance.equalityLagrangian + trajectoryPerformance.inequalityLagrangian;
+  }
   return totalPerformance;
 }
 
@@ -781,6 +840,7 @@ ipm::StepInfo IpmSolver::takePrimalStep(const PerformanceIndex& baseline, const
                                         const vector_t& initState, const OcpSubproblemSolution& subproblemSolution, vector_array_t& x,
                                         vector_array_t& u, scalar_t barrierParam, vector_array_t& slackStateIneq,
                                         vector_array_t& slackStateInputIneq, std::vector<Metrics>& metrics) {
+  OCS2_TRACE_SCOPE("IpmSolver::linesearch");
   using StepType = FilterLinesearch::StepType;
 
   /*
@@ -805,66 +865,82 @@ ipm::StepInfo IpmSolver::takePrimalStep(const PerformanceIndex& baseline, const
   const auto deltaUnorm = multiple_shooting::trajectoryNorm(du);
   const auto deltaXnorm = multiple_shooting::trajectoryNorm(dx);
 
+  // Backtracking sequence alpha = maxPrimalStepSize * alpha_decay^j. The linesearch terminates when alpha drops below alpha_min or when the
+  // primal step becomes too small, which prevents going all the way to alpha_min.
+  const auto isTooSmallStep = [&](scalar_t alpha) {
+    return alpha * deltaXnorm < settings_.deltaTol && alpha * deltaUnorm < settings_.deltaTol;
+  };
+  const size_t batchSize = std::max(settings_.linesearchBatchSize, size_t(1));
+
   scalar_t alpha = subproblemSolution.maxPrimalStepSize;
-  vector_array_t xNew(x.size());
-  vector_array_t uNew(u.size());
-  vector_array_t slackStateIneqNew(slackStateIneq.size());
-  vector_array_t slackStateInputIneqNew(slackStateInputIneq.size());
-  std::vector<Metrics> metricsNew(metrics.size());
-  do {
-    // Compute step
-    multiple_shooting::incrementTrajectory(u, du, alpha, uNew);
-    multiple_shooting::incrementTrajectory(x, dx, alpha, xNew);
-    multiple_shooting::incrementTrajectory(slackStateIneq, deltaSlackStateIneq, alpha, slackStateIneqNew);
-    multiple_shooting::incrementTrajectory(slackStateInputIneq, deltaSlackStateInputIneq, alpha, slackStateInputIneqNew);
+  scalar_array_t alphas;
+  std::vector<vector_array_t> xNew, uNew, slackStateIneqNew, slackStateInputIneqNew;
+  std::vector<std::vector<Metrics>> metricsNew;
+  bool continueLinesearch = true;
+  while (continueLinesearch) {
+    // The next step sizes of the sequence are evaluated concurrently
+    alphas.clear();
+    do {
+      alphas.push_back(alpha);
+      alpha *= settings_.alpha_decay;
+      continueLinesearch = alpha >= settings_.alpha_min && !isTooSmallStep(alpha);
+    } while (continueLinesearch && alphas.size() < batchSize);
+
+    // Compute steps
+    xNew.resize(alphas.size(), vector_array_t(x.size()));
+    uNew.resize(alphas.size(), vector_array_t(u.size()));
+    slackStateIneqNew.resize(alphas.size(), vector_array_t(slackStateIneq.size()));
+    slackStateInputIneqNew.resize(alphas.size(), vector_array_t(slackStateInputIneq.size()));
+    for (int k = 0; k < alphas.size(); ++k) {
+      multiple_shooting::incrementTrajectory(u, du, alphas[k], uNew[k]);
+      multiple_shooting::incrementTrajectory(x, dx, alphas[k], xNew[k]);
+      multiple_shooting::incrementTrajectory(slackStateIneq, deltaSlackStateIneq, alphas[k], slackStateIneqNew[k]);
+      multiple_shooting::incrementTrajectory(slackStateInputIneq, deltaSlackStateInputIneq, alphas[k], slackStateInputIneqNew[k]);
+    }
 
     // Compute cost and constraints
-    const PerformanceIndex performanceNew =
+    const auto performanceNew =
         computePerformance(timeDiscretization, initState, xNew, uNew, barrierParam, slackStateIneqNew, slackStateInputIneqNew, metricsNew);
 
-    // Step acceptance and record step type
-    bool stepAccepted;
-    StepType stepType;
-    std::tie(stepAccepted, stepType) =
-        filterLinesearch_.acceptStep(baseline, performanceNew, alpha * subproblemSolution.armijoDescentMetric);
-
-    if (settings_.printLinesearch) {
-      std::cerr << "Step size: " << alpha << ", Step Type: " << toString(stepType)
-                << (stepAccepted ? std::string{" (Accepted)"} : std::string{" (Rejected)"}) << "\n";
-      std::cerr << "|dx| = " << alpha * deltaXnorm << "\t|du| = " << alpha * deltaUnorm << "\n";
-      std::cerr << performanceNew << "\n";
-    }
-
-    if (stepAccepted) {  // Return if step accepted
-      x = std::move(xNew);
-      u = std::move(uNew);
-      slackStateIneq = std::move(slackStateIneqNew);
-      slackStateInputIneq = std::move(slackStateInputIneqNew);
-      metrics = std::move(metricsNew);
-
-      // Prepare step info
-      ipm::StepInfo stepInfo;
-      stepInfo.primalStepSize = alpha;
-      stepInfo.stepType = stepType;
-      stepInfo.dx_norm = alpha * deltaXnorm;
-      stepInfo.du_norm = alpha * deltaUnorm;
-      stepInfo.performanceAfterStep = performanceNew;
-      stepInfo.totalConstraintViolationAfterStep = FilterLinesearch::totalConstraintViolation(performanceNew);
-      return stepInfo;
-
-    } else {  // Try smaller step
-      alpha *= settings_.alpha_decay;
+    // Take the largest accepted step
+    for (int k = 0; k < alphas.size(); ++k) {
+      // Step acceptance and record step type
+      bool stepAccepted;
+      StepType stepType;
+      std::tie(stepAccepted, stepType) =
+          filterLinesearch_.acceptStep(baseline, performanceNew[k], alphas[k] * subproblemSolution.armijoDescentMetric);
+
+      if (settings_.printLinesearch) {
+        std::cerr << "Step size: " << alphas[k] << ", Step Type: " << toString(stepType)
+                  << (stepAccepted ? std::string{" (Accepted)"} : std::string{" (Rejected)"}) << "\n";
+        std::cerr << "|dx| = " << alphas[k] * deltaXnorm << "\t|du| = " << alphas[k] * deltaUnorm << "\n";
+        std::cerr << performanceNew[k] << "\n";
+      }
 
-      // Detect too small step size during back-tracking to escape early. Prevents going all the way to alpha_min
-      if (alpha * deltaXnorm < settings_.deltaTol && alpha * deltaUnorm < settings_.deltaTol) {
-        if (settings_.printLinesearch) {
-          std::cerr << "Exiting linesearch early due to too small primal steps |dx|: " << alpha * deltaXnorm
-                    << ", and or |du|: " << alpha * deltaUnorm << " are below deltaTol: " << settings_.deltaTol << "\n";
-        }
-        break;
+      if (stepAccepted) {  // Return if step accepted
+        x = std::move(xNew[k]);
+        u = std::move(uNew[k]);
+        slackStateIneq = std::move(slackStateIneqNew[k]);
+        slackStateInputIneq = std::move(slackStateInputIneqNew[k]);
+        metrics = std::move(metricsNew[k]);
+
+        // Prepare step info
+        ipm::StepInfo stepInfo;
+        stepInfo.primalStepSize = alphas[k];
+        stepInfo.stepType = stepType;
+        stepInfo.dx_norm = alphas[k] * deltaXnorm;
+        stepInfo.du_norm = alphas[k] * deltaUnorm;
+        stepInfo.performanceAfterStep = performanceNew[k];
+        stepInfo.totalConstraintViolationAfterStep = FilterLinesearch::totalConstraintViolation(performanceNew[k]);
+        return stepInfo;
       }
     }
-  } while (alpha >= settings_.alpha_min);
+  }
+
+  if (settings_.printLinesearch && alpha >= settings_.alpha_min) {
+    std::cerr << "Exiting linesearch early due to too small primal steps |dx|: " << alpha * deltaXnorm
+              << ", and or |du|: " << alpha * deltaUnorm << " are below deltaTol: " << settings_.deltaTol << "\n";
+  }
 
   // Alpha_min reached -> Don't take a step
   ipm::StepInfo stepInfo;
@@ -343,4 +343,61 @@ TEST(test_circular_kinematics, solve_projected_EqConstraints_MixedIneqConstraint
   for (const auto e : shiftTime) {
     solver.run(startTime + e, initState, finalTime + e);
   }
-}
\ No newline at end of file
+}
+
+TEST(test_circular_kinematics, solve_linesearchBatch) {
+  // optimal control problem
+  OptimalControlProblem problem = createCircularKinematicsProblem("/tmp/ocs2/ipm_test_generated");
+
+  // inequality constraints
+  const scalar_t xumin = -0.5;
+  const scalar_t xumax = 0.5;
+  problem.inequalityConstraintPtr->add("xubound", std::make_unique<CircleKinematics_MixedStateInputIneqConstraints>(xumin, xumax));
+
+  // Initializer
+  DefaultInitializer zeroInitializer(2);
+
+  // Solver settings
+  const auto settings = []() {
+    ipm::Settings s;
+    s.dt = 0.01;
+    s.ipmIteration = 40;
+    s.useFeedbackPolicy = true;
+    s.printSolverStatistics = false;
+    s.printSolverStatus = false;
+    s.printLinesearch = false;
+    s.nThreads = 3;
+    s.initialBarrierParameter = 1.0e-02;
+    s.targetBarrierParameter = 1.0e-04;
+    s.barrierLinearDecreaseFactor = 0.2;
+    s.barrierSuperlinearDecreasePower = 1.5;
+    s.fractionToBoundaryMargin = 0.995;
+    return s;
+  }();
+
+  // Additional problem definitions
+  const scalar_t startTime = 0.0;
+  const scalar_t finalTime = 1.0;
+  const vector_t initState = (vector_t(2) << 1.0, 0.0).finished();  // radius 1.0
+
+  // Solve with sequential and batched linesearch
+  auto solve = [&](size_t linesearchBatchSize) {
+    auto batchSettings = settings;
+    batchSettings.linesearchBatchSize = linesearchBatchSize;
+    IpmSolver solver(batchSettings, problem, zeroInitializer);
+    solver.run(startTime, initState, finalTime);
+    return std::make_pair(solver.primalSolution(finalTime), solver.getIterationsLog());
+  };
+  const auto sequential = solve(1);
+  const auto batched = solve(4);
+
+  // The batched linesearch accepts the same steps
+  ASSERT_EQ(sequential.second.size(), batched.second.size());
+  for (int i = 0; i < sequential.second.size(); i++) {
+    ASSERT_NEAR(sequential.second[i].merit, batched.second[i].merit, 1e-9);
+  }
+  for (int i = 0; i < sequential.first.timeTrajectory_.size(); i++) {
+    ASSERT_TRUE(sequential.first.stateTrajectory_[i].isApprox(batched.first.stateTrajectory_[i]));
+    ASSERT_TRUE(sequential.first.inputTrajectory_[i].isApprox(batched.first.inputTrajectory_[i]));
+  }
+}
@@ -67,6 +67,14 @@ class MPC_BASE {
    */
   virtual bool run(scalar_t currentTime, const vector_t& currentState);
 
+  /**
+   * Prepares the next call of run() for solvers that split an iteration into a preparation and a feedback phase (real-time
+   * iteration). It should be called right after run() such that the next call only needs to perform the feedback phase.
+   *
+   * @param [in] nextTime: The expected time of the next call to run().
+   */
+  void prepare(scalar_t nextTime);
+
   /** Gets a pointer to the underlying solver used in the MPC. */
   virtual SolverBase* getSolverPtr() = 0;
 
@@ -89,6 +97,14 @@ class MPC_BASE {
    */
   virtual void calculateController(scalar_t initTime, const vector_t& initState, scalar_t finalTime) = 0;
 
+  /**
+   * Runs the preparation phase of the solver for the given time period ([initTime,finalTime]). By default, there is nothing to prepare.
+   *
+   * @param [in] initTime: The expected initial time of the next solver call.
+   * @param [in] finalTime: The expected final time of the next solver call.
+   */
+  virtual void prepareController(scalar_t initTime, scalar_t finalTime) {}
+
   /** Whether this is the first iteration of MPC or not. */
   bool isFirstMpcRun() const { return initRun_; }
 
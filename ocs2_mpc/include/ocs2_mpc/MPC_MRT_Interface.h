@@ -125,6 +125,8 @@ class MPC_MRT_Interface final : public MRT_BASE {
 
   MPC_BASE& mpc_;
   benchmark::RepeatedTimer mpcTimer_;
+  scalar_t lastMpcObservationTime_ = 0.0;
+  size_t numMpcRuns_ = 0;
 
   // MPC inputs
   SystemObservation currentObservation_;
@@ -48,6 +48,11 @@ struct Settings {
    * trajectories). Any negative number will be interpreted as the whole time horizon.
    * */
   scalar_t solutionTimeWindow_ = -1;
+  /**
+   * Wall-clock time budget (in seconds) of a single MPC solve. The solver stops iterating once its next iteration is expected to exceed
+   * the budget and returns its latest iterate. Any non-positive number disables the budget.
+   */
+  scalar_t timeBudget_ = -1;
 
   /** This value determines to display the log output of MPC. */
   bool debugPrint_ = false;
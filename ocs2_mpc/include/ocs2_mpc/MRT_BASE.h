@@ -34,13 +34,13 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <atomic>
 #include <cstddef>
 #include <memory>
-#include <mutex>
 
 #include <ocs2_core/Types.h>
 #include <ocs2_core/control/ControllerBase.h>
 #include <ocs2_core/misc/LinearInterpolation.h>
 #include <ocs2_core/reference/ModeSchedule.h>
 #include <ocs2_core/reference/TargetTrajectories.h>
+#include <ocs2_core/thread_support/TripleBuffer.h>
 #include <ocs2_oc/oc_data/PerformanceIndex.h>
 #include <ocs2_oc/oc_data/PrimalSolution.h>
 #include <ocs2_oc/rollout/RolloutBase.h>
@@ -54,6 +54,9 @@ namespace ocs2 {
 /**
  * This class implements core MRT (Model Reference Tracking) functionality.
  * The responsibility of filling the buffer variables is left to the deriving classes.
+ *
+ * The policy is exchanged through a wait-free triple buffer between the thread that receives the MPC policy and the thread that calls
+ * updatePolicy(). Neither of them ever blocks the other, and updatePolicy() always receives the latest policy.
  */
 class MRT_BASE {
  public:
@@ -62,7 +65,10 @@ class MRT_BASE {
   virtual ~MRT_BASE() = default;
 
   /**
-   * Resets the class to its instantiated state.
+   * Resets the class to its instantiated state. A policy that has been published but not yet taken by updatePolicy() is dropped.
+   * @note Like updatePolicy(), this method is on the consumer side of the policy buffer: it must be called from the thread that calls
+   * updatePolicy(), or while no other thread uses this class. The derived classes only call it from resetMpcNode() and before their
+   * policy callbacks are set up.
    */
   void reset();
 
@@ -86,7 +92,7 @@ class MRT_BASE {
 
   /**
    * Gets a reference to the command data corresponding to the current policy.
-   * @warning access to the returned reference is not threadsafe. Read access and calls to updatePolicy() must be synced by the user.
+   * @warning the referenced data changes in updatePolicy(). Read access and calls to updatePolicy() must be synced by the user.
    *
    * @return a constant reference to command data.
    */
@@ -94,7 +100,7 @@ class MRT_BASE {
 
   /**
    * Gets a reference to the performance indices data corresponding to the current policy.
-   * @warning access to the returned reference is not threadsafe. Read access and calls to updatePolicy() must be synced by the user.
+   * @warning the referenced data changes in updatePolicy(). Read access and calls to updatePolicy() must be synced by the user.
    *
    * @return a constant reference to performance indices data.
    */
@@ -102,7 +108,7 @@ class MRT_BASE {
 
   /**
    * Gets a reference to current optimized policy.
-   * @warning access to the returned reference is not threadsafe. Read access and calls to updatePolicy() must be synced by the user.
+   * @warning the referenced data changes in updatePolicy(). Read access and calls to updatePolicy() must be synced by the user.
    *
    * @return constant reference to the policy data.
    */
@@ -142,6 +148,7 @@ class MRT_BASE {
    * Checks the data buffer for an update of the MPC policy. If a new policy
    * is available on the buffer this method will load it to the in-use policy.
    * This method also calls the modifyActiveSolution() method.
+   * This method is wait-free and does not allocate memory.
    *
    * @return True if the policy is updated.
    */
@@ -159,35 +166,43 @@ class MRT_BASE {
   void addMrtObserver(std::shared_ptr<MrtObserver> mrtObserver) { observerPtrArray_.push_back(std::move(mrtObserver)); };
 
  protected:
+  /** The data of a policy that is passed from the MPC to the MRT */
+  struct PolicyData {
+    CommandData command;
+    PrimalSolution primalSolution;
+    PerformanceIndex performanceIndices;
+  };
+
+  /**
+   * Gives access to the buffer that is published by the next call to publishBuffer(). It contains an old policy, such that overwriting
+   * it reuses the memory of its trajectories. This method and publishBuffer() must only be called from a single thread.
+   */
+  PolicyData& getBufferToWrite() { return policyBuffer_.getWriteBuffer(); }
+
+  /** Calls modifyBufferedSolution() on the buffer returned by getBufferToWrite() and makes it available to updatePolicy(). */
+  void publishBuffer();
+
+  /** Moves the given policy to the buffer and publishes it, see publishBuffer(). */
   void moveToBuffer(std::unique_ptr<CommandData> commandDataPtr, std::unique_ptr<PrimalSolution> primalSolutionPtr,
                     std::unique_ptr<PerformanceIndex> performanceIndicesPtr);
 
  private:
-  /** Calls modifyActiveSolution on all mrt observers. This function is called while holding a policyBufferMutex lock */
+  /** Calls modifyActiveSolution on all mrt observers. This function is called from updatePolicy() */
   void modifyActiveSolution(const CommandData& command, PrimalSolution& primalSolution);
 
-  /** Calls modifyBufferedSolution on all mrt observers. This function is called while holding a policyBufferMutex lock */
+  /** Calls modifyBufferedSolution on all mrt observers. This function is called from publishBuffer() */
   void modifyBufferedSolution(const CommandData& commandBuffer, PrimalSolution& primalSolutionBuffer);
 
   // flags on state of the class
   std::atomic_bool policyReceivedEver_;
-  bool newPolicyInBuffer_;  // whether a new policy is waiting to be swapped in
+  bool activePolicyAvailable_;  // whether updatePolicy() has loaded a policy since the last reset
 
   // variables related to the MPC output
-  std::unique_ptr<CommandData> activeCommandPtr_;
-  std::unique_ptr<CommandData> bufferCommandPtr_;
-  std::unique_ptr<PrimalSolution> activePrimalSolutionPtr_;
-  std::unique_ptr<PrimalSolution> bufferPrimalSolutionPtr_;
-  std::unique_ptr<PerformanceIndex> activePerformanceIndicesPtr_;
-  std::unique_ptr<PerformanceIndex> bufferPerformanceIndicesPtr_;
-
-  // thread safety
-  mutable std::mutex bufferMutex_;  // for policy variables with the prefix (buffer*)
-  const size_t mrtTrylockWarningThreshold_ = 5;
-  size_t mrtTrylockWarningCount_;
+  TripleBuffer<PolicyData> policyBuffer_;
 
   // variables needed for policy evaluation
   std::unique_ptr<RolloutBase> rolloutPtr_;
+  LinearInterpolation::TimeSegmentCursor stateCursor_;  // evaluatePolicy() is called at increasing times
 
   std::vector<std::shared_ptr<MrtObserver>> observerPtrArray_;
 };
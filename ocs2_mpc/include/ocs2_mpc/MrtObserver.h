@@ -46,7 +46,7 @@ namespace ocs2 {
  * When a user requests an update, the in-use policy is swapped for the buffered policy.
  *      - At this point the "modifyActiveSolution" of this class is called.
  *
- * Both filling of the buffer and the update swapping are protected by the same mutex.
+ * The buffer is filled and swapped without locks. Each function is only called for a policy that the other thread does not access.
  */
 class MrtObserver {
  public:
@@ -66,7 +66,7 @@ class MrtObserver {
    * This function is executed sequentially with updatePolicy and thus blocks the main thread. Computationally expensive modifications
    * should therefore rather be done in "modifyBufferedSolution".
    *
-   * A call to this function is protected by the same mutex as modifyBufferedSolution.
+   * This function is called from the thread that calls updatePolicy(), it may run concurrently with modifyBufferedSolution.
    */
   virtual void modifyActiveSolution(const CommandData& command, PrimalSolution& primalSolution) {}
 
@@ -76,7 +76,7 @@ class MrtObserver {
    *
    * When using a multi-threaded MRT, this function does not block the main thread.
    *
-   * A call to this function is protected by the same mutex as modifyActiveSolution.
+   * This function is called from the thread that fills the buffer, it may run concurrently with modifyActiveSolution.
    */
   virtual void modifyBufferedSolution(const CommandData& commandBuffer, PrimalSolution& primalSolutionBuffer) {}
 };
@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <algorithm>
 
+#include <ocs2_core/misc/Trace.h>
+
 #include <ocs2_mpc/MPC_BASE.h>
 
 namespace ocs2 {
@@ -51,6 +53,7 @@ void MPC_BASE::reset() {
 /******************************************************************************************************/
 /******************************************************************************************************/
 bool MPC_BASE::run(scalar_t currentTime, const vector_t& currentState) {
+  OCS2_TRACE_SCOPE("MPC_BASE::run");
   // check if the current time exceeds the solver final limit
   if (!initRun_ && currentTime >= getSolverPtr()->getFinalTime()) {
     std::cerr << "WARNING: The MPC time-horizon is smaller than the MPC starting time.\n";
@@ -72,6 +75,7 @@ bool MPC_BASE::run(scalar_t currentTime, const vector_t& currentState) {
   }
 
   // calculate the MPC policy
+  getSolverPtr()->setTimeBudget(mpcSettings_.timeBudget_);
   calculateController(currentTime, currentState, finalTime);
 
   // set initRun flag to false
@@ -89,4 +93,16 @@ bool MPC_BASE::run(scalar_t currentTime, const vector_t& currentState) {
   return true;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MPC_BASE::prepare(scalar_t nextTime) {
+  // nothing to prepare before the first solution
+  if (initRun_) {
+    return;
+  }
+
+  prepareController(nextTime, nextTime + mpcSettings_.timeHorizon_);
+}
+
 }  // namespace ocs2
@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_mpc/MPC_MRT_Interface.h"
 
+#include <algorithm>
+
 #include <ocs2_core/control/FeedforwardController.h>
 #include <ocs2_core/control/LinearController.h>
 
@@ -48,6 +50,7 @@ void MPC_MRT_Interface::resetMpcNode(const TargetTrajectories& initTargetTraject
   mpc_.reset();
   mpc_.getSolverPtr()->getReferenceManager().setTargetTrajectories(initTargetTrajectories);
   mpcTimer_.reset();
+  numMpcRuns_ = 0;
 }
 
 /******************************************************************************************************/
@@ -110,29 +113,40 @@ void MPC_MRT_Interface::advanceMpc() {
     std::cerr << "\n###   Average : " << mpcTimer_.getAverageInMilliseconds() << "[ms].";
     std::cerr << "\n###   Latest  : " << mpcTimer_.getLastIntervalInMilliseconds() << "[ms]." << std::endl;
   }
+
+  // prepare the next MPC call, which is expected one MPC period later. The period is either the desired one or the last observed one.
+  scalar_t mpcPeriod = 0.0;
+  if (mpc_.settings().mpcDesiredFrequency_ > 0.0) {
+    mpcPeriod = 1.0 / mpc_.settings().mpcDesiredFrequency_;
+  } else if (numMpcRuns_ > 0) {
+    mpcPeriod = std::max(currentObservation.time - lastMpcObservationTime_, 0.0);
+  }
+  lastMpcObservationTime_ = currentObservation.time;
+  ++numMpcRuns_;
+  mpc_.prepare(currentObservation.time + mpcPeriod);
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 void MPC_MRT_Interface::copyToBuffer(const SystemObservation& mpcInitObservation) {
+  // Write into the free buffer such that the memory of an old policy is reused
+  auto& bufferPolicy = this->getBufferToWrite();
+
   // policy
-  auto primalSolutionPtr = std::make_unique<PrimalSolution>();
   const scalar_t startTime = mpcInitObservation.time;
   const scalar_t finalTime =
       (mpc_.settings().solutionTimeWindow_ < 0) ? mpc_.getSolverPtr()->getFinalTime() : startTime + mpc_.settings().solutionTimeWindow_;
-  mpc_.getSolverPtr()->getPrimalSolution(finalTime, primalSolutionPtr.get());
+  mpc_.getSolverPtr()->getPrimalSolution(finalTime, &bufferPolicy.primalSolution);
 
   // command
-  auto commandPtr = std::make_unique<CommandData>();
-  commandPtr->mpcInitObservation_ = mpcInitObservation;
-  commandPtr->mpcTargetTrajectories_ = mpc_.getSolverPtr()->getReferenceManager().getTargetTrajectories();
+  bufferPolicy.command.mpcInitObservation_ = mpcInitObservation;
+  bufferPolicy.command.mpcTargetTrajectories_ = mpc_.getSolverPtr()->getReferenceManager().getTargetTrajectories();
 
   // performance indices
-  auto performanceIndicesPtr = std::make_unique<PerformanceIndex>();
-  *performanceIndicesPtr = mpc_.getSolverPtr()->getPerformanceIndeces();
+  bufferPolicy.performanceIndices = mpc_.getSolverPtr()->getPerformanceIndeces();
 
-  this->moveToBuffer(std::move(commandPtr), std::move(primalSolutionPtr), std::move(performanceIndicesPtr));
+  this->publishBuffer();
 }
 
 /******************************************************************************************************/
@@ -29,6 +29,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_mpc/MRT_BASE.h"
 
+#include <ocs2_core/misc/Trace.h>
 #include <ocs2_oc/rollout/TimeTriggeredRollout.h>
 
 namespace ocs2 {
@@ -44,26 +45,19 @@ MRT_BASE::MRT_BASE() {
 /******************************************************************************************************/
 /******************************************************************************************************/
 void MRT_BASE::reset() {
-  std::lock_guard<std::mutex> lock(bufferMutex_);
-
+  // The buffers keep their memory, a policy that is waiting in the buffer is dropped. Discarding is a consumer side operation of the
+  // triple buffer, it is safe against a concurrent publishBuffer() of the producer.
   policyReceivedEver_ = false;
-  newPolicyInBuffer_ = false;
-  mrtTrylockWarningCount_ = 0;
-
-  activeCommandPtr_.reset();
-  bufferCommandPtr_.reset();
-  activePrimalSolutionPtr_.reset();
-  bufferPrimalSolutionPtr_.reset();
-  activePerformanceIndicesPtr_.reset();
-  bufferPerformanceIndicesPtr_.reset();
+  activePolicyAvailable_ = false;
+  policyBuffer_.discardBuffer();
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 const CommandData& MRT_BASE::getCommand() const {
-  if (activeCommandPtr_ != nullptr) {
-    return *activeCommandPtr_;
+  if (activePolicyAvailable_) {
+    return policyBuffer_.get().command;
   } else {
     throw std::runtime_error("[MRT_BASE::getCommand] updatePolicy() should be called first!");
   }
@@ -73,8 +67,8 @@ const CommandData& MRT_BASE::getCommand() const {
 /******************************************************************************************************/
 /******************************************************************************************************/
 const PrimalSolution& MRT_BASE::getPolicy() const {
-  if (activePrimalSolutionPtr_ != nullptr) {
-    return *activePrimalSolutionPtr_;
+  if (activePolicyAvailable_) {
+    return policyBuffer_.get().primalSolution;
   } else {
     throw std::runtime_error("[MRT_BASE::getPolicy] updatePolicy() should be called first!");
   }
@@ -84,8 +78,8 @@ const PrimalSolution& MRT_BASE::getPolicy() const {
 /******************************************************************************************************/
 /******************************************************************************************************/
 const PerformanceIndex& MRT_BASE::getPerformanceIndices() const {
-  if (activePerformanceIndicesPtr_ != nullptr) {
-    return *activePerformanceIndicesPtr_;
+  if (activePolicyAvailable_) {
+    return policyBuffer_.get().performanceIndices;
   } else {
     throw std::runtime_error("[MRT_BASE::getPerformanceIndices] updatePolicy() should be called first!");
   }
@@ -102,20 +96,21 @@ void MRT_BASE::initRollout(const RolloutBase* rolloutPtr) {
 /******************************************************************************************************/
 /******************************************************************************************************/
 void MRT_BASE::evaluatePolicy(scalar_t currentTime, const vector_t& currentState, vector_t& mpcState, vector_t& mpcInput, size_t& mode) {
-  if (activePrimalSolutionPtr_ == nullptr) {
+  if (!activePolicyAvailable_) {
     throw std::runtime_error("[MRT_BASE::evaluatePolicy] updatePolicy() should be called first!");
   }
+  const auto& activePrimalSolution = policyBuffer_.get().primalSolution;
 
-  if (currentTime > activePrimalSolutionPtr_->timeTrajectory_.back()) {
+  if (currentTime > activePrimalSolution.timeTrajectory_.back()) {
     std::cerr << "The requested currentTime is greater than the received plan: " << std::to_string(currentTime) << ">"
-              << std::to_string(activePrimalSolutionPtr_->timeTrajectory_.back()) << "\n";
+              << std::to_string(activePrimalSolution.timeTrajectory_.back()) << "\n";
   }
 
-  mpcInput = activePrimalSolutionPtr_->controllerPtr_->computeInput(currentTime, currentState);
-  mpcState =
-      LinearInterpolation::interpolate(currentTime, activePrimalSolutionPtr_->timeTrajectory_, activePrimalSolutionPtr_->stateTrajectory_);
+  mpcInput = activePrimalSolution.controllerPtr_->computeInput(currentTime, currentState);
+  mpcState = LinearInterpolation::interpolate(stateCursor_.timeSegment(currentTime, activePrimalSolution.timeTrajectory_),
+                                              activePrimalSolution.stateTrajectory_);
 
-  mode = activePrimalSolutionPtr_->modeSchedule_.modeAtTime(currentTime);
+  mode = activePrimalSolution.modeSchedule_.modeAtTime(currentTime);
 }
 
 /******************************************************************************************************/
@@ -127,13 +122,14 @@ void MRT_BASE::rolloutPolicy(scalar_t currentTime, const vector_t& currentState,
     throw std::runtime_error("[MRT_BASE::rolloutPolicy] rollout class is not set! Use initRollout() to initialize it!");
   }
 
-  if (activePrimalSolutionPtr_ == nullptr) {
+  if (!activePolicyAvailable_) {
     throw std::runtime_error("[MRT_BASE::rolloutPolicy] updatePolicy() should be called first!");
   }
+  auto& activePrimalSolution = policyBuffer_.get().primalSolution;
 
-  if (currentTime > activePrimalSolutionPtr_->timeTrajectory_.back()) {
+  if (currentTime > activePrimalSolution.timeTrajectory_.back()) {
     std::cerr << "The requested currentTime is greater than the received plan: " << std::to_string(currentTime) << ">"
-              << std::to_string(activePrimalSolutionPtr_->timeTrajectory_.back()) << "\n";
+              << std::to_string(activePrimalSolution.timeTrajectory_.back()) << "\n";
   }
 
   // perform a rollout
@@ -141,42 +137,40 @@ void MRT_BASE::rolloutPolicy(scalar_t currentTime, const vector_t& currentState,
   size_array_t postEventIndicesStock;
   vector_array_t stateTrajectory, inputTrajectory;
   const scalar_t finalTime = currentTime + timeStep;
-  rolloutPtr_->run(currentTime, currentState, finalTime, activePrimalSolutionPtr_->controllerPtr_.get(),
-                   activePrimalSolutionPtr_->modeSchedule_, timeTrajectory, postEventIndicesStock, stateTrajectory, inputTrajectory);
+  rolloutPtr_->run(currentTime, currentState, finalTime, activePrimalSolution.controllerPtr_.get(), activePrimalSolution.modeSchedule_,
+                   timeTrajectory, postEventIndicesStock, stateTrajectory, inputTrajectory);
 
   mpcState = stateTrajectory.back();
   mpcInput = inputTrajectory.back();
 
-  mode = activePrimalSolutionPtr_->modeSchedule_.modeAtTime(finalTime);
+  mode = activePrimalSolution.modeSchedule_.modeAtTime(finalTime);
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 bool MRT_BASE::updatePolicy() {
-  std::unique_lock<std::mutex> lock(bufferMutex_, std::try_to_lock);
-  if (lock.owns_lock()) {
-    mrtTrylockWarningCount_ = 0;
-    if (newPolicyInBuffer_) {
-      // update the active solution from buffer
-      activeCommandPtr_.swap(bufferCommandPtr_);
-      activePrimalSolutionPtr_.swap(bufferPrimalSolutionPtr_);
-      activePerformanceIndicesPtr_.swap(bufferPerformanceIndicesPtr_);
-      newPolicyInBuffer_ = false;  // make sure we don't swap in the old policy again
-
-      modifyActiveSolution(*activeCommandPtr_, *activePrimalSolutionPtr_);
-      return true;
-    } else {
-      return false;  // No policy update: the buffer contains nothing new.
-    }
-  } else {
-    ++mrtTrylockWarningCount_;
-    if (mrtTrylockWarningCount_ > mrtTrylockWarningThreshold_) {
-      std::cerr << "[MRT_BASE::updatePolicy] failed to lock the policyBufferMutex for " << mrtTrylockWarningCount_
-                << " consecutive times.\n";
-    }
-    return false;  // No policy update: the lock could not be acquired.
+  OCS2_TRACE_SCOPE("MRT_BASE::updatePolicy");
+  if (!policyBuffer_.updateFromBuffer()) {
+    return false;  // No policy update: the buffer contains nothing new.
   }
+  activePolicyAvailable_ = true;
+
+  auto& activePolicy = policyBuffer_.get();
+  modifyActiveSolution(activePolicy.command, activePolicy.primalSolution);
+  return true;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MRT_BASE::publishBuffer() {
+  // allow user to modify the buffer
+  auto& bufferPolicy = policyBuffer_.getWriteBuffer();
+  modifyBufferedSolution(bufferPolicy.command, bufferPolicy.primalSolution);
+
+  policyBuffer_.publish();
+  policyReceivedEver_ = true;
 }
 
 /******************************************************************************************************/
@@ -184,6 +178,7 @@ bool MRT_BASE::updatePolicy() {
 /******************************************************************************************************/
 void MRT_BASE::moveToBuffer(std::unique_ptr<CommandData> commandDataPtr, std::unique_ptr<PrimalSolution> primalSolutionPtr,
                             std::unique_ptr<PerformanceIndex> performanceIndicesPtr) {
+  OCS2_TRACE_SCOPE("MRT_BASE::moveToBuffer");
   if (commandDataPtr == nullptr) {
     throw std::runtime_error("[MRT_BASE::moveToBuffer] commandDataPtr cannot be a null pointer!");
   }
@@ -196,17 +191,11 @@ void MRT_BASE::moveToBuffer(std::unique_ptr<CommandData> commandDataPtr, std::un
     throw std::runtime_error("[MRT_BASE::moveToBuffer] performanceIndicesPtr cannot be a null pointer!");
   }
 
-  std::lock_guard<std::mutex> lk(bufferMutex_);
-  // use swap such that the old objects are destroyed after releasing the lock.
-  bufferCommandPtr_.swap(commandDataPtr);
-  bufferPrimalSolutionPtr_.swap(primalSolutionPtr);
-  bufferPerformanceIndicesPtr_.swap(performanceIndicesPtr);
-
-  // allow user to modify the buffer
-  modifyBufferedSolution(*bufferCommandPtr_, *bufferPrimalSolutionPtr_);
-
-  newPolicyInBuffer_ = true;
-  policyReceivedEver_ = true;
+  auto& bufferPolicy = getBufferToWrite();
+  bufferPolicy.command = std::move(*commandDataPtr);
+  bufferPolicy.primalSolution = std::move(*primalSolutionPtr);
+  bufferPolicy.performanceIndices = *performanceIndicesPtr;
+  publishBuffer();
 }
 
 /******************************************************************************************************/
@@ -0,0 +1,131 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <thread>
+
+#include <ros/package.h>
+
+#include <ocs2_ballbot/definitions.h>
+#include <ocs2_mpcnet_core/control/MpcnetOnnxBatchInference.h>
+#include <ocs2_mpcnet_core/control/MpcnetOnnxController.h>
+#include <ocs2_oc/synchronized_module/ReferenceManager.h>
+
+#include "ocs2_ballbot_mpcnet/BallbotMpcnetDefinition.h"
+
+using namespace ocs2;
+using namespace ocs2::ballbot;
+
+class BallbotMpcnetOnnxControllerTest : public testing::Test {
+ protected:
+  static constexpr size_t numSamples = 8;
+  static constexpr scalar_t tolerance = 1e-6;  // the model is evaluated in single precision
+
+  BallbotMpcnetOnnxControllerTest() {
+    TargetTrajectories targetTrajectories({0.0, 1.0}, {vector_t::Zero(STATE_DIM), vector_t::Ones(STATE_DIM)},
+                                          {vector_t::Zero(INPUT_DIM), vector_t::Zero(INPUT_DIM)});
+    referenceManagerPtr = std::make_shared<ReferenceManager>(std::move(targetTrajectories));
+    controllerPtr.reset(new ocs2::mpcnet::MpcnetOnnxController(std::make_shared<BallbotMpcnetDefinition>(), referenceManagerPtr,
+                                                              ocs2::mpcnet::createOnnxEnvironment()));
+    controllerPtr->loadPolicyModel(ros::package::getPath("ocs2_ballbot_mpcnet") + "/policy/ballbot.onnx");
+
+    for (size_t i = 0; i < numSamples; i++) {
+      times.push_back(static_cast<scalar_t>(i) / numSamples);
+      states.push_back(vector_t::Random(STATE_DIM));
+    }
+  }
+
+  std::shared_ptr<ReferenceManager> referenceManagerPtr;
+  std::unique_ptr<ocs2::mpcnet::MpcnetOnnxController> controllerPtr;
+  scalar_array_t times;
+  vector_array_t states;
+};
+
+constexpr size_t BallbotMpcnetOnnxControllerTest::numSamples;
+constexpr scalar_t BallbotMpcnetOnnxControllerTest::tolerance;
+
+TEST_F(BallbotMpcnetOnnxControllerTest, evaluatePolicy) {
+  matrix_t observations(controllerPtr->getObservation(times[0], states[0]).size(), numSamples);
+  for (size_t i = 0; i < numSamples; i++) {
+    observations.col(i) = controllerPtr->getObservation(times[i], states[i]);
+  }
+  const matrix_t actions = controllerPtr->evaluatePolicy(observations);
+  ASSERT_EQ(actions.cols(), numSamples);
+  for (size_t i = 0; i < numSamples; i++) {
+    const vector_t input = controllerPtr->getInput(times[i], states[i], actions.col(i));
+    EXPECT_TRUE(input.isApprox(controllerPtr->computeInput(times[i], states[i]), tolerance)) << "sample " << i;
+  }
+
+  // an empty batch does not run an inference
+  EXPECT_EQ(controllerPtr->evaluatePolicy(observations.leftCols(0)).cols(), 0);
+}
+
+TEST_F(BallbotMpcnetOnnxControllerTest, holdInput) {
+  const vector_t heldInput = vector_t::Constant(INPUT_DIM, 42.0);
+  const vector_t input = controllerPtr->computeInput(times[1], states[1]);
+  controllerPtr->holdInput(times[0], states[0], heldInput);
+  EXPECT_TRUE(controllerPtr->computeInput(times[0], states[0]).isApprox(heldInput));
+  EXPECT_TRUE(controllerPtr->computeInput(times[1], states[1]).isApprox(input));
+}
+
+TEST_F(BallbotMpcnetOnnxControllerTest, batchInference) {
+  constexpr int numSteps = 5;
+  ocs2::mpcnet::MpcnetOnnxBatchInference batchInference(*controllerPtr);
+
+  // all threads join before the first step, hence each step is a single batch over all threads
+  for (size_t i = 0; i < numSamples; i++) {
+    batchInference.join(ros::package::getPath("ocs2_ballbot_mpcnet") + "/policy/ballbot.onnx");
+  }
+
+  std::vector<vector_array_t> batchedInputs(numSamples, vector_array_t(numSteps));
+  std::vector<std::thread> threads;
+  for (size_t i = 0; i < numSamples; i++) {
+    threads.emplace_back([&, i]() {
+      for (int j = 0; j < numSteps; j++) {
+        const scalar_t time = times[i] + j;
+        const vector_t action = batchInference.computeAction(controllerPtr->getObservation(time, states[i]));
+        batchedInputs[i][j] = controllerPtr->getInput(time, states[i], action);
+      }
+      batchInference.leave();
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  EXPECT_EQ(batchInference.getNumInferences(), numSteps);
+  EXPECT_EQ(batchInference.getNumSamples(), numSamples * numSteps);
+  for (size_t i = 0; i < numSamples; i++) {
+    for (int j = 0; j < numSteps; j++) {
+      EXPECT_TRUE(batchedInputs[i][j].isApprox(controllerPtr->computeInput(times[i] + j, states[i]), tolerance))
+          << "sample " << i << ", step " << j;
+    }
+  }
+}
@@ -76,6 +76,12 @@ class MpcnetBehavioralController final : public ControllerBase {
    */
   void setLearnedController(const MpcnetControllerBase& learnedController) { learnedControllerPtr_.reset(learnedController.clone()); }
 
+  /**
+   * Get the learned controller.
+   * @return Pointer to the learned controller owned by this class, or nullptr if not set.
+   */
+  MpcnetControllerBase* getLearnedControllerPtr() { return learnedControllerPtr_.get(); }
+
   vector_t computeInput(scalar_t t, const vector_t& x) override;
   ControllerType getType() const override { return ControllerType::BEHAVIORAL; }
 
@@ -0,0 +1,108 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <condition_variable>
+#include <exception>
+#include <memory>
+#include <mutex>
+
+#include <ocs2_core/misc/Benchmark.h>
+
+#include "ocs2_mpcnet_core/control/MpcnetOnnxController.h"
+
+namespace ocs2 {
+namespace mpcnet {
+
+/**
+ * Evaluates the policy of several rollouts that are stepped in lockstep with a single inference per step.
+ * Each rollout thread joins the batch, then submits the observation of its current step with computeAction(). The thread that completes
+ * the batch runs the inference for all submitted observations, while the other threads wait for the result. A thread that leaves the
+ * batch no longer holds back the remaining ones.
+ */
+class MpcnetOnnxBatchInference {
+ public:
+  /**
+   * Constructor.
+   * @param [in] policy : The controller used for the batched inference (this class takes ownership of a clone).
+   */
+  explicit MpcnetOnnxBatchInference(const MpcnetOnnxController& policy) : policyPtr_(policy.clone()) {}
+
+  /**
+   * Joins the batch and loads the model of the policy, if it is the first thread to join or the model changed.
+   * @param [in] policyFilePath : Path to the file with the model of the policy.
+   */
+  void join(const std::string& policyFilePath);
+
+  /** Leaves the batch. */
+  void leave();
+
+  /**
+   * Computes the action for an observation together with the observations of all other threads in the batch.
+   * @note Blocks until all threads in the batch submitted their observation.
+   * @param [in] observation : The observation.
+   * @return The action.
+   */
+  vector_t computeAction(const vector_t& observation);
+
+  /** Resets the inference statistics. */
+  void resetStatistics();
+
+  /** Gets the number of inferences since the last reset. */
+  int getNumInferences() const;
+
+  /** Gets the number of evaluated observations since the last reset. */
+  size_t getNumSamples() const;
+
+  /** Gets the total inference time in milliseconds since the last reset. */
+  scalar_t getTotalInferenceTimeInMilliseconds() const;
+
+ private:
+  /** Runs the inference for the submitted observations and wakes up the waiting threads. Requires the lock. */
+  void evaluate();
+
+  std::unique_ptr<MpcnetOnnxController> policyPtr_;
+  std::string policyFilePath_;
+
+  mutable std::mutex mutex_;
+  std::condition_variable batchDone_;
+  size_t numParticipants_ = 0;
+  size_t batchCounter_ = 0;
+  std::vector<vector_t> observations_;
+  matrix_t observationMatrix_;
+  matrix_t actions_;
+  std::exception_ptr batchError_;
+
+  size_t numSamples_ = 0;
+  benchmark::RepeatedTimer inferenceTimer_;
+};
+
+}  // namespace mpcnet
+}  // namespace ocs2
@@ -55,6 +55,8 @@ inline std::shared_ptr<Ort::Env> createOnnxEnvironment() {
  * x: relative state (1 x dimensionOfState),
  * u: predicted input (1 x dimensionOfInput),
  * @note The additional first dimension with size 1 for the variables of the model comes from batch processing during training.
+ * @note The input and output tensors are preallocated and bound to the session once per batch size, such that an inference does not
+ * allocate. If the model is exported with a dynamic first dimension, evaluatePolicy() evaluates a whole batch with a single inference.
  */
 class MpcnetOnnxController final : public MpcnetControllerBase {
  public:
@@ -77,6 +79,41 @@ class MpcnetOnnxController final : public MpcnetControllerBase {
   void loadPolicyModel(const std::string& policyFilePath) override;
 
   vector_t computeInput(const scalar_t t, const vector_t& x) override;
+
+  /**
+   * Gets the observation of the policy, i.e. the input of the model.
+   * @param [in] t : The time.
+   * @param [in] x : The state.
+   * @return The observation.
+   */
+  vector_t getObservation(scalar_t t, const vector_t& x) const;
+
+  /**
+   * Gets the input from the action of the policy, i.e. the output of the model.
+   * @param [in] t : The time.
+   * @param [in] x : The state.
+   * @param [in] action : The action.
+   * @return The input.
+   */
+  vector_t getInput(scalar_t t, const vector_t& x, const vector_t& action) const;
+
+  /**
+   * Evaluates the policy model for a batch of observations with a single inference.
+   * @note Falls back to one inference per observation if the model has a fixed batch size.
+   * @param [in] observations : The observations (dimensionOfObservation x batchSize).
+   * @return The actions (dimensionOfAction x batchSize).
+   */
+  matrix_t evaluatePolicy(const matrix_t& observations);
+
+  /**
+   * Holds an input that was computed elsewhere (e.g. by a batched inference), such that computeInput() returns it without an inference
+   * when queried for exactly this time and state.
+   * @param [in] t : The time.
+   * @param [in] x : The state.
+   * @param [in] u : The input.
+   */
+  void holdInput(scalar_t t, const vector_t& x, const vector_t& u);
+
   ControllerType getType() const override { return ControllerType::ONNX; }
 
   int size() const override { throw std::runtime_error("[MpcnetOnnxController::size] not implemented."); }
@@ -88,6 +125,13 @@ class MpcnetOnnxController final : public MpcnetControllerBase {
 
  private:
   using tensor_element_t = float;
+  using tensor_matrix_t = Eigen::Matrix<tensor_element_t, Eigen::Dynamic, Eigen::Dynamic>;
+
+  /** Resizes the observation and action buffers and binds them to the session, if the batch size changed. */
+  void bindBuffers(int64_t batchSize);
+
+  /** Runs the inference on the bound buffers. */
+  void run();
 
   MpcnetOnnxController(const MpcnetOnnxController& other)
       : MpcnetOnnxController(other.mpcnetDefinitionPtr_, other.referenceManagerPtr_, other.onnxEnvironmentPtr_) {
@@ -105,6 +149,21 @@ class MpcnetOnnxController final : public MpcnetControllerBase {
   std::vector<const char*> outputNames_;
   std::vector<std::vector<int64_t>> inputShapes_;
   std::vector<std::vector<int64_t>> outputShapes_;
+
+  bool hasDynamicBatchSize_ = false;
+  int64_t boundBatchSize_ = 0;
+  Ort::MemoryInfo memoryInfo_{nullptr};
+  Ort::RunOptions runOptions_{nullptr};
+  std::unique_ptr<Ort::IoBinding> ioBindingPtr_;
+  tensor_matrix_t observationBuffer_;  // column-major (dimensionOfObservation x batchSize), i.e. row-major (batchSize x dimension)
+  tensor_matrix_t actionBuffer_;       // column-major (dimensionOfAction x batchSize)
+  Ort::Value observationTensor_{nullptr};
+  Ort::Value actionTensor_{nullptr};
+
+  bool hasHeldInput_ = false;
+  scalar_t heldTime_ = 0.0;
+  vector_t heldState_;
+  vector_t heldInput_;
 };
 
 }  // namespace mpcnet
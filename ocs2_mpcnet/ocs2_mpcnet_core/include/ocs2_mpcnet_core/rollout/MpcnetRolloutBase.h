@@ -40,6 +40,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ocs2_mpcnet_core/MpcnetDefinitionBase.h"
 #include "ocs2_mpcnet_core/control/MpcnetBehavioralController.h"
 #include "ocs2_mpcnet_core/control/MpcnetControllerBase.h"
+#include "ocs2_mpcnet_core/control/MpcnetOnnxBatchInference.h"
 
 namespace ocs2 {
 namespace mpcnet {
@@ -83,6 +84,15 @@ class MpcnetRolloutBase {
    */
   MpcnetRolloutBase& operator=(const MpcnetRolloutBase&) = delete;
 
+  /**
+   * Set the batch inference shared with the other rollouts that are stepped in lockstep.
+   * @note The learned policy is then evaluated once per step for all rollouts together, which requires an ONNX policy. Only the query at
+   * the start of the step is batched. The queries of the rollout integrator within the step are at times and states which are specific
+   * to each rollout, hence they still run one inference each.
+   * @param [in] batchInferencePtr : Pointer to the batch inference (shared ownership), or nullptr to evaluate the policy per rollout.
+   */
+  void setBatchInference(std::shared_ptr<MpcnetOnnxBatchInference> batchInferencePtr) { batchInferencePtr_ = std::move(batchInferencePtr); }
+
  protected:
   /**
    * (Re)set system components.
@@ -101,6 +111,11 @@ class MpcnetRolloutBase {
    */
   void step(scalar_t timeStep);
 
+  /**
+   * Finish the rollout, i.e. leave the lockstep batch of the policy inference.
+   */
+  void finish();
+
   std::unique_ptr<MPC_BASE> mpcPtr_;
   std::shared_ptr<MpcnetDefinitionBase> mpcnetDefinitionPtr_;
   std::unique_ptr<MpcnetBehavioralController> behavioralControllerPtr_;
@@ -111,6 +126,8 @@ class MpcnetRolloutBase {
   std::unique_ptr<MpcnetControllerBase> mpcnetPtr_;
   std::unique_ptr<RolloutBase> rolloutPtr_;
   std::shared_ptr<ReferenceManagerInterface> referenceManagerPtr_;
+  std::shared_ptr<MpcnetOnnxBatchInference> batchInferencePtr_;
+  bool isInBatch_ = false;
 };
 
 }  // namespace mpcnet
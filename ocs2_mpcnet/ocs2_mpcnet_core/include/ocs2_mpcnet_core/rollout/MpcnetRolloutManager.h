@@ -29,6 +29,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <ocs2_core/misc/Benchmark.h>
 #include <ocs2_core/thread_support/ThreadPool.h>
 
 #include "ocs2_mpcnet_core/rollout/MpcnetDataGeneration.h"
@@ -39,6 +40,8 @@ namespace mpcnet {
 
 /**
  *  A class to manage the data generation and policy evaluation rollouts for MPC-Net.
+ *  @note For ONNX policies, the rollouts running in parallel are stepped in lockstep, such that the learned policy is evaluated for all
+ *  of them with a single inference per step.
  */
 class MpcnetRolloutManager {
  public:
@@ -118,12 +121,22 @@ class MpcnetRolloutManager {
   metrics_array_t getComputedMetrics();
 
  private:
+  /**
+   * Prints the throughput of the batched policy inference.
+   * @param [in] name : The name of the rollouts.
+   * @param [in] batchInference : The batch inference of the rollouts.
+   * @param [in] elapsedTime : The wall time of all rollouts in milliseconds.
+   */
+  static void printThroughput(const std::string& name, const MpcnetOnnxBatchInference& batchInference, scalar_t elapsedTime);
+
   // data generation variables
   size_t nDataGenerationThreads_;
   std::atomic_int nDataGenerationTasksDone_;
   std::unique_ptr<ThreadPool> dataGenerationThreadPoolPtr_;
   std::vector<std::unique_ptr<MpcnetDataGeneration>> dataGenerationPtrs_;
   std::vector<std::future<const data_array_t*>> dataGenerationFtrs_;
+  std::shared_ptr<MpcnetOnnxBatchInference> dataGenerationBatchInferencePtr_;
+  benchmark::RepeatedTimer dataGenerationTimer_;
   data_array_t dataArray_;
   // policy evaluation variables
   size_t nPolicyEvaluationThreads_;
@@ -131,6 +144,8 @@ class MpcnetRolloutManager {
   std::unique_ptr<ThreadPool> policyEvaluationThreadPoolPtr_;
   std::vector<std::unique_ptr<MpcnetPolicyEvaluation>> policyEvaluationPtrs_;
   std::vector<std::future<metrics_t>> policyEvaluationFtrs_;
+  std::shared_ptr<MpcnetOnnxBatchInference> policyEvaluationBatchInferencePtr_;
+  benchmark::RepeatedTimer policyEvaluationTimer_;
 };
 
 }  // namespace mpcnet
@@ -123,6 +123,28 @@ class Mpcnet(metaclass=ABCMeta):
         """
         pass
 
+    def export_policy(self, policy: BasePolicy, policy_file_path: str) -> None:
+        """Export policy.
+
+        Exports the policy to the ONNX format with a dynamic batch dimension, such that the C++ side can evaluate several observations
+        with a single inference.
+
+        Args:
+            policy: The policy to be exported.
+            policy_file_path: The path of the exported file.
+        """
+        number_of_outputs = len(policy(self.dummy_observation))
+        output_names = ["output_" + str(i) for i in range(number_of_outputs)]
+        dynamic_axes = {name: {0: "batch"} for name in ["observation"] + output_names}
+        torch.onnx.export(
+            model=policy,
+            args=self.dummy_observation,
+            f=policy_file_path,
+            input_names=["observation"],
+            output_names=output_names,
+            dynamic_axes=dynamic_axes,
+        )
+
     def start_data_generation(self, policy: BasePolicy, alpha: float = 1.0):
         """Start data generation.
 
@@ -133,7 +155,7 @@ class Mpcnet(metaclass=ABCMeta):
             alpha: The weight of the MPC policy in the rollouts.
         """
         policy_file_path = "/tmp/data_generation_" + datetime.datetime.now().strftime("%Y-%m-%d_%H-%M-%S") + ".onnx"
-        torch.onnx.export(model=policy, args=self.dummy_observation, f=policy_file_path)
+        self.export_policy(policy, policy_file_path)
         initial_observations, mode_schedules, target_trajectories = self.get_tasks(
             self.config.DATA_GENERATION_TASKS, self.config.DATA_GENERATION_DURATION
         )
@@ -159,7 +181,7 @@ class Mpcnet(metaclass=ABCMeta):
             alpha: The weight of the MPC policy in the rollouts.
         """
         policy_file_path = "/tmp/policy_evaluation_" + datetime.datetime.now().strftime("%Y-%m-%d_%H-%M-%S") + ".onnx"
-        torch.onnx.export(model=policy, args=self.dummy_observation, f=policy_file_path)
+        self.export_policy(policy, policy_file_path)
         initial_observations, mode_schedules, target_trajectories = self.get_tasks(
             self.config.POLICY_EVALUATION_TASKS, self.config.POLICY_EVALUATION_DURATION
         )
@@ -180,7 +202,7 @@ class Mpcnet(metaclass=ABCMeta):
         try:
             # save initial policy
             save_path = self.log_dir + "/initial_policy"
-            torch.onnx.export(model=self.policy, args=self.dummy_observation, f=save_path + ".onnx")
+            self.export_policy(self.policy, save_path + ".onnx")
             torch.save(obj=self.policy, f=save_path + ".pt")
 
             print("==============\nWaiting for first data.\n==============")
@@ -239,7 +261,7 @@ class Mpcnet(metaclass=ABCMeta):
                 # save intermediate policy
                 if (iteration % int(0.1 * self.config.LEARNING_ITERATIONS) == 0) and (iteration > 0):
                     save_path = self.log_dir + "/intermediate_policy_" + str(iteration)
-                    torch.onnx.export(model=self.policy, args=self.dummy_observation, f=save_path + ".onnx")
+                    self.export_policy(self.policy, save_path + ".onnx")
                     torch.save(obj=self.policy, f=save_path + ".pt")
 
                 # extract batch from memory
@@ -316,7 +338,7 @@ class Mpcnet(metaclass=ABCMeta):
 
             # save final policy
             save_path = self.log_dir + "/final_policy"
-            torch.onnx.export(model=self.policy, args=self.dummy_observation, f=save_path + ".onnx")
+            self.export_policy(self.policy, save_path + ".onnx")
             torch.save(obj=self.policy, f=save_path + ".pt")
 
         except KeyboardInterrupt:
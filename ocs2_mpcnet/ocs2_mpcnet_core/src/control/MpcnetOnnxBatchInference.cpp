@@ -0,0 +1,143 @@
+/******************************************************************************
+Copyright (c) 2022, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+ * Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+ * Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+ * Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_mpcnet_core/control/MpcnetOnnxBatchInference.h"
+
+namespace ocs2 {
+namespace mpcnet {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MpcnetOnnxBatchInference::join(const std::string& policyFilePath) {
+  std::lock_guard<std::mutex> lock(mutex_);
+  // the first thread reloads the model, since the file might have been overwritten with a new policy
+  if (numParticipants_ == 0 || policyFilePath != policyFilePath_) {
+    if (!observations_.empty()) {
+      throw std::runtime_error("[MpcnetOnnxBatchInference::join] cannot load a new policy model while a batch is pending.");
+    }
+    policyPtr_->loadPolicyModel(policyFilePath);
+    policyFilePath_ = policyFilePath;
+  }
+  ++numParticipants_;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MpcnetOnnxBatchInference::leave() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  if (numParticipants_ == 0) {
+    throw std::runtime_error("[MpcnetOnnxBatchInference::leave] cannot leave, since no thread joined.");
+  }
+  --numParticipants_;
+  // the remaining threads might all be waiting for the leaving one
+  if (!observations_.empty() && observations_.size() == numParticipants_) {
+    evaluate();
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_t MpcnetOnnxBatchInference::computeAction(const vector_t& observation) {
+  std::unique_lock<std::mutex> lock(mutex_);
+  const size_t batch = batchCounter_;
+  const size_t index = observations_.size();
+  observations_.push_back(observation);
+  if (observations_.size() == numParticipants_) {
+    evaluate();
+  } else {
+    // the next batch cannot be completed before this thread submitted its next observation, hence the actions are not overwritten
+    batchDone_.wait(lock, [&] { return batchCounter_ != batch; });
+  }
+  if (batchError_ != nullptr) {
+    std::rethrow_exception(batchError_);
+  }
+  return actions_.col(index);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MpcnetOnnxBatchInference::resetStatistics() {
+  std::lock_guard<std::mutex> lock(mutex_);
+  numSamples_ = 0;
+  inferenceTimer_.reset();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+int MpcnetOnnxBatchInference::getNumInferences() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return inferenceTimer_.getNumTimedIntervals();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+size_t MpcnetOnnxBatchInference::getNumSamples() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return numSamples_;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+scalar_t MpcnetOnnxBatchInference::getTotalInferenceTimeInMilliseconds() const {
+  std::lock_guard<std::mutex> lock(mutex_);
+  return inferenceTimer_.getTotalInMilliseconds();
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MpcnetOnnxBatchInference::evaluate() {
+  observationMatrix_.resize(observations_.front().size(), observations_.size());
+  for (size_t i = 0; i < observations_.size(); i++) {
+    observationMatrix_.col(i) = observations_[i];
+  }
+  try {
+    inferenceTimer_.startTimer();
+    actions_ = policyPtr_->evaluatePolicy(observationMatrix_);
+    inferenceTimer_.endTimer();
+    numSamples_ += observations_.size();
+    batchError_ = nullptr;
+  } catch (...) {
+    // all threads of the batch report the error
+    batchError_ = std::current_exception();
+  }
+  observations_.clear();
+  ++batchCounter_;
+  batchDone_.notify_all();
+}
+
+}  // namespace mpcnet
+}  // namespace ocs2
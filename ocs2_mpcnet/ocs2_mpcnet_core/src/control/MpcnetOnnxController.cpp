@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_mpcnet_core/control/MpcnetOnnxController.h"
 
+#include <array>
+
 namespace ocs2 {
 namespace mpcnet {
 
@@ -56,33 +58,125 @@ void MpcnetOnnxController::loadPolicyModel(const std::string& policyFilePath) {
     outputNames_.push_back(sessionPtr_->GetOutputName(i, allocator));
     outputShapes_.push_back(sessionPtr_->GetOutputTypeInfo(i).GetTensorTypeAndShapeInfo().GetShape());
   }
+  // prepare the io binding, a negative size marks a dynamic dimension
+  hasDynamicBatchSize_ = inputShapes_[0][0] < 0;
+  memoryInfo_ = Ort::MemoryInfo::CreateCpu(OrtAllocatorType::OrtArenaAllocator, OrtMemType::OrtMemTypeDefault);
+  runOptions_ = Ort::RunOptions();
+  ioBindingPtr_.reset(new Ort::IoBinding(*sessionPtr_));
+  boundBatchSize_ = 0;
+  bindBuffers(1);
+  hasHeldInput_ = false;
 }
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 vector_t MpcnetOnnxController::computeInput(const scalar_t t, const vector_t& x) {
+  if (hasHeldInput_ && t == heldTime_ && x == heldState_) {
+    return heldInput_;
+  }
   if (sessionPtr_ == nullptr) {
     throw std::runtime_error("[MpcnetOnnxController::computeInput] cannot compute input, since policy model is not loaded.");
   }
-  // create input tensor object
-  Eigen::Matrix<tensor_element_t, Eigen::Dynamic, 1> observation =
-      mpcnetDefinitionPtr_->getObservation(t, x, referenceManagerPtr_->getModeSchedule(), referenceManagerPtr_->getTargetTrajectories())
-          .cast<tensor_element_t>();
-  Ort::MemoryInfo memoryInfo = Ort::MemoryInfo::CreateCpu(OrtAllocatorType::OrtArenaAllocator, OrtMemType::OrtMemTypeDefault);
-  std::vector<Ort::Value> inputValues;
-  inputValues.push_back(Ort::Value::CreateTensor<tensor_element_t>(memoryInfo, observation.data(), observation.size(),
-                                                                   inputShapes_[0].data(), inputShapes_[0].size()));
+  // fill input tensor
+  bindBuffers(1);
+  observationBuffer_.col(0) = getObservation(t, x).cast<tensor_element_t>();
   // run inference
-  Ort::RunOptions runOptions;
-  std::vector<Ort::Value> outputValues = sessionPtr_->Run(runOptions, inputNames_.data(), inputValues.data(), 1, outputNames_.data(), 1);
-  // evaluate output tensor object
-  Eigen::Map<Eigen::Matrix<tensor_element_t, Eigen::Dynamic, 1>> action(outputValues[0].GetTensorMutableData<tensor_element_t>(),
-                                                                        outputShapes_[0][1], outputShapes_[0][0]);
-  std::pair<matrix_t, vector_t> actionTransformation = mpcnetDefinitionPtr_->getActionTransformation(
-      t, x, referenceManagerPtr_->getModeSchedule(), referenceManagerPtr_->getTargetTrajectories());
+  run();
   // transform action
-  return actionTransformation.first * action.cast<scalar_t>() + actionTransformation.second;
+  return getInput(t, x, actionBuffer_.col(0).cast<scalar_t>());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_t MpcnetOnnxController::getObservation(scalar_t t, const vector_t& x) const {
+  return mpcnetDefinitionPtr_->getObservation(t, x, referenceManagerPtr_->getModeSchedule(), referenceManagerPtr_->getTargetTrajectories());
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+vector_t MpcnetOnnxController::getInput(scalar_t t, const vector_t& x, const vector_t& action) const {
+  const std::pair<matrix_t, vector_t> actionTransformation = mpcnetDefinitionPtr_->getActionTransformation(
+      t, x, referenceManagerPtr_->getModeSchedule(), referenceManagerPtr_->getTargetTrajectories());
+  return actionTransformation.first * action + actionTransformation.second;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+matrix_t MpcnetOnnxController::evaluatePolicy(const matrix_t& observations) {
+  if (sessionPtr_ == nullptr) {
+    throw std::runtime_error("[MpcnetOnnxController::evaluatePolicy] cannot evaluate policy, since policy model is not loaded.");
+  }
+  if (observations.rows() != observationBuffer_.rows()) {
+    throw std::runtime_error("[MpcnetOnnxController::evaluatePolicy] observations have wrong dimension.");
+  }
+  if (observations.cols() == 0) {
+    return matrix_t(actionBuffer_.rows(), 0);
+  }
+  if (hasDynamicBatchSize_) {
+    bindBuffers(observations.cols());
+    observationBuffer_ = observations.cast<tensor_element_t>();
+    run();
+    return actionBuffer_.cast<scalar_t>();
+  } else {
+    bindBuffers(1);
+    matrix_t actions(actionBuffer_.rows(), observations.cols());
+    for (int i = 0; i < observations.cols(); i++) {
+      observationBuffer_ = observations.col(i).cast<tensor_element_t>();
+      run();
+      actions.col(i) = actionBuffer_.col(0).cast<scalar_t>();
+    }
+    return actions;
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MpcnetOnnxController::holdInput(scalar_t t, const vector_t& x, const vector_t& u) {
+  hasHeldInput_ = true;
+  heldTime_ = t;
+  heldState_ = x;
+  heldInput_ = u;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MpcnetOnnxController::bindBuffers(int64_t batchSize) {
+  if (batchSize <= 0) {
+    throw std::runtime_error("[MpcnetOnnxController::bindBuffers] batch size must be positive.");
+  }
+  if (batchSize == boundBatchSize_) {
+    return;
+  }
+  // the buffers are column-major, hence their memory layout matches the row-major (batchSize x dimension) tensors of the model
+  const int64_t observationDimension = inputShapes_[0][1];
+  const int64_t actionDimension = outputShapes_[0][1];
+  observationBuffer_.setZero(observationDimension, batchSize);
+  actionBuffer_.setZero(actionDimension, batchSize);
+  const std::array<int64_t, 2> observationShape{batchSize, observationDimension};
+  const std::array<int64_t, 2> actionShape{batchSize, actionDimension};
+  observationTensor_ = Ort::Value::CreateTensor<tensor_element_t>(memoryInfo_, observationBuffer_.data(), observationBuffer_.size(),
+                                                                  observationShape.data(), observationShape.size());
+  actionTensor_ = Ort::Value::CreateTensor<tensor_element_t>(memoryInfo_, actionBuffer_.data(), actionBuffer_.size(), actionShape.data(),
+                                                             actionShape.size());
+  // only the first output (the action) is bound, further outputs of the model are not computed
+  ioBindingPtr_->ClearBoundInputs();
+  ioBindingPtr_->ClearBoundOutputs();
+  ioBindingPtr_->BindInput(inputNames_[0], observationTensor_);
+  ioBindingPtr_->BindOutput(outputNames_[0], actionTensor_);
+  boundBatchSize_ = batchSize;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MpcnetOnnxController::run() {
+  sessionPtr_->Run(runOptions_, *ioBindingPtr_);
 }
 
 }  // namespace mpcnet
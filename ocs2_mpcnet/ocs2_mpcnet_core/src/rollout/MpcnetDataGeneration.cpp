@@ -86,6 +86,9 @@ const data_array_t* MpcnetDataGeneration::run(scalar_t alpha, const std::string&
     dataArray_.clear();
   }
 
+  // finish system
+  finish();
+
   // return pointer to the data array
   return &dataArray_;
 }
@@ -63,6 +63,9 @@ metrics_t MpcnetPolicyEvaluation::run(scalar_t alpha, const std::string& policyF
     metrics.incurredHamiltonian = std::numeric_limits<scalar_t>::quiet_NaN();
   }
 
+  // finish system
+  finish();
+
   // report survival time
   metrics.survivalTime = systemObservation_.time;
 
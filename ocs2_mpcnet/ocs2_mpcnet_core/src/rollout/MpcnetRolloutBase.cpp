@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_mpcnet_core/rollout/MpcnetRolloutBase.h"
 
+#include <ocs2_core/misc/Numerics.h>
+
 #include "ocs2_mpcnet_core/control/MpcnetBehavioralController.h"
 
 namespace ocs2 {
@@ -58,6 +60,15 @@ void MpcnetRolloutBase::set(scalar_t alpha, const std::string& policyFilePath, c
   // set up behavioral controller with mixture parameter alpha and learned controller
   behavioralControllerPtr_->setAlpha(alpha);
   behavioralControllerPtr_->setLearnedController(*mpcnetPtr_);
+
+  // join the lockstep batch, unless the learned controller is not used by the behavioral controller
+  if (batchInferencePtr_ != nullptr && !numerics::almost_eq(alpha, 1.0)) {
+    if (mpcnetPtr_->getType() != ControllerType::ONNX) {
+      throw std::runtime_error("[MpcnetRolloutBase::set] batch inference requires an ONNX policy.");
+    }
+    batchInferencePtr_->join(policyFilePath);
+    isInBatch_ = true;
+  }
 }
 
 /******************************************************************************************************/
@@ -75,6 +86,15 @@ void MpcnetRolloutBase::step(scalar_t timeStep) {
   // update behavioral controller with MPC controller
   behavioralControllerPtr_->setOptimalController(*primalSolution_.controllerPtr_);
 
+  // evaluate the learned controller at the initial time and state together with the other rollouts of the batch
+  if (isInBatch_) {
+    auto& learnedController = static_cast<MpcnetOnnxController&>(*behavioralControllerPtr_->getLearnedControllerPtr());
+    const scalar_t time = primalSolution_.timeTrajectory_.front();
+    const vector_t& state = primalSolution_.stateTrajectory_.front();
+    const vector_t action = batchInferencePtr_->computeAction(learnedController.getObservation(time, state));
+    learnedController.holdInput(time, state, learnedController.getInput(time, state, action));
+  }
+
   // forward simulate system with behavioral controller
   scalar_array_t timeTrajectory;
   size_array_t postEventIndicesStock;
@@ -97,5 +117,15 @@ void MpcnetRolloutBase::step(scalar_t timeStep) {
   }
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MpcnetRolloutBase::finish() {
+  if (isInBatch_) {
+    batchInferencePtr_->leave();
+    isInBatch_ = false;
+  }
+}
+
 }  // namespace mpcnet
 }  // namespace ocs2
@@ -45,11 +45,16 @@ MpcnetRolloutManager::MpcnetRolloutManager(size_t nDataGenerationThreads, size_t
   nDataGenerationThreads_ = nDataGenerationThreads;
   if (nDataGenerationThreads_ > 0) {
     dataGenerationThreadPoolPtr_.reset(new ThreadPool(nDataGenerationThreads_));
+    if (mpcnetPtrs.at(0)->getType() == ControllerType::ONNX) {
+      dataGenerationBatchInferencePtr_ =
+          std::make_shared<MpcnetOnnxBatchInference>(static_cast<const MpcnetOnnxController&>(*mpcnetPtrs.at(0)));
+    }
     dataGenerationPtrs_.reserve(nDataGenerationThreads);
     for (int i = 0; i < nDataGenerationThreads; i++) {
       dataGenerationPtrs_.push_back(
           std::make_unique<MpcnetDataGeneration>(std::move(mpcPtrs.at(i)), std::move(mpcnetPtrs.at(i)), std::move(rolloutPtrs.at(i)),
                                                  std::move(mpcnetDefinitionPtrs.at(i)), referenceManagerPtrs.at(i)));
+      dataGenerationPtrs_.back()->setBatchInference(dataGenerationBatchInferencePtr_);
     }
   }
 
@@ -57,11 +62,16 @@ MpcnetRolloutManager::MpcnetRolloutManager(size_t nDataGenerationThreads, size_t
   nPolicyEvaluationThreads_ = nPolicyEvaluationThreads;
   if (nPolicyEvaluationThreads_ > 0) {
     policyEvaluationThreadPoolPtr_.reset(new ThreadPool(nPolicyEvaluationThreads_));
+    if (mpcnetPtrs.at(nDataGenerationThreads_)->getType() == ControllerType::ONNX) {
+      policyEvaluationBatchInferencePtr_ =
+          std::make_shared<MpcnetOnnxBatchInference>(static_cast<const MpcnetOnnxController&>(*mpcnetPtrs.at(nDataGenerationThreads_)));
+    }
     policyEvaluationPtrs_.reserve(nPolicyEvaluationThreads_);
     for (int i = nDataGenerationThreads_; i < (nDataGenerationThreads_ + nPolicyEvaluationThreads_); i++) {
       policyEvaluationPtrs_.push_back(
           std::make_unique<MpcnetPolicyEvaluation>(std::move(mpcPtrs.at(i)), std::move(mpcnetPtrs.at(i)), std::move(rolloutPtrs.at(i)),
                                                    std::move(mpcnetDefinitionPtrs.at(i)), referenceManagerPtrs.at(i)));
+      policyEvaluationPtrs_.back()->setBatchInference(policyEvaluationBatchInferencePtr_);
     }
   }
 }
@@ -81,6 +91,10 @@ void MpcnetRolloutManager::startDataGeneration(scalar_t alpha, const std::string
   // reset variables
   dataGenerationFtrs_.clear();
   nDataGenerationTasksDone_ = 0;
+  if (dataGenerationBatchInferencePtr_ != nullptr) {
+    dataGenerationBatchInferencePtr_->resetStatistics();
+  }
+  dataGenerationTimer_.startTimer();
 
   // push tasks into pool
   for (int i = 0; i < initialObservations.size(); i++) {
@@ -88,9 +102,14 @@ void MpcnetRolloutManager::startDataGeneration(scalar_t alpha, const std::string
       const auto* result =
           dataGenerationPtrs_[threadNumber]->run(alpha, policyFilePath, timeStep, dataDecimation, nSamples, samplingCovariance,
                                                  initialObservations.at(i), modeSchedules.at(i), targetTrajectories.at(i));
-      nDataGenerationTasksDone_++;
+      const int nTasksDone = ++nDataGenerationTasksDone_;
       // print thread and task number
-      std::cerr << "Data generation thread " << threadNumber << " finished task " << nDataGenerationTasksDone_ << "\n";
+      std::cerr << "Data generation thread " << threadNumber << " finished task " << nTasksDone << "\n";
+      // print throughput after the last task
+      if (nTasksDone == static_cast<int>(initialObservations.size()) && dataGenerationBatchInferencePtr_ != nullptr) {
+        dataGenerationTimer_.endTimer();
+        printThroughput("Data generation", *dataGenerationBatchInferencePtr_, dataGenerationTimer_.getLastIntervalInMilliseconds());
+      }
       return result;
     }));
   }
@@ -175,15 +194,24 @@ void MpcnetRolloutManager::startPolicyEvaluation(scalar_t alpha, const std::stri
   // reset variables
   policyEvaluationFtrs_.clear();
   nPolicyEvaluationTasksDone_ = 0;
+  if (policyEvaluationBatchInferencePtr_ != nullptr) {
+    policyEvaluationBatchInferencePtr_->resetStatistics();
+  }
+  policyEvaluationTimer_.startTimer();
 
   // push tasks into pool
   for (int i = 0; i < initialObservations.size(); i++) {
     policyEvaluationFtrs_.push_back(policyEvaluationThreadPoolPtr_->run([=](int threadNumber) {
       const auto result = policyEvaluationPtrs_[threadNumber]->run(alpha, policyFilePath, timeStep, initialObservations.at(i),
                                                                    modeSchedules.at(i), targetTrajectories.at(i));
-      nPolicyEvaluationTasksDone_++;
+      const int nTasksDone = ++nPolicyEvaluationTasksDone_;
       // print thread and task number
-      std::cerr << "Policy evaluation thread " << threadNumber << " finished task " << nPolicyEvaluationTasksDone_ << "\n";
+      std::cerr << "Policy evaluation thread " << threadNumber << " finished task " << nTasksDone << "\n";
+      // print throughput after the last task
+      if (nTasksDone == static_cast<int>(initialObservations.size()) && policyEvaluationBatchInferencePtr_ != nullptr) {
+        policyEvaluationTimer_.endTimer();
+        printThroughput("Policy evaluation", *policyEvaluationBatchInferencePtr_, policyEvaluationTimer_.getLastIntervalInMilliseconds());
+      }
       return result;
     }));
   }
@@ -239,5 +267,20 @@ metrics_array_t MpcnetRolloutManager::getComputedMetrics() {
   return metricsArray;
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void MpcnetRolloutManager::printThroughput(const std::string& name, const MpcnetOnnxBatchInference& batchInference, scalar_t elapsedTime) {
+  const size_t nSamples = batchInference.getNumSamples();
+  const int nInferences = batchInference.getNumInferences();
+  if (nInferences == 0) {
+    return;
+  }
+  std::cerr << name << ": " << nSamples << " policy evaluations in " << nInferences << " inferences (mean batch size "
+            << static_cast<scalar_t>(nSamples) / nInferences << "), "
+            << 1000.0 * nSamples / batchInference.getTotalInferenceTimeInMilliseconds() << " evaluations/s during inference, "
+            << 1000.0 * nSamples / elapsedTime << " evaluations/s overall.\n";
+}
+
 }  // namespace mpcnet
 }  // namespace ocs2
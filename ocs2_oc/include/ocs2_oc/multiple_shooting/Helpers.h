@@ -89,6 +89,19 @@ void remapProjectedGain(const std::vector<VectorFunctionLinearApproximation>& co
 PrimalSolution toPrimalSolution(const std::vector<AnnotatedTime>& time, ModeSchedule&& modeSchedule, vector_array_t&& x,
                                 vector_array_t&& u);
 
+/**
+ * Writes a primal solution (with a feedforward controller) based the LQ subproblem solution into an existing primal solution. The memory
+ * of the trajectories and of an existing feedforward controller is reused.
+ *
+ * @param [in] time : The annotated time trajectory
+ * @param [in] modeSchedule: The mode schedule.
+ * @param [in] x: The state trajectory of the QP subproblem solution.
+ * @param [in] u: The input trajectory of the QP subproblem solution.
+ * @param [out] primalSolution: The primal solution.
+ */
+void toPrimalSolution(const std::vector<AnnotatedTime>& time, const ModeSchedule& modeSchedule, const vector_array_t& x,
+                      const vector_array_t& u, PrimalSolution& primalSolution);
+
 /**
  * Constructs a primal solution (with a linear controller) based the LQ subproblem solution.
  *
@@ -111,5 +124,14 @@ PrimalSolution toPrimalSolution(const std::vector<AnnotatedTime>& time, ModeSche
  */
 ProblemMetrics toProblemMetrics(const std::vector<AnnotatedTime>& time, std::vector<Metrics>&& metrics);
 
+/**
+ * Writes the metrics into an existing ProblemMetrics. The metrics are swapped in, such that both sides keep their memory.
+ *
+ * @param [in] time : The annotated time trajectory
+ * @param [in, out] metrics: The metrics array. Holds the previous content of problemMetrics on return.
+ * @param [out] problemMetrics: The ProblemMetrics.
+ */
+void toProblemMetrics(const std::vector<AnnotatedTime>& time, std::vector<Metrics>& metrics, ProblemMetrics& problemMetrics);
+
 }  // namespace multiple_shooting
 }  // namespace ocs2
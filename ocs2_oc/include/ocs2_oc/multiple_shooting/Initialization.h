@@ -67,6 +67,24 @@ inline std::pair<vector_t, vector_t> initializeIntermediateNode(const PrimalSolu
           LinearInterpolation::interpolate(tNext, primalSolution.timeTrajectory_, primalSolution.stateTrajectory_)};
 }
 
+/**
+ * Interpolate a primal solution for state-input initialization at a intermediate node. Same as above, but looks up the times with a
+ * cursor, which is faster when the nodes are initialized in order.
+ *
+ * @param primalSolution : previous solution
+ * @param t :  Start of the discrete interval
+ * @param tNext : End time of te discrete interval
+ * @param cursor : cursor into the time trajectory of the primal solution
+ * @return {u(t), x(tNext)} : input and state transition
+ */
+inline std::pair<vector_t, vector_t> initializeIntermediateNode(const PrimalSolution& primalSolution, scalar_t t, scalar_t tNext,
+                                                                LinearInterpolation::TimeSegmentCursor& cursor) {
+  const auto& timeTrajectory = primalSolution.timeTrajectory_;
+  vector_t input = LinearInterpolation::interpolate(cursor.timeSegment(t, timeTrajectory), primalSolution.inputTrajectory_);
+  vector_t nextState = LinearInterpolation::interpolate(cursor.timeSegment(tNext, timeTrajectory), primalSolution.stateTrajectory_);
+  return {std::move(input), std::move(nextState)};
+}
+
 /**
  * Initialize the state jump at an event node.
  *
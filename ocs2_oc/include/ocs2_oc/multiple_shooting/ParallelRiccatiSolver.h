@@ -0,0 +1,147 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/thread_support/ThreadPool.h>
+
+namespace ocs2 {
+
+/**
+ * Parallel-in-time Riccati solver for the linear quadratic subproblems of multiple-shooting solvers without constraints:
+ *
+ * min  sum_k 0.5 x_k' Q_k x_k + u_k' P_k x_k + 0.5 u_k' R_k u_k + q_k' x_k + r_k' u_k  +  0.5 x_N' Q_N x_N + q_N' x_N
+ * s.t. x_{k+1} = A_k x_k + B_k u_k + b_k,  x_0 given.
+ *
+ * The horizon is partitioned into one block of stages per thread. Each block condenses its stages into a single conditional
+ * value function element (A, b, C, eta, J), which represents the minimal cost of moving from the block's first state to its last:
+ *
+ * V(x, y) = max_lambda  0.5 x' J x - eta' x + lambda' (y - A x - b) - 0.5 lambda' C lambda.
+ *
+ * The elements are combined by an associative operator, see [Sarkka and Garcia-Fernandez, "Temporal Parallelization of Dynamic
+ * Programming and Linear Quadratic Control", 2023]. The reduced interface system of the blocks is solved serially for the cost-to-go and
+ * the optimal state at the block boundaries. Afterwards, every block runs a regular Riccati recursion from its boundary cost-to-go and a
+ * rollout from its boundary state.
+ *
+ * The result is identical to a serial Riccati recursion up to round-off errors. The stage input Hessians R_k must be positive definite.
+ */
+class ParallelRiccatiSolver {
+ public:
+  /**
+   * Solves the linear quadratic problem.
+   *
+   * @param [in] threadPool: The thread pool. All of its threads and the calling thread are used.
+   * @param [in] x0: The initial state (deviation).
+   * @param [in] dynamics: Linearized approximation of the discrete dynamics, size N.
+   * @param [in] cost: Quadratic approximation of the cost, size N + 1.
+   * @param [out] stateTrajectory: The solution state (deviation) trajectory, size N + 1.
+   * @param [out] inputTrajectory: The solution input (deviation) trajectory, size N.
+   */
+  void solve(ThreadPool& threadPool, const vector_t& x0, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+             const std::vector<ScalarFunctionQuadraticApproximation>& cost, vector_array_t& stateTrajectory,
+             vector_array_t& inputTrajectory);
+
+  /**
+   * Returns the cost-to-go of the previously solved problem: V_k(x) = 0.5 * x' * dfdxx * x + x' * dfdx + f. As for HpipmInterface, the
+   * value of f is set to zero.
+   */
+  const std::vector<ScalarFunctionQuadraticApproximation>& getRiccatiCostToGo() const { return costToGo_; }
+
+  /** Returns the N feedback matrices K of the optimal solution u = K x + k of the previously solved problem. */
+  const matrix_array_t& getRiccatiFeedback() const { return feedback_; }
+
+  /** Returns the N feedforward vectors k of the optimal solution u = K x + k of the previously solved problem. */
+  const vector_array_t& getRiccatiFeedforward() const { return feedforward_; }
+
+ private:
+  /** Conditional value function element of a sequence of stages, see the class description. */
+  struct Element {
+    matrix_t A;
+    vector_t b;
+    matrix_t C;
+    vector_t eta;
+    matrix_t J;
+  };
+
+  /** Workspace of a block, reused across solves. */
+  struct BlockWorkspace {
+    Element element;
+    // Stage element
+    matrix_t stageA;
+    vector_t stageb;
+    matrix_t stageJ;
+    vector_t stageEta;
+    matrix_t RinvP;
+    vector_t Rinvr;
+    // Element combination and Riccati recursion
+    Eigen::LLT<matrix_t> inputHessianLlt;
+    Eigen::PartialPivLU<matrix_t> couplingLu;
+    matrix_t SA;
+    matrix_t SB;
+    matrix_t G;
+    matrix_t HinvG;
+    vector_t g;
+    matrix_t tmpMatrix;
+    vector_t tmpVector;
+  };
+
+  /** Condenses the stages [first, last) into workspace.element. */
+  static void condenseBlock(size_t first, size_t last, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                            const std::vector<ScalarFunctionQuadraticApproximation>& cost, BlockWorkspace& workspace);
+
+  /** Combines the element of a single stage with the element of the stages that follow it, stored in workspace.element. */
+  static void prependStage(const VectorFunctionLinearApproximation& dynamics, const ScalarFunctionQuadraticApproximation& cost,
+                           BlockWorkspace& workspace);
+
+  /**
+   * Computes the cost-to-go at the start of a block from the cost-to-go at its end. The factorization of I + C * S is kept in
+   * workspace.couplingLu for stateAtBlockEnd().
+   */
+  static void valueAtBlockStart(const ScalarFunctionQuadraticApproximation& valueAtEnd, ScalarFunctionQuadraticApproximation& valueAtStart,
+                                BlockWorkspace& workspace);
+
+  /** Computes the optimal state at the end of a block from the state at its start: x_end = inv(I + C * S) * (A x_start + b - C * s). */
+  static void stateAtBlockEnd(const vector_t& stateAtStart, const ScalarFunctionQuadraticApproximation& valueAtEnd, vector_t& stateAtEnd,
+                              BlockWorkspace& workspace);
+
+  /** Riccati recursion over the stages [first, last) followed by the rollout from the state at first. */
+  void solveBlock(size_t blockIndex, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                  const std::vector<ScalarFunctionQuadraticApproximation>& cost, vector_array_t& stateTrajectory,
+                  vector_array_t& inputTrajectory);
+
+  std::vector<size_t> blockStart_;
+  std::vector<BlockWorkspace> workspace_;
+
+  std::vector<ScalarFunctionQuadraticApproximation> costToGo_;
+  matrix_array_t feedback_;
+  vector_array_t feedforward_;
+};
+
+}  // namespace ocs2
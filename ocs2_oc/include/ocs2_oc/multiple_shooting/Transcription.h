@@ -31,6 +31,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_core/Types.h>
 #include <ocs2_core/integration/SensitivityIntegrator.h>
+#include <ocs2_core/model_data/Metrics.h>
 
 #include "ocs2_oc/multiple_shooting/ProjectionMultiplierCoefficients.h"
 #include "ocs2_oc/oc_problem/OptimalControlProblem.h"
@@ -86,6 +87,35 @@ Transcription setupIntermediateNode(OptimalControlProblem& optimalControlProblem
  */
 void projectTranscription(Transcription& transcription, bool extractProjectionMultiplier = false);
 
+/**
+ * Apply the state-input equality constraint projection to the terms of a single intermediate node, without modifying its state-input
+ * equality constraints. This allows to keep the unprojected transcription and to project a copy of its terms.
+ *
+ * @param stateInputEqConstraints : State-input equality constraints of the node.
+ * @param dynamics : Dynamics of the node, projected in place.
+ * @param cost : Cost of the node, projected in place.
+ * @param stateInputIneqConstraints : State-input inequality constraints of the node, projected in place.
+ * @param constraintsProjection : Output constraint projection, empty if there are no state-input equality constraints.
+ * @param projectionMultiplierCoefficients : Output projection multiplier coefficients.
+ * @param extractProjectionMultiplier : Whether to extract the projection multiplier.
+ */
+void projectTranscription(const VectorFunctionLinearApproximation& stateInputEqConstraints, VectorFunctionLinearApproximation& dynamics,
+                          ScalarFunctionQuadraticApproximation& cost, VectorFunctionLinearApproximation& stateInputIneqConstraints,
+                          VectorFunctionLinearApproximation& constraintsProjection,
+                          ProjectionMultiplierCoefficients& projectionMultiplierCoefficients, bool extractProjectionMultiplier = false);
+
+/**
+ * Moves an (unprojected) intermediate node transcription to a nearby point without recomputing its derivatives. The zeroth-order terms
+ * are taken from the metrics evaluated at the new point, the cost gradient is shifted to first order with the cost Hessian, and all other
+ * derivatives are kept.
+ *
+ * @param transcription : Transcription of an intermediate node, before projection.
+ * @param metrics : Metrics at the new point, see computeIntermediateMetrics.
+ * @param dx : State difference between the new point and the point of the transcription.
+ * @param du : Input difference between the new point and the point of the transcription.
+ */
+void updateTranscription(Transcription& transcription, const Metrics& metrics, const vector_t& dx, const vector_t& du);
+
 /**
  * Results of the transcription at a terminal node
  */
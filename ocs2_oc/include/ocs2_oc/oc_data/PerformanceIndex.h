@@ -84,6 +84,15 @@ struct PerformanceIndex {
    */
   scalar_t inequalityLagrangian = 0.0;
 
+  /**
+   * Time budget report of the solver run, see SolverBase::setTimeBudget(). These flags describe the run rather than a trajectory,
+   * therefore they are ignored by the arithmetic operators and by isApprox().
+   * - earlyExit: the solver stopped before convergence since its next iteration was expected to exceed the time budget
+   * - deadlineMissed: the solver run took longer than the time budget
+   */
+  bool earlyExit = false;
+  bool deadlineMissed = false;
+
   /** Add performance indices. */
   PerformanceIndex& operator+=(const PerformanceIndex& rhs);
 
@@ -56,7 +56,7 @@ struct PrimalSolution {
         modeSchedule_(other.modeSchedule_),
         controllerPtr_(other.controllerPtr_ ? other.controllerPtr_->clone() : nullptr) {}
 
-  /** Copy Assignment */
+  /** Copy Assignment, reuses the memory of this solution and of its controller if it has the same type */
   PrimalSolution& operator=(const PrimalSolution& other) {
     timeTrajectory_ = other.timeTrajectory_;
     stateTrajectory_ = other.stateTrajectory_;
@@ -64,7 +64,9 @@ struct PrimalSolution {
     postEventIndices_ = other.postEventIndices_;
     modeSchedule_ = other.modeSchedule_;
     if (other.controllerPtr_) {
-      controllerPtr_.reset(other.controllerPtr_->clone());
+      if (controllerPtr_ == nullptr || !controllerPtr_->copyFrom(*other.controllerPtr_)) {
+        controllerPtr_.reset(other.controllerPtr_->clone());
+      }
     } else {
       controllerPtr_.reset();
     }
@@ -76,6 +76,27 @@ std::vector<AnnotatedTime> timeDiscretizationWithEvents(scalar_t initTime, scala
                                                         const scalar_array_t& eventTimes,
                                                         scalar_t dt_min = 10.0 * numeric_traits::limitEpsilon<scalar_t>());
 
+/**
+ * Decides on a non-uniform time discretization along the horizon. The first step is dt, and every following step is dtGrowthFactor times
+ * larger than the previous one, until it reaches dtMax. The step is reset to dt after every event, such that the dynamics right after a
+ * mode switch are resolved as finely as at the start of the horizon. Event times are always part of the discretization.
+ *
+ * For dtGrowthFactor = 1 the result is identical to the uniform discretization above.
+ *
+ * @param initTime : start time.
+ * @param finalTime : final time.
+ * @param dt : the smallest discretization step, used at the start of the horizon and after events.
+ * @param dtGrowthFactor : ratio between consecutive steps. Needs to be >= 1.
+ * @param dtMax : the largest discretization step. Values smaller than dt are ignored.
+ * @param eventTimes : Event times where a time discretization must be made.
+ * @param dt_min : minimum discretization step. Smaller intervals will be merged. Needs to be bigger than limitEpsilon to avoid
+ * interpolation problems
+ * @return vector of discrete time points
+ */
+std::vector<AnnotatedTime> timeDiscretizationWithEvents(scalar_t initTime, scalar_t finalTime, scalar_t dt, scalar_t dtGrowthFactor,
+                                                        scalar_t dtMax, const scalar_array_t& eventTimes,
+                                                        scalar_t dt_min = 10.0 * numeric_traits::limitEpsilon<scalar_t>());
+
 /**
  * Extracts the time trajectory from the annotated time trajectory.
  *
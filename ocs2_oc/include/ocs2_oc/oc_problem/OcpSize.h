@@ -80,10 +80,26 @@ bool operator==(const OcpSize& lhs, const OcpSize& rhs) noexcept;
  * @param dynamics : Linearized approximation of the discrete dynamics.
  * @param cost : Quadratic approximation of the cost.
  * @param constraints : Linearized approximation of constraints, all constraints are mapped to inequality constraints in HPIPM.
+ * @param ineqConstraints : Linearized approximation of general inequality constraints. They are stacked below the equality constraints.
  * @return Derived sizes
  */
 OcpSize extractSizesFromProblem(const std::vector<VectorFunctionLinearApproximation>& dynamics,
                                 const std::vector<ScalarFunctionQuadraticApproximation>& cost,
-                                const std::vector<VectorFunctionLinearApproximation>* constraints);
+                                const std::vector<VectorFunctionLinearApproximation>* constraints,
+                                const std::vector<VectorFunctionLinearApproximation>* ineqConstraints = nullptr);
+
+/**
+ * Extract sizes based on the problem data. Overload that writes into an existing OcpSize to reuse its memory.
+ *
+ * @param dynamics : Linearized approximation of the discrete dynamics.
+ * @param cost : Quadratic approximation of the cost.
+ * @param constraints : Linearized approximation of constraints, all constraints are mapped to inequality constraints in HPIPM.
+ * @param ineqConstraints : Linearized approximation of general inequality constraints. They are stacked below the equality constraints.
+ * @param [out] problemSize : Derived sizes
+ */
+void extractSizesFromProblem(const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                             const std::vector<ScalarFunctionQuadraticApproximation>& cost,
+                             const std::vector<VectorFunctionLinearApproximation>* constraints,
+                             const std::vector<VectorFunctionLinearApproximation>* ineqConstraints, OcpSize& problemSize);
 
 }  // namespace ocs2
\ No newline at end of file
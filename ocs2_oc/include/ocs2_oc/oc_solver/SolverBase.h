@@ -29,7 +29,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #pragma once
 
+#include <chrono>
 #include <iostream>
+#include <map>
 #include <memory>
 #include <mutex>
 #include <vector>
@@ -102,6 +104,17 @@ class SolverBase {
    */
   void run(scalar_t initTime, const vector_t& initState, scalar_t finalTime, const PrimalSolution& primalSolution);
 
+  /**
+   * Sets the wall-clock time budget of a single call to run(). Once the next iteration is expected to exceed the budget, the solver stops
+   * and returns its latest accepted iterate. The early exit and a missed budget are reported by the PerformanceIndex of the solution.
+   *
+   * @param [in] timeBudget: The time budget in seconds. Any non-positive number disables the budget.
+   */
+  void setTimeBudget(scalar_t timeBudget) { timeBudget_ = timeBudget; }
+
+  /** Returns the wall-clock time budget of a single call to run() in seconds. A non-positive number means there is no budget. */
+  scalar_t getTimeBudget() const { return timeBudget_; }
+
   /**
    * Sets the ReferenceManager which manages both ModeSchedule and TargetTrajectories. This module updates before SynchronizedModules.
    */
@@ -245,6 +258,12 @@ class SolverBase {
    */
   virtual std::string getBenchmarkingInfo() const { return {}; }
 
+  /**
+   * Gets the total wall-clock time [ms] of each phase of the solver (e.g. "solveQp") since the last reset(), as measured by the
+   * benchmarking timers of the solver.
+   */
+  virtual std::map<std::string, scalar_t> getBenchmarkingTimes() const { return {}; }
+
   /**
    * Prints to output.
    *
@@ -252,6 +271,15 @@ class SolverBase {
    */
   void printString(const std::string& text) const;
 
+ protected:
+  /**
+   * Checks whether the remaining time budget of the current call to run() is too short for a task of the given expected duration.
+   * Always returns false if there is no time budget.
+   *
+   * @param [in] expectedDuration: The expected duration of the task in milliseconds, e.g. the duration of the last iteration.
+   */
+  bool exceedsTimeBudget(scalar_t expectedDuration) const;
+
  private:
   virtual void runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime) = 0;
 
@@ -270,6 +298,9 @@ class SolverBase {
   std::shared_ptr<ReferenceManagerInterface> referenceManagerPtr_;  // this pointer cannot be nullptr
   std::vector<std::shared_ptr<SolverSynchronizedModule>> synchronizedModules_;
   std::vector<std::unique_ptr<SolverObserver>> solverObservers_;
+
+  scalar_t timeBudget_ = -1.0;
+  std::chrono::steady_clock::time_point runStartTime_;
 };
 
 }  // namespace ocs2
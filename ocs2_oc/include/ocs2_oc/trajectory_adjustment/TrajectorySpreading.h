@@ -30,6 +30,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #pragma once
 
 #include <ocs2_core/Types.h>
+#include <ocs2_core/misc/ContiguousTrajectory.h>
 #include <ocs2_core/reference/ModeSchedule.h>
 
 namespace ocs2 {
@@ -69,6 +70,16 @@ class TrajectorySpreading final {
   template <typename T>
   void adjustTrajectory(std::vector<T>& trajectory) const;
 
+  /**
+   * Adjust continuous-time trajectory which is stored in a contiguous buffer. The spreading values are copied to a member buffer,
+   * such that adjusting several trajectories with the same instance only allocates once.
+   *
+   * @tparam Eigen matrix type.
+   * @param [in, out] trajectory: trajectory for rectification.
+   */
+  template <typename Matrix>
+  void adjustTrajectory(ContiguousTrajectory<Matrix>& trajectory);
+
   /**
    * Extracts event-time data.
    *
@@ -148,6 +159,8 @@ class TrajectorySpreading final {
 
   size_array_t updatedPostEventIndices_;
   scalar_array_t updatedMatchedEventTimes_;
+
+  ContiguousTrajectory<matrix_t> spreadingValuesBuffer_; /**< Spreading values of the contiguous trajectories **/
 };
 
 /******************************************************************************************************/
@@ -182,4 +195,26 @@ void TrajectorySpreading::adjustTrajectory(std::vector<T>& trajectory) const {
   }    // end of j loop
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+template <typename Matrix>
+void TrajectorySpreading::adjustTrajectory(ContiguousTrajectory<Matrix>& trajectory) {
+  // erase segment of trajectory associated to mismatched modes
+  trajectory.truncate(eraseFromIndex_);
+
+  // extract spreading values beforehand since they might be overridden
+  spreadingValuesBuffer_.clear();
+  for (const auto ind : spreadingValueIndices_) {
+    spreadingValuesBuffer_.push_back(trajectory[ind]);
+  }
+
+  // spread
+  for (size_t i = 0; i < spreadingValueIndices_.size(); i++) {
+    for (size_t j = beginIndices_[i]; j < endIndices_[i]; j++) {
+      trajectory.set(j, spreadingValuesBuffer_[i]);
+    }  // end of i loop
+  }    // end of j loop
+}
+
 }  // namespace ocs2
@@ -186,23 +186,18 @@ ScalarFunctionQuadraticApproximation approximateCost(const OptimalControlProblem
   // get the state-input cost approximations
   auto cost = problem.costPtr->getQuadraticApproximation(time, state, input, targetTrajectories, preComputation);
 
+  // accumulate the other approximations in place
   if (!problem.softConstraintPtr->empty()) {
-    cost += problem.softConstraintPtr->getQuadraticApproximation(time, state, input, targetTrajectories, preComputation);
+    problem.softConstraintPtr->accumulateQuadraticApproximation(time, state, input, targetTrajectories, preComputation, cost);
   }
 
   // get the state only cost approximations
   if (!problem.stateCostPtr->empty()) {
-    auto stateCost = problem.stateCostPtr->getQuadraticApproximation(time, state, targetTrajectories, preComputation);
-    cost.f += stateCost.f;
-    cost.dfdx += stateCost.dfdx;
-    cost.dfdxx += stateCost.dfdxx;
+    problem.stateCostPtr->accumulateQuadraticApproximation(time, state, targetTrajectories, preComputation, cost);
   }
 
   if (!problem.stateSoftConstraintPtr->empty()) {
-    auto stateCost = problem.stateSoftConstraintPtr->getQuadraticApproximation(time, state, targetTrajectories, preComputation);
-    cost.f += stateCost.f;
-    cost.dfdx += stateCost.dfdx;
-    cost.dfdxx += stateCost.dfdxx;
+    problem.stateSoftConstraintPtr->accumulateQuadraticApproximation(time, state, targetTrajectories, preComputation, cost);
   }
 
   return cost;
@@ -231,7 +226,7 @@ ScalarFunctionQuadraticApproximation approximateEventCost(const OptimalControlPr
 
   auto cost = problem.preJumpCostPtr->getQuadraticApproximation(time, state, targetTrajectories, preComputation);
   if (!problem.preJumpSoftConstraintPtr->empty()) {
-    cost += problem.preJumpSoftConstraintPtr->getQuadraticApproximation(time, state, targetTrajectories, preComputation);
+    problem.preJumpSoftConstraintPtr->accumulateQuadraticApproximation(time, state, targetTrajectories, preComputation, cost);
   }
 
   return cost;
@@ -260,7 +255,7 @@ ScalarFunctionQuadraticApproximation approximateFinalCost(const OptimalControlPr
 
   auto cost = problem.finalCostPtr->getQuadraticApproximation(time, state, targetTrajectories, preComputation);
   if (!problem.finalSoftConstraintPtr->empty()) {
-    cost += problem.finalSoftConstraintPtr->getQuadraticApproximation(time, state, targetTrajectories, preComputation);
+    problem.finalSoftConstraintPtr->accumulateQuadraticApproximation(time, state, targetTrajectories, preComputation, cost);
   }
 
   return cost;
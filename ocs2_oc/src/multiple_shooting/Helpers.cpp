@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_oc/multiple_shooting/Helpers.h"
 
+#include <algorithm>
+
 #include <ocs2_core/control/FeedforwardController.h>
 #include <ocs2_core/control/LinearController.h>
 
@@ -79,6 +81,42 @@ PrimalSolution toPrimalSolution(const std::vector<AnnotatedTime>& time, ModeSche
   return primalSolution;
 }
 
+void toPrimalSolution(const std::vector<AnnotatedTime>& time, const ModeSchedule& modeSchedule, const vector_array_t& x,
+                      const vector_array_t& u, PrimalSolution& primalSolution) {
+  // Construct nominal time and state trajectories
+  primalSolution.timeTrajectory_.resize(time.size());
+  std::transform(time.begin(), time.end(), primalSolution.timeTrajectory_.begin(), [](const AnnotatedTime& t) { return t.time; });
+  primalSolution.postEventIndices_.clear();
+  for (size_t i = 0; i < time.size(); i++) {
+    if (time[i].event == AnnotatedTime::Event::PreEvent) {
+      primalSolution.postEventIndices_.push_back(i + 1);
+    }
+  }
+  primalSolution.stateTrajectory_ = x;
+
+  // Correct for missing inputs at PreEvents and the terminal time, and repeat last input to make equal length vectors
+  auto& inputTrajectory = primalSolution.inputTrajectory_;
+  inputTrajectory.resize(u.size() + 1);
+  for (int i = 0; i < u.size(); ++i) {
+    if (time[i].event == AnnotatedTime::Event::PreEvent && i > 0) {
+      inputTrajectory[i] = inputTrajectory[i - 1];
+    } else {
+      inputTrajectory[i] = u[i];
+    }
+  }
+  inputTrajectory.back() = inputTrajectory[u.size() - 1];
+
+  primalSolution.modeSchedule_ = modeSchedule;
+
+  // Reuse the controller if it has the right type
+  auto* controllerPtr = dynamic_cast<FeedforwardController*>(primalSolution.controllerPtr_.get());
+  if (controllerPtr != nullptr) {
+    controllerPtr->setController(primalSolution.timeTrajectory_, inputTrajectory);
+  } else {
+    primalSolution.controllerPtr_.reset(new FeedforwardController(primalSolution.timeTrajectory_, inputTrajectory));
+  }
+}
+
 PrimalSolution toPrimalSolution(const std::vector<AnnotatedTime>& time, ModeSchedule&& modeSchedule, vector_array_t&& x, vector_array_t&& u,
                                 matrix_array_t&& KMatrices) {
   // Compute feedback, before x and u are moved to primal solution
@@ -143,5 +181,30 @@ ProblemMetrics toProblemMetrics(const std::vector<AnnotatedTime>& time, std::vec
   return problemMetrics;
 }
 
+void toProblemMetrics(const std::vector<AnnotatedTime>& time, std::vector<Metrics>& metrics, ProblemMetrics& problemMetrics) {
+  assert(time.size() > 1);
+  assert(metrics.size() == time.size());
+
+  // Problem horizon
+  const int N = static_cast<int>(time.size()) - 1;
+
+  // resize
+  const auto numPreJumps =
+      std::count_if(time.begin(), time.begin() + N, [](const AnnotatedTime& t) { return t.event == AnnotatedTime::Event::PreEvent; });
+  problemMetrics.preJumps.resize(numPreJumps);
+  problemMetrics.intermediates.resize(N - numPreJumps);
+  problemMetrics.final.swap(metrics.back());
+
+  int preJumpIndex = 0;
+  int intermediateIndex = 0;
+  for (int i = 0; i < N; ++i) {
+    if (time[i].event == AnnotatedTime::Event::PreEvent) {
+      problemMetrics.preJumps[preJumpIndex++].swap(metrics[i]);
+    } else {
+      problemMetrics.intermediates[intermediateIndex++].swap(metrics[i]);
+    }
+  }
+}
+
 }  // namespace multiple_shooting
 }  // namespace ocs2
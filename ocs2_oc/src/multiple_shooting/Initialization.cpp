@@ -49,10 +49,13 @@ void initializeStateInputTrajectories(const vector_t& initState, const std::vect
     interpolateInputTill = primalSolution.timeTrajectory_[primalSolution.timeTrajectory_.size() - 2];
   }
 
+  LinearInterpolation::TimeSegmentCursor cursor;
+
   // Initial state
   const scalar_t initTime = getIntervalStart(timeDiscretization[0]);
   if (initTime < interpolateStateTill) {
-    stateTrajectory.push_back(LinearInterpolation::interpolate(initTime, primalSolution.timeTrajectory_, primalSolution.stateTrajectory_));
+    stateTrajectory.push_back(
+        LinearInterpolation::interpolate(cursor.timeSegment(initTime, primalSolution.timeTrajectory_), primalSolution.stateTrajectory_));
   } else {
     stateTrajectory.push_back(initState);
   }
@@ -70,7 +73,7 @@ void initializeStateInputTrajectories(const vector_t& initState, const std::vect
       if (time > interpolateInputTill || nextTime > interpolateStateTill) {  // Using initializer
         std::tie(input, nextState) = initializeIntermediateNode(initializer, time, nextTime, stateTrajectory.back());
       } else {  // interpolate previous solution
-        std::tie(input, nextState) = initializeIntermediateNode(primalSolution, time, nextTime);
+        std::tie(input, nextState) = initializeIntermediateNode(primalSolution, time, nextTime, cursor);
       }
       inputTrajectory.push_back(std::move(input));
       stateTrajectory.push_back(std::move(nextState));
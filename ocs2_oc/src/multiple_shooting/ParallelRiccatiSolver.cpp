@@ -0,0 +1,284 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_oc/multiple_shooting/ParallelRiccatiSolver.h"
+
+#include <stdexcept>
+
+namespace ocs2 {
+
+namespace {
+/** Factorizes the input Hessian. Throws if it is not positive definite, since the solves would silently return garbage. */
+void computeInputHessianLlt(const matrix_t& H, Eigen::LLT<matrix_t>& llt) {
+  llt.compute(H);
+  if (llt.info() != Eigen::Success) {
+    throw std::runtime_error("[ParallelRiccatiSolver] The input Hessian is not positive definite.");
+  }
+}
+}  // namespace
+
+void ParallelRiccatiSolver::solve(ThreadPool& threadPool, const vector_t& x0,
+                                  const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                                  const std::vector<ScalarFunctionQuadraticApproximation>& cost, vector_array_t& stateTrajectory,
+                                  vector_array_t& inputTrajectory) {
+  const size_t N = dynamics.size();
+  assert(cost.size() == N + 1);
+
+  costToGo_.resize(N + 1);
+  feedback_.resize(N);
+  feedforward_.resize(N);
+  stateTrajectory.resize(N + 1);
+  inputTrajectory.resize(N);
+
+  // Terminal cost-to-go
+  costToGo_[N].dfdxx = cost[N].dfdxx;
+  costToGo_[N].dfdx = cost[N].dfdx;
+  costToGo_[N].f = 0.0;
+  stateTrajectory[0] = x0;
+  if (N == 0) {
+    return;
+  }
+
+  // Partition the stages into one block per thread
+  const size_t numBlocks = std::min<size_t>(threadPool.numThreads() + 1, N);
+  blockStart_.resize(numBlocks + 1);
+  for (size_t p = 0; p <= numBlocks; p++) {
+    blockStart_[p] = p * N / numBlocks;
+  }
+  workspace_.resize(numBlocks);
+
+  if (numBlocks > 1) {
+    // Condense each block into a single element
+    threadPool.parallelFor(
+        numBlocks, [&](int, size_t p) { condenseBlock(blockStart_[p], blockStart_[p + 1], dynamics, cost, workspace_[p]); });
+
+    // Reduced interface system: cost-to-go and optimal state at the block boundaries
+    for (size_t p = numBlocks; p-- > 0;) {
+      valueAtBlockStart(costToGo_[blockStart_[p + 1]], costToGo_[blockStart_[p]], workspace_[p]);
+    }
+    for (size_t p = 0; p + 1 < numBlocks; p++) {
+      const size_t end = blockStart_[p + 1];
+      stateAtBlockEnd(stateTrajectory[blockStart_[p]], costToGo_[end], stateTrajectory[end], workspace_[p]);
+    }
+  }
+
+  // Riccati recursion and rollout within each block
+  threadPool.parallelFor(numBlocks, [&](int, size_t p) { solveBlock(p, dynamics, cost, stateTrajectory, inputTrajectory); });
+}
+
+void ParallelRiccatiSolver::condenseBlock(size_t first, size_t last, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                                          const std::vector<ScalarFunctionQuadraticApproximation>& cost, BlockWorkspace& workspace) {
+  // Start from the neutral element, which maps the state at the block end onto itself at no cost
+  auto& element = workspace.element;
+  const auto nx = dynamics[last - 1].dfdx.rows();
+  element.A.setIdentity(nx, nx);
+  element.b.setZero(nx);
+  element.C.setZero(nx, nx);
+  element.eta.setZero(nx);
+  element.J.setZero(nx, nx);
+
+  for (size_t k = last; k-- > first;) {
+    prependStage(dynamics[k], cost[k], workspace);
+  }
+}
+
+void ParallelRiccatiSolver::prependStage(const VectorFunctionLinearApproximation& dynamics,
+                                         const ScalarFunctionQuadraticApproximation& cost, BlockWorkspace& workspace) {
+  auto& element = workspace.element;
+  const auto& B = dynamics.dfdu;
+  const auto& R = cost.dfduu;
+  const bool hasInputs = B.cols() > 0;
+
+  // Stage element (A_s, b_s, C_s = B * inv(R) * B', eta_s, J_s), with the cross term eliminated by u = v - inv(R) * (P * x + r)
+  workspace.stageA = dynamics.dfdx;
+  workspace.stageb = dynamics.f;
+  workspace.stageJ = cost.dfdxx;
+  workspace.stageEta = -cost.dfdx;
+  if (hasInputs) {
+    computeInputHessianLlt(R, workspace.inputHessianLlt);
+    workspace.RinvP = workspace.inputHessianLlt.solve(cost.dfdux);
+    workspace.Rinvr = workspace.inputHessianLlt.solve(cost.dfdu);
+    workspace.stageA.noalias() -= B * workspace.RinvP;
+    workspace.stageb.noalias() -= B * workspace.Rinvr;
+    workspace.stageJ.noalias() -= cost.dfdux.transpose() * workspace.RinvP;
+    workspace.stageEta.noalias() += cost.dfdux.transpose() * workspace.Rinvr;
+  }
+
+  // Since C_s has the rank of the input, the coupling matrix is inverted with the Woodbury identity
+  // inv(I + C_s * J) = I - B * inv(H) * B' * J, where H = R + B' * J * B.
+  // d = eta - J * b_s, SA = J * A_s, MinvA = inv(I + C_s * J) * A_s
+  auto& d = workspace.tmpVector;
+  d = element.eta;
+  d.noalias() -= element.J * workspace.stageb;
+  workspace.SA.noalias() = element.J * workspace.stageA;
+  if (hasInputs) {
+    workspace.SB.noalias() = element.J * B;
+    workspace.tmpMatrix = R;
+    workspace.tmpMatrix.noalias() += B.transpose() * workspace.SB;
+    computeInputHessianLlt(workspace.tmpMatrix, workspace.inputHessianLlt);
+    workspace.G.noalias() = B.transpose() * workspace.SA;
+    workspace.HinvG = workspace.inputHessianLlt.solve(workspace.G);
+    workspace.stageA.noalias() -= B * workspace.HinvG;  // stageA now holds MinvA
+
+    // inv(I + C_s * J) * (b_s + C_s * eta) = b_s + B * inv(H) * B' * d
+    workspace.g.noalias() = B.transpose() * d;
+    workspace.Rinvr = workspace.inputHessianLlt.solve(workspace.g);
+    workspace.stageb.noalias() += B * workspace.Rinvr;
+
+    // C = A * inv(I + C_s * J) * C_s * A' + C = (A * B) * inv(H) * (A * B)' + C
+    workspace.SB.noalias() = element.A * B;
+    workspace.RinvP = workspace.inputHessianLlt.solve(workspace.SB.transpose());
+    element.C.noalias() += workspace.SB * workspace.RinvP;
+    element.C.triangularView<Eigen::StrictlyLower>() = element.C.triangularView<Eigen::StrictlyUpper>().transpose();
+  }
+  const auto& MinvA = workspace.stageA;
+
+  // b = A * inv(I + C_s * J) * (b_s + C_s * eta) + b
+  element.b.noalias() += element.A * workspace.stageb;
+
+  // eta = A_s' * inv(I + J * C_s) * (eta - J * b_s) + eta_s
+  element.eta = workspace.stageEta;
+  element.eta.noalias() += MinvA.transpose() * d;
+
+  // J = A_s' * inv(I + J * C_s) * J * A_s + J_s = A_s' * J * A_s - G' * inv(H) * G + J_s
+  workspace.tmpMatrix = workspace.stageJ;
+  workspace.tmpMatrix.noalias() += MinvA.transpose() * workspace.SA;
+  element.J.swap(workspace.tmpMatrix);
+  element.J.triangularView<Eigen::StrictlyLower>() = element.J.triangularView<Eigen::StrictlyUpper>().transpose();
+
+  // A = A * inv(I + C_s * J) * A_s
+  workspace.tmpMatrix.noalias() = element.A * MinvA;
+  element.A.swap(workspace.tmpMatrix);
+}
+
+void ParallelRiccatiSolver::valueAtBlockStart(const ScalarFunctionQuadraticApproximation& valueAtEnd,
+                                              ScalarFunctionQuadraticApproximation& valueAtStart, BlockWorkspace& workspace) {
+  const auto& element = workspace.element;
+  const auto& S = valueAtEnd.dfdxx;
+  const auto& s = valueAtEnd.dfdx;
+
+  workspace.tmpMatrix.noalias() = element.C * S;
+  workspace.tmpMatrix.diagonal().array() += 1.0;
+  workspace.couplingLu.compute(workspace.tmpMatrix);
+  workspace.stageA = workspace.couplingLu.solve(element.A);
+
+  // S_start = A' * S * inv(I + C * S) * A + J
+  workspace.tmpMatrix.noalias() = S * workspace.stageA;
+  valueAtStart.dfdxx = element.J;
+  valueAtStart.dfdxx.noalias() += element.A.transpose() * workspace.tmpMatrix;
+  valueAtStart.dfdxx.triangularView<Eigen::StrictlyLower>() = valueAtStart.dfdxx.triangularView<Eigen::StrictlyUpper>().transpose();
+
+  // s_start = A' * inv(I + S * C) * (s + S * b) - eta
+  workspace.tmpVector = s;
+  workspace.tmpVector.noalias() += S * element.b;
+  valueAtStart.dfdx = -element.eta;
+  valueAtStart.dfdx.noalias() += workspace.stageA.transpose() * workspace.tmpVector;
+  valueAtStart.f = 0.0;
+}
+
+void ParallelRiccatiSolver::stateAtBlockEnd(const vector_t& stateAtStart, const ScalarFunctionQuadraticApproximation& valueAtEnd,
+                                            vector_t& stateAtEnd, BlockWorkspace& workspace) {
+  const auto& element = workspace.element;
+  workspace.tmpVector = element.b;
+  workspace.tmpVector.noalias() += element.A * stateAtStart;
+  workspace.tmpVector.noalias() -= element.C * valueAtEnd.dfdx;
+  stateAtEnd = workspace.couplingLu.solve(workspace.tmpVector);
+}
+
+void ParallelRiccatiSolver::solveBlock(size_t blockIndex, const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                                       const std::vector<ScalarFunctionQuadraticApproximation>& cost, vector_array_t& stateTrajectory,
+                                       vector_array_t& inputTrajectory) {
+  const size_t first = blockStart_[blockIndex];
+  const size_t last = blockStart_[blockIndex + 1];
+  auto& workspace = workspace_[blockIndex];
+
+  // The cost-to-go at the block start is given by the reduced interface system, unless the horizon is a single block
+  const size_t lastCostToGo = (blockStart_.size() == 2) ? first : first + 1;
+  for (size_t k = last; k-- > first;) {
+    const auto& A = dynamics[k].dfdx;
+    const auto& B = dynamics[k].dfdu;
+    const auto& S = costToGo_[k + 1].dfdxx;
+
+    // SA = S * A, sv = s + S * b
+    workspace.SA.noalias() = S * A;
+    workspace.tmpVector = costToGo_[k + 1].dfdx;
+    workspace.tmpVector.noalias() += S * dynamics[k].f;
+
+    auto& K = feedback_[k];
+    auto& kff = feedforward_[k];
+    if (B.cols() > 0) {
+      // H = R + B' * S * B, G = P + B' * S * A, g = r + B' * sv
+      workspace.SB.noalias() = S * B;
+      workspace.tmpMatrix = cost[k].dfduu;
+      workspace.tmpMatrix.noalias() += B.transpose() * workspace.SB;
+      computeInputHessianLlt(workspace.tmpMatrix, workspace.inputHessianLlt);
+      workspace.G = cost[k].dfdux;
+      workspace.G.noalias() += B.transpose() * workspace.SA;
+      workspace.g = cost[k].dfdu;
+      workspace.g.noalias() += B.transpose() * workspace.tmpVector;
+
+      K = -workspace.inputHessianLlt.solve(workspace.G);
+      kff = -workspace.inputHessianLlt.solve(workspace.g);
+    } else {
+      K.setZero(0, A.cols());
+      kff.resize(0);
+    }
+
+    if (k >= lastCostToGo) {
+      // S = Q + A' * S * A + G' * K, s = q + A' * sv + G' * k
+      auto& costToGo = costToGo_[k];
+      costToGo.dfdxx = cost[k].dfdxx;
+      costToGo.dfdxx.noalias() += A.transpose() * workspace.SA;
+      costToGo.dfdx = cost[k].dfdx;
+      costToGo.dfdx.noalias() += A.transpose() * workspace.tmpVector;
+      if (B.cols() > 0) {
+        costToGo.dfdxx.noalias() += workspace.G.transpose() * K;
+        costToGo.dfdx.noalias() += workspace.G.transpose() * kff;
+      }
+      costToGo.dfdxx.triangularView<Eigen::StrictlyLower>() = costToGo.dfdxx.triangularView<Eigen::StrictlyUpper>().transpose();
+      costToGo.f = 0.0;
+    }
+  }
+
+  // Rollout from the boundary state. The state at the end of a block is given by the reduced interface system, except at the horizon end.
+  const size_t lastState = (last == dynamics.size()) ? last : last - 1;
+  for (size_t k = first; k < last; k++) {
+    auto& u = inputTrajectory[k];
+    u = feedforward_[k];
+    u.noalias() += feedback_[k] * stateTrajectory[k];
+    if (k < lastState) {
+      auto& x = stateTrajectory[k + 1];
+      x = dynamics[k].f;
+      x.noalias() += dynamics[k].dfdx * stateTrajectory[k];
+      x.noalias() += dynamics[k].dfdu * u;
+    }
+  }
+}
+
+}  // namespace ocs2
@@ -94,15 +94,21 @@ Transcription setupIntermediateNode(OptimalControlProblem& optimalControlProblem
 }
 
 void projectTranscription(Transcription& transcription, bool extractProjectionMultiplier) {
-  auto& cost = transcription.cost;
-  auto& dynamics = transcription.dynamics;
-  auto& stateInputEqConstraints = transcription.stateInputEqConstraints;
-  auto& stateInputIneqConstraints = transcription.stateInputIneqConstraints;
-  auto& projection = transcription.constraintsProjection;
-  auto& projectionMultiplierCoefficients = transcription.projectionMultiplierCoefficients;
+  projectTranscription(transcription.stateInputEqConstraints, transcription.dynamics, transcription.cost,
+                       transcription.stateInputIneqConstraints, transcription.constraintsProjection,
+                       transcription.projectionMultiplierCoefficients, extractProjectionMultiplier);
+  if (transcription.stateInputEqConstraints.f.size() > 0) {
+    // Projection stored instead of constraint
+    transcription.stateInputEqConstraints = VectorFunctionLinearApproximation();
+  }
+}
 
+void projectTranscription(const VectorFunctionLinearApproximation& stateInputEqConstraints, VectorFunctionLinearApproximation& dynamics,
+                          ScalarFunctionQuadraticApproximation& cost, VectorFunctionLinearApproximation& stateInputIneqConstraints,
+                          VectorFunctionLinearApproximation& projection, ProjectionMultiplierCoefficients& projectionMultiplierCoefficients,
+                          bool extractProjectionMultiplier) {
   if (stateInputEqConstraints.f.size() > 0) {
-    // Projection stored instead of constraint, // TODO: benchmark between lu and qr method. LU seems slightly faster.
+    // TODO: benchmark between lu and qr method. LU seems slightly faster.
     if (extractProjectionMultiplier) {
       matrix_t constraintPseudoInverse;
       std::tie(projection, constraintPseudoInverse) = LinearAlgebra::qrConstraintProjection(stateInputEqConstraints);
@@ -111,7 +117,6 @@ void projectTranscription(Transcription& transcription, bool extractProjectionMu
       projection = LinearAlgebra::luConstraintProjection(stateInputEqConstraints).first;
       projectionMultiplierCoefficients = ProjectionMultiplierCoefficients();
     }
-    stateInputEqConstraints = VectorFunctionLinearApproximation();
 
     // Adapt dynamics, cost, and state-input inequality constraints
     changeOfInputVariables(dynamics, projection.dfdu, projection.dfdx, projection.f);
@@ -119,9 +124,32 @@ void projectTranscription(Transcription& transcription, bool extractProjectionMu
     if (stateInputIneqConstraints.f.size() > 0) {
       changeOfInputVariables(stateInputIneqConstraints, projection.dfdu, projection.dfdx, projection.f);
     }
+  } else {
+    projection = VectorFunctionLinearApproximation();
+    projectionMultiplierCoefficients = ProjectionMultiplierCoefficients();
   }
 }
 
+void updateTranscription(Transcription& transcription, const Metrics& metrics, const vector_t& dx, const vector_t& du) {
+  auto& cost = transcription.cost;
+
+  // Cost: first-order update of the gradient with the Hessian of the transcription
+  cost.f = metrics.cost;
+  cost.dfdx.noalias() += cost.dfdxx * dx;
+  cost.dfdx.noalias() += cost.dfdux.transpose() * du;
+  cost.dfdu.noalias() += cost.dfdux * dx;
+  cost.dfdu.noalias() += cost.dfduu * du;
+
+  // Dynamics
+  transcription.dynamics.f = metrics.dynamicsViolation;
+
+  // Constraints
+  transcription.stateEqConstraints.f = toVector(metrics.stateEqConstraint);
+  transcription.stateInputEqConstraints.f = toVector(metrics.stateInputEqConstraint);
+  transcription.stateIneqConstraints.f = toVector(metrics.stateIneqConstraint);
+  transcription.stateInputIneqConstraints.f = toVector(metrics.stateInputIneqConstraint);
+}
+
 TerminalTranscription setupTerminalNode(OptimalControlProblem& optimalControlProblem, scalar_t t, const vector_t& x) {
   // Results and short-hand notation
   TerminalTranscription transcription;
@@ -78,6 +78,8 @@ void swap(PerformanceIndex& lhs, PerformanceIndex& rhs) {
   std::swap(lhs.inequalityConstraintsSSE, rhs.inequalityConstraintsSSE);
   std::swap(lhs.equalityLagrangian, rhs.equalityLagrangian);
   std::swap(lhs.inequalityLagrangian, rhs.inequalityLagrangian);
+  std::swap(lhs.earlyExit, rhs.earlyExit);
+  std::swap(lhs.deadlineMissed, rhs.deadlineMissed);
 }
 
 PerformanceIndex toPerformanceIndex(const Metrics& m) {
@@ -125,6 +127,13 @@ std::ostream& operator<<(std::ostream& stream, const PerformanceIndex& performan
   stream << "Equality Lagrangian:        " << std::setw(tabSpace) << performanceIndex.equalityLagrangian;
   stream << "Inequality Lagrangian:      " << std::setw(tabSpace) << performanceIndex.inequalityLagrangian;
 
+  if (performanceIndex.earlyExit || performanceIndex.deadlineMissed) {
+    stream << '\n' << std::setw(indentation) << "";
+    stream << "Time budget:                " << (performanceIndex.earlyExit ? "early exit" : "")
+           << (performanceIndex.earlyExit && performanceIndex.deadlineMissed ? ", " : "")
+           << (performanceIndex.deadlineMissed ? "deadline missed" : "");
+  }
+
   return stream;
 }
 
@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_oc/oc_data/TimeDiscretization.h"
 
+#include <algorithm>
+
 #include <ocs2_core/misc/Lookup.h>
 
 namespace ocs2 {
@@ -59,7 +61,13 @@ scalar_t getIntervalDuration(const AnnotatedTime& start, const AnnotatedTime& en
 
 std::vector<AnnotatedTime> timeDiscretizationWithEvents(scalar_t initTime, scalar_t finalTime, scalar_t dt,
                                                         const scalar_array_t& eventTimes, scalar_t dt_min) {
+  return timeDiscretizationWithEvents(initTime, finalTime, dt, 1.0, dt, eventTimes, dt_min);
+}
+
+std::vector<AnnotatedTime> timeDiscretizationWithEvents(scalar_t initTime, scalar_t finalTime, scalar_t dt, scalar_t dtGrowthFactor,
+                                                        scalar_t dtMax, const scalar_array_t& eventTimes, scalar_t dt_min) {
   assert(dt > 0);
+  assert(dtGrowthFactor >= 1.0);
   assert(finalTime > initTime);
   std::vector<AnnotatedTime> timeDiscretization;
 
@@ -69,15 +77,19 @@ std::vector<AnnotatedTime> timeDiscretizationWithEvents(scalar_t initTime, scala
 
   // Fill iteratively with pre event, post events are added later
   AnnotatedTime nextNode = timeDiscretization.back();
+  const scalar_t stepMax = std::max(dt, dtMax);
+  scalar_t step = dt;
   while (timeDiscretization.back().time < finalTime) {
-    nextNode.time = nextNode.time + dt;
+    nextNode.time = nextNode.time + step;
     nextNode.event = AnnotatedTime::Event::None;
+    step = std::min(dtGrowthFactor * step, stepMax);
 
     // Check if an event has passed
     if (nextEventIdx < eventTimes.size() && nextNode.time >= eventTimes[nextEventIdx]) {
       nextNode.time = eventTimes[nextEventIdx];
       nextNode.event = AnnotatedTime::Event::PreEvent;
       nextEventIdx++;
+      step = dt;  // refine after the event
     }
 
     // Check if final time has passed
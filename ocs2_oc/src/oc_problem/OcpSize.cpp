@@ -46,10 +46,28 @@ bool operator==(const OcpSize& lhs, const OcpSize& rhs) noexcept {
 
 OcpSize extractSizesFromProblem(const std::vector<VectorFunctionLinearApproximation>& dynamics,
                                 const std::vector<ScalarFunctionQuadraticApproximation>& cost,
-                                const std::vector<VectorFunctionLinearApproximation>* constraints) {
+                                const std::vector<VectorFunctionLinearApproximation>* constraints,
+                                const std::vector<VectorFunctionLinearApproximation>* ineqConstraints) {
+  OcpSize problemSize;
+  extractSizesFromProblem(dynamics, cost, constraints, ineqConstraints, problemSize);
+  return problemSize;
+}
+
+void extractSizesFromProblem(const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                             const std::vector<ScalarFunctionQuadraticApproximation>& cost,
+                             const std::vector<VectorFunctionLinearApproximation>* constraints,
+                             const std::vector<VectorFunctionLinearApproximation>* ineqConstraints, OcpSize& problemSize) {
   const int numStages = dynamics.size();
 
-  OcpSize problemSize(dynamics.size());
+  problemSize.numStages = numStages;
+  problemSize.numInputs.resize(numStages + 1);
+  problemSize.numStates.resize(numStages + 1);
+  problemSize.numInputBoxConstraints.assign(numStages + 1, 0);
+  problemSize.numStateBoxConstraints.assign(numStages + 1, 0);
+  problemSize.numIneqConstraints.assign(numStages + 1, 0);
+  problemSize.numInputBoxSlack.assign(numStages + 1, 0);
+  problemSize.numStateBoxSlack.assign(numStages + 1, 0);
+  problemSize.numIneqSlack.assign(numStages + 1, 0);
 
   // State inputs
   for (int k = 0; k < numStages; k++) {
@@ -65,8 +83,11 @@ OcpSize extractSizesFromProblem(const std::vector<VectorFunctionLinearApproximat
       problemSize.numIneqConstraints[k] = (*constraints)[k].f.size();
     }
   }
-
-  return problemSize;
+  if (ineqConstraints != nullptr) {
+    for (int k = 0; k < numStages + 1; k++) {
+      problemSize.numIneqConstraints[k] += (*ineqConstraints)[k].f.size();
+    }
+  }
 }
 
 }  // namespace ocs2
\ No newline at end of file
@@ -87,10 +87,23 @@ void SolverBase::printString(const std::string& text) const {
   std::cerr << text << '\n';
 }
 
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+bool SolverBase::exceedsTimeBudget(scalar_t expectedDuration) const {
+  if (timeBudget_ <= 0.0) {
+    return false;
+  }
+  const std::chrono::duration<scalar_t, std::milli> elapsedTime = std::chrono::steady_clock::now() - runStartTime_;
+  return elapsedTime.count() + expectedDuration > 1e3 * timeBudget_;
+}
+
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 void SolverBase::preRun(scalar_t initTime, const vector_t& initState, scalar_t finalTime) {
+  runStartTime_ = std::chrono::steady_clock::now();
+
   referenceManagerPtr_->preSolverRun(initTime, finalTime, initState);
 
   for (auto& module : synchronizedModules_) {
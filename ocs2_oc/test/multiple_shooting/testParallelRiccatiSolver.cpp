@@ -0,0 +1,143 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include <ocs2_core/test/testTools.h>
+
+#include "ocs2_oc/multiple_shooting/ParallelRiccatiSolver.h"
+#include "ocs2_oc/oc_problem/OcpSize.h"
+#include "ocs2_oc/oc_problem/OcpToKkt.h"
+#include "ocs2_oc/test/testProblemsGeneration.h"
+
+using namespace ocs2;
+
+class ParallelRiccatiSolverTest : public testing::Test {
+ protected:
+  static constexpr size_t N_ = 20;
+  static constexpr size_t nx_ = 4;
+  static constexpr size_t nu_ = 3;
+  static constexpr size_t eventIndex_ = 7;  // stage without inputs
+
+  ParallelRiccatiSolverTest() {
+    srand(0);
+    x0_ = vector_t::Random(nx_);
+    for (size_t k = 0; k < N_; k++) {
+      const size_t nu = (k == eventIndex_) ? 0 : nu_;
+      dynamics_.push_back(getRandomDynamics(nx_, nu));
+      dynamics_.back().dfdx = matrix_t::Identity(nx_, nx_) + 0.1 * dynamics_.back().dfdx;
+      cost_.push_back(getRandomCost(nx_, nu));
+      cost_.back().dfduu += matrix_t::Identity(nu, nu);
+    }
+    cost_.push_back(getRandomCost(nx_, 0));
+  }
+
+  vector_t x0_;
+  std::vector<VectorFunctionLinearApproximation> dynamics_;
+  std::vector<ScalarFunctionQuadraticApproximation> cost_;
+};
+
+constexpr size_t ParallelRiccatiSolverTest::N_;
+constexpr size_t ParallelRiccatiSolverTest::nx_;
+constexpr size_t ParallelRiccatiSolverTest::nu_;
+constexpr size_t ParallelRiccatiSolverTest::eventIndex_;
+
+TEST_F(ParallelRiccatiSolverTest, kktSolution) {
+  // Dense KKT system as reference
+  const auto ocpSize = extractSizesFromProblem(dynamics_, cost_, nullptr);
+  VectorFunctionLinearApproximation constraints;
+  ScalarFunctionQuadraticApproximation cost;
+  getConstraintMatrix(ocpSize, x0_, dynamics_, nullptr, nullptr, constraints);
+  getCostMatrix(ocpSize, x0_, cost_, cost);
+  const auto numDecisionVariables = cost.dfdx.size();
+  const auto numConstraints = constraints.f.size();
+  matrix_t kktMatrix = matrix_t::Zero(numDecisionVariables + numConstraints, numDecisionVariables + numConstraints);
+  kktMatrix.topLeftCorner(numDecisionVariables, numDecisionVariables) = cost.dfdxx;
+  kktMatrix.topRightCorner(numDecisionVariables, numConstraints) = constraints.dfdx.transpose();
+  kktMatrix.bottomLeftCorner(numConstraints, numDecisionVariables) = constraints.dfdx;
+  vector_t kktRhs(numDecisionVariables + numConstraints);
+  kktRhs << -cost.dfdx, constraints.f;
+  const vector_t kktSolution = kktMatrix.lu().solve(kktRhs);
+  vector_array_t xReference, uReference;
+  toOcpSolution(ocpSize, kktSolution.head(numDecisionVariables), x0_, xReference, uReference);
+
+  for (const size_t numThreads : {1, 2, 3, 8}) {
+    ThreadPool threadPool(numThreads - 1);
+    ParallelRiccatiSolver solver;
+    vector_array_t xSol, uSol;
+    solver.solve(threadPool, x0_, dynamics_, cost_, xSol, uSol);
+    EXPECT_TRUE(isEqual(xSol, xReference, 1e-8)) << "numThreads = " << numThreads;
+    EXPECT_TRUE(isEqual(uSol, uReference, 1e-8)) << "numThreads = " << numThreads;
+  }
+}
+
+TEST_F(ParallelRiccatiSolverTest, riccatiQuantities) {
+  // A single block is a serial Riccati recursion
+  ThreadPool serialPool(0);
+  ParallelRiccatiSolver serialSolver;
+  vector_array_t xSerial, uSerial;
+  serialSolver.solve(serialPool, x0_, dynamics_, cost_, xSerial, uSerial);
+
+  ThreadPool threadPool(3);
+  ParallelRiccatiSolver solver;
+  vector_array_t xSol, uSol;
+  solver.solve(threadPool, x0_, dynamics_, cost_, xSol, uSol);
+  // solving again reuses the workspace
+  solver.solve(threadPool, x0_, dynamics_, cost_, xSol, uSol);
+
+  const auto& costToGo = solver.getRiccatiCostToGo();
+  const auto& feedback = solver.getRiccatiFeedback();
+  const auto& feedforward = solver.getRiccatiFeedforward();
+  ASSERT_EQ(costToGo.size(), N_ + 1);
+  ASSERT_EQ(feedback.size(), N_);
+  ASSERT_EQ(feedforward.size(), N_);
+  for (size_t k = 0; k <= N_; k++) {
+    EXPECT_TRUE(costToGo[k].dfdxx.isApprox(serialSolver.getRiccatiCostToGo()[k].dfdxx, 1e-8)) << "k = " << k;
+    EXPECT_TRUE(costToGo[k].dfdx.isApprox(serialSolver.getRiccatiCostToGo()[k].dfdx, 1e-8)) << "k = " << k;
+  }
+  for (size_t k = 0; k < N_; k++) {
+    EXPECT_TRUE(isEqual(feedback[k], serialSolver.getRiccatiFeedback()[k], 1e-8)) << "k = " << k;
+    EXPECT_TRUE(isEqual(feedforward[k], serialSolver.getRiccatiFeedforward()[k], 1e-8)) << "k = " << k;
+    // The optimal input is the feedback policy evaluated along the solution
+    EXPECT_TRUE(isEqual(uSol[k], vector_t(feedback[k] * xSol[k] + feedforward[k]), 1e-8)) << "k = " << k;
+  }
+  EXPECT_EQ(feedback[eventIndex_].rows(), 0);
+  EXPECT_EQ(feedback[eventIndex_].cols(), nx_);
+}
+
+TEST_F(ParallelRiccatiSolverTest, indefiniteInputHessian) {
+  auto cost = cost_;
+  cost[eventIndex_ + 1].dfduu = -1e6 * matrix_t::Identity(nu_, nu_);
+  for (const size_t numThreads : {1, 3}) {
+    ThreadPool threadPool(numThreads - 1);
+    ParallelRiccatiSolver solver;
+    vector_array_t xSol, uSol;
+    EXPECT_THROW(solver.solve(threadPool, x0_, dynamics_, cost, xSol, uSol), std::runtime_error) << "numThreads = " << numThreads;
+  }
+}
@@ -119,3 +119,43 @@ TEST(test_transcription_metrics, terminal) {
 
   ASSERT_TRUE(metrics.isApprox(multiple_shooting::computeMetrics(transcription), 1e-12));
 }
+
+TEST(test_transcription_metrics, updateIntermediate) {
+  constexpr int nx = 3;
+  constexpr int nu = 2;
+
+  // linear-quadratic optimal control problem, such that the derivatives are exact everywhere
+  OptimalControlProblem problem;
+  problem.dynamicsPtr = getOcs2Dynamics(getRandomDynamics(nx, nu));
+  problem.costPtr->add("cost", getOcs2Cost(getRandomCost(nx, nu)));
+  problem.softConstraintPtr->add("softCost", getOcs2Cost(getRandomCost(nx, nu)));
+  problem.equalityConstraintPtr->add("equalityConstraint", getOcs2Constraints(getRandomConstraints(nx, nu, 1)));
+  problem.stateEqualityConstraintPtr->add("stateEqualityConstraint", getOcs2StateOnlyConstraints(getRandomConstraints(nx, 0, 1)));
+  problem.inequalityConstraintPtr->add("inequalityConstraint", getOcs2Constraints(getRandomConstraints(nx, nu, 3)));
+  problem.stateInequalityConstraintPtr->add("stateInequalityConstraint", getOcs2StateOnlyConstraints(getRandomConstraints(nx, 0, 4)));
+
+  const TargetTrajectories targetTrajectories({0.0}, {vector_t::Random(nx)}, {vector_t::Random(nu)});
+  problem.targetTrajectoriesPtr = &targetTrajectories;
+
+  auto discretizer = selectDynamicsDiscretization(SensitivityIntegratorType::RK4);
+  auto sensitivityDiscretizer = selectDynamicsSensitivityDiscretization(SensitivityIntegratorType::RK4);
+
+  const scalar_t t = 0.5;
+  const scalar_t dt = 0.1;
+  const vector_t x = vector_t::Random(nx);
+  const vector_t u = vector_t::Random(nu);
+  const vector_t x_next = vector_t::Random(nx);
+  const vector_t dx = 0.1 * vector_t::Random(nx);
+  const vector_t du = 0.1 * vector_t::Random(nu);
+
+  auto transcription = multiple_shooting::setupIntermediateNode(problem, sensitivityDiscretizer, t, dt, x, x_next, u);
+  const auto metrics = multiple_shooting::computeIntermediateMetrics(problem, discretizer, t, dt, x + dx, x_next, u + du);
+  multiple_shooting::updateTranscription(transcription, metrics, dx, du);
+
+  const auto expected = multiple_shooting::setupIntermediateNode(problem, sensitivityDiscretizer, t, dt, x + dx, x_next, u + du);
+  ASSERT_TRUE(multiple_shooting::computeMetrics(transcription).isApprox(multiple_shooting::computeMetrics(expected), 1e-12));
+  ASSERT_TRUE(transcription.cost.dfdx.isApprox(expected.cost.dfdx, 1e-12));
+  ASSERT_TRUE(transcription.cost.dfdu.isApprox(expected.cost.dfdu, 1e-12));
+  ASSERT_TRUE(transcription.dynamics.dfdx.isApprox(expected.dynamics.dfdx, 1e-12));
+  ASSERT_TRUE(transcription.stateInputEqConstraints.dfdu.isApprox(expected.stateInputEqConstraints.dfdu, 1e-12));
+}
@@ -127,4 +127,67 @@ TEST(test_time_discretization, withEvents) {
   ASSERT_EQ(time[12].event, AnnotatedTime::Event::PreEvent);
   ASSERT_EQ(time[13].event, AnnotatedTime::Event::PostEvent);
   ASSERT_EQ(time[14].event, AnnotatedTime::Event::None);
-}
\ No newline at end of file
+}
+TEST(test_time_discretization, growingSteps) {
+  scalar_t initTime = 0.0;
+  scalar_t finalTime = 1.0;
+  scalar_t dt = 0.1;
+  scalar_t dtGrowthFactor = 2.0;
+  scalar_t dtMax = 0.3;
+  scalar_array_t eventTimes{};
+
+  auto time = timeDiscretizationWithEvents(initTime, finalTime, dt, dtGrowthFactor, dtMax, eventTimes);
+  //  timeDiscretization = {0.0, 0.1, 0.3, 0.6, 0.9, 1.0}
+  ASSERT_EQ(time.size(), 6);
+  ASSERT_EQ(time[0].time, initTime);
+  ASSERT_DOUBLE_EQ(time[1].time, 0.1);
+  ASSERT_DOUBLE_EQ(time[2].time, 0.3);
+  ASSERT_DOUBLE_EQ(time[3].time, 0.6);
+  ASSERT_DOUBLE_EQ(time[4].time, 0.9);
+  ASSERT_EQ(time[5].time, finalTime);
+  for (const auto& t : time) {
+    ASSERT_EQ(t.event, AnnotatedTime::Event::None);
+  }
+}
+
+TEST(test_time_discretization, growingStepsWithEvents) {
+  scalar_t initTime = 0.0;
+  scalar_t finalTime = 1.0;
+  scalar_t dt = 0.1;
+  scalar_t dtGrowthFactor = 2.0;
+  scalar_t dtMax = 1.0;
+  scalar_array_t eventTimes{0.5};
+
+  auto time = timeDiscretizationWithEvents(initTime, finalTime, dt, dtGrowthFactor, dtMax, eventTimes);
+  //  timeDiscretization = {0.0, 0.1, 0.3, 0.5, 0.5, 0.6, 0.8, 1.0}, the step is reset after the event
+  ASSERT_EQ(time.size(), 8);
+  ASSERT_EQ(time[0].time, initTime);
+  ASSERT_DOUBLE_EQ(time[1].time, 0.1);
+  ASSERT_DOUBLE_EQ(time[2].time, 0.3);
+  ASSERT_EQ(time[3].time, eventTimes[0]);
+  ASSERT_EQ(time[4].time, eventTimes[0]);
+  ASSERT_DOUBLE_EQ(time[5].time, eventTimes[0] + dt);
+  ASSERT_DOUBLE_EQ(time[6].time, eventTimes[0] + 3.0 * dt);
+  ASSERT_EQ(time[7].time, finalTime);
+
+  // Events
+  ASSERT_EQ(time[2].event, AnnotatedTime::Event::None);
+  ASSERT_EQ(time[3].event, AnnotatedTime::Event::PreEvent);
+  ASSERT_EQ(time[4].event, AnnotatedTime::Event::PostEvent);
+  ASSERT_EQ(time[5].event, AnnotatedTime::Event::None);
+}
+
+TEST(test_time_discretization, unitGrowthIsUniform) {
+  scalar_t initTime = 3.0;
+  scalar_t finalTime = 4.0;
+  scalar_t dt = 0.1;
+  scalar_array_t eventTimes{3.25, 3.4, 3.8999999999999999999, 4.02, 4.5};
+
+  const auto uniform = timeDiscretizationWithEvents(initTime, finalTime, dt, eventTimes);
+  const auto growing = timeDiscretizationWithEvents(initTime, finalTime, dt, 1.0, 0.5, eventTimes);
+  ASSERT_EQ(uniform.size(), growing.size());
+  for (size_t i = 0; i < uniform.size(); ++i) {
+    ASSERT_EQ(uniform[i].time, growing[i].time);
+    ASSERT_EQ(uniform[i].event, growing[i].event);
+  }
+}
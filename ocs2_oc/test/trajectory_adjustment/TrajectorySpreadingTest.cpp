@@ -27,6 +27,7 @@ OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
 OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 ******************************************************************************/
 
+#include <algorithm>
 #include <cstdlib>
 #include <ctime>
 #include <iostream>
@@ -134,6 +135,14 @@ class TrajectorySpreadingTest : public testing::Test {
     out.eventDataArray = trajectorySpreadingPtr->extractEventsArray(out.eventDataArray);
     out.preEventModeTrajectory = trajectorySpreadingPtr->extractEventsArray(out.preEventModeTrajectory);
 
+    // a trajectory in contiguous storage is adjusted identically
+    ocs2::ContiguousTrajectory<ocs2::vector_t> contiguousStateTrajectory(in.stateTrajectory);
+    trajectorySpreadingPtr->adjustTrajectory(contiguousStateTrajectory);
+    EXPECT_EQ(contiguousStateTrajectory.size(), out.stateTrajectory.size());
+    for (size_t k = 0; k < std::min(contiguousStateTrajectory.size(), out.stateTrajectory.size()); k++) {
+      EXPECT_TRUE(contiguousStateTrajectory[k].isApprox(out.stateTrajectory[k]));
+    }
+
     return {out, status};
   }
 
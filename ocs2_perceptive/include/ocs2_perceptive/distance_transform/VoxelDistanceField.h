@@ -0,0 +1,163 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+#include <ocs2_core/Types.h>
+#include <ocs2_core/thread_support/ThreadPool.h>
+
+#include "ocs2_perceptive/distance_transform/DistanceTransformInterface.h"
+
+namespace ocs2 {
+
+/**
+ * Euclidean signed distance field (ESDF) on a 3D voxel grid. The distance of each voxel is positive in free space (distance to the
+ * nearest occupied voxel) and negative inside obstacles (distance to the nearest free voxel), truncated to [-maxDistance, maxDistance].
+ *
+ * The field is built with the separable distance transform of computeDistanceTransform(), i.e. one pass along each axis, where the lines
+ * of a pass are processed in parallel. Since the distances are truncated, a change of the occupancy in a box only affects the voxels
+ * within maxDistance of the box. Therefore updateOccupancy() only recomputes this region, from the occupancy of the region extended by
+ * another maxDistance.
+ *
+ * The field is queried by trilinear interpolation between the voxel centers. Points outside of the grid are projected onto its bounds.
+ * The voxel (i, j, k) is centered at origin + resolution * (i, j, k) and the voxels are stored with the x index running fastest.
+ */
+class VoxelDistanceField final : public DistanceTransformInterface {
+ public:
+  using index3_t = std::array<size_t, 3>;
+
+  /**
+   * Constructor. The grid is initialized as free space.
+   *
+   * @param [in] resolution: The edge length of a voxel [m].
+   * @param [in] origin: The center of the voxel (0, 0, 0).
+   * @param [in] size: The number of voxels along each axis. Each axis must have at least two voxels.
+   * @param [in] maxDistance: The truncation distance of the field [m].
+   * @param [in] nThreads: The number of threads used for computing the field, including the calling thread.
+   */
+  VoxelDistanceField(scalar_t resolution, const vector3_t& origin, const index3_t& size, scalar_t maxDistance, size_t nThreads = 1);
+
+  ~VoxelDistanceField() override = default;
+
+  /**
+   * Sets the occupancy of the whole grid and recomputes the distance field.
+   *
+   * @param [in] occupancy: The occupancy of each voxel, in the storage order of the grid.
+   */
+  void setOccupancy(const std::vector<bool>& occupancy);
+
+  /**
+   * Updates the occupancy of a box of voxels and recomputes the affected region of the distance field.
+   *
+   * @param [in] boxMin: The voxel index of the lower corner of the box.
+   * @param [in] boxSize: The number of voxels of the box along each axis.
+   * @param [in] occupancy: The occupancy of the voxels in the box, with the x index running fastest.
+   */
+  void updateOccupancy(const index3_t& boxMin, const index3_t& boxSize, const std::vector<bool>& occupancy);
+
+  scalar_t getValue(const vector3_t& p) const override;
+  vector3_t getProjectedPoint(const vector3_t& p) const override;
+  std::pair<scalar_t, vector3_t> getLinearApproximation(const vector3_t& p) const override;
+
+  /** Batched queries. The points are interpolated in packets of four. */
+  void getValues(const std::vector<vector3_t>& points, scalar_array_t& values) const override;
+  void getLinearApproximations(const std::vector<vector3_t>& points, scalar_array_t& values,
+                               std::vector<vector3_t>& gradients) const override;
+
+  /** Whether the given voxel is occupied. */
+  bool isOccupied(const index3_t& index) const { return occupancy_[linearIndex(index)] != 0; }
+
+  /** The signed distance of the given voxel. */
+  scalar_t getVoxelDistance(const index3_t& index) const { return static_cast<scalar_t>(distance_[linearIndex(index)]); }
+
+  scalar_t getResolution() const { return resolution_; }
+  const vector3_t& getOrigin() const { return origin_; }
+  const index3_t& getSize() const { return size_; }
+  scalar_t getMaxDistance() const { return maxDistance_; }
+
+ private:
+  /** A box of voxels [min, min + size). */
+  struct Box {
+    index3_t min;
+    index3_t size;
+  };
+
+  /** Per-thread memory of the 1D distance transforms. */
+  struct LineBuffer {
+    std::vector<float> line;
+    std::vector<size_t> v;
+    std::vector<float> z;
+  };
+
+  size_t linearIndex(const index3_t& index) const { return index[0] + size_[0] * (index[1] + size_[1] * index[2]); }
+
+  /** Grows the box by the given number of voxels on each side, clipped to the grid. */
+  Box dilate(const Box& box, size_t numVoxels) const;
+
+  /**
+   * Computes the squared distances within computeBox from the occupancy within computeBox only, and writes the signed distances of the
+   * voxels in writeBox (which must be contained in computeBox).
+   */
+  void computeRegion(const Box& computeBox, const Box& writeBox);
+
+  /** Runs the 1D distance transform in place on the line of the scratch volume starting at offset. */
+  static void transformLine(std::vector<float>& volume, size_t offset, size_t stride, size_t length, LineBuffer& buffer);
+
+  /** Computes the local coordinate of a point, i.e. the reference voxel and the normalized offset in [0, 1] from its center. */
+  void getReferenceVoxel(const vector3_t& p, index3_t& referenceVoxel, vector3_t& offset) const;
+
+  /** Gathers the values of the eight voxels around the reference voxel in the order of trilinear_interpolation. */
+  std::array<scalar_t, 8> getCornerValues(const index3_t& referenceVoxel) const;
+
+  template <bool ComputeGradient>
+  void interpolateBatch(const std::vector<vector3_t>& points, scalar_array_t& values, std::vector<vector3_t>* gradientsPtr) const;
+
+  const scalar_t resolution_;
+  const vector3_t origin_;
+  const index3_t size_;
+  const scalar_t maxDistance_;
+  const size_t maxDistanceInVoxels_;
+
+  std::vector<uint8_t> occupancy_;
+  std::vector<float> distance_;
+
+  // scratch memory
+  std::vector<float> squaredDistanceToOccupied_;
+  std::vector<float> squaredDistanceToFree_;
+  std::vector<LineBuffer> lineBuffers_;
+
+  ThreadPool threadPool_;
+};
+
+}  // namespace ocs2
@@ -0,0 +1,346 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include "ocs2_perceptive/distance_transform/VoxelDistanceField.h"
+
+#include <algorithm>
+#include <cmath>
+#include <stdexcept>
+#include <string>
+#include <tuple>
+
+#include "ocs2_perceptive/distance_transform/ComputeDistanceTransform.h"
+#include "ocs2_perceptive/interpolation/TrilinearInterpolation.h"
+
+namespace ocs2 {
+
+namespace {
+// squared distance of the voxels without a source in the processed region
+constexpr float SquaredInfinity = 1e20;
+}  // unnamed namespace
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+VoxelDistanceField::VoxelDistanceField(scalar_t resolution, const vector3_t& origin, const index3_t& size, scalar_t maxDistance,
+                                       size_t nThreads)
+    : resolution_(resolution),
+      origin_(origin),
+      size_(size),
+      maxDistance_(maxDistance),
+      maxDistanceInVoxels_(static_cast<size_t>(std::ceil(maxDistance / resolution))),
+      occupancy_(size[0] * size[1] * size[2], 0),
+      distance_(size[0] * size[1] * size[2], static_cast<float>(maxDistance)),
+      threadPool_(std::max(nThreads, size_t(1)) - 1, 0) {
+  if (resolution <= 0.0) {
+    throw std::runtime_error("[VoxelDistanceField] The resolution must be positive!");
+  }
+  if (!std::isfinite(maxDistance) || maxDistance <= 0.0) {
+    throw std::runtime_error("[VoxelDistanceField] The maximum distance must be positive and finite!");
+  }
+  if (size[0] < 2 || size[1] < 2 || size[2] < 2) {
+    throw std::runtime_error("[VoxelDistanceField] The grid must have at least two voxels along each axis!");
+  }
+  lineBuffers_.resize(threadPool_.numThreads() + 1);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void VoxelDistanceField::setOccupancy(const std::vector<bool>& occupancy) {
+  if (occupancy.size() != occupancy_.size()) {
+    throw std::runtime_error("[VoxelDistanceField::setOccupancy] The occupancy has " + std::to_string(occupancy.size()) +
+                             " voxels while the grid has " + std::to_string(occupancy_.size()) + "!");
+  }
+  std::copy(occupancy.begin(), occupancy.end(), occupancy_.begin());
+
+  const Box grid{{0, 0, 0}, size_};
+  computeRegion(grid, grid);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void VoxelDistanceField::updateOccupancy(const index3_t& boxMin, const index3_t& boxSize, const std::vector<bool>& occupancy) {
+  for (size_t axis = 0; axis < 3; axis++) {
+    if (boxMin[axis] + boxSize[axis] > size_[axis]) {
+      throw std::runtime_error("[VoxelDistanceField::updateOccupancy] The box exceeds the grid along axis " + std::to_string(axis) + "!");
+    }
+  }
+  if (occupancy.size() != boxSize[0] * boxSize[1] * boxSize[2]) {
+    throw std::runtime_error("[VoxelDistanceField::updateOccupancy] The occupancy size does not match the box size!");
+  }
+  if (occupancy.empty()) {
+    return;
+  }
+
+  size_t boxIndex = 0;
+  for (size_t k = 0; k < boxSize[2]; k++) {
+    for (size_t j = 0; j < boxSize[1]; j++) {
+      for (size_t i = 0; i < boxSize[0]; i++) {
+        occupancy_[linearIndex({boxMin[0] + i, boxMin[1] + j, boxMin[2] + k})] = occupancy[boxIndex++] ? 1 : 0;
+      }
+    }
+  }
+
+  // Only the voxels within maxDistance of the box can change. Their truncated distances only depend on the voxels within maxDistance.
+  const Box writeBox = dilate({boxMin, boxSize}, maxDistanceInVoxels_);
+  const Box computeBox = dilate(writeBox, maxDistanceInVoxels_);
+  computeRegion(computeBox, writeBox);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+auto VoxelDistanceField::dilate(const Box& box, size_t numVoxels) const -> Box {
+  Box dilatedBox;
+  for (size_t axis = 0; axis < 3; axis++) {
+    dilatedBox.min[axis] = (box.min[axis] > numVoxels) ? box.min[axis] - numVoxels : 0;
+    const size_t max = std::min(box.min[axis] + box.size[axis] + numVoxels, size_[axis]);
+    dilatedBox.size[axis] = max - dilatedBox.min[axis];
+  }
+  return dilatedBox;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void VoxelDistanceField::computeRegion(const Box& computeBox, const Box& writeBox) {
+  const auto& n = computeBox.size;
+  const index3_t strides{1, n[0], n[0] * n[1]};
+  squaredDistanceToOccupied_.resize(n[0] * n[1] * n[2]);
+  squaredDistanceToFree_.resize(n[0] * n[1] * n[2]);
+
+  // initialization: the occupied voxels are the sources of the distance to obstacles and vice versa
+  threadPool_.parallelFor(n[2], [&](int, size_t k) {
+    for (size_t j = 0; j < n[1]; j++) {
+      const size_t gridOffset = linearIndex({computeBox.min[0], computeBox.min[1] + j, computeBox.min[2] + k});
+      const size_t localOffset = j * strides[1] + k * strides[2];
+      for (size_t i = 0; i < n[0]; i++) {
+        const bool occupied = occupancy_[gridOffset + i] != 0;
+        squaredDistanceToOccupied_[localOffset + i] = occupied ? 0.0 : SquaredInfinity;
+        squaredDistanceToFree_[localOffset + i] = occupied ? SquaredInfinity : 0.0;
+      }
+    }
+  });
+
+  // separable passes along x, y and z
+  for (size_t axis = 0; axis < 3; axis++) {
+    const size_t axis1 = (axis + 1) % 3;
+    const size_t axis2 = (axis + 2) % 3;
+    threadPool_.parallelFor(n[axis1] * n[axis2], [&](int workerIndex, size_t line) {
+      const size_t offset = (line % n[axis1]) * strides[axis1] + (line / n[axis1]) * strides[axis2];
+      auto& buffer = lineBuffers_[workerIndex];
+      transformLine(squaredDistanceToOccupied_, offset, strides[axis], n[axis], buffer);
+      transformLine(squaredDistanceToFree_, offset, strides[axis], n[axis], buffer);
+    });
+  }
+
+  // signed distance
+  const float resolution = static_cast<float>(resolution_);
+  const float maxDistance = static_cast<float>(maxDistance_);
+  threadPool_.parallelFor(writeBox.size[2], [&](int, size_t k) {
+    for (size_t j = 0; j < writeBox.size[1]; j++) {
+      const index3_t gridIndex{writeBox.min[0], writeBox.min[1] + j, writeBox.min[2] + k};
+      const size_t gridOffset = linearIndex(gridIndex);
+      const size_t localOffset = (gridIndex[0] - computeBox.min[0]) + (gridIndex[1] - computeBox.min[1]) * strides[1] +
+                                 (gridIndex[2] - computeBox.min[2]) * strides[2];
+      for (size_t i = 0; i < writeBox.size[0]; i++) {
+        const float distance = resolution * (std::sqrt(squaredDistanceToOccupied_[localOffset + i]) -
+                                             std::sqrt(squaredDistanceToFree_[localOffset + i]));
+        distance_[gridOffset + i] = std::min(std::max(distance, -maxDistance), maxDistance);
+      }
+    }
+  });
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void VoxelDistanceField::transformLine(std::vector<float>& volume, size_t offset, size_t stride, size_t length, LineBuffer& buffer) {
+  buffer.line.resize(length);
+  for (size_t i = 0; i < length; i++) {
+    buffer.line[i] = volume[offset + i * stride];
+  }
+
+  computeDistanceTransform(
+      length, [&](size_t i) { return buffer.line[i]; }, [&](size_t i, float value) { volume[offset + i * stride] = value; }, 0, length,
+      buffer.v, buffer.z);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void VoxelDistanceField::getReferenceVoxel(const vector3_t& p, index3_t& referenceVoxel, vector3_t& offset) const {
+  for (size_t axis = 0; axis < 3; axis++) {
+    const scalar_t maxCoordinate = static_cast<scalar_t>(size_[axis] - 1);
+    const scalar_t coordinate = std::min(std::max((p[axis] - origin_[axis]) / resolution_, scalar_t(0.0)), maxCoordinate);
+    referenceVoxel[axis] = std::min(static_cast<size_t>(coordinate), size_[axis] - 2);
+    offset[axis] = coordinate - static_cast<scalar_t>(referenceVoxel[axis]);
+  }
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+std::array<scalar_t, 8> VoxelDistanceField::getCornerValues(const index3_t& referenceVoxel) const {
+  const size_t i000 = linearIndex(referenceVoxel);
+  const size_t dy = size_[0];
+  const size_t dz = size_[0] * size_[1];
+  return {distance_[i000],      distance_[i000 + 1],      distance_[i000 + dy],      distance_[i000 + dy + 1],
+          distance_[i000 + dz], distance_[i000 + dz + 1], distance_[i000 + dz + dy], distance_[i000 + dz + dy + 1]};
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+scalar_t VoxelDistanceField::getValue(const vector3_t& p) const {
+  index3_t referenceVoxel;
+  vector3_t offset;
+  getReferenceVoxel(p, referenceVoxel, offset);
+
+  const vector3_t referenceCorner = origin_ + resolution_ * vector3_t(referenceVoxel[0], referenceVoxel[1], referenceVoxel[2]);
+  const vector3_t position = referenceCorner + resolution_ * offset;
+  return trilinear_interpolation::getValue(resolution_, referenceCorner, getCornerValues(referenceVoxel), position);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+auto VoxelDistanceField::getProjectedPoint(const vector3_t& p) const -> vector3_t {
+  const auto valueGradient = getLinearApproximation(p);
+  const scalar_t gradientNorm = valueGradient.second.norm();
+  if (gradientNorm < 1e-9) {
+    return p;
+  }
+  return p - (valueGradient.first / gradientNorm) * valueGradient.second;
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+auto VoxelDistanceField::getLinearApproximation(const vector3_t& p) const -> std::pair<scalar_t, vector3_t> {
+  index3_t referenceVoxel;
+  vector3_t offset;
+  getReferenceVoxel(p, referenceVoxel, offset);
+
+  const vector3_t referenceCorner = origin_ + resolution_ * vector3_t(referenceVoxel[0], referenceVoxel[1], referenceVoxel[2]);
+  const vector3_t position = referenceCorner + resolution_ * offset;
+  return trilinear_interpolation::getLinearApproximation(resolution_, referenceCorner, getCornerValues(referenceVoxel), position);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void VoxelDistanceField::getValues(const std::vector<vector3_t>& points, scalar_array_t& values) const {
+  interpolateBatch<false>(points, values, nullptr);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+void VoxelDistanceField::getLinearApproximations(const std::vector<vector3_t>& points, scalar_array_t& values,
+                                                 std::vector<vector3_t>& gradients) const {
+  interpolateBatch<true>(points, values, &gradients);
+}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+template <bool ComputeGradient>
+void VoxelDistanceField::interpolateBatch(const std::vector<vector3_t>& points, scalar_array_t& values,
+                                          std::vector<vector3_t>* gradientsPtr) const {
+  // Fixed-size Eigen arrays of four lanes, such that the interpolation arithmetic is vectorized over the points of a packet.
+  constexpr size_t PacketSize = 4;
+  using packet_t = Eigen::Array<scalar_t, PacketSize, 1>;
+  using corner_packet_t = Eigen::Array<scalar_t, PacketSize, 8>;
+
+  const size_t numPoints = points.size();
+  const size_t numPacketPoints = numPoints - numPoints % PacketSize;
+  values.resize(numPoints);
+  if (ComputeGradient) {
+    gradientsPtr->resize(numPoints);
+  }
+
+  index3_t referenceVoxel;
+  vector3_t offset;
+  packet_t x, y, z;
+  corner_packet_t c;
+  for (size_t first = 0; first < numPacketPoints; first += PacketSize) {
+    // gather
+    for (size_t lane = 0; lane < PacketSize; lane++) {
+      getReferenceVoxel(points[first + lane], referenceVoxel, offset);
+      x(lane) = offset.x();
+      y(lane) = offset.y();
+      z(lane) = offset.z();
+      const auto cornerValues = getCornerValues(referenceVoxel);
+      for (size_t corner = 0; corner < 8; corner++) {
+        c(lane, corner) = cornerValues[corner];
+      }
+    }
+
+    // interpolate
+    const packet_t xFlip = 1.0 - x;
+    const packet_t yFlip = 1.0 - y;
+    const packet_t zFlip = 1.0 - z;
+    const packet_t f00 = xFlip * c.col(0) + x * c.col(1);  // f_00 = (1 - x) f_000 + x f_100
+    const packet_t f10 = xFlip * c.col(2) + x * c.col(3);  // f_10 = (1 - x) f_010 + x f_110
+    const packet_t f01 = xFlip * c.col(4) + x * c.col(5);  // f_01 = (1 - x) f_001 + x f_101
+    const packet_t f11 = xFlip * c.col(6) + x * c.col(7);  // f_11 = (1 - x) f_011 + x f_111
+    const packet_t f0 = yFlip * f00 + y * f10;             // f_0 = (1 - y) f_00 + y f_10
+    const packet_t f1 = yFlip * f01 + y * f11;             // f_1 = (1 - y) f_01 + y f_11
+    const packet_t f = zFlip * f0 + z * f1;                // f = (1 - z) f_0 + z f_1
+    for (size_t lane = 0; lane < PacketSize; lane++) {
+      values[first + lane] = f(lane);
+    }
+
+    if (ComputeGradient) {
+      const scalar_t rInv = 1.0 / resolution_;
+      const packet_t dfdx = (zFlip * yFlip * (c.col(1) - c.col(0)) + zFlip * y * (c.col(3) - c.col(2)) +
+                             z * yFlip * (c.col(5) - c.col(4)) + z * y * (c.col(7) - c.col(6))) *
+                            rInv;
+      const packet_t dfdy = (zFlip * (f10 - f00) + z * (f11 - f01)) * rInv;
+      const packet_t dfdz = (f1 - f0) * rInv;
+      for (size_t lane = 0; lane < PacketSize; lane++) {
+        (*gradientsPtr)[first + lane] << dfdx(lane), dfdy(lane), dfdz(lane);
+      }
+    }
+  }
+
+  // remainder
+  for (size_t i = numPacketPoints; i < numPoints; i++) {
+    if (ComputeGradient) {
+      std::tie(values[i], (*gradientsPtr)[i]) = getLinearApproximation(points[i]);
+    } else {
+      values[i] = getValue(points[i]);
+    }
+  }
+}
+
+}  // namespace ocs2
@@ -0,0 +1,211 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <vector>
+
+#include <gtest/gtest.h>
+
+#include "ocs2_perceptive/distance_transform/VoxelDistanceField.h"
+
+namespace ocs2 {
+
+class VoxelDistanceFieldTest : public ::testing::Test {
+ protected:
+  using vector3_t = VoxelDistanceField::vector3_t;
+  using index3_t = VoxelDistanceField::index3_t;
+
+  static constexpr scalar_t resolution = 0.1;
+  static constexpr scalar_t maxDistance = 0.45;
+  const vector3_t origin{-0.5, 0.2, 1.0};
+  const index3_t size{{14, 11, 9}};
+
+  std::vector<bool> randomOccupancy(size_t numVoxels, scalar_t probability) {
+    std::bernoulli_distribution distribution(probability);
+    std::vector<bool> occupancy(numVoxels);
+    for (size_t i = 0; i < numVoxels; i++) {
+      occupancy[i] = distribution(generator);
+    }
+    return occupancy;
+  }
+
+  size_t linearIndex(size_t i, size_t j, size_t k) const { return i + size[0] * (j + size[1] * k); }
+
+  /** Brute force truncated signed distance of each voxel */
+  std::vector<scalar_t> bruteForceDistance(const std::vector<bool>& occupancy) const {
+    std::vector<scalar_t> distance(occupancy.size());
+    for (size_t k = 0; k < size[2]; k++) {
+      for (size_t j = 0; j < size[1]; j++) {
+        for (size_t i = 0; i < size[0]; i++) {
+          const bool occupied = occupancy[linearIndex(i, j, k)];
+          scalar_t minSquaredDistance = std::numeric_limits<scalar_t>::max();
+          for (size_t kk = 0; kk < size[2]; kk++) {
+            for (size_t jj = 0; jj < size[1]; jj++) {
+              for (size_t ii = 0; ii < size[0]; ii++) {
+                if (occupancy[linearIndex(ii, jj, kk)] != occupied) {
+                  const vector3_t delta(scalar_t(i) - scalar_t(ii), scalar_t(j) - scalar_t(jj), scalar_t(k) - scalar_t(kk));
+                  minSquaredDistance = std::min(minSquaredDistance, delta.squaredNorm());
+                }
+              }
+            }
+          }
+          const scalar_t value = std::min(resolution * std::sqrt(minSquaredDistance), maxDistance);
+          distance[linearIndex(i, j, k)] = occupied ? -value : value;
+        }
+      }
+    }
+    return distance;
+  }
+
+  vector3_t randomPoint(scalar_t margin) {
+    std::uniform_real_distribution<scalar_t> distribution(0.0, 1.0);
+    vector3_t p;
+    for (size_t axis = 0; axis < 3; axis++) {
+      const scalar_t length = resolution * (size[axis] - 1);
+      p[axis] = origin[axis] - margin + (length + 2.0 * margin) * distribution(generator);
+    }
+    return p;
+  }
+
+  std::mt19937 generator{0};
+};
+
+constexpr scalar_t VoxelDistanceFieldTest::resolution;
+constexpr scalar_t VoxelDistanceFieldTest::maxDistance;
+
+TEST_F(VoxelDistanceFieldTest, fullComputation) {
+  const auto occupancy = randomOccupancy(size[0] * size[1] * size[2], 0.03);
+  const auto expectedDistance = bruteForceDistance(occupancy);
+
+  for (size_t nThreads : {1, 3}) {
+    VoxelDistanceField distanceField(resolution, origin, size, maxDistance, nThreads);
+    distanceField.setOccupancy(occupancy);
+    for (size_t k = 0; k < size[2]; k++) {
+      for (size_t j = 0; j < size[1]; j++) {
+        for (size_t i = 0; i < size[0]; i++) {
+          ASSERT_NEAR(distanceField.getVoxelDistance({i, j, k}), expectedDistance[linearIndex(i, j, k)], 1e-5)
+              << "voxel (" << i << ", " << j << ", " << k << ") with " << nThreads << " threads";
+        }
+      }
+    }
+  }
+}
+
+TEST_F(VoxelDistanceFieldTest, incrementalUpdate) {
+  auto occupancy = randomOccupancy(size[0] * size[1] * size[2], 0.02);
+  VoxelDistanceField incrementalField(resolution, origin, size, maxDistance, 2);
+  VoxelDistanceField fullField(resolution, origin, size, maxDistance, 2);
+  incrementalField.setOccupancy(occupancy);
+
+  std::uniform_int_distribution<size_t> boxSizeDistribution(1, 4);
+  for (size_t update = 0; update < 20; update++) {
+    // random box and its new occupancy
+    index3_t boxMin, boxSize;
+    for (size_t axis = 0; axis < 3; axis++) {
+      boxSize[axis] = boxSizeDistribution(generator);
+      boxMin[axis] = std::uniform_int_distribution<size_t>(0, size[axis] - boxSize[axis])(generator);
+    }
+    const auto boxOccupancy = randomOccupancy(boxSize[0] * boxSize[1] * boxSize[2], 0.3);
+    size_t boxIndex = 0;
+    for (size_t k = 0; k < boxSize[2]; k++) {
+      for (size_t j = 0; j < boxSize[1]; j++) {
+        for (size_t i = 0; i < boxSize[0]; i++) {
+          occupancy[linearIndex(boxMin[0] + i, boxMin[1] + j, boxMin[2] + k)] = boxOccupancy[boxIndex++];
+        }
+      }
+    }
+
+    incrementalField.updateOccupancy(boxMin, boxSize, boxOccupancy);
+    fullField.setOccupancy(occupancy);
+    for (size_t k = 0; k < size[2]; k++) {
+      for (size_t j = 0; j < size[1]; j++) {
+        for (size_t i = 0; i < size[0]; i++) {
+          ASSERT_EQ(incrementalField.isOccupied({i, j, k}), fullField.isOccupied({i, j, k}));
+          ASSERT_NEAR(incrementalField.getVoxelDistance({i, j, k}), fullField.getVoxelDistance({i, j, k}), 1e-6)
+              << "voxel (" << i << ", " << j << ", " << k << ") after update " << update;
+        }
+      }
+    }
+  }
+}
+
+TEST_F(VoxelDistanceFieldTest, interpolation) {
+  VoxelDistanceField distanceField(resolution, origin, size, maxDistance);
+  distanceField.setOccupancy(randomOccupancy(size[0] * size[1] * size[2], 0.03));
+
+  // at the voxel centers
+  for (size_t n = 0; n < 100; n++) {
+    const index3_t index{{n % size[0], (3 * n) % size[1], (7 * n) % size[2]}};
+    const vector3_t center = origin + resolution * vector3_t(index[0], index[1], index[2]);
+    EXPECT_NEAR(distanceField.getValue(center), distanceField.getVoxelDistance(index), 1e-9);
+  }
+
+  // gradient versus finite differences
+  const scalar_t eps = 1e-6;
+  for (size_t n = 0; n < 100; n++) {
+    const vector3_t p = randomPoint(-0.01);
+    const auto valueGradient = distanceField.getLinearApproximation(p);
+    EXPECT_NEAR(valueGradient.first, distanceField.getValue(p), 1e-12);
+    for (size_t axis = 0; axis < 3; axis++) {
+      const vector3_t dp = eps * vector3_t::Unit(axis);
+      const scalar_t finiteDifference = (distanceField.getValue(p + dp) - distanceField.getValue(p - dp)) / (2.0 * eps);
+      EXPECT_NEAR(valueGradient.second[axis], finiteDifference, 1e-5);
+    }
+  }
+}
+
+TEST_F(VoxelDistanceFieldTest, batchedQueries) {
+  VoxelDistanceField distanceField(resolution, origin, size, maxDistance);
+  distanceField.setOccupancy(randomOccupancy(size[0] * size[1] * size[2], 0.03));
+
+  // not a multiple of the packet size, some points outside of the grid
+  std::vector<vector3_t> points(23);
+  for (auto& p : points) {
+    p = randomPoint(0.2);
+  }
+
+  scalar_array_t values, approximationValues;
+  std::vector<vector3_t> gradients;
+  distanceField.getValues(points, values);
+  distanceField.getLinearApproximations(points, approximationValues, gradients);
+  ASSERT_EQ(values.size(), points.size());
+  ASSERT_EQ(gradients.size(), points.size());
+
+  for (size_t i = 0; i < points.size(); i++) {
+    const auto valueGradient = distanceField.getLinearApproximation(points[i]);
+    EXPECT_NEAR(values[i], valueGradient.first, 1e-12);
+    EXPECT_NEAR(approximationValues[i], valueGradient.first, 1e-12);
+    EXPECT_TRUE(gradients[i].isApprox(valueGradient.second, 1e-12) || gradients[i].norm() + valueGradient.second.norm() < 1e-12);
+  }
+}
+
+}  // namespace ocs2
@@ -31,6 +31,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <ocs2_pinocchio_interface/PinocchioInterface.h>
 #include <ocs2_self_collision/PinocchioGeometryInterface.h>
+#include <ocs2_self_collision/SelfCollisionDistanceEngine.h>
 
 namespace ocs2 {
 
@@ -43,8 +44,10 @@ class SelfCollision {
    *
    * @param [in] pinocchioGeometryInterface: pinocchio geometry interface of the robot model
    * @parma [in] minimumDistance: minimum allowed distance between each collision pair
+   * @param [in] cullingDistance: distance above which a collision pair is inactive, see SelfCollisionDistanceEngine
    */
-  SelfCollision(PinocchioGeometryInterface pinocchioGeometryInterface, scalar_t minimumDistance);
+  SelfCollision(PinocchioGeometryInterface pinocchioGeometryInterface, scalar_t minimumDistance,
+                scalar_t cullingDistance = std::numeric_limits<scalar_t>::infinity());
 
   /** Get the number of collision pairs */
   size_t getNumCollisionPairs() const { return pinocchioGeometryInterface_.getNumCollisionPairs(); }
@@ -76,6 +79,7 @@ class SelfCollision {
  private:
   PinocchioGeometryInterface pinocchioGeometryInterface_;
   scalar_t minimumDistance_;
+  mutable SelfCollisionDistanceEngine distanceEngine_;
 };
 
 }  // namespace ocs2
@@ -61,11 +61,12 @@ class SelfCollisionConstraintCppAd final : public StateConstraint {
    * @param [in] recompileLibraries: If true, the model library will be newly compiled. If false, an existing library will be loaded if
    *                                 available.
    * @param [in] verbose: If true, print information. Otherwise, no information is printed.
+   * @param [in] cullingDistance: The distance above which a collision pair is inactive, see SelfCollisionDistanceEngine.
    */
   SelfCollisionConstraintCppAd(PinocchioInterface pinocchioInterface, const PinocchioStateInputMapping<scalar_t>& mapping,
                                PinocchioGeometryInterface pinocchioGeometryInterface, scalar_t minimumDistance,
                                const std::string& modelName, const std::string& modelFolder = "/tmp/ocs2", bool recompileLibraries = true,
-                               bool verbose = true);
+                               bool verbose = true, scalar_t cullingDistance = std::numeric_limits<scalar_t>::infinity());
 
   /**
    * Constructor
@@ -81,11 +82,13 @@ class SelfCollisionConstraintCppAd final : public StateConstraint {
    * @param [in] recompileLibraries: If true, the model library will be newly compiled. If false, an existing library will be loaded if
    *                                 available.
    * @param [in] verbose: If true, print information. Otherwise, no information is printed.
+   * @param [in] cullingDistance: The distance above which a collision pair is inactive, see SelfCollisionDistanceEngine.
    */
   SelfCollisionConstraintCppAd(PinocchioInterface pinocchioInterface, const PinocchioStateInputMapping<scalar_t>& mapping,
                                PinocchioGeometryInterface pinocchioGeometryInterface, scalar_t minimumDistance,
                                update_pinocchio_interface_callback updateCallback, const std::string& modelName,
-                               const std::string& modelFolder = "/tmp/ocs2", bool recompileLibraries = true, bool verbose = true);
+                               const std::string& modelFolder = "/tmp/ocs2", bool recompileLibraries = true, bool verbose = true,
+                               scalar_t cullingDistance = std::numeric_limits<scalar_t>::infinity());
 
   ~SelfCollisionConstraintCppAd() override = default;
   SelfCollisionConstraintCppAd* clone() const override { return new SelfCollisionConstraintCppAd(*this); }
@@ -33,6 +33,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_pinocchio_interface/PinocchioInterface.h>
 
 #include "ocs2_self_collision/PinocchioGeometryInterface.h"
+#include "ocs2_self_collision/SelfCollisionDistanceEngine.h"
 
 namespace ocs2 {
 
@@ -52,10 +53,12 @@ class SelfCollisionCppAd {
    * @param [in] recompileLibraries : If true, the model library will be newly compiled. If false, an existing library will be loaded if
    *                                  available.
    * @param [in] verbose : print information.
+   * @param [in] cullingDistance : distance above which a collision pair is inactive, see SelfCollisionDistanceEngine
    */
   SelfCollisionCppAd(const PinocchioInterface& pinocchioInterface, PinocchioGeometryInterface pinocchioGeometryInterface,
                      scalar_t minimumDistance, const std::string& modelName, const std::string& modelFolder = "/tmp/ocs2",
-                     bool recompileLibraries = true, bool verbose = true);
+                     bool recompileLibraries = true, bool verbose = true,
+                     scalar_t cullingDistance = std::numeric_limits<scalar_t>::infinity());
 
   /** Default destructor */
   ~SelfCollisionCppAd() = default;
@@ -113,6 +116,7 @@ class SelfCollisionCppAd {
 
   PinocchioGeometryInterface pinocchioGeometryInterface_;
   scalar_t minimumDistance_;
+  mutable SelfCollisionDistanceEngine distanceEngine_;
 };
 
 } /* namespace ocs2 */
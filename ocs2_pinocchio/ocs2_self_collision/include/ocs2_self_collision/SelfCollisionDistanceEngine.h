@@ -0,0 +1,104 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#pragma once
+
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include <ocs2_pinocchio_interface/PinocchioInterface.h>
+#include <ocs2_self_collision/PinocchioGeometryInterface.h>
+
+/* Forward declaration of pinocchio geometry types */
+namespace pinocchio {
+struct GeometryData;
+}  // namespace pinocchio
+
+namespace ocs2 {
+
+/**
+ * Computes the self-collision distances of a PinocchioGeometryInterface for a sequence of nearby configurations, such as the nodes of a
+ * shooting grid or consecutive solver iterations.
+ *
+ * Two things are reused between calls:
+ * - Broad phase: pairs whose bounding spheres are further apart than the culling distance skip the exact distance computation.
+ * - Warm start: the GJK of the remaining pairs starts from the guess of the previous call, which is usually close to the solution.
+ *
+ * All returned distances are saturated at the culling distance. The culled pairs are thereby reported exactly like pairs that were
+ * computed and found further away, and the distance remains a continuous function of the configuration. Callers should treat saturated
+ * pairs as inactive, i.e. with a zero derivative.
+ *
+ * The warm start data is local to the instance and is not copied. One instance should therefore be used per thread.
+ */
+class SelfCollisionDistanceEngine {
+ public:
+  /**
+   * Constructor
+   *
+   * @param [in] cullingDistance: Distance above which a pair is inactive. The default disables the culling and the saturation.
+   */
+  explicit SelfCollisionDistanceEngine(scalar_t cullingDistance = std::numeric_limits<scalar_t>::infinity());
+
+  ~SelfCollisionDistanceEngine();
+
+  /** Copy constructor. Copies the settings but not the warm start data. */
+  SelfCollisionDistanceEngine(const SelfCollisionDistanceEngine& rhs);
+  SelfCollisionDistanceEngine& operator=(const SelfCollisionDistanceEngine&) = delete;
+
+  /**
+   * Compute collision pair distances
+   *
+   * @note Requires pinocchioInterface with updated joint placements by calling forwardKinematics().
+   *
+   * @param [in] pinocchioInterface: pinocchio interface of the robot model
+   * @param [in] pinocchioGeometryInterface: pinocchio geometry interface of the robot model
+   * @return An array of distances between the collision pairs, valid until the next call.
+   */
+  const std::vector<hpp::fcl::DistanceResult>& computeDistances(const PinocchioInterface& pinocchioInterface,
+                                                                const PinocchioGeometryInterface& pinocchioGeometryInterface);
+
+  /** Whether a distance result returned by computeDistances() is saturated at the culling distance */
+  bool isSaturated(const hpp::fcl::DistanceResult& distanceResult) const { return distanceResult.min_distance >= cullingDistance_; }
+
+  /** Number of pairs skipped by the broad phase during the last call to computeDistances() */
+  size_t getNumCulledPairs() const { return numCulledPairs_; }
+
+  scalar_t getCullingDistance() const { return cullingDistance_; }
+
+ private:
+  const scalar_t cullingDistance_;
+  size_t numCulledPairs_ = 0;
+
+  // Geometry data of the last call, its requests carry the GJK guesses. Recreated when the geometry model changes.
+  const pinocchio::GeometryModel* geometryModelPtr_ = nullptr;
+  std::unique_ptr<pinocchio::GeometryData> geometryDataPtr_;
+};
+
+}  // namespace ocs2
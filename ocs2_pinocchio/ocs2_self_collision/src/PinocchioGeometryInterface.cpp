@@ -100,6 +100,11 @@ void PinocchioGeometryInterface::buildGeomFromPinocchioInterface(const Pinocchio
   const std::stringstream urdfAsStringStream(printer.Str());
 
   pinocchio::urdf::buildGeom(pinocchioInterface.getModel(), urdfAsStringStream, pinocchio::COLLISION, geomModel);
+
+  // Bounding spheres used by the broad phase of SelfCollisionDistanceEngine
+  for (auto& geometryObject : geomModel.geometryObjects) {
+    geometryObject.geometry->computeLocalAABB();
+  }
 }
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -42,14 +42,16 @@ namespace ocs2 {
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
-SelfCollision::SelfCollision(PinocchioGeometryInterface pinocchioGeometryInterface, scalar_t minimumDistance)
-    : pinocchioGeometryInterface_(std::move(pinocchioGeometryInterface)), minimumDistance_(minimumDistance) {}
+SelfCollision::SelfCollision(PinocchioGeometryInterface pinocchioGeometryInterface, scalar_t minimumDistance, scalar_t cullingDistance)
+    : pinocchioGeometryInterface_(std::move(pinocchioGeometryInterface)),
+      minimumDistance_(minimumDistance),
+      distanceEngine_(cullingDistance) {}
 
 /******************************************************************************************************/
 /******************************************************************************************************/
 /******************************************************************************************************/
 vector_t SelfCollision::getValue(const PinocchioInterface& pinocchioInterface) const {
-  const std::vector<hpp::fcl::DistanceResult> distanceArray = pinocchioGeometryInterface_.computeDistances(pinocchioInterface);
+  const auto& distanceArray = distanceEngine_.computeDistances(pinocchioInterface, pinocchioGeometryInterface_);
 
   vector_t violations = vector_t::Zero(distanceArray.size());
   for (size_t i = 0; i < distanceArray.size(); ++i) {
@@ -63,7 +65,7 @@ vector_t SelfCollision::getValue(const PinocchioInterface& pinocchioInterface) c
 /******************************************************************************************************/
 /******************************************************************************************************/
 std::pair<vector_t, matrix_t> SelfCollision::getLinearApproximation(const PinocchioInterface& pinocchioInterface) const {
-  const std::vector<hpp::fcl::DistanceResult> distanceArray = pinocchioGeometryInterface_.computeDistances(pinocchioInterface);
+  const auto& distanceArray = distanceEngine_.computeDistances(pinocchioInterface, pinocchioGeometryInterface_);
 
   const auto& model = pinocchioInterface.getModel();
   const auto& data = pinocchioInterface.getData();
@@ -76,6 +78,12 @@ std::pair<vector_t, matrix_t> SelfCollision::getLinearApproximation(const Pinocc
     // Distance violation
     f[i] = distanceArray[i].min_distance - minimumDistance_;
 
+    // Inactive pair
+    if (distanceEngine_.isSaturated(distanceArray[i])) {
+      dfdq.row(i).setZero();
+      continue;
+    }
+
     // Jacobian calculation
     const auto& collisionPair = geometryModel.collisionPairs[i];
     const auto& joint1 = geometryModel.geometryObjects[collisionPair.first].parentJoint;
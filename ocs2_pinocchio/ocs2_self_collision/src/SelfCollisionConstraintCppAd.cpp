@@ -49,9 +49,9 @@ SelfCollisionConstraintCppAd::SelfCollisionConstraintCppAd(PinocchioInterface pi
                                                            const PinocchioStateInputMapping<scalar_t>& mapping,
                                                            PinocchioGeometryInterface pinocchioGeometryInterface, scalar_t minimumDistance,
                                                            const std::string& modelName, const std::string& modelFolder,
-                                                           bool recompileLibraries, bool verbose)
+                                                           bool recompileLibraries, bool verbose, scalar_t cullingDistance)
     : SelfCollisionConstraintCppAd(std::move(pinocchioInterface), mapping, std::move(pinocchioGeometryInterface), minimumDistance,
-                                   defaultUpdatePinocchioInterface, modelName, modelFolder, recompileLibraries, verbose) {}
+                                   defaultUpdatePinocchioInterface, modelName, modelFolder, recompileLibraries, verbose, cullingDistance) {}
 
 /******************************************************************************************************/
 /******************************************************************************************************/
@@ -60,11 +60,12 @@ SelfCollisionConstraintCppAd::SelfCollisionConstraintCppAd(PinocchioInterface pi
                                                            const PinocchioStateInputMapping<scalar_t>& mapping,
                                                            PinocchioGeometryInterface pinocchioGeometryInterface, scalar_t minimumDistance,
                                                            update_pinocchio_interface_callback updateCallback, const std::string& modelName,
-                                                           const std::string& modelFolder, bool recompileLibraries, bool verbose)
+                                                           const std::string& modelFolder, bool recompileLibraries, bool verbose,
+                                                           scalar_t cullingDistance)
     : StateConstraint(ConstraintOrder::Linear),
       pinocchioInterface_(std::move(pinocchioInterface)),
       selfCollision_(pinocchioInterface_, std::move(pinocchioGeometryInterface), minimumDistance, modelName, modelFolder,
-                     recompileLibraries, verbose),
+                     recompileLibraries, verbose, cullingDistance),
       mappingPtr_(mapping.clone()),
       updateCallback_(std::move(updateCallback)) {
   mappingPtr_->setPinocchioInterface(pinocchioInterface_);
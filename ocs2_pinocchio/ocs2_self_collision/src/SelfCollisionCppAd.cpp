@@ -44,16 +44,15 @@ namespace ocs2 {
 /******************************************************************************************************/
 SelfCollisionCppAd::SelfCollisionCppAd(const PinocchioInterface& pinocchioInterface, PinocchioGeometryInterface pinocchioGeometryInterface,
                                        scalar_t minimumDistance, const std::string& modelName, const std::string& modelFolder,
-                                       bool recompileLibraries, bool verbose)
-    : pinocchioGeometryInterface_(std::move(pinocchioGeometryInterface)), minimumDistance_(minimumDistance) {
+                                       bool recompileLibraries, bool verbose, scalar_t cullingDistance)
+    : pinocchioGeometryInterface_(std::move(pinocchioGeometryInterface)), minimumDistance_(minimumDistance), distanceEngine_(cullingDistance) {
   PinocchioInterfaceCppAd pinocchioInterfaceAd = pinocchioInterface.toCppAd();
   setADInterfaces(pinocchioInterfaceAd, modelName, modelFolder);
+  const std::vector<CppAdInterface*> adInterfaces{cppAdInterfaceDistanceCalculation_.get(), cppAdInterfaceLinkPoints_.get()};
   if (recompileLibraries) {
-    cppAdInterfaceDistanceCalculation_->createModels(CppAdInterface::ApproximationOrder::First, verbose);
-    cppAdInterfaceLinkPoints_->createModels(CppAdInterface::ApproximationOrder::First, verbose);
+    CppAdInterface::createModels(adInterfaces, CppAdInterface::ApproximationOrder::First, verbose);
   } else {
-    cppAdInterfaceDistanceCalculation_->loadModelsIfAvailable(CppAdInterface::ApproximationOrder::First, verbose);
-    cppAdInterfaceLinkPoints_->loadModelsIfAvailable(CppAdInterface::ApproximationOrder::First, verbose);
+    CppAdInterface::loadModelsIfAvailable(adInterfaces, CppAdInterface::ApproximationOrder::First, verbose);
   }
 }
 
@@ -63,6 +62,7 @@ SelfCollisionCppAd::SelfCollisionCppAd(const PinocchioInterface& pinocchioInterf
 SelfCollisionCppAd::SelfCollisionCppAd(const SelfCollisionCppAd& rhs)
     : minimumDistance_(rhs.minimumDistance_),
       pinocchioGeometryInterface_(rhs.pinocchioGeometryInterface_),
+      distanceEngine_(rhs.distanceEngine_),
       cppAdInterfaceDistanceCalculation_(new CppAdInterface(*rhs.cppAdInterfaceDistanceCalculation_)),
       cppAdInterfaceLinkPoints_(new CppAdInterface(*rhs.cppAdInterfaceLinkPoints_)) {}
 
@@ -70,7 +70,7 @@ SelfCollisionCppAd::SelfCollisionCppAd(const SelfCollisionCppAd& rhs)
 /******************************************************************************************************/
 /******************************************************************************************************/
 vector_t SelfCollisionCppAd::getValue(const PinocchioInterface& pinocchioInterface) const {
-  const std::vector<hpp::fcl::DistanceResult> distanceArray = pinocchioGeometryInterface_.computeDistances(pinocchioInterface);
+  const auto& distanceArray = distanceEngine_.computeDistances(pinocchioInterface, pinocchioGeometryInterface_);
 
   vector_t violations = vector_t::Zero(distanceArray.size());
   for (size_t i = 0; i < distanceArray.size(); ++i) {
@@ -85,7 +85,7 @@ vector_t SelfCollisionCppAd::getValue(const PinocchioInterface& pinocchioInterfa
 /******************************************************************************************************/
 std::pair<vector_t, matrix_t> SelfCollisionCppAd::getLinearApproximation(const PinocchioInterface& pinocchioInterface,
                                                                          const vector_t& q) const {
-  const std::vector<hpp::fcl::DistanceResult> distanceArray = pinocchioGeometryInterface_.computeDistances(pinocchioInterface);
+  const auto& distanceArray = distanceEngine_.computeDistances(pinocchioInterface, pinocchioGeometryInterface_);
 
   vector_t pointsInWorldFrame(distanceArray.size() * numberOfParamsPerResult_);
   for (size_t i = 0; i < distanceArray.size(); ++i) {
@@ -95,8 +95,16 @@ std::pair<vector_t, matrix_t> SelfCollisionCppAd::getLinearApproximation(const P
   }
 
   const auto pointsInLinkFrame = cppAdInterfaceLinkPoints_->getFunctionValue(q, pointsInWorldFrame);
-  const auto f = cppAdInterfaceDistanceCalculation_->getFunctionValue(q, pointsInLinkFrame);
-  const auto dfdq = cppAdInterfaceDistanceCalculation_->getJacobian(q, pointsInLinkFrame);
+  vector_t f = cppAdInterfaceDistanceCalculation_->getFunctionValue(q, pointsInLinkFrame);
+  matrix_t dfdq = cppAdInterfaceDistanceCalculation_->getJacobian(q, pointsInLinkFrame);
+
+  // Inactive pairs
+  for (size_t i = 0; i < distanceArray.size(); ++i) {
+    if (distanceEngine_.isSaturated(distanceArray[i])) {
+      f[i] = distanceArray[i].min_distance - minimumDistance_;
+      dfdq.row(i).setZero();
+    }
+  }
 
   return std::make_pair(f, dfdq);
 }
@@ -0,0 +1,105 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <pinocchio/fwd.hpp>
+
+#include <ocs2_self_collision/SelfCollisionDistanceEngine.h>
+
+#include <algorithm>
+
+#include <pinocchio/algorithm/geometry.hpp>
+#include <pinocchio/multibody/geometry.hpp>
+
+namespace ocs2 {
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+SelfCollisionDistanceEngine::SelfCollisionDistanceEngine(scalar_t cullingDistance) : cullingDistance_(cullingDistance) {}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+SelfCollisionDistanceEngine::~SelfCollisionDistanceEngine() = default;
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+SelfCollisionDistanceEngine::SelfCollisionDistanceEngine(const SelfCollisionDistanceEngine& rhs)
+    : SelfCollisionDistanceEngine(rhs.cullingDistance_) {}
+
+/******************************************************************************************************/
+/******************************************************************************************************/
+/******************************************************************************************************/
+const std::vector<hpp::fcl::DistanceResult>& SelfCollisionDistanceEngine::computeDistances(
+    const PinocchioInterface& pinocchioInterface, const PinocchioGeometryInterface& pinocchioGeometryInterface) {
+  const auto& geometryModel = pinocchioGeometryInterface.getGeometryModel();
+  if (geometryDataPtr_ == nullptr || geometryModelPtr_ != &geometryModel ||
+      geometryDataPtr_->distanceResults.size() != geometryModel.collisionPairs.size()) {
+    geometryModelPtr_ = &geometryModel;
+    geometryDataPtr_.reset(new pinocchio::GeometryData(geometryModel));
+    for (auto& distanceRequest : geometryDataPtr_->distanceRequests) {
+      distanceRequest.enable_cached_gjk_guess = true;
+    }
+  }
+  auto& geometryData = *geometryDataPtr_;
+
+  pinocchio::updateGeometryPlacements(pinocchioInterface.getModel(), pinocchioInterface.getData(), geometryModel, geometryData);
+
+  numCulledPairs_ = 0;
+  for (size_t i = 0; i < geometryModel.collisionPairs.size(); ++i) {
+    const auto& collisionPair = geometryModel.collisionPairs[i];
+    const auto& geometry1 = *geometryModel.geometryObjects[collisionPair.first].geometry;
+    const auto& geometry2 = *geometryModel.geometryObjects[collisionPair.second].geometry;
+    auto& distanceResult = geometryData.distanceResults[i];
+
+    // Broad phase: distance between the bounding spheres is a lower bound on the distance between the objects
+    const Eigen::Vector3d center1 = geometryData.oMg[collisionPair.first].act(geometry1.aabb_center);
+    const Eigen::Vector3d center2 = geometryData.oMg[collisionPair.second].act(geometry2.aabb_center);
+    const scalar_t centerDistance = (center2 - center1).norm();
+    if (centerDistance - geometry1.aabb_radius - geometry2.aabb_radius >= cullingDistance_) {
+      const Eigen::Vector3d direction = (center2 - center1) / centerDistance;
+      distanceResult.clear();
+      distanceResult.min_distance = cullingDistance_;
+      distanceResult.nearest_points[0] = center1 + geometry1.aabb_radius * direction;
+      distanceResult.nearest_points[1] = center2 - geometry2.aabb_radius * direction;
+      ++numCulledPairs_;
+      continue;
+    }
+
+    // Narrow phase, warm started from the result of the previous call
+    pinocchio::computeDistance(geometryModel, geometryData, i);
+    geometryData.distanceRequests[i].updateGuess(distanceResult);
+    distanceResult.min_distance = std::min(distanceResult.min_distance, cullingDistance_);
+  }
+
+  return geometryData.distanceResults;
+}
+
+}  // namespace ocs2
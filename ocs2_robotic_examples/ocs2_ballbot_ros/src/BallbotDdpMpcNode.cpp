@@ -35,6 +35,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_ros_interfaces/synchronized_module/RosReferenceManager.h>
 
 #include <ocs2_ballbot/BallbotInterface.h>
+#include <ocs2_ballbot/definitions.h>
 
 int main(int argc, char** argv) {
   const std::string robotName = "ballbot";
@@ -63,6 +64,9 @@ int main(int argc, char** argv) {
   // MPC
   ocs2::GaussNewtonDDP_MPC mpc(ballbotInterface.mpcSettings(), ballbotInterface.ddpSettings(), ballbotInterface.getRollout(),
                                ballbotInterface.getOptimalControlProblem(), ballbotInterface.getInitializer());
+  if (ballbotInterface.ddpSettings().algorithm_ == ocs2::ddp::Algorithm::ILQR) {
+    static_cast<ocs2::ILQR*>(mpc.getSolverPtr())->useFixedSizeRiccatiEquations<ocs2::ballbot::STATE_DIM, ocs2::ballbot::INPUT_DIM>();
+  }
   mpc.getSolverPtr()->setReferenceManager(rosReferenceManagerPtr);
 
   // Launch MPC ROS node
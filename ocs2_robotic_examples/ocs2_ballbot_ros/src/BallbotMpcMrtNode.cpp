@@ -48,6 +48,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_ros_interfaces/synchronized_module/RosReferenceManager.h>
 
 #include <ocs2_ballbot/BallbotInterface.h>
+#include <ocs2_ballbot/definitions.h>
 #include "ocs2_ballbot_ros/BallbotDummyVisualization.h"
 
 /**
@@ -89,6 +90,9 @@ int main(int argc, char** argv) {
   // MPC
   ocs2::GaussNewtonDDP_MPC mpc(ballbotInterface.mpcSettings(), ballbotInterface.ddpSettings(), ballbotInterface.getRollout(),
                                ballbotInterface.getOptimalControlProblem(), ballbotInterface.getInitializer());
+  if (ballbotInterface.ddpSettings().algorithm_ == ocs2::ddp::Algorithm::ILQR) {
+    static_cast<ocs2::ILQR*>(mpc.getSolverPtr())->useFixedSizeRiccatiEquations<ocs2::ballbot::STATE_DIM, ocs2::ballbot::INPUT_DIM>();
+  }
 
   // ROS ReferenceManager. This gives us the command interface. Requires the observations to be published
   auto rosReferenceManagerPtr = std::make_shared<ocs2::RosReferenceManager>(robotName, ballbotInterface.getReferenceManagerPtr());
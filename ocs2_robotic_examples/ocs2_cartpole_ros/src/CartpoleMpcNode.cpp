@@ -33,6 +33,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ros/package.h>
 
 #include <ocs2_cartpole/CartPoleInterface.h>
+#include <ocs2_cartpole/definitions.h>
 #include <ocs2_ddp/GaussNewtonDDP_MPC.h>
 #include <ocs2_ros_interfaces/mpc/MPC_ROS_Interface.h>
 #include <ocs2_ros_interfaces/synchronized_module/SolverObserverRosCallbacks.h>
@@ -60,6 +61,9 @@ int main(int argc, char** argv) {
   // MPC
   ocs2::GaussNewtonDDP_MPC mpc(cartPoleInterface.mpcSettings(), cartPoleInterface.ddpSettings(), cartPoleInterface.getRollout(),
                                cartPoleInterface.getOptimalControlProblem(), cartPoleInterface.getInitializer());
+  if (cartPoleInterface.ddpSettings().algorithm_ == ocs2::ddp::Algorithm::ILQR) {
+    static_cast<ocs2::ILQR*>(mpc.getSolverPtr())->useFixedSizeRiccatiEquations<ocs2::cartpole::STATE_DIM, ocs2::cartpole::INPUT_DIM>();
+  }
 
   // observer for the input limits constraints
   auto createStateInputBoundsObserver = [&]() {
@@ -40,8 +40,9 @@ namespace mobile_manipulator {
 class MobileManipulatorSelfCollisionConstraint final : public SelfCollisionConstraint {
  public:
   MobileManipulatorSelfCollisionConstraint(const PinocchioStateInputMapping<scalar_t>& mapping,
-                                           PinocchioGeometryInterface pinocchioGeometryInterface, scalar_t minimumDistance)
-      : SelfCollisionConstraint(mapping, std::move(pinocchioGeometryInterface), minimumDistance) {}
+                                           PinocchioGeometryInterface pinocchioGeometryInterface, scalar_t minimumDistance,
+                                           scalar_t cullingDistance = std::numeric_limits<scalar_t>::infinity())
+      : SelfCollisionConstraint(mapping, std::move(pinocchioGeometryInterface), minimumDistance, cullingDistance) {}
   ~MobileManipulatorSelfCollisionConstraint() override = default;
   MobileManipulatorSelfCollisionConstraint(const MobileManipulatorSelfCollisionConstraint& other) = default;
   MobileManipulatorSelfCollisionConstraint* clone() const { return new MobileManipulatorSelfCollisionConstraint(*this); }
@@ -156,3 +156,49 @@ TEST_F(TestSelfCollision, testRandomJointPositions) {
     ASSERT_TRUE(Jd1.isApprox(Jd2));
   }
 }
+
+TEST_F(TestSelfCollision, culledDistancesAreSaturated) {
+  const scalar_t cullingDistance = 0.3;
+  SelfCollision selfCollision(geometryInterface, minDistance);
+  SelfCollision selfCollisionCulled(geometryInterface, minDistance, cullingDistance);
+  SelfCollisionCppAd selfCollisionCppAdCulled(pinocchioInterface, geometryInterface, minDistance, "testSelfCollision", libraryFolder,
+                                              true, false, cullingDistance);
+
+  for (int i = 0; i < 10; i++) {
+    vector_t q = vector_t::Random(9);
+    computeLinearApproximation(pinocchioInterface, q);
+
+    vector_t d, dCulled, dCppAdCulled;
+    matrix_t Jd, JdCulled, JdCppAdCulled;
+    std::tie(d, Jd) = selfCollision.getLinearApproximation(pinocchioInterface);
+    std::tie(dCulled, JdCulled) = selfCollisionCulled.getLinearApproximation(pinocchioInterface);
+    std::tie(dCppAdCulled, JdCppAdCulled) = selfCollisionCppAdCulled.getLinearApproximation(pinocchioInterface, q);
+
+    for (int j = 0; j < d.size(); j++) {
+      if (d[j] < cullingDistance - minDistance) {
+        ASSERT_NEAR(dCulled[j], d[j], 1e-9);
+        ASSERT_TRUE(JdCulled.row(j).isApprox(Jd.row(j), 1e-6));
+      } else {
+        ASSERT_DOUBLE_EQ(dCulled[j], cullingDistance - minDistance);
+        ASSERT_TRUE(JdCulled.row(j).isZero());
+      }
+    }
+    ASSERT_TRUE(dCulled.isApprox(dCppAdCulled));
+    ASSERT_TRUE(JdCulled.isApprox(JdCppAdCulled));
+  }
+}
+
+TEST_F(TestSelfCollision, warmStartedDistances) {
+  SelfCollision selfCollision(geometryInterface, minDistance);
+
+  for (int i = 0; i < 10; i++) {
+    vector_t q = vector_t::Random(9);
+    computeValue(pinocchioInterface, q);
+
+    // A fresh copy does not carry the warm start of the previous configurations
+    const SelfCollision selfCollisionCold(selfCollision);
+    const vector_t dWarm = selfCollision.getValue(pinocchioInterface);
+    const vector_t dCold = selfCollisionCold.getValue(pinocchioInterface);
+    ASSERT_TRUE(dWarm.isApprox(dCold, 1e-6));
+  }
+}
@@ -111,6 +111,7 @@ class SwitchedModelPreComputation : public ocs2::PreComputation {
   std::vector<kinematic_model_t::CollisionSphere> collisionSpheresInOriginFrame_;
   CostElements<scalar_t> motionReference_;
   vector_t stateReference_;
+  ocs2::LinearInterpolation::TimeSegmentCursor referenceCursor_;  // the nodes are requested at increasing times
 
   // Precomputation access : any(cost, constraint, softConstraint) + (derivatives)
   feet_array_t<matrix_t> feetPositionInOriginFrameStateDerivative_;
@@ -4,6 +4,10 @@
 
 #pragma once
 
+#include <cassert>
+#include <functional>
+#include <vector>
+
 #include "ocs2_switched_model_interface/core/SwitchedModel.h"
 #include "ocs2_switched_model_interface/terrain/ConvexTerrain.h"
 #include "ocs2_switched_model_interface/terrain/SignedDistanceField.h"
@@ -41,6 +45,33 @@ class TerrainModel {
     return {getLocalTerrainAtPositionInWorldAlongGravity(positionInWorld, std::move(penaltyFunction)), {}};
   }
 
+  /**
+   * Batched version of getLocalTerrainAtPositionInWorldAlongGravity, with one penalty function per query point. Terrain models with a
+   * spatial index can override this to share work across the queries. The default implementation queries one point at a time.
+   */
+  virtual std::vector<TerrainPlane> getLocalTerrainsAtPositionsInWorldAlongGravity(
+      const std::vector<vector3_t>& positionsInWorld, const std::vector<std::function<scalar_t(const vector3_t&)>>& penaltyFunctions) const {
+    assert(positionsInWorld.size() == penaltyFunctions.size());
+    std::vector<TerrainPlane> terrainPlanes;
+    terrainPlanes.reserve(positionsInWorld.size());
+    for (size_t i = 0; i < positionsInWorld.size(); ++i) {
+      terrainPlanes.push_back(getLocalTerrainAtPositionInWorldAlongGravity(positionsInWorld[i], penaltyFunctions[i]));
+    }
+    return terrainPlanes;
+  }
+
+  /** Batched version of getConvexTerrainAtPositionInWorld, see getLocalTerrainsAtPositionsInWorldAlongGravity. */
+  virtual std::vector<ConvexTerrain> getConvexTerrainsAtPositionsInWorld(
+      const std::vector<vector3_t>& positionsInWorld, const std::vector<std::function<scalar_t(const vector3_t&)>>& penaltyFunctions) const {
+    assert(positionsInWorld.size() == penaltyFunctions.size());
+    std::vector<ConvexTerrain> convexTerrains;
+    convexTerrains.reserve(positionsInWorld.size());
+    for (size_t i = 0; i < positionsInWorld.size(); ++i) {
+      convexTerrains.push_back(getConvexTerrainAtPositionInWorld(positionsInWorld[i], penaltyFunctions[i]));
+    }
+    return convexTerrains;
+  }
+
   /** Returns the signed distance field for this terrain if one is available */
   virtual const SignedDistanceField* getSignedDistanceField() const { return nullptr; }
 
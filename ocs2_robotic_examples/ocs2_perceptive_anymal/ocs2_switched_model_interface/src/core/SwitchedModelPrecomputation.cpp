@@ -46,12 +46,11 @@ SwitchedModelPreComputation::SwitchedModelPreComputation(const SwingTrajectoryPl
   // Generate the models
   const bool verbose = true;
   const auto order = ocs2::CppAdInterface::ApproximationOrder::First;
+  const std::vector<ocs2::CppAdInterface*> adInterfaces{intermediateLinearOutputAdInterface_.get(), prejumpLinearOutputAdInterface_.get()};
   if (settings.recompileLibraries_) {
-    intermediateLinearOutputAdInterface_->createModels(order, verbose);
-    prejumpLinearOutputAdInterface_->createModels(order, verbose);
+    ocs2::CppAdInterface::createModels(adInterfaces, order, verbose);
   } else {
-    intermediateLinearOutputAdInterface_->loadModelsIfAvailable(order, verbose);
-    prejumpLinearOutputAdInterface_->loadModelsIfAvailable(order, verbose);
+    ocs2::CppAdInterface::loadModelsIfAvailable(adInterfaces, order, verbose);
   }
 }
 
@@ -115,8 +114,8 @@ void SwitchedModelPreComputation::updateFeetPhases(scalar_t t) {
 
 void SwitchedModelPreComputation::updateMotionReference(scalar_t t) {
   // Interpolate reference
-  stateReference_ = swingTrajectoryPlannerPtr_->getTargetTrajectories().getDesiredState(t);
-  vector_t uRef = swingTrajectoryPlannerPtr_->getTargetTrajectories().getDesiredInput(t);
+  stateReference_ = swingTrajectoryPlannerPtr_->getTargetTrajectories().getDesiredState(t, referenceCursor_);
+  vector_t uRef = swingTrajectoryPlannerPtr_->getTargetTrajectories().getDesiredInput(t, referenceCursor_);
 
   // Extract elements from reference
   const auto basePose = getBasePose(stateReference_);
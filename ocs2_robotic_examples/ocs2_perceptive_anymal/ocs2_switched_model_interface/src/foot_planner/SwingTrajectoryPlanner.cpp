@@ -362,6 +362,11 @@ std::vector<ConvexTerrain> SwingTrajectoryPlanner::selectNominalFootholdTerrain(
   auto heuristicFootholdIt = heuristicFootholds.cbegin();
   std::vector<ConvexTerrain> nominalFootholdTerrain;
 
+  // Convex terrain queries are collected and resolved in a single batched call to the terrain model
+  std::vector<size_t> convexTerrainQueryIndices;
+  std::vector<vector3_t> convexTerrainQueryPositions;
+  std::vector<std::function<scalar_t(const vector3_t&)>> convexTerrainQueryPenalties;
+
   // Nominal foothold is equal to current foothold for legs in contact
   if (startsWithStancePhase(contactTimings)) {
     ConvexTerrain convexTerrain;
@@ -404,14 +409,16 @@ std::vector<ConvexTerrain> SwingTrajectoryPlanner::selectNominalFootholdTerrain(
         ApproximateKinematicsConfig config;
         config.kinematicPenaltyWeight = settings_.legOverExtensionPenalty;
         config.maxLegExtension = settings_.nominalLegExtension;
-        auto scoringFunction = [&](const vector3_t& footPositionInWorld) {
+        auto scoringFunction = [=](const vector3_t& footPositionInWorld) {
           return computeKinematicPenalty(footPositionInWorld, hipPositionInWorldTouchdown, hipOrientationInWorldTouchdown, config) +
                  computeKinematicPenalty(footPositionInWorld, hipPositionInWorldLiftoff, hipOrientationInWorldLiftoff, config);
         };
 
         if (contactPhase.start < finalTime) {
-          ConvexTerrain convexTerrain = terrainModel.getConvexTerrainAtPositionInWorld(referenceFootholdPositionInWorld, scoringFunction);
-          nominalFootholdTerrain.push_back(convexTerrain);
+          convexTerrainQueryIndices.push_back(nominalFootholdTerrain.size());
+          convexTerrainQueryPositions.push_back(referenceFootholdPositionInWorld);
+          convexTerrainQueryPenalties.push_back(std::move(scoringFunction));
+          nominalFootholdTerrain.emplace_back();  // Filled in by the batched query below
           ++heuristicFootholdIt;
         } else {  // After the horizon -> we are only interested in the position and orientation
           ConvexTerrain convexTerrain;
@@ -429,6 +436,13 @@ std::vector<ConvexTerrain> SwingTrajectoryPlanner::selectNominalFootholdTerrain(
     }
   }
 
+  if (!convexTerrainQueryPositions.empty()) {
+    auto convexTerrains = terrainModel.getConvexTerrainsAtPositionsInWorld(convexTerrainQueryPositions, convexTerrainQueryPenalties);
+    for (size_t i = 0; i < convexTerrainQueryIndices.size(); ++i) {
+      nominalFootholdTerrain[convexTerrainQueryIndices[i]] = std::move(convexTerrains[i]);
+    }
+  }
+
   return nominalFootholdTerrain;
 }
 
@@ -0,0 +1,75 @@
+#pragma once
+
+#include <functional>
+#include <vector>
+
+#include <ocs2_switched_model_interface/core/SwitchedModel.h>
+
+#include <convex_plane_decomposition/PlanarRegion.h>
+#include <convex_plane_decomposition/SegmentedPlaneProjection.h>
+
+namespace switched_model {
+
+/**
+ * Uniform 2D grid over the world XY bounding boxes of a set of planar regions. Used to find the best region for a query point without
+ * projecting onto every region of the terrain.
+ *
+ * Each cell stores the regions whose XY bounding box overlaps it. A query visits the cells in rings of increasing Chebyshev distance
+ * around the query point and stops once the distance to the next ring exceeds the best cost found so far. Regions are additionally
+ * culled with a lower bound on their distance computed in the plane frame. Because the penalty function is required to be >= 0, the
+ * result is identical to convex_plane_decomposition::getBestPlanarRegionAtPositionInWorld.
+ *
+ * The index stores pointers into the region vector passed to the constructor, which must outlive the index.
+ */
+class PlanarRegionIndex {
+ public:
+  using penalty_function_t = std::function<scalar_t(const vector3_t&)>;
+
+  /**
+   * Constructor
+   * @param [in] planarRegions : regions to index.
+   * @param [in] cellSize : edge length of the grid cells [m]. Increased automatically if the grid would become too large.
+   */
+  explicit PlanarRegionIndex(const std::vector<convex_plane_decomposition::PlanarRegion>& planarRegions, scalar_t cellSize = 0.25);
+
+  /** Returns the region and projected position that minimize the squared distance + penalty. regionPtr is nullptr if there are no regions. */
+  convex_plane_decomposition::PlanarTerrainProjection getBestPlanarRegionAtPositionInWorld(const vector3_t& positionInWorld,
+                                                                                          const penalty_function_t& penaltyFunction) const;
+
+  /** Batched version of getBestPlanarRegionAtPositionInWorld, with one penalty function per query point. */
+  std::vector<convex_plane_decomposition::PlanarTerrainProjection> getBestPlanarRegionsAtPositionsInWorld(
+      const std::vector<vector3_t>& positionsInWorld, const std::vector<penalty_function_t>& penaltyFunctions) const;
+
+ private:
+  struct IndexedRegion {
+    const convex_plane_decomposition::PlanarRegion* regionPtr;
+    Eigen::Matrix3d rotationWorldToPlane;
+    Eigen::Vector3d translationWorldToPlane;
+  };
+
+  /** Scratch memory of a query, reused across the queries of a batch. */
+  struct QueryBuffer {
+    std::vector<bool> isEvaluated;
+    std::vector<size_t> evaluatedRegions;
+  };
+
+  convex_plane_decomposition::PlanarTerrainProjection query(const vector3_t& positionInWorld, const penalty_function_t& penaltyFunction,
+                                                            QueryBuffer& buffer) const;
+
+  void evaluateRegion(size_t regionIndex, const vector3_t& positionInWorld, const penalty_function_t& penaltyFunction,
+                      convex_plane_decomposition::PlanarTerrainProjection& best) const;
+
+  std::vector<IndexedRegion> regions_;
+
+  scalar_t cellSize_;
+  scalar_t gridOriginX_;
+  scalar_t gridOriginY_;
+  int numCellsX_;
+  int numCellsY_;
+
+  // Region indices per cell in compressed row format: the regions of cell c are cellRegions_[cellOffsets_[c] : cellOffsets_[c + 1]].
+  std::vector<size_t> cellOffsets_;
+  std::vector<size_t> cellRegions_;
+};
+
+}  // namespace switched_model
@@ -8,6 +8,7 @@
 
 #include <convex_plane_decomposition/PlanarRegion.h>
 
+#include "segmented_planes_terrain_model/PlanarRegionIndex.h"
 #include "segmented_planes_terrain_model/SegmentedPlanesSignedDistanceField.h"
 
 namespace switched_model {
@@ -23,6 +24,14 @@ class SegmentedPlanesTerrainModel : public switched_model::TerrainModel {
   ConvexTerrain getConvexTerrainAtPositionInWorld(const vector3_t& positionInWorld,
                                                   std::function<scalar_t(const vector3_t&)> penaltyFunction) const override;
 
+  std::vector<TerrainPlane> getLocalTerrainsAtPositionsInWorldAlongGravity(
+      const std::vector<vector3_t>& positionsInWorld,
+      const std::vector<std::function<scalar_t(const vector3_t&)>>& penaltyFunctions) const override;
+
+  std::vector<ConvexTerrain> getConvexTerrainsAtPositionsInWorld(
+      const std::vector<vector3_t>& positionsInWorld,
+      const std::vector<std::function<scalar_t(const vector3_t&)>>& penaltyFunctions) const override;
+
   void createSignedDistanceBetween(const Eigen::Vector3d& minCoordinates, const Eigen::Vector3d& maxCoordinates);
 
   const SegmentedPlanesSignedDistanceField* getSignedDistanceField() const override { return signedDistanceField_.get(); }
@@ -35,6 +44,7 @@ class SegmentedPlanesTerrainModel : public switched_model::TerrainModel {
 
  private:
   const convex_plane_decomposition::PlanarTerrain planarTerrain_;
+  const PlanarRegionIndex planarRegionIndex_;
   std::unique_ptr<SegmentedPlanesSignedDistanceField> signedDistanceField_;
   const grid_map::Matrix* const elevationData_;
 };
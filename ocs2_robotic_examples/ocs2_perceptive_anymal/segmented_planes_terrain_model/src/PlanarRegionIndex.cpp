@@ -0,0 +1,206 @@
+#include "segmented_planes_terrain_model/PlanarRegionIndex.h"
+
+#include <algorithm>
+#include <cassert>
+#include <cmath>
+#include <limits>
+
+namespace switched_model {
+
+namespace {
+// Limits the memory of the grid for very large or sparse terrains.
+constexpr int maxNumberOfCellsPerAxis = 512;
+
+scalar_t squaredDistanceToBoundingBox(scalar_t x, scalar_t y, const convex_plane_decomposition::CgalBbox2d& boundingBox) {
+  const scalar_t dx = std::max({boundingBox.xmin() - x, 0.0, x - boundingBox.xmax()});
+  const scalar_t dy = std::max({boundingBox.ymin() - y, 0.0, y - boundingBox.ymax()});
+  return dx * dx + dy * dy;
+}
+}  // namespace
+
+PlanarRegionIndex::PlanarRegionIndex(const std::vector<convex_plane_decomposition::PlanarRegion>& planarRegions, scalar_t cellSize)
+    : cellSize_(cellSize), gridOriginX_(0.0), gridOriginY_(0.0), numCellsX_(1), numCellsY_(1) {
+  assert(cellSize > 0.0);
+  regions_.reserve(planarRegions.size());
+
+  // World XY bounding box of each region, from the corners of its bounding box in the plane frame.
+  std::vector<Eigen::Vector4d, Eigen::aligned_allocator<Eigen::Vector4d>> regionBoxes;  // {xmin, ymin, xmax, ymax}
+  regionBoxes.reserve(planarRegions.size());
+  const Eigen::Vector4d emptyBox(std::numeric_limits<scalar_t>::max(), std::numeric_limits<scalar_t>::max(),
+                                 std::numeric_limits<scalar_t>::lowest(), std::numeric_limits<scalar_t>::lowest());
+  Eigen::Vector4d gridBox = emptyBox;
+  for (const auto& region : planarRegions) {
+    const auto& bbox = region.bbox2d;
+    Eigen::Vector4d box = emptyBox;
+    for (const auto& corner : {Eigen::Vector2d(bbox.xmin(), bbox.ymin()), Eigen::Vector2d(bbox.xmax(), bbox.ymin()),
+                               Eigen::Vector2d(bbox.xmin(), bbox.ymax()), Eigen::Vector2d(bbox.xmax(), bbox.ymax())}) {
+      const Eigen::Vector3d cornerInWorld = region.transformPlaneToWorld * Eigen::Vector3d(corner.x(), corner.y(), 0.0);
+      box.head<2>() = box.head<2>().cwiseMin(cornerInWorld.head<2>());
+      box.tail<2>() = box.tail<2>().cwiseMax(cornerInWorld.head<2>());
+    }
+    gridBox.head<2>() = gridBox.head<2>().cwiseMin(box.head<2>());
+    gridBox.tail<2>() = gridBox.tail<2>().cwiseMax(box.tail<2>());
+    regionBoxes.push_back(box);
+
+    const Eigen::Matrix3d rotationWorldToPlane = region.transformPlaneToWorld.linear().transpose();
+    regions_.push_back({&region, rotationWorldToPlane, -rotationWorldToPlane * region.transformPlaneToWorld.translation()});
+  }
+
+  if (!regions_.empty()) {
+    const scalar_t lengthX = gridBox(2) - gridBox(0);
+    const scalar_t lengthY = gridBox(3) - gridBox(1);
+    cellSize_ = std::max({cellSize_, lengthX / maxNumberOfCellsPerAxis, lengthY / maxNumberOfCellsPerAxis});
+    gridOriginX_ = gridBox(0);
+    gridOriginY_ = gridBox(1);
+    numCellsX_ = std::max(1, static_cast<int>(std::ceil(lengthX / cellSize_)));
+    numCellsY_ = std::max(1, static_cast<int>(std::ceil(lengthY / cellSize_)));
+  }
+
+  const auto cellRange = [&](const Eigen::Vector4d& box) {
+    const int xmin = std::max(0, static_cast<int>(std::floor((box(0) - gridOriginX_) / cellSize_)));
+    const int ymin = std::max(0, static_cast<int>(std::floor((box(1) - gridOriginY_) / cellSize_)));
+    const int xmax = std::min(numCellsX_ - 1, static_cast<int>(std::floor((box(2) - gridOriginX_) / cellSize_)));
+    const int ymax = std::min(numCellsY_ - 1, static_cast<int>(std::floor((box(3) - gridOriginY_) / cellSize_)));
+    return Eigen::Vector4i(xmin, ymin, xmax, ymax);
+  };
+
+  // Counting pass followed by a filling pass into the compressed row storage.
+  cellOffsets_.assign(numCellsX_ * numCellsY_ + 1, 0);
+  for (const auto& box : regionBoxes) {
+    const Eigen::Vector4i range = cellRange(box);
+    for (int i = range(0); i <= range(2); ++i) {
+      for (int j = range(1); j <= range(3); ++j) {
+        ++cellOffsets_[i * numCellsY_ + j + 1];
+      }
+    }
+  }
+  for (size_t c = 1; c < cellOffsets_.size(); ++c) {
+    cellOffsets_[c] += cellOffsets_[c - 1];
+  }
+  cellRegions_.resize(cellOffsets_.back());
+  std::vector<size_t> fillPosition(cellOffsets_.begin(), cellOffsets_.end() - 1);
+  for (size_t k = 0; k < regionBoxes.size(); ++k) {
+    const Eigen::Vector4i range = cellRange(regionBoxes[k]);
+    for (int i = range(0); i <= range(2); ++i) {
+      for (int j = range(1); j <= range(3); ++j) {
+        cellRegions_[fillPosition[i * numCellsY_ + j]++] = k;
+      }
+    }
+  }
+}
+
+convex_plane_decomposition::PlanarTerrainProjection PlanarRegionIndex::getBestPlanarRegionAtPositionInWorld(
+    const vector3_t& positionInWorld, const penalty_function_t& penaltyFunction) const {
+  QueryBuffer buffer;
+  return query(positionInWorld, penaltyFunction, buffer);
+}
+
+std::vector<convex_plane_decomposition::PlanarTerrainProjection> PlanarRegionIndex::getBestPlanarRegionsAtPositionsInWorld(
+    const std::vector<vector3_t>& positionsInWorld, const std::vector<penalty_function_t>& penaltyFunctions) const {
+  assert(positionsInWorld.size() == penaltyFunctions.size());
+  QueryBuffer buffer;
+  std::vector<convex_plane_decomposition::PlanarTerrainProjection> projections;
+  projections.reserve(positionsInWorld.size());
+  for (size_t i = 0; i < positionsInWorld.size(); ++i) {
+    projections.push_back(query(positionsInWorld[i], penaltyFunctions[i], buffer));
+  }
+  return projections;
+}
+
+convex_plane_decomposition::PlanarTerrainProjection PlanarRegionIndex::query(const vector3_t& positionInWorld,
+                                                                             const penalty_function_t& penaltyFunction,
+                                                                             QueryBuffer& buffer) const {
+  convex_plane_decomposition::PlanarTerrainProjection best;
+  best.regionPtr = nullptr;
+  best.cost = std::numeric_limits<scalar_t>::max();
+  if (regions_.empty()) {
+    return best;
+  }
+
+  buffer.isEvaluated.resize(regions_.size(), false);
+
+  // Cell of the query point, clamped to the grid. Points outside the grid are at least their distance to the clamped cell away from
+  // every cell, so the ring bound below remains valid.
+  const auto clampedCell = [](scalar_t coordinate, int numCells) {
+    return std::min(std::max(static_cast<int>(std::floor(coordinate)), 0), numCells - 1);
+  };
+  const int cx = clampedCell((positionInWorld.x() - gridOriginX_) / cellSize_, numCellsX_);
+  const int cy = clampedCell((positionInWorld.y() - gridOriginY_) / cellSize_, numCellsY_);
+  const int maxRing = std::max({cx, numCellsX_ - 1 - cx, cy, numCellsY_ - 1 - cy});
+
+  const auto visitCell = [&](int i, int j) {
+    const size_t cell = i * numCellsY_ + j;
+    for (size_t c = cellOffsets_[cell]; c < cellOffsets_[cell + 1]; ++c) {
+      const size_t regionIndex = cellRegions_[c];
+      if (!buffer.isEvaluated[regionIndex]) {
+        buffer.isEvaluated[regionIndex] = true;
+        buffer.evaluatedRegions.push_back(regionIndex);
+        evaluateRegion(regionIndex, positionInWorld, penaltyFunction, best);
+      }
+    }
+  };
+
+  for (int ring = 0; ring <= maxRing; ++ring) {
+    // Every region not seen yet lies entirely in cells of this ring or further out.
+    if (ring > 0) {
+      const scalar_t ringDistance = (ring - 1) * cellSize_;
+      if (ringDistance * ringDistance > best.cost) {
+        break;
+      }
+    }
+
+    const int imin = cx - ring;
+    const int imax = cx + ring;
+    const int jmin = std::max(cy - ring, 0);
+    const int jmax = std::min(cy + ring, numCellsY_ - 1);
+    for (int i = std::max(imin, 0); i <= std::min(imax, numCellsX_ - 1); ++i) {
+      if (i == imin || i == imax) {
+        for (int j = jmin; j <= jmax; ++j) {
+          visitCell(i, j);
+        }
+      } else {
+        if (cy - ring >= 0) {
+          visitCell(i, cy - ring);
+        }
+        if (cy + ring < numCellsY_) {
+          visitCell(i, cy + ring);
+        }
+      }
+    }
+  }
+
+  for (const auto regionIndex : buffer.evaluatedRegions) {
+    buffer.isEvaluated[regionIndex] = false;
+  }
+  buffer.evaluatedRegions.clear();
+
+  return best;
+}
+
+void PlanarRegionIndex::evaluateRegion(size_t regionIndex, const vector3_t& positionInWorld, const penalty_function_t& penaltyFunction,
+                                       convex_plane_decomposition::PlanarTerrainProjection& best) const {
+  const auto& indexedRegion = regions_[regionIndex];
+  const Eigen::Vector3d positionInPlane = indexedRegion.rotationWorldToPlane * positionInWorld + indexedRegion.translationWorldToPlane;
+
+  // The bounding box in the plane frame gives a lower bound on the squared distance. The penalty is >= 0.
+  const scalar_t lowerBound = squaredDistanceToBoundingBox(positionInPlane.x(), positionInPlane.y(), indexedRegion.regionPtr->bbox2d) +
+                              positionInPlane.z() * positionInPlane.z();
+  if (lowerBound >= best.cost) {
+    return;
+  }
+
+  const auto& region = *indexedRegion.regionPtr;
+  const auto projectedPointInPlane =
+      convex_plane_decomposition::projectToPlanarRegion({positionInPlane.x(), positionInPlane.y()}, region);
+  const auto projectedPointInWorld =
+      convex_plane_decomposition::positionInWorldFrameFromPosition2dInPlane(projectedPointInPlane, region.transformPlaneToWorld);
+  const scalar_t cost = (projectedPointInWorld - positionInWorld).squaredNorm() + penaltyFunction(projectedPointInWorld);
+  if (cost < best.cost) {
+    best.cost = cost;
+    best.regionPtr = &region;
+    best.positionInTerrainFrame = projectedPointInPlane;
+    best.positionInWorld = projectedPointInWorld;
+  }
+}
+
+}  // namespace switched_model
@@ -15,16 +15,8 @@ namespace switched_model {
 
 namespace {
 const std::string elevationLayerName = "elevation";
-}  // namespace
-
-SegmentedPlanesTerrainModel::SegmentedPlanesTerrainModel(convex_plane_decomposition::PlanarTerrain planarTerrain)
-    : planarTerrain_(std::move(planarTerrain)),
-      signedDistanceField_(nullptr),
-      elevationData_(&planarTerrain_.gridMap.get(elevationLayerName)) {}
 
-TerrainPlane SegmentedPlanesTerrainModel::getLocalTerrainAtPositionInWorldAlongGravity(
-    const vector3_t& positionInWorld, std::function<scalar_t(const vector3_t&)> penaltyFunction) const {
-  const auto projection = getBestPlanarRegionAtPositionInWorld(positionInWorld, planarTerrain_.planarRegions, std::move(penaltyFunction));
+TerrainPlane terrainPlaneFromProjection(const convex_plane_decomposition::PlanarTerrainProjection& projection) {
   if (projection.regionPtr == nullptr) {
     throw std::runtime_error("[SegmentedPlanesTerrainModel] no region found");
   }
@@ -32,9 +24,7 @@ TerrainPlane SegmentedPlanesTerrainModel::getLocalTerrainAtPositionInWorldAlongG
   return TerrainPlane{projection.positionInWorld, projection.regionPtr->transformPlaneToWorld.linear().transpose()};
 }
 
-ConvexTerrain SegmentedPlanesTerrainModel::getConvexTerrainAtPositionInWorld(
-    const vector3_t& positionInWorld, std::function<scalar_t(const vector3_t&)> penaltyFunction) const {
-  const auto projection = getBestPlanarRegionAtPositionInWorld(positionInWorld, planarTerrain_.planarRegions, std::move(penaltyFunction));
+ConvexTerrain convexTerrainFromProjection(const convex_plane_decomposition::PlanarTerrainProjection& projection) {
   if (projection.regionPtr == nullptr) {
     throw std::runtime_error("[SegmentedPlanesTerrainModel] no region found");
   }
@@ -57,6 +47,46 @@ ConvexTerrain SegmentedPlanesTerrainModel::getConvexTerrainAtPositionInWorld(
   return convexTerrain;
 }
 
+}  // namespace
+
+SegmentedPlanesTerrainModel::SegmentedPlanesTerrainModel(convex_plane_decomposition::PlanarTerrain planarTerrain)
+    : planarTerrain_(std::move(planarTerrain)),
+      planarRegionIndex_(planarTerrain_.planarRegions),
+      signedDistanceField_(nullptr),
+      elevationData_(&planarTerrain_.gridMap.get(elevationLayerName)) {}
+
+TerrainPlane SegmentedPlanesTerrainModel::getLocalTerrainAtPositionInWorldAlongGravity(
+    const vector3_t& positionInWorld, std::function<scalar_t(const vector3_t&)> penaltyFunction) const {
+  return terrainPlaneFromProjection(planarRegionIndex_.getBestPlanarRegionAtPositionInWorld(positionInWorld, penaltyFunction));
+}
+
+ConvexTerrain SegmentedPlanesTerrainModel::getConvexTerrainAtPositionInWorld(
+    const vector3_t& positionInWorld, std::function<scalar_t(const vector3_t&)> penaltyFunction) const {
+  return convexTerrainFromProjection(planarRegionIndex_.getBestPlanarRegionAtPositionInWorld(positionInWorld, penaltyFunction));
+}
+
+std::vector<TerrainPlane> SegmentedPlanesTerrainModel::getLocalTerrainsAtPositionsInWorldAlongGravity(
+    const std::vector<vector3_t>& positionsInWorld, const std::vector<std::function<scalar_t(const vector3_t&)>>& penaltyFunctions) const {
+  const auto projections = planarRegionIndex_.getBestPlanarRegionsAtPositionsInWorld(positionsInWorld, penaltyFunctions);
+  std::vector<TerrainPlane> terrainPlanes;
+  terrainPlanes.reserve(projections.size());
+  for (const auto& projection : projections) {
+    terrainPlanes.push_back(terrainPlaneFromProjection(projection));
+  }
+  return terrainPlanes;
+}
+
+std::vector<ConvexTerrain> SegmentedPlanesTerrainModel::getConvexTerrainsAtPositionsInWorld(
+    const std::vector<vector3_t>& positionsInWorld, const std::vector<std::function<scalar_t(const vector3_t&)>>& penaltyFunctions) const {
+  const auto projections = planarRegionIndex_.getBestPlanarRegionsAtPositionsInWorld(positionsInWorld, penaltyFunctions);
+  std::vector<ConvexTerrain> convexTerrains;
+  convexTerrains.reserve(projections.size());
+  for (const auto& projection : projections) {
+    convexTerrains.push_back(convexTerrainFromProjection(projection));
+  }
+  return convexTerrains;
+}
+
 void SegmentedPlanesTerrainModel::createSignedDistanceBetween(const Eigen::Vector3d& minCoordinates,
                                                               const Eigen::Vector3d& maxCoordinates) {
   // Compute coordinates of submap
@@ -0,0 +1,54 @@
+#pragma once
+
+#include <cmath>
+#include <random>
+#include <vector>
+
+#include <convex_plane_decomposition/PlanarRegion.h>
+
+namespace switched_model {
+
+/**
+ * Generates rectangular planar regions with a random size, position, height and orientation in [-extent, extent]^2.
+ * The inset of each region is its boundary shrunk by a small margin.
+ */
+inline std::vector<convex_plane_decomposition::PlanarRegion> getRandomPlanarRegions(size_t numRegions, double extent, std::mt19937& rng) {
+  using convex_plane_decomposition::CgalPoint2d;
+  using convex_plane_decomposition::CgalPolygon2d;
+  using convex_plane_decomposition::CgalPolygonWithHoles2d;
+
+  std::uniform_real_distribution<double> positionDistribution(-extent, extent);
+  std::uniform_real_distribution<double> sizeDistribution(0.1, 1.0);
+  std::uniform_real_distribution<double> heightDistribution(-0.5, 0.5);
+  std::uniform_real_distribution<double> tiltDistribution(-0.3, 0.3);
+  std::uniform_real_distribution<double> yawDistribution(-M_PI, M_PI);
+
+  const auto rectangle = [](double halfSizeX, double halfSizeY) {
+    CgalPolygon2d polygon;
+    polygon.push_back(CgalPoint2d(-halfSizeX, -halfSizeY));
+    polygon.push_back(CgalPoint2d(halfSizeX, -halfSizeY));
+    polygon.push_back(CgalPoint2d(halfSizeX, halfSizeY));
+    polygon.push_back(CgalPoint2d(-halfSizeX, halfSizeY));
+    return polygon;
+  };
+
+  std::vector<convex_plane_decomposition::PlanarRegion> planarRegions(numRegions);
+  for (auto& region : planarRegions) {
+    const double halfSizeX = 0.5 * sizeDistribution(rng);
+    const double halfSizeY = 0.5 * sizeDistribution(rng);
+    constexpr double insetMargin = 0.02;
+    region.boundaryWithInset.boundary = CgalPolygonWithHoles2d(rectangle(halfSizeX, halfSizeY));
+    region.boundaryWithInset.insets.emplace_back(rectangle(halfSizeX - insetMargin, halfSizeY - insetMargin));
+    region.bbox2d = region.boundaryWithInset.boundary.outer_boundary().bbox();
+
+    region.transformPlaneToWorld.setIdentity();
+    region.transformPlaneToWorld.translation() << positionDistribution(rng), positionDistribution(rng), heightDistribution(rng);
+    region.transformPlaneToWorld.linear() = (Eigen::AngleAxisd(yawDistribution(rng), Eigen::Vector3d::UnitZ()) *
+                                             Eigen::AngleAxisd(tiltDistribution(rng), Eigen::Vector3d::UnitY()) *
+                                             Eigen::AngleAxisd(tiltDistribution(rng), Eigen::Vector3d::UnitX()))
+                                                .toRotationMatrix();
+  }
+  return planarRegions;
+}
+
+}  // namespace switched_model
@@ -0,0 +1,60 @@
+#include <chrono>
+#include <cmath>
+#include <iostream>
+#include <random>
+
+#include "segmented_planes_terrain_model/PlanarRegionIndex.h"
+
+#include "RandomPlanarRegions.h"
+
+using namespace switched_model;
+
+namespace {
+
+/** Returns the average time in microseconds of one query. */
+template <typename Query>
+double timeQueries(const std::vector<vector3_t>& queryPoints, Query&& query) {
+  double costSum = 0.0;  // keeps the queries from being optimized away
+  const auto start = std::chrono::steady_clock::now();
+  for (const auto& point : queryPoints) {
+    costSum += query(point).cost;
+  }
+  const std::chrono::duration<double, std::micro> duration = std::chrono::steady_clock::now() - start;
+  if (!std::isfinite(costSum)) {
+    std::cerr << "Non-finite projection cost\n";
+  }
+  return duration.count() / queryPoints.size();
+}
+
+}  // unnamed namespace
+
+int main() {
+  std::mt19937 rng(0);
+  constexpr double extent = 5.0;
+  const auto penaltyFunction = [](const vector3_t& p) { return 10.0 * p.z() * p.z(); };
+
+  std::uniform_real_distribution<double> positionDistribution(-extent, extent);
+  std::uniform_real_distribution<double> heightDistribution(-1.0, 1.0);
+  std::vector<vector3_t> queryPoints(10000);
+  for (auto& point : queryPoints) {
+    point << positionDistribution(rng), positionDistribution(rng), heightDistribution(rng);
+  }
+
+  for (const size_t numRegions : {10, 50, 200, 1000}) {
+    const auto planarRegions = getRandomPlanarRegions(numRegions, extent, rng);
+
+    const auto constructionStart = std::chrono::steady_clock::now();
+    const PlanarRegionIndex planarRegionIndex(planarRegions);
+    const std::chrono::duration<double, std::micro> constructionTime = std::chrono::steady_clock::now() - constructionStart;
+
+    const auto exhaustiveTime = timeQueries(queryPoints, [&](const vector3_t& point) {
+      return convex_plane_decomposition::getBestPlanarRegionAtPositionInWorld(point, planarRegions, penaltyFunction);
+    });
+    const auto indexTime = timeQueries(
+        queryPoints, [&](const vector3_t& point) { return planarRegionIndex.getBestPlanarRegionAtPositionInWorld(point, penaltyFunction); });
+
+    std::cerr << numRegions << " regions: exhaustive search " << exhaustiveTime << " [us], index " << indexTime
+              << " [us] per query, index construction " << constructionTime.count() << " [us]\n";
+  }
+  return 0;
+}
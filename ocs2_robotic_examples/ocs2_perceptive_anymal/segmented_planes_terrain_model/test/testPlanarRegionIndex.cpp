@@ -0,0 +1,63 @@
+#include <gtest/gtest.h>
+
+#include <random>
+
+#include "segmented_planes_terrain_model/PlanarRegionIndex.h"
+
+#include "RandomPlanarRegions.h"
+
+using namespace switched_model;
+
+namespace {
+
+void compareWithExhaustiveSearch(const PlanarRegionIndex& planarRegionIndex,
+                                 const std::vector<convex_plane_decomposition::PlanarRegion>& planarRegions,
+                                 const std::vector<vector3_t>& queryPoints, const PlanarRegionIndex::penalty_function_t& penaltyFunction) {
+  const std::vector<PlanarRegionIndex::penalty_function_t> penaltyFunctions(queryPoints.size(), penaltyFunction);
+  const auto batchedProjections = planarRegionIndex.getBestPlanarRegionsAtPositionsInWorld(queryPoints, penaltyFunctions);
+  ASSERT_EQ(batchedProjections.size(), queryPoints.size());
+
+  for (size_t i = 0; i < queryPoints.size(); ++i) {
+    const auto expected = convex_plane_decomposition::getBestPlanarRegionAtPositionInWorld(queryPoints[i], planarRegions, penaltyFunction);
+    for (const auto& projection : {planarRegionIndex.getBestPlanarRegionAtPositionInWorld(queryPoints[i], penaltyFunction),
+                                   batchedProjections[i]}) {
+      ASSERT_EQ(projection.regionPtr, expected.regionPtr) << "query point: " << queryPoints[i].transpose();
+      ASSERT_NEAR(projection.cost, expected.cost, 1e-9);
+      ASSERT_TRUE(projection.positionInWorld.isApprox(expected.positionInWorld));
+    }
+  }
+}
+
+}  // unnamed namespace
+
+TEST(TestPlanarRegionIndex, compareWithExhaustiveSearch) {
+  std::mt19937 rng(0);
+  constexpr double extent = 5.0;
+  const auto planarRegions = getRandomPlanarRegions(100, extent, rng);
+
+  // Query points above and next to the regions, as well as points outside the bounding box of all regions
+  std::uniform_real_distribution<double> positionDistribution(-2.0 * extent, 2.0 * extent);
+  std::uniform_real_distribution<double> heightDistribution(-1.0, 1.0);
+  std::vector<vector3_t> queryPoints(1000);
+  for (auto& point : queryPoints) {
+    point << positionDistribution(rng), positionDistribution(rng), heightDistribution(rng);
+  }
+  queryPoints.emplace_back(10.0 * extent, 0.0, 0.0);
+  queryPoints.emplace_back(-10.0 * extent, -10.0 * extent, 5.0);
+
+  const auto zeroPenalty = [](const vector3_t&) { return 0.0; };
+  const auto heightPenalty = [](const vector3_t& p) { return 10.0 * p.z() * p.z(); };
+
+  for (const double cellSize : {0.1, 0.25, 2.0}) {
+    const PlanarRegionIndex planarRegionIndex(planarRegions, cellSize);
+    compareWithExhaustiveSearch(planarRegionIndex, planarRegions, queryPoints, zeroPenalty);
+    compareWithExhaustiveSearch(planarRegionIndex, planarRegions, queryPoints, heightPenalty);
+  }
+}
+
+TEST(TestPlanarRegionIndex, noRegions) {
+  const std::vector<convex_plane_decomposition::PlanarRegion> planarRegions;
+  const PlanarRegionIndex planarRegionIndex(planarRegions);
+  const auto projection = planarRegionIndex.getBestPlanarRegionAtPositionInWorld(vector3_t::Zero(), [](const vector3_t&) { return 0.0; });
+  ASSERT_EQ(projection.regionPtr, nullptr);
+}
@@ -34,6 +34,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_ros_interfaces/mpc/MPC_ROS_Interface.h>
 #include <ocs2_ros_interfaces/synchronized_module/RosReferenceManager.h>
 #include "ocs2_quadrotor/QuadrotorInterface.h"
+#include "ocs2_quadrotor/definitions.h"
 
 int main(int argc, char** argv) {
   const std::string robotName = "quadrotor";
@@ -63,6 +64,11 @@ int main(int argc, char** argv) {
   ocs2::GaussNewtonDDP_MPC mpc(quadrotorInterface.mpcSettings(), quadrotorInterface.ddpSettings(), quadrotorInterface.getRollout(),
                                quadrotorInterface.getOptimalControlProblem(), quadrotorInterface.getInitializer());
   mpc.getSolverPtr()->setReferenceManager(rosReferenceManagerPtr);
+  // The dimensions are known at compile time, hence ILQR runs the Riccati recursion on fixed-size matrices
+  if (quadrotorInterface.ddpSettings().algorithm_ == ocs2::ddp::Algorithm::ILQR) {
+    auto* ilqrPtr = static_cast<ocs2::ILQR*>(mpc.getSolverPtr());
+    ilqrPtr->useFixedSizeRiccatiEquations<ocs2::quadrotor::STATE_DIM, ocs2::quadrotor::INPUT_DIM>();
+  }
 
   // Launch MPC ROS node
   ocs2::MPC_ROS_Interface mpcNode(mpc, robotName);
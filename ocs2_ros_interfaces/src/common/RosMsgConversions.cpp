@@ -130,6 +130,8 @@ ocs2_msgs::mpc_performance_indices createPerformanceIndicesMsg(scalar_t initTime
   performanceIndicesMsg.equalityConstraintsSSE = performanceIndices.equalityConstraintsSSE;
   performanceIndicesMsg.equalityLagrangian = performanceIndices.equalityLagrangian;
   performanceIndicesMsg.inequalityLagrangian = performanceIndices.inequalityLagrangian;
+  performanceIndicesMsg.earlyExit = performanceIndices.earlyExit;
+  performanceIndicesMsg.deadlineMissed = performanceIndices.deadlineMissed;
 
   return performanceIndicesMsg;
 }
@@ -146,6 +148,8 @@ PerformanceIndex readPerformanceIndicesMsg(const ocs2_msgs::mpc_performance_indi
   performanceIndices.equalityConstraintsSSE = performanceIndicesMsg.equalityConstraintsSSE;
   performanceIndices.equalityLagrangian = performanceIndicesMsg.equalityLagrangian;
   performanceIndices.inequalityLagrangian = performanceIndicesMsg.inequalityLagrangian;
+  performanceIndices.earlyExit = performanceIndicesMsg.earlyExit;
+  performanceIndices.deadlineMissed = performanceIndicesMsg.deadlineMissed;
 
   return performanceIndices;
 }
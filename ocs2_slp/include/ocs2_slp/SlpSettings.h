@@ -55,7 +55,9 @@ struct Settings {
   scalar_t gamma_c = 1e-6;       // (3): ELSE REQUIRE c{i+1} < (c{i} - gamma_c * g{i}) OR g{i+1} < (1-gamma_c) * g{i}
 
   // Discretization method
-  scalar_t dt = 0.01;  // user-defined time discretization
+  scalar_t dt = 0.01;             // user-defined time discretization, the step at the start of the horizon and after events
+  scalar_t dtGrowthFactor = 1.0;  // ratio between consecutive steps (>= 1). Use 1.0 for a uniform discretization
+  scalar_t dtMax = 0.1;           // the steps do not grow beyond this value
   SensitivityIntegratorType integratorType = SensitivityIntegratorType::RK2;
 
   // Inequality penalty relaxed barrier parameters
@@ -73,6 +75,8 @@ struct Settings {
   // Threading
   size_t nThreads = 4;
   int threadPriority = 50;
+  int threadSpinDuration = 0;          // Time [us] for which idle workers poll for new work before sleeping, see ThreadPool::Settings
+  std::vector<int> threadCpuAffinity;  // CPUs to pin the workers to, empty to not pin them
 
   // LP subproblem solver settings
   pipg::Settings pipgSettings = pipg::Settings();
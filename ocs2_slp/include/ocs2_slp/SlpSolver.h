@@ -91,6 +91,8 @@ class SlpSolver : public SolverBase {
     throw std::runtime_error("[SqpSolver] getIntermediateDualSolution() not available yet.");
   }
 
+  std::map<std::string, scalar_t> getBenchmarkingTimes() const override;
+
  private:
   void runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime) override;
 
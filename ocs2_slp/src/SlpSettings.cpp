@@ -30,6 +30,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include "ocs2_slp/SlpSettings.h"
 
 #include <iostream>
+#include <stdexcept>
 
 #include <boost/property_tree/info_parser.hpp>
 #include <boost/property_tree/ptree.hpp>
@@ -61,6 +62,8 @@ Settings loadSettings(const std::string& filename, const std::string& fieldName,
   loadData::loadPtreeValue(pt, settings.armijoFactor, fieldName + ".armijoFactor", verbose);
   loadData::loadPtreeValue(pt, settings.costTol, fieldName + ".costTol", verbose);
   loadData::loadPtreeValue(pt, settings.dt, fieldName + ".dt", verbose);
+  loadData::loadPtreeValue(pt, settings.dtGrowthFactor, fieldName + ".dtGrowthFactor", verbose);
+  loadData::loadPtreeValue(pt, settings.dtMax, fieldName + ".dtMax", verbose);
   auto integratorName = sensitivity_integrator::toString(settings.integratorType);
   loadData::loadPtreeValue(pt, integratorName, fieldName + ".integratorType", verbose);
   settings.integratorType = sensitivity_integrator::fromString(integratorName);
@@ -72,8 +75,17 @@ Settings loadSettings(const std::string& filename, const std::string& fieldName,
   loadData::loadPtreeValue(pt, settings.printLinesearch, fieldName + ".printLinesearch", verbose);
   loadData::loadPtreeValue(pt, settings.nThreads, fieldName + ".nThreads", verbose);
   loadData::loadPtreeValue(pt, settings.threadPriority, fieldName + ".threadPriority", verbose);
+  loadData::loadPtreeValue(pt, settings.threadSpinDuration, fieldName + ".threadSpinDuration", verbose);
+  loadData::loadStdVector(filename, fieldName + ".threadCpuAffinity", settings.threadCpuAffinity, verbose);
   settings.pipgSettings = pipg::loadSettings(filename, fieldName + ".pipg", verbose);
 
+  if (settings.dtGrowthFactor < 1.0) {
+    throw std::invalid_argument("[slp::loadSettings] dtGrowthFactor must be at least 1.0!");
+  }
+  if (settings.dtMax < settings.dt) {
+    throw std::invalid_argument("[slp::loadSettings] dtMax must be at least dt!");
+  }
+
   if (verbose) {
     std::cerr << " #### =============================================================================" << std::endl;
   }
@@ -33,6 +33,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <iostream>
 #include <numeric>
 
+#include <ocs2_core/misc/Trace.h>
 #include <ocs2_oc/multiple_shooting/Helpers.h>
 #include <ocs2_oc/multiple_shooting/Initialization.h>
 #include <ocs2_oc/multiple_shooting/MetricsComputation.h>
@@ -48,7 +49,8 @@ namespace ocs2 {
 SlpSolver::SlpSolver(slp::Settings settings, const OptimalControlProblem& optimalControlProblem, const Initializer& initializer)
     : settings_(std::move(settings)),
       pipgSolver_(settings_.pipgSettings),
-      threadPool_(std::max(settings_.nThreads - 1, size_t(1)) - 1, settings_.threadPriority) {
+      threadPool_(std::max(settings_.nThreads - 1, size_t(1)) - 1, settings_.threadPriority,
+                  ThreadPool::Settings{settings_.threadSpinDuration, settings_.threadCpuAffinity}) {
   Eigen::setNbThreads(1);  // No multithreading within Eigen.
   Eigen::initParallel();
 
@@ -148,6 +150,13 @@ std::string SlpSolver::getBenchmarkingInformation() const {
   return infoStream.str();
 }
 
+std::map<std::string, scalar_t> SlpSolver::getBenchmarkingTimes() const {
+  return {{"lqApproximation", linearQuadraticApproximationTimer_.getTotalInMilliseconds()},
+          {"solveQp", solveQpTimer_.getTotalInMilliseconds()},
+          {"linesearch", linesearchTimer_.getTotalInMilliseconds()},
+          {"computeController", computeControllerTimer_.getTotalInMilliseconds()}};
+}
+
 const std::vector<PerformanceIndex>& SlpSolver::getIterationsLog() const {
   if (performanceIndeces_.empty()) {
     throw std::runtime_error("[SlpSolver]: No performance log yet, no problem solved yet?");
@@ -157,6 +166,7 @@ const std::vector<PerformanceIndex>& SlpSolver::getIterationsLog() const {
 }
 
 void SlpSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime) {
+  OCS2_TRACE_SCOPE("SlpSolver::run");
   if (settings_.printSolverStatus || settings_.printLinesearch) {
     std::cerr << "\n++++++++++++++++++++++++++++++++++++++++++++++++++++++";
     std::cerr << "\n+++++++++++++ SLP solver is initialized ++++++++++++++";
@@ -165,7 +175,8 @@ void SlpSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
 
   // Determine time discretization, taking into account event times.
   const auto& eventTimes = this->getReferenceManager().getModeSchedule().eventTimes;
-  const auto timeDiscretization = timeDiscretizationWithEvents(initTime, finalTime, settings_.dt, eventTimes);
+  const auto timeDiscretization =
+      timeDiscretizationWithEvents(initTime, finalTime, settings_.dt, settings_.dtGrowthFactor, settings_.dtMax, eventTimes);
 
   // Initialize references
   for (auto& ocpDefinition : ocpDefinitions_) {
@@ -189,6 +200,7 @@ void SlpSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
   int iter = 0;
   slp::Convergence convergence = slp::Convergence::FALSE;
   while (convergence == slp::Convergence::FALSE) {
+    OCS2_TRACE_SCOPE("SlpSolver::iteration");
     if (settings_.printSolverStatus || settings_.printLinesearch) {
       std::cerr << "\nPIPG iteration: " << iter << "\n";
     }
@@ -212,6 +224,15 @@ void SlpSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
     // Check convergence
     convergence = checkConvergence(iter, baselinePerformance, stepInfo);
 
+    // Stop early if another iteration and the controller computation are not expected to fit in the time budget. The last accepted
+    // iterate is returned in that case.
+    const scalar_t expectedIterationTime =
+        linearQuadraticApproximationTimer_.getLastIntervalInMilliseconds() + solveQpTimer_.getLastIntervalInMilliseconds() +
+        linesearchTimer_.getLastIntervalInMilliseconds() + computeControllerTimer_.getLastIntervalInMilliseconds();
+    if (convergence == slp::Convergence::FALSE && exceedsTimeBudget(expectedIterationTime)) {
+      convergence = slp::Convergence::TIMEBUDGET;
+    }
+
     // Next iteration
     ++iter;
     ++totalNumIterations_;
@@ -222,6 +243,10 @@ void SlpSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
   problemMetrics_ = multiple_shooting::toProblemMetrics(timeDiscretization, std::move(metrics));
   computeControllerTimer_.endTimer();
 
+  // Time budget report
+  performanceIndeces_.back().earlyExit = (convergence == slp::Convergence::TIMEBUDGET);
+  performanceIndeces_.back().deadlineMissed = exceedsTimeBudget(0.0);
+
   ++numProblems_;
 
   if (settings_.printSolverStatus || settings_.printLinesearch) {
@@ -237,6 +262,7 @@ void SlpSolver::runParallel(std::function<void(int)> taskFunction) {
 }
 
 SlpSolver::OcpSubproblemSolution SlpSolver::getOCPSolution(const vector_t& delta_x0) {
+  OCS2_TRACE_SCOPE("SlpSolver::solveQp");
   // Solve the QP
   OcpSubproblemSolution solution;
   auto& deltaXSol = solution.deltaXSol;
@@ -294,12 +320,14 @@ SlpSolver::OcpSubproblemSolution SlpSolver::getOCPSolution(const vector_t& delta
 }
 
 PrimalSolution SlpSolver::toPrimalSolution(const std::vector<AnnotatedTime>& time, vector_array_t&& x, vector_array_t&& u) {
+  OCS2_TRACE_SCOPE("SlpSolver::computeController");
   ModeSchedule modeSchedule = this->getReferenceManager().getModeSchedule();
   return multiple_shooting::toPrimalSolution(time, std::move(modeSchedule), std::move(x), std::move(u));
 }
 
 PerformanceIndex SlpSolver::setupQuadraticSubproblem(const std::vector<AnnotatedTime>& time, const vector_t& initState,
                                                      const vector_array_t& x, const vector_array_t& u, std::vector<Metrics>& metrics) {
+  OCS2_TRACE_SCOPE("SlpSolver::setupQuadraticSubproblem");
   // Problem horizon
   const int N = static_cast<int>(time.size()) - 1;
 
@@ -321,6 +349,7 @@ PerformanceIndex SlpSolver::setupQuadraticSubproblem(const std::vector<Annotated
 
     int i = timeIndex++;
     while (i < N) {
+      OCS2_TRACE_SCOPE("SlpSolver::approximateNode");
       if (time[i].event == AnnotatedTime::Event::PreEvent) {
         // Event node
         auto result = multiple_shooting::setupEventNode(ocpDefinition, time[i].time, x[i], x[i + 1]);
@@ -379,6 +408,7 @@ PerformanceIndex SlpSolver::setupQuadraticSubproblem(const std::vector<Annotated
 
 PerformanceIndex SlpSolver::computePerformance(const std::vector<AnnotatedTime>& time, const vector_t& initState, const vector_array_t& x,
                                                const vector_array_t& u, std::vector<Metrics>& metrics) {
+  OCS2_TRACE_SCOPE("SlpSolver::computePerformance");
   // Problem size
   const int N = static_cast<int>(time.size()) - 1;
   metrics.resize(N + 1);
@@ -428,6 +458,7 @@ PerformanceIndex SlpSolver::computePerformance(const std::vector<AnnotatedTime>&
 slp::StepInfo SlpSolver::takeStep(const PerformanceIndex& baseline, const std::vector<AnnotatedTime>& timeDiscretization,
                                   const vector_t& initState, const OcpSubproblemSolution& subproblemSolution, vector_array_t& x,
                                   vector_array_t& u, std::vector<Metrics>& metrics) {
+  OCS2_TRACE_SCOPE("SlpSolver::linesearch");
   using StepType = FilterLinesearch::StepType;
 
   /*
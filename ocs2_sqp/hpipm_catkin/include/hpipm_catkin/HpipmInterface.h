@@ -30,6 +30,7 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #pragma once
 
 #include <memory>
+#include <vector>
 
 extern "C" {
 #include <hpipm_common.h>
@@ -41,6 +42,31 @@ extern "C" {
 #include "hpipm_catkin/HpipmInterfaceSettings.h"
 
 namespace ocs2 {
+namespace hpipm_interface {
+
+/**
+ * Box constraints on a subset of the entries of a state or input vector: lowerBound <= v[index] <= upperBound.
+ * One-sided bounds are specified with +/- infinity.
+ */
+struct BoxConstraints {
+  std::vector<int> index;
+  vector_t lowerBound;
+  vector_t upperBound;
+};
+
+/**
+ * Inequality constraints of the QP. Each member is either empty, i.e., no constraints of that type, or has one entry per node.
+ */
+struct InequalityConstraints {
+  // State box constraints. Size N+1. The entry at the first node is ignored since the initial state is not a decision variable.
+  std::vector<BoxConstraints> stateBoxConstraints;
+  // Input box constraints. Size N.
+  std::vector<BoxConstraints> inputBoxConstraints;
+  // General inequality constraints f + dfdx * x + dfdu * u >= 0. Size N+1, without inputs at the terminal node.
+  std::vector<VectorFunctionLinearApproximation> generalConstraints;
+};
+
+}  // namespace hpipm_interface
 
 /**
  * This class implements the interface between Linear Quadratic optimal control problems defined in OCS2 and the HPIPM solver.
@@ -49,6 +75,8 @@ namespace ocs2 {
 class HpipmInterface {
  public:
   using Settings = hpipm_interface::Settings;
+  using BoxConstraints = hpipm_interface::BoxConstraints;
+  using InequalityConstraints = hpipm_interface::InequalityConstraints;
 
   /**
    * Construct the Hpipm interface with given size and settings.
@@ -60,7 +88,7 @@ class HpipmInterface {
   ~HpipmInterface();
 
   /** Resize the problem */
-  void resize(OcpSize ocpSize);
+  void resize(const OcpSize& ocpSize);
 
   /**
    * Solves a discrete linear quadratic optimal control problem. The interface needs to be resized to a consistent OcpSize before calling
@@ -86,6 +114,42 @@ class HpipmInterface {
                      std::vector<ScalarFunctionQuadraticApproximation>& cost, std::vector<VectorFunctionLinearApproximation>* constraints,
                      vector_array_t& stateTrajectory, vector_array_t& inputTrajectory, bool verbose = false);
 
+  /**
+   * Solves a discrete linear quadratic optimal control problem with inequality constraints. The interface needs to be resized to a
+   * consistent OcpSize before calling this function: The box constraint sizes need to match the number of constrained entries, and
+   * numIneqConstraints needs to be the sum of the equality and general inequality constraints (see extractSizesFromProblem).
+   *
+   * @param x0 : Initial state (deviation).
+   * @param dynamics : Linearized approximation of the discrete dynamics.
+   * @param cost : Quadratic approximation of the cost.
+   * @param constraints : Linearized approximation of equality constraints, can be nullptr.
+   * @param ineqConstraints : Box and general inequality constraints, can be nullptr.
+   * @param [out] stateTrajectory : Solution state (deviation) trajectory.
+   * @param [out] inputTrajectory : Solution input (deviation) trajectory.
+   * @param verbose : Prints the HPIPM iteration statistics if true.
+   * @return HPIPM returned flag, see above.
+   */
+  hpipm_status solve(const vector_t& x0, std::vector<VectorFunctionLinearApproximation>& dynamics,
+                     std::vector<ScalarFunctionQuadraticApproximation>& cost, std::vector<VectorFunctionLinearApproximation>* constraints,
+                     const InequalityConstraints* ineqConstraints, vector_array_t& stateTrajectory, vector_array_t& inputTrajectory,
+                     bool verbose = false);
+
+  /**
+   * Prepares the warm start of the next solve by shifting the duals and slacks of the previous solve in time. Each node of the next
+   * problem is initialized with the node of the previous problem at the same or the next time instance. Nodes without a previous node of
+   * consistent size are initialized with zero equality multipliers, and with sqrt(mu0) for inequality multipliers and slacks. The primal
+   * deltas always start at zero, since the previous ones are relative to the previous linearization point.
+   * Only takes effect if warm_start is enabled in the settings. Without calling this function, the previous iterate is reused node by node.
+   * With partial condensing, HPIPM always starts from the previous iterate of the condensed problem and this function throws.
+   *
+   * @param previousTime : Time of the nodes of the previously solved problem.
+   * @param time : Time of the nodes of the next problem.
+   */
+  void shiftWarmStart(const scalar_array_t& previousTime, const scalar_array_t& time);
+
+  /** Number of interior point iterations of the previous solve. */
+  int getNumIterations() const;
+
   /**
    * Return the Riccati cost-to-go for the previously solved problem.
    * Extra information about the initial stage is needed to complete calculation.
@@ -93,6 +157,10 @@ class HpipmInterface {
    * Cost-to-go at a node is: V_k(x) = 0.5 * x' * dfdxx * x + x' * dfdx + f
    * For the moment, the value for f is set to 0.0 because it is expensive to compute and often not needed.
    *
+   * With partial condensing, the Riccati quantities of all nodes are reconstructed from the expanded solution on the first call after a
+   * solve. The barrier Hessian of the inequality constraints at the final interior point iterate is included, as in the factorization that
+   * HPIPM uses for the sparse QP. The QP data passed to the last solve must still be valid and unchanged at that point.
+   *
    * @param dynamics0 : dynamics at k = 0
    * @param cost0 : cost at k = 0
    * @return Sequence of quadratic cost-to-go's.
@@ -102,7 +170,7 @@ class HpipmInterface {
 
   /**
    * Return the sequence of N feedback matrices for the previously solved problem.
-   * Extra information about the initial stage is needed to complete calculation.
+   * Extra information about the initial stage is needed to complete calculation. See getRiccatiCostToGo for partial condensing.
    *
    * @param dynamics0 : dynamics at k = 0
    * @param cost0 : cost at k = 0
@@ -112,7 +180,7 @@ class HpipmInterface {
 
   /**
    * Return the sequence of N feedforward input vectors for the previously solved problem.
-   * Extra information about the initial stage is needed to complete calculation.
+   * Extra information about the initial stage is needed to complete calculation. See getRiccatiCostToGo for partial condensing.
    *
    * @param dynamics0 : dynamics at k = 0
    * @param cost0 : cost at k = 0
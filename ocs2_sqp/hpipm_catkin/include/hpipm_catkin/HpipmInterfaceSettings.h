@@ -54,6 +54,10 @@ struct Settings {
   int warm_start = 0;
   int pred_corr = 1;
   int ric_alg = 0;  // square root ricatti recursion
+
+  // Number of stages that are condensed into one block before the QP is passed to the interior point method. A value of 1 solves the
+  // sparse QP without condensing. Larger blocks reduce the per-stage overhead of long horizons with small input dimensions.
+  int partialCondensingBlockSize = 1;
 };
 
 std::ostream& operator<<(std::ostream& stream, const Settings& settings);
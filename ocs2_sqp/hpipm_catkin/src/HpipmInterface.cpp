@@ -29,6 +29,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "hpipm_catkin/HpipmInterface.h"
 
+#include <algorithm>
+#include <cmath>
+
 #include <ocs2_core/misc/LinearAlgebra.h>
 
 extern "C" {
@@ -36,6 +39,7 @@ extern "C" {
 #include <hpipm_d_ocp_qp_dim.h>
 #include <hpipm_d_ocp_qp_ipm.h>
 #include <hpipm_d_ocp_qp_sol.h>
+#include <hpipm_d_part_cond.h>
 #include <hpipm_timing.h>
 }
 
@@ -81,25 +85,51 @@ class MemoryBlock {
   void* ptr_;
   size_t size_;
 };
+
+/**
+ * Box constraints in the format expected by HPIPM. HPIPM does not accept infinite bounds, these are set to zero and disabled with a mask.
+ */
+struct BoxConstraintsData {
+  /** Sets the data in place, such that the memory is reused when the number of constraints does not change */
+  void set(const ocs2::hpipm_interface::BoxConstraints& boxConstraints) {
+    index = boxConstraints.index;
+    lowerBound = boxConstraints.lowerBound.array().isFinite().select(boxConstraints.lowerBound, 0.0);
+    upperBound = boxConstraints.upperBound.array().isFinite().select(boxConstraints.upperBound, 0.0);
+    lowerMask = boxConstraints.lowerBound.array().isFinite().cast<ocs2::scalar_t>();
+    upperMask = boxConstraints.upperBound.array().isFinite().cast<ocs2::scalar_t>();
+  }
+
+  std::vector<int> index;
+  ocs2::vector_t lowerBound;
+  ocs2::vector_t upperBound;
+  ocs2::vector_t lowerMask;
+  ocs2::vector_t upperMask;
+};
 }  // namespace
 
 namespace ocs2 {
 
 class HpipmInterface::Impl {
  public:
-  Impl(OcpSize ocpSize, Settings settings) : settings_(std::move(settings)) { initializeMemory(std::move(ocpSize), true); }
+  using BoxConstraints = HpipmInterface::BoxConstraints;
+  using InequalityConstraints = HpipmInterface::InequalityConstraints;
 
-  void initializeMemory(OcpSize ocpSize, bool forceInitialization = false) {
-    // We will remove the initial state from the decision variables before passing the data to HPIPM.
-    // This removes the need for adding constraints to enforce x[0] = x_init
-    ocpSize.numStates[0] = 0;
+  Impl(const OcpSize& ocpSize, Settings settings) : settings_(std::move(settings)) { initializeMemory(ocpSize, true); }
 
-    // Skip memory initialization if problem size didn't change.
-    if (!forceInitialization && ocpSize_ == ocpSize) {
+  void initializeMemory(const OcpSize& ocpSize, bool forceInitialization = false) {
+    // Skip memory initialization if problem size didn't change. Compared against the requested size to avoid a copy.
+    if (!forceInitialization && requestedOcpSize_ == ocpSize) {
       return;
     }
 
-    ocpSize_ = std::move(ocpSize);
+    requestedOcpSize_ = ocpSize;
+    ocpSize_ = ocpSize;
+    // We will remove the initial state from the decision variables before passing the data to HPIPM.
+    // This removes the need for adding constraints to enforce x[0] = x_init
+    ocpSize_.numStates[0] = 0;
+    ocpSize_.numStateBoxConstraints[0] = 0;
+    ocpSize_.numStateBoxSlack[0] = 0;
+    expandedRiccatiData_ = ExpandedRiccatiData();
 
     const int dim_size = d_ocp_qp_dim_memsize(ocpSize_.numStages);
     dimMem_.reserve(dim_size);
@@ -116,16 +146,61 @@ class HpipmInterface::Impl {
     qpSolMem_.reserve(qp_sol_size);
     d_ocp_qp_sol_create(&dim_, &qpSol_, qpSolMem_.get());
 
-    const int ipm_arg_size = d_ocp_qp_ipm_arg_memsize(&dim_);
+    // The interior point method solves either the original or the partially condensed QP
+    d_ocp_qp_dim* ipmDim = &dim_;
+    if (usePartialCondensing()) {
+      initializePartialCondensingMemory();
+      ipmDim = &partDim_;
+    }
+
+    const int ipm_arg_size = d_ocp_qp_ipm_arg_memsize(ipmDim);
     ipmArgMem_.reserve(ipm_arg_size);
-    d_ocp_qp_ipm_arg_create(&dim_, &arg_, ipmArgMem_.get());
+    d_ocp_qp_ipm_arg_create(ipmDim, &arg_, ipmArgMem_.get());
 
     applySettings(settings_);
 
     // Setup workspace after applying the settings
-    const int ipm_size = d_ocp_qp_ipm_ws_memsize(&dim_, &arg_);
+    const int ipm_size = d_ocp_qp_ipm_ws_memsize(ipmDim, &arg_);
     ipmMem_.reserve(ipm_size);
-    d_ocp_qp_ipm_ws_create(&dim_, &arg_, &workspace_, ipmMem_.get());
+    d_ocp_qp_ipm_ws_create(ipmDim, &arg_, &workspace_, ipmMem_.get());
+  }
+
+  /** Partial condensing is used if it reduces the number of stages */
+  bool usePartialCondensing() const {
+    return settings_.partialCondensingBlockSize > 1 && ocpSize_.numStages > 1;
+  }
+
+  /** Sets up the partially condensed QP with blocks of (at most) partialCondensingBlockSize stages. */
+  void initializePartialCondensingMemory() {
+    const int N = ocpSize_.numStages;
+    const int numBlocks = (N + settings_.partialCondensingBlockSize - 1) / settings_.partialCondensingBlockSize;
+
+    // Distributes the stages evenly over the blocks, the terminal node is a block on its own.
+    blockSize_.resize(numBlocks + 1);
+    d_part_cond_qp_compute_block_size(N, numBlocks, blockSize_.data());
+
+    const int part_dim_size = d_ocp_qp_dim_memsize(numBlocks);
+    partDimMem_.reserve(part_dim_size);
+    d_ocp_qp_dim_create(numBlocks, &partDim_, partDimMem_.get());
+    d_part_cond_qp_compute_dim(&dim_, blockSize_.data(), &partDim_);
+
+    const int part_qp_size = d_ocp_qp_memsize(&partDim_);
+    partQpMem_.reserve(part_qp_size);
+    d_ocp_qp_create(&partDim_, &partQp_, partQpMem_.get());
+
+    const int part_qp_sol_size = d_ocp_qp_sol_memsize(&partDim_);
+    partQpSolMem_.reserve(part_qp_sol_size);
+    d_ocp_qp_sol_create(&partDim_, &partQpSol_, partQpSolMem_.get());
+
+    const int part_cond_arg_size = d_part_cond_qp_arg_memsize(numBlocks);
+    partCondArgMem_.reserve(part_cond_arg_size);
+    d_part_cond_qp_arg_create(numBlocks, &partCondArg_, partCondArgMem_.get());
+    d_part_cond_qp_arg_set_default(&partCondArg_);
+    d_part_cond_qp_arg_set_ric_alg(settings_.ric_alg, &partCondArg_);
+
+    const int part_cond_size = d_part_cond_qp_ws_memsize(&dim_, blockSize_.data(), &partDim_, &partCondArg_);
+    partCondMem_.reserve(part_cond_size);
+    d_part_cond_qp_ws_create(&dim_, blockSize_.data(), &partDim_, &partCondArg_, &partCondWorkspace_, partCondMem_.get());
   }
 
   void applySettings(Settings& settings) {
@@ -144,8 +219,8 @@ class HpipmInterface::Impl {
   }
 
   void verifySizes(const vector_t& x0, std::vector<VectorFunctionLinearApproximation>& dynamics,
-                   std::vector<ScalarFunctionQuadraticApproximation>& cost,
-                   std::vector<VectorFunctionLinearApproximation>* constraints) const {
+                   std::vector<ScalarFunctionQuadraticApproximation>& cost, std::vector<VectorFunctionLinearApproximation>* constraints,
+                   const InequalityConstraints* ineqConstraints) const {
     if (dynamics.size() != ocpSize_.numStages) {
       throw std::runtime_error("[HpipmInterface] Inconsistent size of dynamics: " + std::to_string(dynamics.size()) + " with " +
                                std::to_string(ocpSize_.numStages) + " number of stages.");
@@ -160,19 +235,105 @@ class HpipmInterface::Impl {
                                  std::to_string(ocpSize_.numStages + 1) + " nodes.");
       }
     }
+    if (ineqConstraints != nullptr) {
+      verifyInequalitySizes(constraints, *ineqConstraints);
+    } else {
+      verifyInequalitySizes(constraints, InequalityConstraints());
+    }
     // TODO: expand with state-input size checks
   }
 
+  void verifyInequalitySizes(std::vector<VectorFunctionLinearApproximation>* constraints,
+                             const InequalityConstraints& ineqConstraints) const {
+    const int N = ocpSize_.numStages;
+    const auto& stateBoxes = ineqConstraints.stateBoxConstraints;
+    const auto& inputBoxes = ineqConstraints.inputBoxConstraints;
+    const auto& general = ineqConstraints.generalConstraints;
+    if (!stateBoxes.empty() && stateBoxes.size() != N + 1) {
+      throw std::runtime_error("[HpipmInterface] Inconsistent size of state box constraints: " + std::to_string(stateBoxes.size()) +
+                               " with " + std::to_string(N + 1) + " nodes.");
+    }
+    if (!inputBoxes.empty() && inputBoxes.size() != N) {
+      throw std::runtime_error("[HpipmInterface] Inconsistent size of input box constraints: " + std::to_string(inputBoxes.size()) +
+                               " with " + std::to_string(N) + " number of stages.");
+    }
+    if (!general.empty() && general.size() != N + 1) {
+      throw std::runtime_error("[HpipmInterface] Inconsistent size of inequality constraints: " + std::to_string(general.size()) +
+                               " with " + std::to_string(N + 1) + " nodes.");
+    }
+
+    const auto numBoxConstraints = [](const std::vector<BoxConstraints>& boxes, int k) {
+      if (boxes.empty()) {
+        return 0;
+      }
+      const auto& box = boxes[k];
+      if (box.lowerBound.size() != box.index.size() || box.upperBound.size() != box.index.size()) {
+        throw std::runtime_error("[HpipmInterface] Box constraint bounds and index are of inconsistent size at node " + std::to_string(k));
+      }
+      return static_cast<int>(box.index.size());
+    };
+    for (int k = 0; k <= N; k++) {
+      // The initial state is not a decision variable, its box constraints are ignored.
+      if (k > 0 && numBoxConstraints(stateBoxes, k) != ocpSize_.numStateBoxConstraints[k]) {
+        throw std::runtime_error("[HpipmInterface] Inconsistent number of state box constraints at node " + std::to_string(k));
+      }
+      if (k < N && numBoxConstraints(inputBoxes, k) != ocpSize_.numInputBoxConstraints[k]) {
+        throw std::runtime_error("[HpipmInterface] Inconsistent number of input box constraints at node " + std::to_string(k));
+      }
+      const int numEq = (constraints != nullptr) ? (*constraints)[k].f.size() : 0;
+      const int numIneq = general.empty() ? 0 : general[k].f.size();
+      if (numEq + numIneq != ocpSize_.numIneqConstraints[k]) {
+        throw std::runtime_error("[HpipmInterface] Inconsistent number of general constraints at node " + std::to_string(k));
+      }
+    }
+  }
+
+  /**
+   * Disables the bounds that are not set: the upper bounds of general inequality constraints and infinite box constraint bounds.
+   * The masks are set for every constrained node since HPIPM keeps them in the QP memory across solves.
+   */
+  void setInequalityMasks(std::vector<VectorFunctionLinearApproximation>* constraints, const InequalityConstraints* ineqConstraints,
+                          std::vector<BoxConstraintsData>& stateBoxData, std::vector<BoxConstraintsData>& inputBoxData) {
+    const int N = ocpSize_.numStages;
+    auto& lowerMask = qpData_.generalLowerMask;
+    auto& upperMask = qpData_.generalUpperMask;
+    lowerMask.resize(N + 1);
+    upperMask.resize(N + 1);
+    for (int k = 0; k <= N; k++) {
+      const int numGeneral = ocpSize_.numIneqConstraints[k];
+      if (numGeneral > 0) {
+        const int numEq = (constraints != nullptr) ? (*constraints)[k].f.size() : 0;
+        lowerMask[k].setOnes(numGeneral);
+        upperMask[k].setZero(numGeneral);
+        upperMask[k].head(numEq).setOnes();
+        d_ocp_qp_set_lg_mask(k, lowerMask[k].data(), &qp_);
+        d_ocp_qp_set_ug_mask(k, upperMask[k].data(), &qp_);
+      }
+      if (ocpSize_.numStateBoxConstraints[k] > 0) {
+        d_ocp_qp_set_lbx_mask(k, stateBoxData[k].lowerMask.data(), &qp_);
+        d_ocp_qp_set_ubx_mask(k, stateBoxData[k].upperMask.data(), &qp_);
+      }
+      if (ocpSize_.numInputBoxConstraints[k] > 0) {
+        d_ocp_qp_set_lbu_mask(k, inputBoxData[k].lowerMask.data(), &qp_);
+        d_ocp_qp_set_ubu_mask(k, inputBoxData[k].upperMask.data(), &qp_);
+      }
+    }
+  }
+
   hpipm_status solve(const vector_t& x0, std::vector<VectorFunctionLinearApproximation>& dynamics,
                      std::vector<ScalarFunctionQuadraticApproximation>& cost, std::vector<VectorFunctionLinearApproximation>* constraints,
-                     vector_array_t& stateTrajectory, vector_array_t& inputTrajectory, bool verbose) {
+                     const InequalityConstraints* ineqConstraints, vector_array_t& stateTrajectory, vector_array_t& inputTrajectory,
+                     bool verbose) {
     const int N = ocpSize_.numStages;
-    verifySizes(x0, dynamics, cost, constraints);
+    verifySizes(x0, dynamics, cost, constraints, ineqConstraints);
 
     // === Dynamics ===
-    std::vector<scalar_t*> AA(N, nullptr);
-    std::vector<scalar_t*> BB(N, nullptr);
-    std::vector<scalar_t*> bb(N, nullptr);
+    auto& AA = qpData_.AA;
+    auto& BB = qpData_.BB;
+    auto& bb = qpData_.bb;
+    AA.assign(N, nullptr);
+    BB.assign(N, nullptr);
+    bb.assign(N, nullptr);
 
     // k = 0. Absorb initial state into dynamics
     // The initial state is removed from the decision variables
@@ -181,7 +342,8 @@ class HpipmInterface::Impl {
     //         = B[0]*u[0] + (b[0] + A[0]*x[0])
     //         = B[0]*u[0] + \tilde{b}[0]
     // numState[0] = 0 --> No need to specify A[0] here
-    vector_t b0 = dynamics[0].f;
+    auto& b0 = qpData_.b0;
+    b0 = dynamics[0].f;
     b0.noalias() += dynamics[0].dfdx * x0;
     BB[0] = dynamics[0].dfdu.data();
     bb[0] = b0.data();
@@ -194,16 +356,22 @@ class HpipmInterface::Impl {
     }
 
     // === Costs ===
-    std::vector<scalar_t*> QQ(N + 1, nullptr);
-    std::vector<scalar_t*> RR(N + 1, nullptr);
-    std::vector<scalar_t*> SS(N + 1, nullptr);
-    std::vector<scalar_t*> qq(N + 1, nullptr);
-    std::vector<scalar_t*> rr(N + 1, nullptr);
+    auto& QQ = qpData_.QQ;
+    auto& RR = qpData_.RR;
+    auto& SS = qpData_.SS;
+    auto& qq = qpData_.qq;
+    auto& rr = qpData_.rr;
+    QQ.assign(N + 1, nullptr);
+    RR.assign(N + 1, nullptr);
+    SS.assign(N + 1, nullptr);
+    qq.assign(N + 1, nullptr);
+    rr.assign(N + 1, nullptr);
 
     // k = 0. Elimination of initial state requires cost adaptation
     // numState[0] = 0 --> No need to specify Q[0], S[0], q[0] here
-    vector_t r0 = cost[0].dfdu;
-    r0 += cost[0].dfdux * x0;
+    auto& r0 = qpData_.r0;
+    r0 = cost[0].dfdu;
+    r0.noalias() += cost[0].dfdux * x0;
     RR[0] = cost[0].dfduu.data();
     rr[0] = r0.data();
 
@@ -221,55 +389,132 @@ class HpipmInterface::Impl {
     qq[N] = cost[N].dfdx.data();
 
     // === Constraints ===
-    // for ocs2 --> C*dx + D*du + e = 0
+    // for ocs2 --> C*dx + D*du + e = 0 (equality constraints) and C*dx + D*du + e >= 0 (general inequality constraints)
     // for hpipm --> ug >= C*dx + D*du >= lg
-    std::vector<scalar_t*> CC(N + 1, nullptr);
-    std::vector<scalar_t*> DD(N + 1, nullptr);
-    std::vector<scalar_t*> llg(N + 1, nullptr);
-    std::vector<scalar_t*> uug(N + 1, nullptr);
-    std::vector<ocs2::vector_t> boundData;  // Declare at this scope to keep the data alive while HPIPM has the pointers
-
-    if (constraints != nullptr) {
-      auto& constr = *constraints;
+    // General inequality constraints are stacked below the equality constraints, their upper bound is disabled with a mask.
+    auto& CC = qpData_.CC;
+    auto& DD = qpData_.DD;
+    auto& llg = qpData_.llg;
+    auto& uug = qpData_.uug;
+    auto& boundData = qpData_.boundData;
+    auto& upperBoundData = qpData_.upperBoundData;
+    auto& stackedC = qpData_.stackedC;
+    auto& stackedD = qpData_.stackedD;
+    CC.assign(N + 1, nullptr);
+    DD.assign(N + 1, nullptr);
+    llg.assign(N + 1, nullptr);
+    uug.assign(N + 1, nullptr);
+
+    const bool hasGeneralIneqConstraints = ineqConstraints != nullptr && !ineqConstraints->generalConstraints.empty();
+    if (constraints != nullptr || hasGeneralIneqConstraints) {
       boundData.resize(N + 1);
+      upperBoundData.resize(N + 1);
+      stackedC.resize(N + 1);
+      stackedD.resize(N + 1);
+    }
 
-      // k = 0, eliminate initial state
-      // numState[0] = 0 --> No need to specify C[0] here
-      if (constr[0].f.size() > 0) {
-        boundData[0] = -constr[0].f;
-        boundData[0].noalias() -= constr[0].dfdx * x0;
-        llg[0] = boundData[0].data();
-        uug[0] = boundData[0].data();
-        DD[0] = constr[0].dfdu.data();
+    for (int k = 0; k <= N; k++) {
+      auto* eqConstr = (constraints != nullptr && (*constraints)[k].f.size() > 0) ? &(*constraints)[k] : nullptr;
+      const auto* ineqConstr = (hasGeneralIneqConstraints && ineqConstraints->generalConstraints[k].f.size() > 0)
+                                   ? &ineqConstraints->generalConstraints[k]
+                                   : nullptr;
+
+      if (eqConstr != nullptr && ineqConstr == nullptr) {
+        // Only equality constraints: pass the data without copies, lower and upper bound are identical.
+        boundData[k] = -eqConstr->f;
+        if (k == 0) {
+          // numState[0] = 0 --> No need to specify C[0] here, eliminate initial state
+          boundData[k].noalias() -= eqConstr->dfdx * x0;
+        } else {
+          CC[k] = eqConstr->dfdx.data();
+        }
+        if (k < N) {  // k = N, no inputs
+          DD[k] = eqConstr->dfdu.data();
+        }
+        llg[k] = boundData[k].data();
+        uug[k] = boundData[k].data();
+      } else if (ineqConstr != nullptr) {
+        const int numEq = (eqConstr != nullptr) ? eqConstr->f.size() : 0;
+        const int numIneq = ineqConstr->f.size();
+        const int nx = ocpSize_.numStates[k];
+        const int nu = ocpSize_.numInputs[k];
+
+        // Stack the constraints, the initial state is eliminated at k = 0.
+        boundData[k].resize(numEq + numIneq);
+        upperBoundData[k].setZero(numEq + numIneq);
+        stackedC[k].resize(numEq + numIneq, nx);
+        stackedD[k].resize(numEq + numIneq, nu);
+        if (eqConstr != nullptr) {
+          boundData[k].head(numEq) = -eqConstr->f;
+          if (k == 0) {
+            boundData[k].head(numEq).noalias() -= eqConstr->dfdx * x0;
+          } else {
+            stackedC[k].topRows(numEq) = eqConstr->dfdx;
+          }
+          if (nu > 0) {
+            stackedD[k].topRows(numEq) = eqConstr->dfdu;
+          }
+          upperBoundData[k].head(numEq) = boundData[k].head(numEq);
+        }
+        boundData[k].tail(numIneq) = -ineqConstr->f;
+        if (k == 0) {
+          boundData[k].tail(numIneq).noalias() -= ineqConstr->dfdx * x0;
+        } else {
+          stackedC[k].bottomRows(numIneq) = ineqConstr->dfdx;
+        }
+        if (nu > 0) {
+          stackedD[k].bottomRows(numIneq) = ineqConstr->dfdu;
+        }
+
+        CC[k] = stackedC[k].data();
+        DD[k] = stackedD[k].data();
+        llg[k] = boundData[k].data();
+        uug[k] = upperBoundData[k].data();
       }
+    }
 
-      // k = 1 -> (N-1)
-      for (int k = 1; k < N; k++) {
-        if (constr[k].f.size() > 0) {
-          CC[k] = constr[k].dfdx.data();
-          DD[k] = constr[k].dfdu.data();
-          boundData[k] = -constr[k].f;
-          llg[k] = boundData[k].data();
-          uug[k] = boundData[k].data();
+    // === Box constraints ===
+    auto& hidxbx = qpData_.hidxbx;
+    auto& hlbx = qpData_.hlbx;
+    auto& hubx = qpData_.hubx;
+    auto& hidxbu = qpData_.hidxbu;
+    auto& hlbu = qpData_.hlbu;
+    auto& hubu = qpData_.hubu;
+    auto& stateBoxData = qpData_.stateBoxData;
+    auto& inputBoxData = qpData_.inputBoxData;
+    hidxbx.assign(N + 1, nullptr);
+    hlbx.assign(N + 1, nullptr);
+    hubx.assign(N + 1, nullptr);
+    hidxbu.assign(N + 1, nullptr);
+    hlbu.assign(N + 1, nullptr);
+    hubu.assign(N + 1, nullptr);
+
+    if (ineqConstraints != nullptr && !ineqConstraints->stateBoxConstraints.empty()) {
+      stateBoxData.resize(N + 1);
+      // k = 0, initial state is not a decision variable
+      for (int k = 1; k <= N; k++) {
+        if (!ineqConstraints->stateBoxConstraints[k].index.empty()) {
+          stateBoxData[k].set(ineqConstraints->stateBoxConstraints[k]);
+          hidxbx[k] = stateBoxData[k].index.data();
+          hlbx[k] = stateBoxData[k].lowerBound.data();
+          hubx[k] = stateBoxData[k].upperBound.data();
         }
       }
+    }
 
-      // k = N, no inputs
-      if (constr[N].f.size() > 0) {
-        CC[N] = constr[N].dfdx.data();
-        boundData[N] = -constr[N].f;
-        llg[N] = boundData[N].data();
-        uug[N] = boundData[N].data();
+    if (ineqConstraints != nullptr && !ineqConstraints->inputBoxConstraints.empty()) {
+      inputBoxData.resize(N);
+      for (int k = 0; k < N; k++) {
+        if (!ineqConstraints->inputBoxConstraints[k].index.empty()) {
+          inputBoxData[k].set(ineqConstraints->inputBoxConstraints[k]);
+          hidxbu[k] = inputBoxData[k].index.data();
+          hlbu[k] = inputBoxData[k].lowerBound.data();
+          hubu[k] = inputBoxData[k].upperBound.data();
+        }
       }
     }
 
     // === Unused ===
-    int** hidxbx = nullptr;
-    scalar_t** hlbx = nullptr;
-    scalar_t** hubx = nullptr;
-    int** hidxbu = nullptr;
-    scalar_t** hlbu = nullptr;
-    scalar_t** hubu = nullptr;
     scalar_t** hZl = nullptr;
     scalar_t** hZu = nullptr;
     scalar_t** hzl = nullptr;
@@ -279,9 +524,41 @@ class HpipmInterface::Impl {
     scalar_t** hlus = nullptr;
 
     // === Set and solve ===
-    d_ocp_qp_set_all(AA.data(), BB.data(), bb.data(), QQ.data(), SS.data(), RR.data(), qq.data(), rr.data(), hidxbx, hlbx, hubx, hidxbu,
-                     hlbu, hubu, CC.data(), DD.data(), llg.data(), uug.data(), hZl, hZu, hzl, hzu, hidxs, hlls, hlus, &qp_);
-    d_ocp_qp_ipm_solve(&qp_, &qpSol_, &arg_, &workspace_);
+    d_ocp_qp_set_all(AA.data(), BB.data(), bb.data(), QQ.data(), SS.data(), RR.data(), qq.data(), rr.data(), hidxbx.data(), hlbx.data(),
+                     hubx.data(), hidxbu.data(), hlbu.data(), hubu.data(), CC.data(), DD.data(), llg.data(), uug.data(), hZl, hZu, hzl,
+                     hzu, hidxs, hlls, hlus, &qp_);
+    setInequalityMasks(constraints, ineqConstraints, stateBoxData, inputBoxData);
+    if (usePartialCondensing()) {
+      // The condensed solution memory keeps the previous iterate, from which HPIPM warm starts. Only its duals and slacks are meaningful
+      // for the new QP, the primal deltas are relative to the previous linearization point.
+      d_part_cond_qp_cond(&qp_, &partQp_, &partCondArg_, &partCondWorkspace_);
+      if (settings_.warm_start > 0) {
+        for (int k = 0; k <= partDim_.N; ++k) {
+          Eigen::Map<vector_t>(partQpSol_.ux[k].pa, partQpSol_.ux[k].m).setZero();
+        }
+      }
+      d_ocp_qp_ipm_solve(&partQp_, &partQpSol_, &arg_, &workspace_);
+      d_part_cond_qp_expand_sol(&qp_, &partQp_, &partQpSol_, &qpSol_, &partCondArg_, &partCondWorkspace_);
+    } else {
+      if (settings_.warm_start > 0) {
+        setWarmStart();
+      }
+      d_ocp_qp_ipm_solve(&qp_, &qpSol_, &arg_, &workspace_);
+      if (settings_.warm_start > 0) {
+        storeIterate();
+      }
+    }
+
+    // The factorization of the condensed QP only contains the Riccati quantities at the boundaries of the blocks. The quantities of all
+    // nodes are computed on request from the data of this QP.
+    if (usePartialCondensing()) {
+      expandedRiccatiData_.x0 = x0;
+      expandedRiccatiData_.dynamics = &dynamics;
+      expandedRiccatiData_.cost = &cost;
+      expandedRiccatiData_.constraints = constraints;
+      expandedRiccatiData_.ineqConstraints = ineqConstraints;
+      expandedRiccatiData_.isUpToDate = false;
+    }
 
     if (verbose) {
       printStatus();
@@ -300,6 +577,78 @@ class HpipmInterface::Impl {
     return hpipm_status(hpipmStatus);
   }
 
+  void shiftWarmStart(const scalar_array_t& previousTime, const scalar_array_t& time) {
+    if (usePartialCondensing()) {
+      throw std::runtime_error("[HpipmInterface] shiftWarmStart is not supported with partial condensing.");
+    }
+    warmStartNodes_.resize(time.size());
+    for (int k = 0; k < time.size(); ++k) {
+      const auto it = std::lower_bound(previousTime.begin(), previousTime.end(), time[k]);
+      warmStartNodes_[k] = std::min(static_cast<int>(std::distance(previousTime.begin(), it)), static_cast<int>(previousTime.size()) - 1);
+    }
+  }
+
+  int getNumIterations() {
+    int iter = 0;
+    d_ocp_qp_ipm_get_iter(&workspace_, &iter);
+    return iter;
+  }
+
+  /**
+   * Stores the dual iterate and the slacks of the last solve. The primal solution is not stored: it is a step relative to the previous
+   * linearization point and therefore not a meaningful initial guess for the next QP.
+   */
+  void storeIterate() {
+    const int N = ocpSize_.numStages;
+    previousIterate_.resize(N + 1);
+    for (int k = 0; k <= N; ++k) {
+      auto& iterate = previousIterate_[k];
+      if (k < N) {
+        iterate.pi = Eigen::Map<const vector_t>(qpSol_.pi[k].pa, ocpSize_.numStates[k + 1]);
+      } else {
+        iterate.pi.resize(0);
+      }
+      iterate.lam = Eigen::Map<const vector_t>(qpSol_.lam[k].pa, qpSol_.lam[k].m);
+      iterate.t = Eigen::Map<const vector_t>(qpSol_.t[k].pa, qpSol_.t[k].m);
+      if (!iterate.pi.allFinite() || !iterate.lam.allFinite() || !iterate.t.allFinite()) {
+        previousIterate_.clear();  // Do not warm start from a failed solve
+        break;
+      }
+    }
+    warmStartNodes_.clear();
+  }
+
+  /**
+   * Writes the (shifted) duals and slacks of the previous solve to the solution memory, from where HPIPM reads the initial guess. The primal
+   * deltas start at zero, i.e., at the current linearization point.
+   */
+  void setWarmStart() {
+    const int N = ocpSize_.numStages;
+    const scalar_t defaultMultiplier = std::sqrt(settings_.mu0);
+
+    // Copies the source if the sizes match, otherwise sets the default value.
+    const auto assign = [](scalar_t* dst, int size, const vector_t* src, scalar_t defaultValue) {
+      if (src != nullptr && src->size() == size) {
+        Eigen::Map<vector_t>(dst, size) = *src;
+      } else {
+        Eigen::Map<vector_t>(dst, size).setConstant(defaultValue);
+      }
+    };
+
+    for (int k = 0; k <= N; ++k) {
+      const int previousNode = warmStartNodes_.empty() ? k : warmStartNodes_[k];
+      const Iterate* iterate = (0 <= previousNode && previousNode < previousIterate_.size()) ? &previousIterate_[previousNode] : nullptr;
+      const int nu = ocpSize_.numInputs[k];
+      const int nx = ocpSize_.numStates[k];
+      Eigen::Map<vector_t>(qpSol_.ux[k].pa, nu + nx).setZero();
+      if (k < N) {
+        assign(qpSol_.pi[k].pa, ocpSize_.numStates[k + 1], (iterate != nullptr) ? &iterate->pi : nullptr, 0.0);
+      }
+      assign(qpSol_.lam[k].pa, qpSol_.lam[k].m, (iterate != nullptr) ? &iterate->lam : nullptr, defaultMultiplier);
+      assign(qpSol_.t[k].pa, qpSol_.t[k].m, (iterate != nullptr) ? &iterate->t : nullptr, defaultMultiplier);
+    }
+  }
+
   bool getStateSolution(const vector_t& x0, vector_array_t& stateTrajectory) {
     stateTrajectory.resize(ocpSize_.numStages + 1);
     stateTrajectory.front() = x0;
@@ -327,7 +676,175 @@ class HpipmInterface::Impl {
     return true;
   }
 
+  /** Computes the Riccati quantities of all nodes for the partially condensed solve, if not done since the last solve. */
+  void updateExpandedRiccati() {
+    if (expandedRiccatiData_.isUpToDate) {
+      return;
+    }
+    if (expandedRiccatiData_.dynamics == nullptr) {
+      throw std::runtime_error("[HpipmInterface] The Riccati quantities are only available after a solve.");
+    }
+    vector_array_t stateTrajectory;
+    vector_array_t inputTrajectory;
+    getStateSolution(expandedRiccatiData_.x0, stateTrajectory);
+    getInputSolution(inputTrajectory);
+    computeExpandedRiccati(*expandedRiccatiData_.dynamics, *expandedRiccatiData_.cost, expandedRiccatiData_.constraints,
+                           expandedRiccatiData_.ineqConstraints, stateTrajectory, inputTrajectory);
+    expandedRiccatiData_.isUpToDate = true;
+  }
+
+  /**
+   * Computes the Riccati quantities of all nodes of the original QP for the partially condensed solve. The barrier Hessian of the inequality
+   * constraints at the final interior point iterate is added to the cost. The gradient is adapted such that the solution of this LQ problem
+   * is the solution of the QP, i.e. u[k] = K[k] * x[k] + k[k] holds along the solution.
+   */
+  void computeExpandedRiccati(const std::vector<VectorFunctionLinearApproximation>& dynamics,
+                              const std::vector<ScalarFunctionQuadraticApproximation>& cost,
+                              const std::vector<VectorFunctionLinearApproximation>* constraints, const InequalityConstraints* ineqConstraints,
+                              const vector_array_t& stateTrajectory, const vector_array_t& inputTrajectory) {
+    const int N = ocpSize_.numStages;
+    riccatiCostToGo_.resize(N + 1);
+    riccatiFeedback_.resize(N);
+    riccatiFeedforward_.resize(N);
+
+    // k = N
+    ScalarFunctionQuadraticApproximation stageCost = cost[N];
+    addBarrierApproximation(N, stateTrajectory[N], vector_t(), constraints, ineqConstraints, stageCost);
+    riccatiCostToGo_[N].f = 0.0;
+    riccatiCostToGo_[N].dfdxx = std::move(stageCost.dfdxx);
+    riccatiCostToGo_[N].dfdx = std::move(stageCost.dfdx);
+
+    // k = N-1 -> 0
+    for (int k = N - 1; k >= 0; k--) {
+      stageCost = cost[k];
+      addBarrierApproximation(k, stateTrajectory[k], inputTrajectory[k], constraints, ineqConstraints, stageCost);
+
+      // Shorthand
+      const matrix_t& A = dynamics[k].dfdx;
+      const matrix_t& B = dynamics[k].dfdu;
+      const matrix_t& Sm = riccatiCostToGo_[k + 1].dfdxx;
+      vector_t sv = riccatiCostToGo_[k + 1].dfdx;
+      sv.noalias() += Sm * dynamics[k].f;  // sv + Sm * b
+
+      const matrix_t Sm_A = Sm * A;
+      matrix_t H = stageCost.dfduu;
+      H.noalias() += B.transpose() * Sm * B;
+      matrix_t G = stageCost.dfdux;
+      G.noalias() += B.transpose() * Sm_A;
+      vector_t g = stageCost.dfdu;
+      g.noalias() += B.transpose() * sv;
+
+      const Eigen::LDLT<matrix_t> HFactorization(H);
+      riccatiFeedback_[k] = -HFactorization.solve(G);
+      riccatiFeedforward_[k] = -HFactorization.solve(g);
+
+      auto& costToGo = riccatiCostToGo_[k];
+      costToGo.f = 0.0;
+      costToGo.dfdxx = std::move(stageCost.dfdxx);
+      costToGo.dfdxx.noalias() += A.transpose() * Sm_A;
+      costToGo.dfdxx.noalias() += G.transpose() * riccatiFeedback_[k];
+      costToGo.dfdxx = 0.5 * (costToGo.dfdxx + costToGo.dfdxx.transpose()).eval();
+      costToGo.dfdx = std::move(stageCost.dfdx);
+      costToGo.dfdx.noalias() += A.transpose() * sv;
+      costToGo.dfdx.noalias() += G.transpose() * riccatiFeedforward_[k];
+    }
+  }
+
+  /**
+   * Adds the barrier Hessian W of the inequality constraints g(x, u) >= 0 at node k to the stage cost, with W = lam / t of the final
+   * interior point iterate. The gradient becomes r - dg/du' * (lam + W * g), idem for x, such that the stationarity of the solution is
+   * preserved. HPIPM stores the multipliers and slacks of a node as [lower box, lower general, upper box, upper general], input boxes first.
+   */
+  void addBarrierApproximation(int k, const vector_t& x, const vector_t& u, const std::vector<VectorFunctionLinearApproximation>* constraints,
+                               const InequalityConstraints* ineqConstraints, ScalarFunctionQuadraticApproximation& stageCost) const {
+    const int nbu = ocpSize_.numInputBoxConstraints[k];
+    const int nbx = ocpSize_.numStateBoxConstraints[k];
+    const int nb = nbu + nbx;
+    const int ng = ocpSize_.numIneqConstraints[k];
+    if (nb + ng == 0) {
+      return;
+    }
+
+    const Eigen::Map<const vector_t> lam(qpSol_.lam[k].pa, 2 * (nb + ng));
+    const Eigen::Map<const vector_t> t(qpSol_.t[k].pa, 2 * (nb + ng));
+    const auto weight = [&](int i, bool hasLower, bool hasUpper) {
+      return (hasLower ? lam[i] / t[i] : 0.0) + (hasUpper ? lam[nb + ng + i] / t[nb + ng + i] : 0.0);
+    };
+    const auto multiplier = [&](int i, bool hasLower, bool hasUpper) {
+      return (hasLower ? lam[i] : 0.0) - (hasUpper ? lam[nb + ng + i] : 0.0);
+    };
+
+    // Box constraints
+    for (int j = 0; j < nbu; j++) {
+      const auto& box = ineqConstraints->inputBoxConstraints[k];
+      const int i = box.index[j];
+      const bool hasLower = std::isfinite(box.lowerBound[j]);
+      const bool hasUpper = std::isfinite(box.upperBound[j]);
+      const scalar_t w = weight(j, hasLower, hasUpper);
+      stageCost.dfduu(i, i) += w;
+      stageCost.dfdu[i] -= multiplier(j, hasLower, hasUpper) + w * u[i];
+    }
+    for (int j = 0; j < nbx; j++) {
+      const auto& box = ineqConstraints->stateBoxConstraints[k];
+      const int i = box.index[j];
+      const bool hasLower = std::isfinite(box.lowerBound[j]);
+      const bool hasUpper = std::isfinite(box.upperBound[j]);
+      const scalar_t w = weight(nbu + j, hasLower, hasUpper);
+      stageCost.dfdxx(i, i) += w;
+      stageCost.dfdx[i] -= multiplier(nbu + j, hasLower, hasUpper) + w * x[i];
+    }
+
+    // General constraints: equality constraints (two-sided) stacked on top of the inequality constraints (lower bound only)
+    if (ng > 0) {
+      const auto* eqConstr = (constraints != nullptr && (*constraints)[k].f.size() > 0) ? &(*constraints)[k] : nullptr;
+      const auto* ineqConstr = (ineqConstraints != nullptr && !ineqConstraints->generalConstraints.empty() &&
+                                ineqConstraints->generalConstraints[k].f.size() > 0)
+                                   ? &ineqConstraints->generalConstraints[k]
+                                   : nullptr;
+      const int numEq = (eqConstr != nullptr) ? eqConstr->f.size() : 0;
+      matrix_t C(ng, x.size());
+      matrix_t D(ng, u.size());
+      if (eqConstr != nullptr) {
+        C.topRows(numEq) = eqConstr->dfdx;
+        if (u.size() > 0) {
+          D.topRows(numEq) = eqConstr->dfdu;
+        }
+      }
+      if (ineqConstr != nullptr) {
+        C.bottomRows(ng - numEq) = ineqConstr->dfdx;
+        if (u.size() > 0) {
+          D.bottomRows(ng - numEq) = ineqConstr->dfdu;
+        }
+      }
+
+      vector_t w(ng);
+      vector_t v(ng);  // lam + W * g
+      for (int j = 0; j < ng; j++) {
+        w[j] = weight(nb + j, true, j < numEq);
+        v[j] = multiplier(nb + j, true, j < numEq);
+      }
+      v.noalias() += w.asDiagonal() * (C * x);
+      if (u.size() > 0) {
+        v.noalias() += w.asDiagonal() * (D * u);
+      }
+
+      const matrix_t WC = w.asDiagonal() * C;
+      stageCost.dfdxx.noalias() += C.transpose() * WC;
+      stageCost.dfdx.noalias() -= C.transpose() * v;
+      if (u.size() > 0) {
+        stageCost.dfduu.noalias() += D.transpose() * w.asDiagonal() * D;
+        stageCost.dfdux.noalias() += D.transpose() * WC;
+        stageCost.dfdu.noalias() -= D.transpose() * v;
+      }
+    }
+  }
+
   matrix_array_t getRiccatiFeedback(const VectorFunctionLinearApproximation& dynamics0, const ScalarFunctionQuadraticApproximation& cost0) {
+    if (usePartialCondensing()) {
+      updateExpandedRiccati();
+      return riccatiFeedback_;
+    }
+
     const int N = ocpSize_.numStages;
     matrix_array_t RiccatiFeedback(N);
 
@@ -367,6 +884,11 @@ class HpipmInterface::Impl {
 
   vector_array_t getRiccatiFeedforward(const VectorFunctionLinearApproximation& dynamics0,
                                        const ScalarFunctionQuadraticApproximation& cost0) {
+    if (usePartialCondensing()) {
+      updateExpandedRiccati();
+      return riccatiFeedforward_;
+    }
+
     const int N = ocpSize_.numStages;
     vector_array_t RiccatiFeedforward(N);
 
@@ -399,6 +921,11 @@ class HpipmInterface::Impl {
 
   std::vector<ScalarFunctionQuadraticApproximation> getRiccatiCostToGo(const VectorFunctionLinearApproximation& dynamics0,
                                                                        const ScalarFunctionQuadraticApproximation& cost0) {
+    if (usePartialCondensing()) {
+      updateExpandedRiccati();
+      return riccatiCostToGo_;
+    }
+
     /*
      * Note on notation: HPIPM uses P, p for the cost-to-go, where we use Sm, sv
      */
@@ -503,8 +1030,44 @@ class HpipmInterface::Impl {
   }
 
  private:
+  /** Dual iterate and slacks of a single node */
+  struct Iterate {
+    vector_t pi;   // Multipliers of the dynamics to the next node
+    vector_t lam;  // Multipliers of the inequality constraints
+    vector_t t;    // Slacks of the inequality constraints
+  };
+
+  /** Data passed to HPIPM. It is kept across solves such that solving a QP of unchanged size does not allocate. */
+  struct QpData {
+    // Dynamics
+    std::vector<scalar_t*> AA, BB, bb;
+    vector_t b0;
+    // Costs
+    std::vector<scalar_t*> QQ, RR, SS, qq, rr;
+    vector_t r0;
+    // General constraints
+    std::vector<scalar_t*> CC, DD, llg, uug;
+    vector_array_t boundData;
+    vector_array_t upperBoundData;
+    matrix_array_t stackedC;
+    matrix_array_t stackedD;
+    vector_array_t generalLowerMask;
+    vector_array_t generalUpperMask;
+    // Box constraints
+    std::vector<int*> hidxbx, hidxbu;
+    std::vector<scalar_t*> hlbx, hubx, hlbu, hubu;
+    std::vector<BoxConstraintsData> stateBoxData;
+    std::vector<BoxConstraintsData> inputBoxData;
+  };
+
   Settings settings_;
   OcpSize ocpSize_;
+  OcpSize requestedOcpSize_;  // Size as passed to initializeMemory, before removing the initial state
+  QpData qpData_;
+
+  // Warm start
+  std::vector<Iterate> previousIterate_;
+  std::vector<int> warmStartNodes_;  // Node of the previous iterate to initialize each node with. Node by node if empty.
 
   MemoryBlock dimMem_;
   d_ocp_qp_dim dim_;
@@ -520,22 +1083,70 @@ class HpipmInterface::Impl {
 
   MemoryBlock ipmMem_;
   d_ocp_qp_ipm_ws workspace_;
+
+  // Partial condensing
+  std::vector<int> blockSize_;  // Number of stages per block
+
+  MemoryBlock partDimMem_;
+  d_ocp_qp_dim partDim_;
+
+  MemoryBlock partQpMem_;
+  d_ocp_qp partQp_;
+
+  MemoryBlock partQpSolMem_;
+  d_ocp_qp_sol partQpSol_;
+
+  MemoryBlock partCondArgMem_;
+  d_part_cond_qp_arg partCondArg_;
+
+  MemoryBlock partCondMem_;
+  d_part_cond_qp_ws partCondWorkspace_;
+
+  // QP data of the last partially condensed solve, from which the Riccati quantities of the original QP are computed on request
+  struct ExpandedRiccatiData {
+    vector_t x0;
+    const std::vector<VectorFunctionLinearApproximation>* dynamics = nullptr;
+    const std::vector<ScalarFunctionQuadraticApproximation>* cost = nullptr;
+    const std::vector<VectorFunctionLinearApproximation>* constraints = nullptr;
+    const InequalityConstraints* ineqConstraints = nullptr;
+    bool isUpToDate = false;
+  } expandedRiccatiData_;
+
+  // Riccati quantities of the original QP, only computed with partial condensing
+  std::vector<ScalarFunctionQuadraticApproximation> riccatiCostToGo_;
+  matrix_array_t riccatiFeedback_;
+  vector_array_t riccatiFeedforward_;
 };
 
-HpipmInterface::HpipmInterface(OcpSize ocpSize, const Settings& settings)
-    : pImpl_(new HpipmInterface::Impl(std::move(ocpSize), settings)) {}
+HpipmInterface::HpipmInterface(OcpSize ocpSize, const Settings& settings) : pImpl_(new HpipmInterface::Impl(ocpSize, settings)) {}
 
 HpipmInterface::~HpipmInterface() = default;
 
-void HpipmInterface::resize(OcpSize ocpSize) {
-  pImpl_->initializeMemory(std::move(ocpSize));
+void HpipmInterface::resize(const OcpSize& ocpSize) {
+  pImpl_->initializeMemory(ocpSize);
 }
 
 hpipm_status HpipmInterface::solve(const vector_t& x0, std::vector<VectorFunctionLinearApproximation>& dynamics,
                                    std::vector<ScalarFunctionQuadraticApproximation>& cost,
                                    std::vector<VectorFunctionLinearApproximation>* constraints, vector_array_t& stateTrajectory,
                                    vector_array_t& inputTrajectory, bool verbose) {
-  return pImpl_->solve(x0, dynamics, cost, constraints, stateTrajectory, inputTrajectory, verbose);
+  return pImpl_->solve(x0, dynamics, cost, constraints, nullptr, stateTrajectory, inputTrajectory, verbose);
+}
+
+hpipm_status HpipmInterface::solve(const vector_t& x0, std::vector<VectorFunctionLinearApproximation>& dynamics,
+                                   std::vector<ScalarFunctionQuadraticApproximation>& cost,
+                                   std::vector<VectorFunctionLinearApproximation>* constraints,
+                                   const InequalityConstraints* ineqConstraints, vector_array_t& stateTrajectory,
+                                   vector_array_t& inputTrajectory, bool verbose) {
+  return pImpl_->solve(x0, dynamics, cost, constraints, ineqConstraints, stateTrajectory, inputTrajectory, verbose);
+}
+
+void HpipmInterface::shiftWarmStart(const scalar_array_t& previousTime, const scalar_array_t& time) {
+  pImpl_->shiftWarmStart(previousTime, time);
+}
+
+int HpipmInterface::getNumIterations() const {
+  return pImpl_->getNumIterations();
 }
 
 std::vector<ScalarFunctionQuadraticApproximation> HpipmInterface::getRiccatiCostToGo(const VectorFunctionLinearApproximation& dynamics0,
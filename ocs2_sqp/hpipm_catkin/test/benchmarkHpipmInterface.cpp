@@ -0,0 +1,192 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+
+#include <iomanip>
+#include <iostream>
+#include <string>
+
+#include "hpipm_catkin/HpipmInterface.h"
+
+#include <ocs2_core/misc/Benchmark.h>
+#include <ocs2_core/test/testTools.h>
+#include <ocs2_core/thread_support/ThreadPool.h>
+#include <ocs2_oc/multiple_shooting/ParallelRiccatiSolver.h>
+#include <ocs2_oc/test/testProblemsGeneration.h>
+
+namespace {
+/** Random problem with stable dynamics, such that the condensed matrices stay well conditioned for long horizons */
+void getRandomProblem(int nx, int nu, int N, std::vector<ocs2::VectorFunctionLinearApproximation>& system,
+                      std::vector<ocs2::ScalarFunctionQuadraticApproximation>& cost) {
+  const ocs2::scalar_t dt = 0.01;
+  system.clear();
+  cost.clear();
+  for (int k = 0; k < N; k++) {
+    system.emplace_back(ocs2::getRandomDynamics(nx, nu));
+    system.back().dfdx = ocs2::matrix_t::Identity(nx, nx) + dt * system.back().dfdx;
+    system.back().dfdu *= dt;
+    system.back().f *= dt;
+    cost.emplace_back(ocs2::getRandomCost(nx, nu));
+    cost.back().dfduu += ocs2::matrix_t::Identity(nu, nu);
+  }
+  cost.emplace_back(ocs2::getRandomCost(nx, 0));
+}
+
+/** Prints an error and returns false if the solutions differ */
+bool checkEqual(const std::vector<ocs2::vector_t>& reference, const std::vector<ocs2::vector_t>& solution, const std::string& name) {
+  if (!ocs2::isEqual(reference, solution, 1e-6)) {
+    std::cerr << "\n[benchmarkHpipmInterface] " << name << " differs from the reference solution.\n";
+    return false;
+  }
+  return true;
+}
+
+/** Solve time of HPIPM over horizon length and partial condensing block size */
+bool benchmarkPartialCondensing() {
+  const int nx = 12;
+  const int nu = 4;
+  const int numRepetitions = 10;
+  const std::vector<int> horizons{50, 100, 200};
+  const std::vector<int> blockSizes{1, 2, 5, 10, 20};
+
+  std::cout << "Partial condensing: nx = " << nx << ", nu = " << nu << ", average solve time [ms]\n";
+  std::cout << std::setw(10) << "N \\ block";
+  for (const auto blockSize : blockSizes) {
+    std::cout << std::setw(10) << blockSize;
+  }
+  std::cout << "\n";
+
+  for (const auto N : horizons) {
+    const ocs2::vector_t x0 = ocs2::vector_t::Random(nx);
+    std::vector<ocs2::VectorFunctionLinearApproximation> system;
+    std::vector<ocs2::ScalarFunctionQuadraticApproximation> cost;
+    getRandomProblem(nx, nu, N, system, cost);
+    const ocs2::OcpSize ocpSize(N, nx, nu);
+
+    std::cout << std::setw(10) << N;
+    std::vector<ocs2::vector_t> xSolReference, uSolReference;
+    for (const auto blockSize : blockSizes) {
+      ocs2::HpipmInterface::Settings settings;
+      settings.partialCondensingBlockSize = blockSize;
+      ocs2::HpipmInterface hpipmInterface(ocpSize, settings);
+
+      std::vector<ocs2::vector_t> xSol, uSol;
+      ocs2::benchmark::RepeatedTimer timer;
+      for (int i = 0; i < numRepetitions; i++) {
+        timer.startTimer();
+        const auto status = hpipmInterface.solve(x0, system, cost, nullptr, xSol, uSol, false);
+        timer.endTimer();
+        if (status != hpipm_status::SUCCESS) {
+          std::cerr << "\n[benchmarkHpipmInterface] HPIPM failed with block size " << blockSize << "\n";
+          return false;
+        }
+      }
+      std::cout << std::setw(10) << std::setprecision(3) << timer.getAverageInMilliseconds();
+
+      // All block sizes solve the same problem
+      if (xSolReference.empty()) {
+        xSolReference = xSol;
+        uSolReference = uSol;
+      } else if (!checkEqual(xSolReference, xSol, "State trajectory") || !checkEqual(uSolReference, uSol, "Input trajectory")) {
+        return false;
+      }
+    }
+    std::cout << "\n";
+  }
+  return true;
+}
+
+/** Solve time of HPIPM and of the parallel Riccati solver over horizon length and number of threads */
+bool benchmarkParallelRiccati() {
+  const int nx = 12;
+  const int nu = 4;
+  const int numRepetitions = 10;
+  const std::vector<int> horizons{50, 100, 200, 400};
+  const std::vector<size_t> numThreads{1, 2, 4, 8, 16};
+
+  std::cout << "Parallel Riccati: nx = " << nx << ", nu = " << nu << ", average solve time [ms]\n";
+  std::cout << std::setw(10) << "N" << std::setw(10) << "HPIPM";
+  for (const auto n : numThreads) {
+    std::cout << std::setw(10) << (std::to_string(n) + " thr");
+  }
+  std::cout << "\n";
+
+  for (const auto N : horizons) {
+    const ocs2::vector_t x0 = ocs2::vector_t::Random(nx);
+    std::vector<ocs2::VectorFunctionLinearApproximation> system;
+    std::vector<ocs2::ScalarFunctionQuadraticApproximation> cost;
+    getRandomProblem(nx, nu, N, system, cost);
+
+    // HPIPM reference
+    ocs2::HpipmInterface hpipmInterface(ocs2::OcpSize(N, nx, nu));
+    std::vector<ocs2::vector_t> xSolReference, uSolReference;
+    ocs2::benchmark::RepeatedTimer hpipmTimer;
+    for (int i = 0; i < numRepetitions; i++) {
+      hpipmTimer.startTimer();
+      const auto status = hpipmInterface.solve(x0, system, cost, nullptr, xSolReference, uSolReference, false);
+      hpipmTimer.endTimer();
+      if (status != hpipm_status::SUCCESS) {
+        std::cerr << "\n[benchmarkHpipmInterface] HPIPM failed\n";
+        return false;
+      }
+    }
+    const auto feedbackReference = hpipmInterface.getRiccatiFeedback(system[0], cost[0]);
+    std::cout << std::setw(10) << N << std::setw(10) << std::setprecision(3) << hpipmTimer.getAverageInMilliseconds();
+
+    for (const auto n : numThreads) {
+      ocs2::ThreadPool threadPool(n - 1);
+      ocs2::ParallelRiccatiSolver solver;
+      std::vector<ocs2::vector_t> xSol, uSol;
+      ocs2::benchmark::RepeatedTimer timer;
+      for (int i = 0; i < numRepetitions; i++) {
+        timer.startTimer();
+        solver.solve(threadPool, x0, system, cost, xSol, uSol);
+        timer.endTimer();
+      }
+      std::cout << std::setw(10) << std::setprecision(3) << timer.getAverageInMilliseconds();
+
+      if (!checkEqual(xSolReference, xSol, "State trajectory") || !checkEqual(uSolReference, uSol, "Input trajectory")) {
+        return false;
+      }
+      if (!ocs2::isEqual(feedbackReference, solver.getRiccatiFeedback(), 1e-6)) {
+        std::cerr << "\n[benchmarkHpipmInterface] Feedback differs from the reference solution.\n";
+        return false;
+      }
+    }
+    std::cout << "\n";
+  }
+  return true;
+}
+}  // namespace
+
+int main() {
+  const bool partialCondensingOk = benchmarkPartialCondensing();
+  const bool parallelRiccatiOk = benchmarkParallelRiccati();
+  return (partialCondensingOk && parallelRiccatiOk) ? 0 : 1;
+}
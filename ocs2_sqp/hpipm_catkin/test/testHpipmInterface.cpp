@@ -29,6 +29,8 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include <gtest/gtest.h>
 
+#include <limits>
+
 #include "hpipm_catkin/HpipmInterface.h"
 
 #include <ocs2_core/test/testTools.h>
@@ -205,6 +207,184 @@ TEST(test_hpiphm_interface, with_constraints) {
   }
 }
 
+TEST(test_hpiphm_interface, with_inequality_constraints) {
+  // Initialize without size
+  ocs2::HpipmInterface hpipmInterface;
+
+  int nx = 3;
+  int nu = 2;
+  int nc = 1;
+  int N = 5;
+
+  // Problem setup
+  ocs2::vector_t x0 = ocs2::vector_t::Random(nx);
+  std::vector<ocs2::VectorFunctionLinearApproximation> system;
+  std::vector<ocs2::ScalarFunctionQuadraticApproximation> cost;
+  for (int k = 0; k < N; k++) {
+    system.emplace_back(ocs2::getRandomDynamics(nx, nu));
+    cost.emplace_back(ocs2::getRandomCost(nx, nu));
+  }
+  cost.emplace_back(ocs2::getRandomCost(nx, 0));
+
+  // Unconstrained solution
+  std::vector<ocs2::vector_t> xSolUnconstrained;
+  std::vector<ocs2::vector_t> uSolUnconstrained;
+  hpipmInterface.resize(ocs2::extractSizesFromProblem(system, cost, nullptr));
+  hpipmInterface.solve(x0, system, cost, nullptr, xSolUnconstrained, uSolUnconstrained, true);
+
+  // Input box constraints that cut the unconstrained solution, the first input only has a lower bound
+  ocs2::scalar_t uMax = 0.0;
+  for (const auto& u : uSolUnconstrained) {
+    uMax = std::max(uMax, u.lpNorm<Eigen::Infinity>());
+  }
+  const ocs2::scalar_t uBound = 0.5 * uMax;
+  ocs2::HpipmInterface::InequalityConstraints ineqConstraints;
+  ineqConstraints.inputBoxConstraints.resize(N);
+  for (auto& box : ineqConstraints.inputBoxConstraints) {
+    box.index = {0, 1};
+    box.lowerBound = ocs2::vector_t::Constant(nu, -uBound);
+    box.upperBound = (ocs2::vector_t(nu) << std::numeric_limits<ocs2::scalar_t>::infinity(), uBound).finished();
+  }
+
+  // General inequality constraints C*x + D*u + e >= 0, strictly satisfied by the trajectory with zero inputs
+  ocs2::vector_t xFeasible = x0;
+  for (int k = 0; k < N; k++) {
+    ineqConstraints.generalConstraints.emplace_back(ocs2::getRandomConstraints(nx, nu, nc));
+    auto& g = ineqConstraints.generalConstraints.back();
+    g.f = ocs2::vector_t::Constant(nc, 0.1) - g.dfdx * xFeasible;
+    xFeasible = system[k].dfdx * xFeasible + system[k].f;
+  }
+  ineqConstraints.generalConstraints.emplace_back(ocs2::getRandomConstraints(nx, 0, nc));
+  auto& gN = ineqConstraints.generalConstraints.back();
+  gN.f = ocs2::vector_t::Constant(nc, 0.1) - gN.dfdx * xFeasible;
+
+  // Resize Interface
+  auto ocpSize = ocs2::extractSizesFromProblem(system, cost, nullptr, &ineqConstraints.generalConstraints);
+  std::fill(ocpSize.numInputBoxConstraints.begin(), ocpSize.numInputBoxConstraints.end() - 1, nu);
+  hpipmInterface.resize(ocpSize);
+
+  // Solve!
+  std::vector<ocs2::vector_t> xSol;
+  std::vector<ocs2::vector_t> uSol;
+  const auto status = hpipmInterface.solve(x0, system, cost, nullptr, &ineqConstraints, xSol, uSol, true);
+  ASSERT_EQ(status, hpipm_status::SUCCESS);
+
+  // Check dynamic feasibility
+  for (int k = 0; k < N; k++) {
+    ASSERT_TRUE(xSol[k + 1].isApprox(system[k].dfdx * xSol[k] + system[k].dfdu * uSol[k] + system[k].f, 1e-9));
+  }
+
+  // Check constraints
+  const ocs2::scalar_t tol = 1e-6;
+  for (int k = 0; k < N; k++) {
+    ASSERT_GT(uSol[k].minCoeff(), -uBound - tol);
+    ASSERT_LT(uSol[k](1), uBound + tol);
+    const auto& g = ineqConstraints.generalConstraints[k];
+    ASSERT_GT((g.f + g.dfdx * xSol[k] + g.dfdu * uSol[k]).minCoeff(), -tol);
+  }
+  ASSERT_GT((gN.f + gN.dfdx * xSol[N]).minCoeff(), -tol);
+}
+
+TEST(test_hpiphm_interface, warmStart) {
+  int nx = 3;
+  int nu = 2;
+  int N = 5;
+
+  // Problem setup
+  ocs2::vector_t x0 = ocs2::vector_t::Random(nx);
+  std::vector<ocs2::VectorFunctionLinearApproximation> system;
+  std::vector<ocs2::ScalarFunctionQuadraticApproximation> cost;
+  for (int k = 0; k < N; k++) {
+    system.emplace_back(ocs2::getRandomDynamics(nx, nu));
+    cost.emplace_back(ocs2::getRandomCost(nx, nu));
+    cost.back().dfdu.setConstant(10.0);  // push the inputs against their bounds
+  }
+  cost.emplace_back(ocs2::getRandomCost(nx, 0));
+
+  // Input box constraints
+  ocs2::HpipmInterface::InequalityConstraints ineqConstraints;
+  ineqConstraints.inputBoxConstraints.resize(N);
+  for (auto& box : ineqConstraints.inputBoxConstraints) {
+    box.index = {0, 1};
+    box.lowerBound = ocs2::vector_t::Constant(nu, -0.1);
+    box.upperBound = ocs2::vector_t::Constant(nu, 0.1);
+  }
+  ocs2::OcpSize ocpSize(N, nx, nu);
+  std::fill(ocpSize.numInputBoxConstraints.begin(), ocpSize.numInputBoxConstraints.end() - 1, nu);
+
+  // Solve the same problem twice, the second solve starts from the first solution if warm started.
+  auto solveTwice = [&](int warmStart, std::vector<ocs2::vector_t>& xSol, std::vector<ocs2::vector_t>& uSol) {
+    ocs2::HpipmInterface::Settings settings;
+    settings.warm_start = warmStart;
+    ocs2::HpipmInterface hpipmInterface(ocpSize, settings);
+    hpipmInterface.solve(x0, system, cost, nullptr, &ineqConstraints, xSol, uSol, false);
+    const auto status = hpipmInterface.solve(x0, system, cost, nullptr, &ineqConstraints, xSol, uSol, false);
+    EXPECT_EQ(status, hpipm_status::SUCCESS);
+    return hpipmInterface.getNumIterations();
+  };
+  std::vector<ocs2::vector_t> xSolCold, uSolCold, xSolWarm, uSolWarm;
+  const int coldIterations = solveTwice(0, xSolCold, uSolCold);
+  const int warmIterations = solveTwice(2, xSolWarm, uSolWarm);
+
+  ASSERT_LE(warmIterations, coldIterations);
+  ASSERT_TRUE(ocs2::isEqual(xSolCold, xSolWarm, 1e-6));
+  ASSERT_TRUE(ocs2::isEqual(uSolCold, uSolWarm, 1e-6));
+}
+
+TEST(test_hpiphm_interface, warmStartMovedLinearization) {
+  int nx = 3;
+  int nu = 2;
+  int N = 5;
+
+  // Problem setup
+  ocs2::vector_t x0 = ocs2::vector_t::Random(nx);
+  std::vector<ocs2::VectorFunctionLinearApproximation> system;
+  std::vector<ocs2::ScalarFunctionQuadraticApproximation> cost;
+  for (int k = 0; k < N; k++) {
+    system.emplace_back(ocs2::getRandomDynamics(nx, nu));
+    cost.emplace_back(ocs2::getRandomCost(nx, nu));
+  }
+  cost.emplace_back(ocs2::getRandomCost(nx, 0));
+
+  // Input box constraints
+  ocs2::HpipmInterface::InequalityConstraints ineqConstraints;
+  ineqConstraints.inputBoxConstraints.resize(N);
+  for (auto& box : ineqConstraints.inputBoxConstraints) {
+    box.index = {0, 1};
+    box.lowerBound = ocs2::vector_t::Constant(nu, -0.1);
+    box.upperBound = ocs2::vector_t::Constant(nu, 0.1);
+  }
+  ocs2::OcpSize ocpSize(N, nx, nu);
+  std::fill(ocpSize.numInputBoxConstraints.begin(), ocpSize.numInputBoxConstraints.end() - 1, nu);
+
+  ocs2::HpipmInterface::Settings settings;
+  settings.warm_start = 2;
+  ocs2::HpipmInterface warmInterface(ocpSize, settings);
+  std::vector<ocs2::vector_t> xSolWarm, uSolWarm;
+  ASSERT_EQ(warmInterface.solve(x0, system, cost, nullptr, &ineqConstraints, xSolWarm, uSolWarm, false), hpipm_status::SUCCESS);
+
+  // Move the linearization point: the constant terms of the QP in delta coordinates change
+  x0 = ocs2::vector_t::Random(nx);
+  for (int k = 0; k < N; k++) {
+    system[k].f += 0.1 * ocs2::vector_t::Random(nx);
+    cost[k].dfdx += ocs2::vector_t::Random(nx);
+    cost[k].dfdu += ocs2::vector_t::Random(nu);
+    ineqConstraints.inputBoxConstraints[k].lowerBound.array() -= 0.05;
+    ineqConstraints.inputBoxConstraints[k].upperBound.array() -= 0.05;
+  }
+  cost[N].dfdx += ocs2::vector_t::Random(nx);
+
+  // The warm started solve converges to the solution of a cold solve
+  ASSERT_EQ(warmInterface.solve(x0, system, cost, nullptr, &ineqConstraints, xSolWarm, uSolWarm, false), hpipm_status::SUCCESS);
+  ocs2::HpipmInterface::Settings coldSettings;
+  ocs2::HpipmInterface coldInterface(ocpSize, coldSettings);
+  std::vector<ocs2::vector_t> xSolCold, uSolCold;
+  ASSERT_EQ(coldInterface.solve(x0, system, cost, nullptr, &ineqConstraints, xSolCold, uSolCold, false), hpipm_status::SUCCESS);
+
+  ASSERT_TRUE(ocs2::isEqual(xSolCold, xSolWarm, 1e-6));
+  ASSERT_TRUE(ocs2::isEqual(uSolCold, uSolWarm, 1e-6));
+}
+
 TEST(test_hpiphm_interface, noInputs) {
   // Initialize without size
   ocs2::HpipmInterface hpipmInterface;
@@ -338,3 +518,110 @@ TEST(test_hpiphm_interface, retrieveRiccati) {
     ASSERT_TRUE(uSol[k].isApprox(KSol[k] * xSol[k] + kSol[k]));
   }
 }
+
+TEST(test_hpiphm_interface, partialCondensing) {
+  int nx = 3;
+  int nu = 2;
+  int N = 10;
+
+  // Problem setup
+  ocs2::vector_t x0 = ocs2::vector_t::Random(nx);
+  std::vector<ocs2::VectorFunctionLinearApproximation> system;
+  std::vector<ocs2::ScalarFunctionQuadraticApproximation> cost;
+  for (int k = 0; k < N; k++) {
+    system.emplace_back(ocs2::getRandomDynamics(nx, nu));
+    cost.emplace_back(ocs2::getRandomCost(nx, nu));
+  }
+  cost.emplace_back(ocs2::getRandomCost(nx, 0));
+
+  // Solve without condensing
+  ocs2::OcpSize ocpSize(N, nx, nu);
+  ocs2::HpipmInterface hpipmInterface(ocpSize);
+  std::vector<ocs2::vector_t> xSol, uSol;
+  ASSERT_EQ(hpipmInterface.solve(x0, system, cost, nullptr, xSol, uSol, false), hpipm_status::SUCCESS);
+  const auto KSol = hpipmInterface.getRiccatiFeedback(system[0], cost[0]);
+  const auto kSol = hpipmInterface.getRiccatiFeedforward(system[0], cost[0]);
+  const auto costToGo = hpipmInterface.getRiccatiCostToGo(system[0], cost[0]);
+
+  // Solve with blocks that do not divide the horizon
+  ocs2::HpipmInterface::Settings settings;
+  settings.partialCondensingBlockSize = 3;
+  ocs2::HpipmInterface condensedInterface(ocpSize, settings);
+  std::vector<ocs2::vector_t> xSolCondensed, uSolCondensed;
+  ASSERT_EQ(condensedInterface.solve(x0, system, cost, nullptr, xSolCondensed, uSolCondensed, false), hpipm_status::SUCCESS);
+  const auto KSolCondensed = condensedInterface.getRiccatiFeedback(system[0], cost[0]);
+  const auto kSolCondensed = condensedInterface.getRiccatiFeedforward(system[0], cost[0]);
+  const auto costToGoCondensed = condensedInterface.getRiccatiCostToGo(system[0], cost[0]);
+
+  ASSERT_TRUE(ocs2::isEqual(xSol, xSolCondensed, 1e-9));
+  ASSERT_TRUE(ocs2::isEqual(uSol, uSolCondensed, 1e-9));
+  ASSERT_TRUE(ocs2::isEqual(KSol, KSolCondensed, 1e-9));
+  ASSERT_TRUE(ocs2::isEqual(kSol, kSolCondensed, 1e-9));
+  for (int k = 0; k < (N + 1); k++) {
+    ASSERT_TRUE(costToGo[k].dfdxx.isApprox(costToGoCondensed[k].dfdxx, 1e-9));
+    ASSERT_TRUE(costToGo[k].dfdx.isApprox(costToGoCondensed[k].dfdx, 1e-9));
+  }
+
+  // The condensed iterate cannot be shifted node by node
+  const ocs2::scalar_array_t time(N + 1, 0.0);
+  ASSERT_ANY_THROW(condensedInterface.shiftWarmStart(time, time));
+}
+
+TEST(test_hpiphm_interface, partialCondensing_with_inequality_constraints) {
+  int nx = 3;
+  int nu = 2;
+  int nc = 2;
+  int N = 10;
+
+  // Problem setup
+  ocs2::vector_t x0 = ocs2::vector_t::Random(nx);
+  std::vector<ocs2::VectorFunctionLinearApproximation> system;
+  std::vector<ocs2::ScalarFunctionQuadraticApproximation> cost;
+  for (int k = 0; k < N; k++) {
+    system.emplace_back(ocs2::getRandomDynamics(nx, nu));
+    cost.emplace_back(ocs2::getRandomCost(nx, nu));
+    cost.back().dfdu.setConstant(10.0);  // push the inputs against their bounds
+  }
+  cost.emplace_back(ocs2::getRandomCost(nx, 0));
+
+  // Input box constraints and general inequality constraints that are satisfied at u = 0
+  ocs2::HpipmInterface::InequalityConstraints ineqConstraints;
+  ineqConstraints.inputBoxConstraints.resize(N);
+  for (auto& box : ineqConstraints.inputBoxConstraints) {
+    box.index = {0, 1};
+    box.lowerBound = ocs2::vector_t::Constant(nu, -0.1);
+    box.upperBound = ocs2::vector_t::Constant(nu, std::numeric_limits<ocs2::scalar_t>::infinity());
+  }
+  for (int k = 0; k < N; k++) {
+    ineqConstraints.generalConstraints.emplace_back(ocs2::getRandomConstraints(nx, nu, nc));
+    ineqConstraints.generalConstraints.back().dfdx.setZero();
+    ineqConstraints.generalConstraints.back().f.setConstant(1.0);
+  }
+  ineqConstraints.generalConstraints.emplace_back();
+
+  ocs2::OcpSize ocpSize(N, nx, nu);
+  std::fill(ocpSize.numInputBoxConstraints.begin(), ocpSize.numInputBoxConstraints.end() - 1, nu);
+  std::fill(ocpSize.numIneqConstraints.begin(), ocpSize.numIneqConstraints.end() - 1, nc);
+
+  // Solve with and without condensing
+  ocs2::HpipmInterface hpipmInterface(ocpSize);
+  std::vector<ocs2::vector_t> xSol, uSol;
+  ASSERT_EQ(hpipmInterface.solve(x0, system, cost, nullptr, &ineqConstraints, xSol, uSol, false), hpipm_status::SUCCESS);
+
+  ocs2::HpipmInterface::Settings settings;
+  settings.partialCondensingBlockSize = 4;
+  ocs2::HpipmInterface condensedInterface(ocpSize, settings);
+  std::vector<ocs2::vector_t> xSolCondensed, uSolCondensed;
+  ASSERT_EQ(condensedInterface.solve(x0, system, cost, nullptr, &ineqConstraints, xSolCondensed, uSolCondensed, false),
+            hpipm_status::SUCCESS);
+
+  ASSERT_TRUE(ocs2::isEqual(xSol, xSolCondensed, 1e-6));
+  ASSERT_TRUE(ocs2::isEqual(uSol, uSolCondensed, 1e-6));
+
+  // The expanded Riccati feedback reproduces the solution
+  const auto KSol = condensedInterface.getRiccatiFeedback(system[0], cost[0]);
+  const auto kSol = condensedInterface.getRiccatiFeedforward(system[0], cost[0]);
+  for (int k = 0; k < N; k++) {
+    ASSERT_TRUE(uSolCondensed[k].isApprox(KSol[k] * xSolCondensed[k] + kSol[k], 1e-6));
+  }
+}
@@ -0,0 +1,94 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "hpipm_catkin/HpipmInterface.h"
+
+#include <ocs2_core/test/AllocationCounter.h>
+#include <ocs2_oc/test/testProblemsGeneration.h>
+
+TEST(test_hpipm_interface_allocations, solve_after_warm_up) {
+  const int nx = 3;
+  const int nu = 2;
+  const int nc = 1;
+  const int N = 10;
+
+  // Problem setup with equality constraints, general inequality constraints, and input box constraints
+  ocs2::vector_t x0 = ocs2::vector_t::Random(nx);
+  std::vector<ocs2::VectorFunctionLinearApproximation> system;
+  std::vector<ocs2::ScalarFunctionQuadraticApproximation> cost;
+  std::vector<ocs2::VectorFunctionLinearApproximation> constraints;
+  ocs2::HpipmInterface::InequalityConstraints ineqConstraints;
+  ineqConstraints.inputBoxConstraints.resize(N);
+  for (int k = 0; k < N; k++) {
+    system.emplace_back(ocs2::getRandomDynamics(nx, nu));
+    cost.emplace_back(ocs2::getRandomCost(nx, nu));
+    constraints.emplace_back(ocs2::getRandomConstraints(nx, nu, nc));
+    ineqConstraints.generalConstraints.emplace_back(ocs2::getRandomConstraints(nx, nu, nc));
+    ineqConstraints.generalConstraints.back().f.setConstant(1.0);
+    auto& box = ineqConstraints.inputBoxConstraints[k];
+    box.index = {0, 1};
+    box.lowerBound = ocs2::vector_t::Constant(nu, -10.0);
+    box.upperBound = ocs2::vector_t::Constant(nu, 10.0);
+  }
+  cost.emplace_back(ocs2::getRandomCost(nx, 0));
+  constraints.emplace_back(ocs2::VectorFunctionLinearApproximation());
+  ineqConstraints.generalConstraints.emplace_back(ocs2::getRandomConstraints(nx, 0, nc));
+  ineqConstraints.generalConstraints.back().f.setConstant(1.0);
+
+  auto ocpSize = ocs2::extractSizesFromProblem(system, cost, &constraints, &ineqConstraints.generalConstraints);
+  std::fill(ocpSize.numInputBoxConstraints.begin(), ocpSize.numInputBoxConstraints.end() - 1, nu);
+  ocs2::scalar_array_t time(N + 1);
+  for (int k = 0; k <= N; k++) {
+    time[k] = 0.1 * k;
+  }
+
+  ocs2::HpipmInterface::Settings settings;
+  settings.warm_start = 1;
+  ocs2::HpipmInterface hpipmInterface(ocpSize, settings);
+
+  // Warm-up: the first warm started solve sizes the memory
+  std::vector<ocs2::vector_t> xSol;
+  std::vector<ocs2::vector_t> uSol;
+  ASSERT_EQ(hpipmInterface.solve(x0, system, cost, &constraints, &ineqConstraints, xSol, uSol, false), hpipm_status::SUCCESS);
+  hpipmInterface.shiftWarmStart(time, time);
+  ASSERT_EQ(hpipmInterface.solve(x0, system, cost, &constraints, &ineqConstraints, xSol, uSol, false), hpipm_status::SUCCESS);
+
+  // Following solves of a problem with the same size reuse the memory
+  for (int i = 0; i < 3; i++) {
+    x0.setRandom();
+    const size_t allocationsBefore = ocs2::getAllocationCount();
+    hpipmInterface.shiftWarmStart(time, time);
+    const auto status = hpipmInterface.solve(x0, system, cost, &constraints, &ineqConstraints, xSol, uSol, false);
+    const size_t numAllocations = ocs2::getAllocationCount() - allocationsBefore;
+    ASSERT_EQ(status, hpipm_status::SUCCESS);
+    ASSERT_EQ(numAllocations, 0);
+  }
+}
@@ -54,6 +54,13 @@ struct LogEntry {
   scalar_t solveQpTime = 0.0;
   scalar_t linesearchTime = 0.0;
 
+  // Incremental relinearization
+  size_t numLinearizedNodes = 0;  // intermediate nodes whose derivatives were computed
+  size_t numReusedNodes = 0;      // intermediate nodes whose derivatives were reused from a previous linearization
+
+  // QP solver
+  int qpIterations = 0;  // number of HPIPM iterations
+
   // Line search
   PerformanceIndex baselinePerformanceIndex;  // before taking the step
   scalar_t totalConstraintViolationBaseline;  // constraint metric used in the line search
@@ -65,6 +65,8 @@ class SqpMpc final : public MPC_BASE {
     solverPtr_->run(initTime, initState, finalTime);
   }
 
+  void prepareController(scalar_t initTime, scalar_t finalTime) override { solverPtr_->prepareRealTimeIteration(initTime, finalTime); }
+
  private:
   std::unique_ptr<SqpSolver> solverPtr_;
 };
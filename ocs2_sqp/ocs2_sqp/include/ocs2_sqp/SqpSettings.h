@@ -44,8 +44,9 @@ struct Settings {
   scalar_t costTol = 1e-4;   // Termination condition : (cost{i+1} - (cost{i}) < costTol AND constraints{i+1} < g_min
 
   // Linesearch - step size rules
-  scalar_t alpha_decay = 0.5;  // multiply the step size by this factor every time a linesearch step is rejected.
-  scalar_t alpha_min = 1e-4;   // terminate linesearch if the attempted step size is below this threshold
+  scalar_t alpha_decay = 0.5;      // multiply the step size by this factor every time a linesearch step is rejected.
+  scalar_t alpha_min = 1e-4;       // terminate linesearch if the attempted step size is below this threshold
+  size_t linesearchBatchSize = 1;  // number of step sizes of the backtracking sequence that are evaluated concurrently.
 
   // Linesearch - step acceptance criteria with c = costs, g = the norm of constraint violation, and w = [x; u]
   scalar_t g_max = 1e6;          // (1): IF g{i+1} > g_max REQUIRE g{i+1} < (1-gamma_c) * g{i}
@@ -53,6 +54,10 @@ struct Settings {
   scalar_t armijoFactor = 1e-4;  // Armijo condition: c{i+1} < c{i} + armijoFactor * dc/dw'{i} * delta_w
   scalar_t gamma_c = 1e-6;       // (3): ELSE REQUIRE c{i+1} < (c{i} - gamma_c * g{i}) OR g{i+1} < (1-gamma_c) * g{i}
 
+  // Real-time iteration (RTI): after the first solve, every call takes a single full SQP step. The linearization is done in a preparation
+  // phase before the next observation arrives, such that the feedback phase only solves the QP for the new initial state.
+  bool useRealTimeIteration = false;
+
   // controller type
   bool useFeedbackPolicy = true;     // true to use feedback, false to use feedforward
   bool createValueFunction = false;  // true to store the value function, false to ignore it
@@ -60,10 +65,22 @@ struct Settings {
   // QP subproblem solver settings
   hpipm_interface::Settings hpipmSettings = hpipm_interface::Settings();
 
+  // Solve the QP subproblem with a parallel-in-time Riccati recursion on the solver threads instead of HPIPM. The QP may not have
+  // constraints, i.e., state-input equality constraints need to be projected and hard inequality constraints are not supported.
+  bool useParallelRiccati = false;
+
   // Discretization method
-  scalar_t dt = 0.01;  // user-defined time discretization
+  scalar_t dt = 0.01;             // user-defined time discretization, the step at the start of the horizon and after events
+  scalar_t dtGrowthFactor = 1.0;  // ratio between consecutive steps (>= 1). Use 1.0 for a uniform discretization
+  scalar_t dtMax = 0.1;           // the steps do not grow beyond this value
   SensitivityIntegratorType integratorType = SensitivityIntegratorType::RK2;
 
+  // Incremental relinearization: an intermediate node keeps the derivatives of its last linearization if its time is unchanged, its state
+  // and input moved less than relinearizationTolerance (infinity norm), and the target trajectories and the mode schedule did not change.
+  // Only the zeroth-order terms of such a node are re-evaluated. The problem may not depend on any other data that changes between solves.
+  bool useIncrementalRelinearization = false;
+  scalar_t relinearizationTolerance = 1e-4;
+
   // Inequality penalty relaxed barrier parameters
   scalar_t inequalityConstraintMu = 0.0;
   scalar_t inequalityConstraintDelta = 1e-6;
@@ -71,6 +88,10 @@ struct Settings {
   bool projectStateInputEqualityConstraints = true;  // Use a projection method to resolve the state-input constraint Cx+Du+e
   bool extractProjectionMultiplier = false;          // Extract the Lagrange multiplier of the projected state-input constraint Cx+Du+e
 
+  // Pass the linearized state and state-input inequality constraints to the QP as hard constraints, where they are handled by the interior
+  // point method of HPIPM. Otherwise, the inequality constraints only enter through the constraint violation in the linesearch.
+  bool useHardInequalityConstraints = false;
+
   // Printing
   bool printSolverStatus = false;      // Print HPIPM status after solving the QP subproblem
   bool printSolverStatistics = false;  // Print benchmarking of the multiple shooting method
@@ -84,6 +105,8 @@ struct Settings {
   // Threading
   size_t nThreads = 4;
   int threadPriority = 50;
+  int threadSpinDuration = 0;          // Time [us] for which idle workers poll for new work before sleeping, see ThreadPool::Settings
+  std::vector<int> threadCpuAffinity;  // CPUs to pin the workers to, empty to not pin them
 };
 
 /**
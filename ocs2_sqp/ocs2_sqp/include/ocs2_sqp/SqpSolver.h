@@ -34,7 +34,9 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #include <ocs2_core/misc/Benchmark.h>
 #include <ocs2_core/thread_support/ThreadPool.h>
 
+#include <ocs2_oc/multiple_shooting/ParallelRiccatiSolver.h>
 #include <ocs2_oc/multiple_shooting/ProjectionMultiplierCoefficients.h>
+#include <ocs2_oc/multiple_shooting/Transcription.h>
 #include <ocs2_oc/oc_data/TimeDiscretization.h>
 #include <ocs2_oc/oc_problem/OptimalControlProblem.h>
 #include <ocs2_oc/oc_solver/SolverBase.h>
@@ -71,6 +73,15 @@ class SqpSolver : public SolverBase {
 
   size_t getNumIterations() const override { return totalNumIterations_; }
 
+  /** Total number of interior point iterations that HPIPM took to solve the QP subproblems */
+  size_t getNumQpIterations() const { return totalNumQpIterations_; }
+
+  /** Total number of intermediate nodes whose derivatives were evaluated, see sqp::Settings::useIncrementalRelinearization */
+  size_t getNumLinearizedNodes() const { return totalNumLinearizedNodes_; }
+
+  /** Total number of intermediate nodes whose derivatives were reused, see sqp::Settings::useIncrementalRelinearization */
+  size_t getNumReusedNodes() const { return totalNumReusedNodes_; }
+
   const OptimalControlProblem& getOptimalControlProblem() const override { return ocpDefinitions_.front(); }
 
   const PerformanceIndex& getPerformanceIndeces() const override { return getIterationsLog().back(); };
@@ -91,6 +102,18 @@ class SqpSolver : public SolverBase {
     throw std::runtime_error("[SqpSolver] getIntermediateDualSolution() not available yet.");
   }
 
+  std::map<std::string, scalar_t> getBenchmarkingTimes() const override;
+
+  /**
+   * Preparation phase of a real-time iteration. It linearizes the problem around the current solution on the time discretization of the
+   * next call to run(), such that this call only has to solve the QP for the measured initial state (feedback phase).
+   * This method has no effect if real-time iterations are disabled or no solution is available yet.
+   *
+   * @param [in] initTime: The expected initial time of the next call to run().
+   * @param [in] finalTime: The expected final time of the next call to run().
+   */
+  void prepareRealTimeIteration(scalar_t initTime, scalar_t finalTime);
+
  private:
   void runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime) override;
 
@@ -112,6 +135,16 @@ class SqpSolver : public SolverBase {
     runImpl(initTime, initState, finalTime);
   }
 
+  /** Feedback phase of a real-time iteration: solves the prepared QP for the given initial state and takes a full step */
+  void runRealTimeIteration(scalar_t initTime, const vector_t& initState, scalar_t finalTime);
+
+  /** Sets up the QP of a real-time iteration around the previous solution */
+  void setupRealTimeIteration(scalar_t initTime, const vector_t& initState, scalar_t finalTime);
+
+  /** Determines the time discretization and initializes the state and input trajectories from the previous solution */
+  std::vector<AnnotatedTime> initializeTrajectories(scalar_t initTime, const vector_t& initState, scalar_t finalTime, vector_array_t& x,
+                                                    vector_array_t& u);
+
   /** Run a task in parallel with settings.nThreads */
   void runParallel(std::function<void(int)> taskFunction);
 
@@ -122,9 +155,20 @@ class SqpSolver : public SolverBase {
   PerformanceIndex setupQuadraticSubproblem(const std::vector<AnnotatedTime>& time, const vector_t& initState, const vector_array_t& x,
                                             const vector_array_t& u, std::vector<Metrics>& metrics);
 
-  /** Computes only the performance metrics at the current {t, x(t), u(t)} */
-  PerformanceIndex computePerformance(const std::vector<AnnotatedTime>& time, const vector_t& initState, const vector_array_t& x,
-                                      const vector_array_t& u, std::vector<Metrics>& metrics);
+  /** Returns true if the cached linearizations of the last QP may be reused. Stores the references they are computed for otherwise. */
+  bool isLinearizationCacheValid();
+
+  /** Returns the cached linearization of an intermediate node that is close enough to {t, dt, x, u} or nullptr if there is none. */
+  struct CachedLinearization;
+  CachedLinearization* findCachedLinearization(scalar_t t, scalar_t dt, const vector_t& x, const vector_t& u);
+
+  /**
+   * Computes only the performance metrics for a batch of trajectories {t, x_k(t), u_k(t)}. The nodes of all trajectories are evaluated
+   * concurrently by the workers. Outputs the performance index of each trajectory.
+   */
+  void computePerformance(const std::vector<AnnotatedTime>& time, const vector_t& initState, const std::vector<vector_array_t>& x,
+                          const std::vector<vector_array_t>& u, std::vector<std::vector<Metrics>>& metrics,
+                          std::vector<PerformanceIndex>& performance);
 
   /** Returns solution of the QP subproblem in delta coordinates: */
   struct OcpSubproblemSolution {
@@ -132,7 +176,7 @@ class SqpSolver : public SolverBase {
     vector_array_t deltaUSol;      // delta_u(t)
     scalar_t armijoDescentMetric;  // inner product of the cost gradient and decision variable step
   };
-  OcpSubproblemSolution getOCPSolution(const vector_t& delta_x0);
+  const OcpSubproblemSolution& getOCPSolution(const std::vector<AnnotatedTime>& time, const vector_t& delta_x0);
 
   /** Extract the value function based on the last solved QP */
   void extractValueFunction(const std::vector<AnnotatedTime>& time, const vector_array_t& x);
@@ -158,6 +202,8 @@ class SqpSolver : public SolverBase {
 
   // Solver interface
   HpipmInterface hpipmInterface_;
+  scalar_array_t qpTime_;  // Time of the nodes of the last solved QP, used to shift the warm start
+  ParallelRiccatiSolver parallelRiccatiSolver_;
 
   // Threading
   ThreadPool threadPool_;
@@ -175,6 +221,7 @@ class SqpSolver : public SolverBase {
   std::vector<VectorFunctionLinearApproximation> stateIneqConstraints_;
   std::vector<VectorFunctionLinearApproximation> stateInputIneqConstraints_;
   std::vector<VectorFunctionLinearApproximation> constraintsProjection_;
+  HpipmInterface::InequalityConstraints qpInequalityConstraints_;  // Only set when using hard inequality constraints
 
   // Lagrange multipliers
   std::vector<multiple_shooting::ProjectionMultiplierCoefficients> projectionMultiplierCoefficients_;
@@ -185,9 +232,63 @@ class SqpSolver : public SolverBase {
   // The ProblemMetrics associated to primalSolution_
   ProblemMetrics problemMetrics_;
 
+  // Real-time iteration: the linearization point of the QP that is set up in the preparation phase
+  struct RealTimeIterationData {
+    bool isPrepared = false;
+    scalar_t initTime = 0.0;
+    scalar_array_t eventTimes;
+    TargetTrajectories targetTrajectories;
+    std::vector<AnnotatedTime> timeDiscretization;
+    vector_array_t x;
+    vector_array_t u;
+    std::vector<Metrics> metrics;
+    PerformanceIndex baselinePerformance;
+  };
+  RealTimeIterationData realTimeIterationData_;
+
+  // Incremental relinearization: the unprojected transcription of each intermediate node of the last QP and its linearization point
+  struct CachedLinearization {
+    bool isValid = false;
+    scalar_t t = 0.0;
+    scalar_t dt = 0.0;
+    vector_t x;  // Linearization point of the derivatives
+    vector_t u;
+    vector_t xTranscription;  // Point of the zeroth-order terms and of the cost gradient of the transcription
+    vector_t uTranscription;
+    multiple_shooting::Transcription transcription;
+  };
+  struct LinearizationCache {
+    std::vector<CachedLinearization> nodes;     // Sorted by time
+    std::vector<CachedLinearization> nodesNew;  // Filled while setting up the next QP
+    TargetTrajectories targetTrajectories;
+    ModeSchedule modeSchedule;
+    size_t numLinearizedNodes = 0;  // Statistics of the last QP
+    size_t numReusedNodes = 0;
+  };
+  LinearizationCache linearizationCache_;
+
+  // Memory that is reused across iterations and MPC cycles, such that it is only allocated when the problem size changes
+  struct Workspace {
+    vector_t deltaX0;                           // Deviation of the initial state from the linearization point
+    scalar_array_t qpTime;                      // Time of the nodes of the current QP
+    OcpSubproblemSolution subproblemSolution;   // Solution of the last QP
+    OcpSize ocpSize;                            // Size of the last QP
+    std::vector<PerformanceIndex> performance;  // Performance accumulated per worker
+    // Linesearch candidates
+    scalar_array_t stepSizes;
+    std::vector<vector_array_t> xNew;
+    std::vector<vector_array_t> uNew;
+    std::vector<std::vector<Metrics>> metricsNew;
+    std::vector<PerformanceIndex> performanceNew;
+  };
+  Workspace workspace_;
+
   // Benchmarking
   size_t numProblems_{0};
   size_t totalNumIterations_{0};
+  size_t totalNumQpIterations_{0};
+  size_t totalNumLinearizedNodes_{0};
+  size_t totalNumReusedNodes_{0};
   sqp::Logger<sqp::LogEntry> logger_;
   benchmark::RepeatedTimer initializationTimer_;
   benchmark::RepeatedTimer linearQuadraticApproximationTimer_;
@@ -39,7 +39,7 @@ namespace ocs2 {
 namespace sqp {
 
 /** Different types of convergence */
-enum class Convergence { FALSE, ITERATIONS, STEPSIZE, METRICS, PRIMAL };
+enum class Convergence { FALSE, ITERATIONS, STEPSIZE, METRICS, PRIMAL, TIMEBUDGET };
 
 /** Struct to contain the result and logging data of the stepsize computation */
 struct StepInfo {
@@ -67,6 +67,8 @@ inline std::string toString(const Convergence& convergence) {
       return "Cost decrease and constraint satisfaction below tolerance";
     case Convergence::PRIMAL:
       return "Primal update below tolerance";
+    case Convergence::TIMEBUDGET:
+      return "Time budget exhausted before convergence";
     case Convergence::FALSE:
     default:
       return "Not Converged";
@@ -45,6 +45,9 @@ std::ostream& operator<<(std::ostream& stream, const LogEntry& logEntry) {
           << logEntry.linearQuadraticApproximationTime << delim
           << logEntry.solveQpTime << delim
           << logEntry.linesearchTime << delim
+          << logEntry.numLinearizedNodes << delim
+          << logEntry.numReusedNodes << delim
+          << logEntry.qpIterations << delim
           << logEntry.baselinePerformanceIndex.merit << delim
           << logEntry.baselinePerformanceIndex.dynamicsViolationSSE << delim
           << logEntry.baselinePerformanceIndex.equalityConstraintsSSE << delim
@@ -73,6 +76,9 @@ std::string logHeader() {
           << "linearQuadraticApproximationTime" << delim
           << "solveQpTime" << delim
           << "linesearchTime" << delim
+          << "numLinearizedNodes" << delim
+          << "numReusedNodes" << delim
+          << "qpIterations" << delim
           << "baselinePerformanceIndex/merit" << delim
           << "baselinePerformanceIndex/dynamicsViolationSSE" << delim
           << "baselinePerformanceIndex/equalityConstraintsSSE" << delim
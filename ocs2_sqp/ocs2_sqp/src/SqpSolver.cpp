@@ -29,12 +29,14 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_sqp/SqpSolver.h"
 
+#include <algorithm>
 #include <iomanip>
 #include <iostream>
 #include <numeric>
 
 #include <boost/filesystem.hpp>
 
+#include <ocs2_core/misc/Trace.h>
 #include <ocs2_oc/multiple_shooting/Helpers.h>
 #include <ocs2_oc/multiple_shooting/Initialization.h>
 #include <ocs2_oc/multiple_shooting/MetricsComputation.h>
@@ -51,14 +53,45 @@ sqp::Settings rectifySettings(const OptimalControlProblem& ocp, sqp::Settings&&
   if (ocp.equalityConstraintPtr->empty()) {
     settings.projectStateInputEqualityConstraints = false;
   }
+  // True does not make sense if there are no inequality constraints.
+  if (ocp.inequalityConstraintPtr->empty() && ocp.stateInequalityConstraintPtr->empty() && ocp.preJumpInequalityConstraintPtr->empty() &&
+      ocp.finalInequalityConstraintPtr->empty()) {
+    settings.useHardInequalityConstraints = false;
+  }
+  // The parallel Riccati recursion solves the QP without constraints.
+  const bool hasQpEqualityConstraints = !ocp.equalityConstraintPtr->empty() && !settings.projectStateInputEqualityConstraints;
+  if (settings.useParallelRiccati && (hasQpEqualityConstraints || settings.useHardInequalityConstraints)) {
+    throw std::runtime_error(
+        "[SqpSolver] useParallelRiccati requires projectStateInputEqualityConstraints and does not support useHardInequalityConstraints.");
+  }
   return settings;
 }
+
+/** Stacks the state and state-input inequality constraints of a node to a single set of constraints in the state and input. */
+VectorFunctionLinearApproximation stackInequalityConstraints(const VectorFunctionLinearApproximation& stateIneqConstraints,
+                                                             const VectorFunctionLinearApproximation& stateInputIneqConstraints, int nx,
+                                                             int nu) {
+  const int numStateIneq = stateIneqConstraints.f.size();
+  const int numStateInputIneq = stateInputIneqConstraints.f.size();
+  auto stacked = VectorFunctionLinearApproximation::Zero(numStateIneq + numStateInputIneq, nx, nu);
+  if (numStateIneq > 0) {
+    stacked.f.head(numStateIneq) = stateIneqConstraints.f;
+    stacked.dfdx.topRows(numStateIneq) = stateIneqConstraints.dfdx;
+  }
+  if (numStateInputIneq > 0) {
+    stacked.f.tail(numStateInputIneq) = stateInputIneqConstraints.f;
+    stacked.dfdx.bottomRows(numStateInputIneq) = stateInputIneqConstraints.dfdx;
+    stacked.dfdu.bottomRows(numStateInputIneq) = stateInputIneqConstraints.dfdu;
+  }
+  return stacked;
+}
 }  // anonymous namespace
 
 SqpSolver::SqpSolver(sqp::Settings settings, const OptimalControlProblem& optimalControlProblem, const Initializer& initializer)
     : settings_(rectifySettings(optimalControlProblem, std::move(settings))),
       hpipmInterface_(OcpSize(), settings_.hpipmSettings),
-      threadPool_(std::max(settings_.nThreads, size_t(1)) - 1, settings_.threadPriority),
+      threadPool_(std::max(settings_.nThreads, size_t(1)) - 1, settings_.threadPriority,
+                  ThreadPool::Settings{settings_.threadSpinDuration, settings_.threadCpuAffinity}),
       logger_(settings_.logSize) {
   Eigen::setNbThreads(1);  // No multithreading within Eigen.
   Eigen::initParallel();
@@ -114,10 +147,16 @@ void SqpSolver::reset() {
   primalSolution_ = PrimalSolution();
   valueFunction_.clear();
   performanceIndeces_.clear();
+  realTimeIterationData_ = RealTimeIterationData();
+  qpTime_.clear();
+  linearizationCache_ = LinearizationCache();
 
   // reset timers
   numProblems_ = 0;
   totalNumIterations_ = 0;
+  totalNumQpIterations_ = 0;
+  totalNumLinearizedNodes_ = 0;
+  totalNumReusedNodes_ = 0;
   logger_ = sqp::Logger<sqp::LogEntry>(settings_.logSize);
   linearQuadraticApproximationTimer_.reset();
   solveQpTimer_.reset();
@@ -138,6 +177,12 @@ std::string SqpSolver::getBenchmarkingInformation() const {
     const scalar_t inPercent = 100.0;
     infoStream << "\n########################################################################\n";
     infoStream << "The benchmarking is computed over " << totalNumIterations_ << " iterations. \n";
+    infoStream << "The QP subproblems took " << totalNumQpIterations_ << " HPIPM iterations. \n";
+    if (settings_.useIncrementalRelinearization) {
+      const auto totalNumNodes = totalNumLinearizedNodes_ + totalNumReusedNodes_;
+      infoStream << "The derivatives of " << totalNumReusedNodes_ << " out of " << totalNumNodes << " intermediate nodes were reused ("
+                 << (totalNumNodes > 0 ? static_cast<scalar_t>(totalNumReusedNodes_) / totalNumNodes * inPercent : 0.0) << "%). \n";
+    }
     infoStream << "SQP Benchmarking\t   :\tAverage time [ms]   (% of total runtime)\n";
     infoStream << "\tLQ Approximation   :\t" << linearQuadraticApproximationTimer_.getAverageInMilliseconds() << " [ms] \t\t("
                << linearQuadraticApproximationTotal / benchmarkTotal * inPercent << "%)\n";
@@ -151,6 +196,13 @@ std::string SqpSolver::getBenchmarkingInformation() const {
   return infoStream.str();
 }
 
+std::map<std::string, scalar_t> SqpSolver::getBenchmarkingTimes() const {
+  return {{"lqApproximation", linearQuadraticApproximationTimer_.getTotalInMilliseconds()},
+          {"solveQp", solveQpTimer_.getTotalInMilliseconds()},
+          {"linesearch", linesearchTimer_.getTotalInMilliseconds()},
+          {"computeController", computeControllerTimer_.getTotalInMilliseconds()}};
+}
+
 const std::vector<PerformanceIndex>& SqpSolver::getIterationsLog() const {
   if (performanceIndeces_.empty()) {
     throw std::runtime_error("[SqpSolver]: No performance log yet, no problem solved yet?");
@@ -181,30 +233,23 @@ ScalarFunctionQuadraticApproximation SqpSolver::getValueFunction(scalar_t time,
 }
 
 void SqpSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t finalTime) {
+  OCS2_TRACE_SCOPE("SqpSolver::run");
+  // After the first full solve, real-time iterations take a single step per call
+  if (settings_.useRealTimeIteration && !primalSolution_.timeTrajectory_.empty()) {
+    runRealTimeIteration(initTime, initState, finalTime);
+    return;
+  }
+  realTimeIterationData_.isPrepared = false;
+
   if (settings_.printSolverStatus || settings_.printLinesearch) {
     std::cerr << "\n++++++++++++++++++++++++++++++++++++++++++++++++++++++";
     std::cerr << "\n+++++++++++++ SQP solver is initialized ++++++++++++++";
     std::cerr << "\n++++++++++++++++++++++++++++++++++++++++++++++++++++++\n";
   }
 
-  // Determine time discretization, taking into account event times.
-  const auto& eventTimes = this->getReferenceManager().getModeSchedule().eventTimes;
-  const auto timeDiscretization = timeDiscretizationWithEvents(initTime, finalTime, settings_.dt, eventTimes);
-
-  // Initialize references
-  for (auto& ocpDefinition : ocpDefinitions_) {
-    const auto& targetTrajectories = this->getReferenceManager().getTargetTrajectories();
-    ocpDefinition.targetTrajectoriesPtr = &targetTrajectories;
-  }
-
-  // Trajectory spread of primalSolution_
-  if (!primalSolution_.timeTrajectory_.empty()) {
-    std::ignore = trajectorySpread(primalSolution_.modeSchedule_, this->getReferenceManager().getModeSchedule(), primalSolution_);
-  }
-
   // Initialize the state and input
   vector_array_t x, u;
-  multiple_shooting::initializeStateInputTrajectories(initState, timeDiscretization, primalSolution_, *initializerPtr_, x, u);
+  const auto timeDiscretization = initializeTrajectories(initTime, initState, finalTime, x, u);
 
   // Bookkeeping
   performanceIndeces_.clear();
@@ -213,6 +258,7 @@ void SqpSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
   int iter = 0;
   sqp::Convergence convergence = sqp::Convergence::FALSE;
   while (convergence == sqp::Convergence::FALSE) {
+    OCS2_TRACE_SCOPE("SqpSolver::iteration");
     if (settings_.printSolverStatus || settings_.printLinesearch) {
       std::cerr << "\nSQP iteration: " << iter << "\n";
     }
@@ -223,8 +269,8 @@ void SqpSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
 
     // Solve QP
     solveQpTimer_.startTimer();
-    const vector_t delta_x0 = initState - x[0];
-    const auto deltaSolution = getOCPSolution(delta_x0);
+    workspace_.deltaX0 = initState - x[0];
+    const auto& deltaSolution = getOCPSolution(timeDiscretization, workspace_.deltaX0);
     extractValueFunction(timeDiscretization, x);
     solveQpTimer_.endTimer();
 
@@ -237,6 +283,15 @@ void SqpSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
     // Check convergence
     convergence = checkConvergence(iter, baselinePerformance, stepInfo);
 
+    // Stop early if another iteration and the controller computation are not expected to fit in the time budget. The last accepted
+    // iterate is returned in that case.
+    const scalar_t expectedIterationTime =
+        linearQuadraticApproximationTimer_.getLastIntervalInMilliseconds() + solveQpTimer_.getLastIntervalInMilliseconds() +
+        linesearchTimer_.getLastIntervalInMilliseconds() + computeControllerTimer_.getLastIntervalInMilliseconds();
+    if (convergence == sqp::Convergence::FALSE && exceedsTimeBudget(expectedIterationTime)) {
+      convergence = sqp::Convergence::TIMEBUDGET;
+    }
+
     // Logging
     if (settings_.enableLogging) {
       auto& logEntry = logger_.currentEntry();
@@ -245,7 +300,10 @@ void SqpSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
       logEntry.iteration = iter;
       logEntry.linearQuadraticApproximationTime = linearQuadraticApproximationTimer_.getLastIntervalInMilliseconds();
       logEntry.solveQpTime = solveQpTimer_.getLastIntervalInMilliseconds();
+      logEntry.qpIterations = settings_.useParallelRiccati ? 1 : hpipmInterface_.getNumIterations();
       logEntry.linesearchTime = linesearchTimer_.getLastIntervalInMilliseconds();
+      logEntry.numLinearizedNodes = linearizationCache_.numLinearizedNodes;
+      logEntry.numReusedNodes = linearizationCache_.numReusedNodes;
       logEntry.baselinePerformanceIndex = baselinePerformance;
       logEntry.totalConstraintViolationBaseline = FilterLinesearch::totalConstraintViolation(baselinePerformance);
       logEntry.stepInfo = stepInfo;
@@ -265,6 +323,10 @@ void SqpSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
   problemMetrics_ = multiple_shooting::toProblemMetrics(timeDiscretization, std::move(metrics));
   computeControllerTimer_.endTimer();
 
+  // Time budget report
+  performanceIndeces_.back().earlyExit = (convergence == sqp::Convergence::TIMEBUDGET);
+  performanceIndeces_.back().deadlineMissed = exceedsTimeBudget(0.0);
+
   if (settings_.printSolverStatus || settings_.printLinesearch) {
     std::cerr << "\nConvergence : " << toString(convergence) << "\n";
     std::cerr << "\n++++++++++++++++++++++++++++++++++++++++++++++++++++++";
@@ -273,28 +335,183 @@ void SqpSolver::runImpl(scalar_t initTime, const vector_t& initState, scalar_t f
   }
 }
 
+void SqpSolver::prepareRealTimeIteration(scalar_t initTime, scalar_t finalTime) {
+  if (!settings_.useRealTimeIteration || primalSolution_.timeTrajectory_.empty()) {
+    return;
+  }
+
+  // Best guess of the next initial state is the current solution at the expected initial time
+  const vector_t initState = LinearInterpolation::interpolate(initTime, primalSolution_.timeTrajectory_, primalSolution_.stateTrajectory_);
+
+  linearQuadraticApproximationTimer_.startTimer();
+  setupRealTimeIteration(initTime, initState, finalTime);
+  linearQuadraticApproximationTimer_.endTimer();
+}
+
+void SqpSolver::setupRealTimeIteration(scalar_t initTime, const vector_t& initState, scalar_t finalTime) {
+  auto& data = realTimeIterationData_;
+  data.timeDiscretization = initializeTrajectories(initTime, initState, finalTime, data.x, data.u);
+  // The deviation of the measured initial state is only known in the feedback phase
+  data.baselinePerformance = setupQuadraticSubproblem(data.timeDiscretization, data.x.front(), data.x, data.u, data.metrics);
+  data.initTime = initTime;
+  data.eventTimes = this->getReferenceManager().getModeSchedule().eventTimes;
+  data.targetTrajectories = this->getReferenceManager().getTargetTrajectories();
+  data.isPrepared = true;
+}
+
+void SqpSolver::runRealTimeIteration(scalar_t initTime, const vector_t& initState, scalar_t finalTime) {
+  OCS2_TRACE_SCOPE("SqpSolver::runRealTimeIteration");
+  auto& data = realTimeIterationData_;
+
+  // The prepared QP is reused if its time grid is less than its first interval off and the references did not change since
+  const scalar_t firstIntervalLength =
+      (data.timeDiscretization.size() > 1) ? data.timeDiscretization[1].time - data.timeDiscretization[0].time : 0.0;
+  const bool isPrepared = data.isPrepared && std::abs(initTime - data.initTime) < firstIntervalLength &&
+                          data.eventTimes == this->getReferenceManager().getModeSchedule().eventTimes &&
+                          data.targetTrajectories == this->getReferenceManager().getTargetTrajectories();
+  if (!isPrepared) {
+    linearQuadraticApproximationTimer_.startTimer();
+    setupRealTimeIteration(initTime, initState, finalTime);
+    linearQuadraticApproximationTimer_.endTimer();
+  }
+  data.isPrepared = false;
+
+  // Account for the measured initial state in the performance of the linearization point
+  auto& delta_x0 = workspace_.deltaX0;
+  delta_x0 = initState - data.x.front();
+  data.metrics.front().dynamicsViolation += delta_x0;
+  data.baselinePerformance.dynamicsViolationSSE += delta_x0.squaredNorm();
+
+  // Solve QP
+  solveQpTimer_.startTimer();
+  const auto& deltaSolution = getOCPSolution(data.timeDiscretization, delta_x0);
+  extractValueFunction(data.timeDiscretization, data.x);
+  solveQpTimer_.endTimer();
+
+  // Take the full step, the performance is reported at the linearization point since it is not evaluated after the step
+  multiple_shooting::incrementTrajectory(data.x, deltaSolution.deltaXSol, 1.0, data.x);
+  multiple_shooting::incrementTrajectory(data.u, deltaSolution.deltaUSol, 1.0, data.u);
+  performanceIndeces_.assign(1, data.baselinePerformance);
+
+  sqp::StepInfo stepInfo;
+  stepInfo.stepSize = 1.0;
+  stepInfo.stepType = FilterLinesearch::StepType::UNKNOWN;
+  stepInfo.dx_norm = multiple_shooting::trajectoryNorm(deltaSolution.deltaXSol);
+  stepInfo.du_norm = multiple_shooting::trajectoryNorm(deltaSolution.deltaUSol);
+  stepInfo.performanceAfterStep = data.baselinePerformance;
+  stepInfo.totalConstraintViolationAfterStep = FilterLinesearch::totalConstraintViolation(data.baselinePerformance);
+
+  if (settings_.printSolverStatus || settings_.printLinesearch) {
+    std::cerr << "\nSQP real-time iteration at time " << initTime << (isPrepared ? " (prepared)" : " (not prepared)") << "\n";
+    std::cerr << "|dx| = " << stepInfo.dx_norm << "\t|du| = " << stepInfo.du_norm << "\n";
+  }
+
+  // Logging
+  if (settings_.enableLogging) {
+    auto& logEntry = logger_.currentEntry();
+    logEntry.problemNumber = numProblems_;
+    logEntry.time = initTime;
+    logEntry.iteration = 0;
+    logEntry.linearQuadraticApproximationTime = linearQuadraticApproximationTimer_.getLastIntervalInMilliseconds();
+    logEntry.solveQpTime = solveQpTimer_.getLastIntervalInMilliseconds();
+    logEntry.qpIterations = settings_.useParallelRiccati ? 1 : hpipmInterface_.getNumIterations();
+    logEntry.linesearchTime = 0.0;
+    logEntry.numLinearizedNodes = linearizationCache_.numLinearizedNodes;
+    logEntry.numReusedNodes = linearizationCache_.numReusedNodes;
+    logEntry.baselinePerformanceIndex = data.baselinePerformance;
+    logEntry.totalConstraintViolationBaseline = stepInfo.totalConstraintViolationAfterStep;
+    logEntry.stepInfo = stepInfo;
+    logEntry.convergence = sqp::Convergence::ITERATIONS;
+    logger_.advance();
+  }
+
+  ++numProblems_;
+  ++totalNumIterations_;
+
+  // The solution starts at the measured initial state, hence at the measured initial time instead of the prepared one
+  data.timeDiscretization.front().time = initTime;
+
+  computeControllerTimer_.startTimer();
+  if (settings_.useFeedbackPolicy) {
+    primalSolution_ = toPrimalSolution(data.timeDiscretization, std::move(data.x), std::move(data.u));
+  } else {
+    // Written in place, such that the feedback phase reuses the memory of the previous solution
+    multiple_shooting::toPrimalSolution(data.timeDiscretization, this->getReferenceManager().getModeSchedule(), data.x, data.u,
+                                        primalSolution_);
+  }
+  multiple_shooting::toProblemMetrics(data.timeDiscretization, data.metrics, problemMetrics_);
+  computeControllerTimer_.endTimer();
+
+  // A real-time iteration cannot exit early, but it can miss the time budget
+  performanceIndeces_.back().deadlineMissed = exceedsTimeBudget(0.0);
+}
+
+std::vector<AnnotatedTime> SqpSolver::initializeTrajectories(scalar_t initTime, const vector_t& initState, scalar_t finalTime,
+                                                             vector_array_t& x, vector_array_t& u) {
+  // Determine time discretization, taking into account event times.
+  const auto& eventTimes = this->getReferenceManager().getModeSchedule().eventTimes;
+  auto timeDiscretization =
+      timeDiscretizationWithEvents(initTime, finalTime, settings_.dt, settings_.dtGrowthFactor, settings_.dtMax, eventTimes);
+
+  // Initialize references
+  for (auto& ocpDefinition : ocpDefinitions_) {
+    const auto& targetTrajectories = this->getReferenceManager().getTargetTrajectories();
+    ocpDefinition.targetTrajectoriesPtr = &targetTrajectories;
+  }
+
+  // Trajectory spread of primalSolution_
+  if (!primalSolution_.timeTrajectory_.empty()) {
+    std::ignore = trajectorySpread(primalSolution_.modeSchedule_, this->getReferenceManager().getModeSchedule(), primalSolution_);
+  }
+
+  // Initialize the state and input
+  multiple_shooting::initializeStateInputTrajectories(initState, timeDiscretization, primalSolution_, *initializerPtr_, x, u);
+
+  return timeDiscretization;
+}
+
 void SqpSolver::runParallel(std::function<void(int)> taskFunction) {
   threadPool_.runParallel(std::move(taskFunction), settings_.nThreads);
 }
 
-SqpSolver::OcpSubproblemSolution SqpSolver::getOCPSolution(const vector_t& delta_x0) {
-  // Solve the QP
-  OcpSubproblemSolution solution;
+const SqpSolver::OcpSubproblemSolution& SqpSolver::getOCPSolution(const std::vector<AnnotatedTime>& time, const vector_t& delta_x0) {
+  OCS2_TRACE_SCOPE("SqpSolver::solveQp");
+  // Solve the QP, the solution is written to the workspace to reuse its memory
+  auto& solution = workspace_.subproblemSolution;
   auto& deltaXSol = solution.deltaXSol;
   auto& deltaUSol = solution.deltaUSol;
-  hpipm_status status;
-  const bool hasStateInputConstraints = !ocpDefinitions_.front().equalityConstraintPtr->empty();
-  if (hasStateInputConstraints && !settings_.projectStateInputEqualityConstraints) {
-    hpipmInterface_.resize(extractSizesFromProblem(dynamics_, cost_, &stateInputEqConstraints_));
-    status =
-        hpipmInterface_.solve(delta_x0, dynamics_, cost_, &stateInputEqConstraints_, deltaXSol, deltaUSol, settings_.printSolverStatus);
-  } else {  // without constraints, or when using projection, we have an unconstrained QP.
-    hpipmInterface_.resize(extractSizesFromProblem(dynamics_, cost_, nullptr));
-    status = hpipmInterface_.solve(delta_x0, dynamics_, cost_, nullptr, deltaXSol, deltaUSol, settings_.printSolverStatus);
-  }
 
-  if (status != hpipm_status::SUCCESS) {
-    throw std::runtime_error("[SqpSolver] Failed to solve QP");
+  if (settings_.useParallelRiccati) {
+    parallelRiccatiSolver_.solve(threadPool_, delta_x0, dynamics_, cost_, deltaXSol, deltaUSol);
+    totalNumQpIterations_ += 1;
+
+  } else {
+    // Warm start with the previous QP solution, shifted to the current time discretization. With partial condensing, HPIPM warm starts
+    // from the previous condensed iterate instead.
+    if (settings_.hpipmSettings.warm_start > 0 && settings_.hpipmSettings.partialCondensingBlockSize <= 1) {
+      auto& qpTime = workspace_.qpTime;
+      qpTime.resize(time.size());
+      std::transform(time.begin(), time.end(), qpTime.begin(), [](const AnnotatedTime& t) { return getInterpolationTime(t); });
+      hpipmInterface_.shiftWarmStart(qpTime_, qpTime);
+      qpTime_.swap(qpTime);
+    }
+
+    // Without constraints, or when using projection, the QP has no equality constraints.
+    const bool hasStateInputConstraints = !ocpDefinitions_.front().equalityConstraintPtr->empty();
+    auto* eqConstraints =
+        (hasStateInputConstraints && !settings_.projectStateInputEqualityConstraints) ? &stateInputEqConstraints_ : nullptr;
+    const auto* ineqConstraints = settings_.useHardInequalityConstraints ? &qpInequalityConstraints_ : nullptr;
+    const auto* generalIneqConstraints = settings_.useHardInequalityConstraints ? &qpInequalityConstraints_.generalConstraints : nullptr;
+
+    extractSizesFromProblem(dynamics_, cost_, eqConstraints, generalIneqConstraints, workspace_.ocpSize);
+    hpipmInterface_.resize(workspace_.ocpSize);
+    const auto status = hpipmInterface_.solve(delta_x0, dynamics_, cost_, eqConstraints, ineqConstraints, deltaXSol, deltaUSol,
+                                              settings_.printSolverStatus);
+    totalNumQpIterations_ += hpipmInterface_.getNumIterations();
+
+    if (status != hpipm_status::SUCCESS) {
+      throw std::runtime_error("[SqpSolver] Failed to solve QP");
+    }
   }
 
   // to determine if the solution is a descent direction for the cost: compute gradient(cost)' * [dx; du]
@@ -310,7 +527,8 @@ SqpSolver::OcpSubproblemSolution SqpSolver::getOCPSolution(const vector_t& delta
 
 void SqpSolver::extractValueFunction(const std::vector<AnnotatedTime>& time, const vector_array_t& x) {
   if (settings_.createValueFunction) {
-    valueFunction_ = hpipmInterface_.getRiccatiCostToGo(dynamics_[0], cost_[0]);
+    valueFunction_ = settings_.useParallelRiccati ? parallelRiccatiSolver_.getRiccatiCostToGo()
+                                                  : hpipmInterface_.getRiccatiCostToGo(dynamics_[0], cost_[0]);
     // Correct for linearization state
     for (int i = 0; i < time.size(); ++i) {
       valueFunction_[i].dfdx.noalias() -= valueFunction_[i].dfdxx * x[i];
@@ -319,9 +537,11 @@ void SqpSolver::extractValueFunction(const std::vector<AnnotatedTime>& time, con
 }
 
 PrimalSolution SqpSolver::toPrimalSolution(const std::vector<AnnotatedTime>& time, vector_array_t&& x, vector_array_t&& u) {
+  OCS2_TRACE_SCOPE("SqpSolver::computeController");
   if (settings_.useFeedbackPolicy) {
     ModeSchedule modeSchedule = this->getReferenceManager().getModeSchedule();
-    matrix_array_t KMatrices = hpipmInterface_.getRiccatiFeedback(dynamics_[0], cost_[0]);
+    matrix_array_t KMatrices = settings_.useParallelRiccati ? parallelRiccatiSolver_.getRiccatiFeedback()
+                                                            : hpipmInterface_.getRiccatiFeedback(dynamics_[0], cost_[0]);
     if (settings_.projectStateInputEqualityConstraints) {
       multiple_shooting::remapProjectedGain(constraintsProjection_, KMatrices);
     }
@@ -335,10 +555,12 @@ PrimalSolution SqpSolver::toPrimalSolution(const std::vector<AnnotatedTime>& tim
 
 PerformanceIndex SqpSolver::setupQuadraticSubproblem(const std::vector<AnnotatedTime>& time, const vector_t& initState,
                                                      const vector_array_t& x, const vector_array_t& u, std::vector<Metrics>& metrics) {
+  OCS2_TRACE_SCOPE("SqpSolver::setupQuadraticSubproblem");
   // Problem horizon
   const int N = static_cast<int>(time.size()) - 1;
 
-  std::vector<PerformanceIndex> performance(settings_.nThreads, PerformanceIndex());
+  auto& performance = workspace_.performance;
+  performance.assign(settings_.nThreads, PerformanceIndex());
   cost_.resize(N + 1);
   dynamics_.resize(N);
   stateInputEqConstraints_.resize(N + 1);  // +1 because of HpipmInterface size check
@@ -346,16 +568,26 @@ PerformanceIndex SqpSolver::setupQuadraticSubproblem(const std::vector<Annotated
   stateInputIneqConstraints_.resize(N);
   constraintsProjection_.resize(N);
   projectionMultiplierCoefficients_.resize(N);
+  qpInequalityConstraints_.generalConstraints.resize(settings_.useHardInequalityConstraints ? N + 1 : 0);
   metrics.resize(N + 1);
 
+  // Incremental relinearization
+  const bool useCache = settings_.useIncrementalRelinearization && isLinearizationCacheValid();
+  if (settings_.useIncrementalRelinearization) {
+    linearizationCache_.nodesNew.resize(N);
+  }
+  std::atomic_size_t numReusedNodes{0};
+
   std::atomic_int timeIndex{0};
   auto parallelTask = [&](int workerId) {
     // Get worker specific resources
     OptimalControlProblem& ocpDefinition = ocpDefinitions_[workerId];
     PerformanceIndex workerPerformance;  // Accumulate performance in local variable
+    size_t workerNumReusedNodes = 0;
 
     int i = timeIndex++;
     while (i < N) {
+      OCS2_TRACE_SCOPE("SqpSolver::approximateNode");
       if (time[i].event == AnnotatedTime::Event::PreEvent) {
         // Event node
         auto result = multiple_shooting::setupEventNode(ocpDefinition, time[i].time, x[i], x[i + 1]);
@@ -368,23 +600,82 @@ PerformanceIndex SqpSolver::setupQuadraticSubproblem(const std::vector<Annotated
         stateInputIneqConstraints_[i].resize(0, x[i].size());
         constraintsProjection_[i].resize(0, x[i].size());
         projectionMultiplierCoefficients_[i] = multiple_shooting::ProjectionMultiplierCoefficients();
+        if (settings_.useHardInequalityConstraints) {
+          // The initial state is fixed, such that state-only inequality constraints at the initial node can make the QP infeasible
+          qpInequalityConstraints_.generalConstraints[i] = (i == 0) ? VectorFunctionLinearApproximation() : stateIneqConstraints_[i];
+        }
+        if (settings_.useIncrementalRelinearization) {
+          linearizationCache_.nodesNew[i].isValid = false;
+          linearizationCache_.nodesNew[i].t = time[i].time;
+        }
       } else {
         // Normal, intermediate node
         const scalar_t ti = getIntervalStart(time[i]);
         const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
-        auto result = multiple_shooting::setupIntermediateNode(ocpDefinition, sensitivityDiscretizer_, ti, dt, x[i], x[i + 1], u[i]);
-        metrics[i] = multiple_shooting::computeMetrics(result);
-        workerPerformance += multiple_shooting::computePerformanceIndex(result, dt);
-        if (settings_.projectStateInputEqualityConstraints) {
-          multiple_shooting::projectTranscription(result, settings_.extractProjectionMultiplier);
+        if (settings_.useIncrementalRelinearization) {
+          auto& node = linearizationCache_.nodesNew[i];
+          auto* cachedNode = useCache ? findCachedLinearization(ti, dt, x[i], u[i]) : nullptr;
+          if (cachedNode != nullptr) {
+            // Only evaluate the zeroth-order terms and update the cached transcription in place, keeping its derivatives
+            metrics[i] = multiple_shooting::computeIntermediateMetrics(ocpDefinition, discretizer_, ti, dt, x[i], x[i + 1], u[i]);
+            workerPerformance += toPerformanceIndex(metrics[i], dt);
+            // A cached node matches at most one node of the new time discretization
+            node = std::move(*cachedNode);
+            multiple_shooting::updateTranscription(node.transcription, metrics[i], x[i] - node.xTranscription, u[i] - node.uTranscription);
+            ++workerNumReusedNodes;
+          } else {
+            node.transcription =
+                multiple_shooting::setupIntermediateNode(ocpDefinition, sensitivityDiscretizer_, ti, dt, x[i], x[i + 1], u[i]);
+            metrics[i] = multiple_shooting::computeMetrics(node.transcription);
+            workerPerformance += multiple_shooting::computePerformanceIndex(node.transcription, dt);
+            node.isValid = true;
+            node.t = ti;
+            node.dt = dt;
+            node.x = x[i];
+            node.u = u[i];
+          }
+          node.xTranscription = x[i];
+          node.uTranscription = u[i];
+
+          // The cache keeps the unprojected transcription, such that its terms are copied into the storage of the QP
+          const auto& transcription = node.transcription;
+          cost_[i] = transcription.cost;
+          dynamics_[i] = transcription.dynamics;
+          stateIneqConstraints_[i] = transcription.stateIneqConstraints;
+          stateInputIneqConstraints_[i] = transcription.stateInputIneqConstraints;
+          if (settings_.projectStateInputEqualityConstraints && transcription.stateInputEqConstraints.f.size() > 0) {
+            // Projection stored instead of constraint
+            multiple_shooting::projectTranscription(transcription.stateInputEqConstraints, dynamics_[i], cost_[i],
+                                                    stateInputIneqConstraints_[i], constraintsProjection_[i],
+                                                    projectionMultiplierCoefficients_[i], settings_.extractProjectionMultiplier);
+            stateInputEqConstraints_[i] = VectorFunctionLinearApproximation();
+          } else {
+            stateInputEqConstraints_[i] = transcription.stateInputEqConstraints;
+            constraintsProjection_[i] = VectorFunctionLinearApproximation();
+            projectionMultiplierCoefficients_[i] = multiple_shooting::ProjectionMultiplierCoefficients();
+          }
+        } else {
+          auto result = multiple_shooting::setupIntermediateNode(ocpDefinition, sensitivityDiscretizer_, ti, dt, x[i], x[i + 1], u[i]);
+          metrics[i] = multiple_shooting::computeMetrics(result);
+          workerPerformance += multiple_shooting::computePerformanceIndex(result, dt);
+          if (settings_.projectStateInputEqualityConstraints) {
+            multiple_shooting::projectTranscription(result, settings_.extractProjectionMultiplier);
+          }
+          cost_[i] = std::move(result.cost);
+          dynamics_[i] = std::move(result.dynamics);
+          stateInputEqConstraints_[i] = std::move(result.stateInputEqConstraints);
+          stateIneqConstraints_[i] = std::move(result.stateIneqConstraints);
+          stateInputIneqConstraints_[i] = std::move(result.stateInputIneqConstraints);
+          constraintsProjection_[i] = std::move(result.constraintsProjection);
+          projectionMultiplierCoefficients_[i] = std::move(result.projectionMultiplierCoefficients);
+        }
+        if (settings_.useHardInequalityConstraints) {
+          // The initial state is fixed, such that state-only inequality constraints at the initial node can make the QP infeasible
+          const VectorFunctionLinearApproximation noConstraints;
+          const auto& qpStateIneqConstraints = (i == 0) ? noConstraints : stateIneqConstraints_[i];
+          qpInequalityConstraints_.generalConstraints[i] = stackInequalityConstraints(
+              qpStateIneqConstraints, stateInputIneqConstraints_[i], x[i].size(), dynamics_[i].dfdu.cols());
         }
-        cost_[i] = std::move(result.cost);
-        dynamics_[i] = std::move(result.dynamics);
-        stateInputEqConstraints_[i] = std::move(result.stateInputEqConstraints);
-        stateIneqConstraints_[i] = std::move(result.stateIneqConstraints);
-        stateInputIneqConstraints_[i] = std::move(result.stateInputIneqConstraints);
-        constraintsProjection_[i] = std::move(result.constraintsProjection);
-        projectionMultiplierCoefficients_[i] = std::move(result.projectionMultiplierCoefficients);
       }
 
       i = timeIndex++;
@@ -398,17 +689,30 @@ PerformanceIndex SqpSolver::setupQuadraticSubproblem(const std::vector<Annotated
       cost_[i] = std::move(result.cost);
       stateInputEqConstraints_[i].resize(0, x[i].size());
       stateIneqConstraints_[i] = std::move(result.ineqConstraints);
+      if (settings_.useHardInequalityConstraints) {
+        qpInequalityConstraints_.generalConstraints[i] = stateIneqConstraints_[i];
+      }
     }
 
     // Accumulate! Same worker might run multiple tasks
     performance[workerId] += workerPerformance;
+    numReusedNodes += workerNumReusedNodes;
   };
   runParallel(std::move(parallelTask));
 
+  if (settings_.useIncrementalRelinearization) {
+    linearizationCache_.nodes.swap(linearizationCache_.nodesNew);
+    const size_t numIntermediateNodes = std::count_if(time.begin(), std::prev(time.end()),
+                                                      [](const AnnotatedTime& t) { return t.event != AnnotatedTime::Event::PreEvent; });
+    linearizationCache_.numReusedNodes = numReusedNodes.load();
+    linearizationCache_.numLinearizedNodes = numIntermediateNodes - linearizationCache_.numReusedNodes;
+    totalNumReusedNodes_ += linearizationCache_.numReusedNodes;
+    totalNumLinearizedNodes_ += linearizationCache_.numLinearizedNodes;
+  }
+
   // Account for initial state in performance
-  const vector_t initDynamicsViolation = initState - x.front();
-  metrics.front().dynamicsViolation += initDynamicsViolation;
-  performance.front().dynamicsViolationSSE += initDynamicsViolation.squaredNorm();
+  metrics.front().dynamicsViolation += initState - x.front();
+  performance.front().dynamicsViolationSSE += (initState - x.front()).squaredNorm();
 
   // Sum performance of the threads
   PerformanceIndex totalPerformance = std::accumulate(std::next(performance.begin()), performance.end(), performance.front());
@@ -417,57 +721,105 @@ PerformanceIndex SqpSolver::setupQuadraticSubproblem(const std::vector<Annotated
   return totalPerformance;
 }
 
-PerformanceIndex SqpSolver::computePerformance(const std::vector<AnnotatedTime>& time, const vector_t& initState, const vector_array_t& x,
-                                               const vector_array_t& u, std::vector<Metrics>& metrics) {
+bool SqpSolver::isLinearizationCacheValid() {
+  auto& cache = linearizationCache_;
+  const auto& targetTrajectories = this->getReferenceManager().getTargetTrajectories();
+  const auto& modeSchedule = this->getReferenceManager().getModeSchedule();
+
+  const bool isValid = cache.targetTrajectories == targetTrajectories && cache.modeSchedule.eventTimes == modeSchedule.eventTimes &&
+                       cache.modeSchedule.modeSequence == modeSchedule.modeSequence;
+  if (!isValid) {
+    cache.targetTrajectories = targetTrajectories;
+    cache.modeSchedule = modeSchedule;
+  }
+  return isValid;
+}
+
+SqpSolver::CachedLinearization* SqpSolver::findCachedLinearization(scalar_t t, scalar_t dt, const vector_t& x, const vector_t& u) {
+  // Only tolerates round-off errors, such that a post-event node never matches a node at the event time
+  constexpr auto timeTolerance = numeric_traits::weakEpsilon<scalar_t>();
+  auto& nodes = linearizationCache_.nodes;
+  auto it = std::upper_bound(nodes.begin(), nodes.end(), t - timeTolerance,
+                             [](scalar_t time, const CachedLinearization& node) { return time < node.t; });
+  for (; it != nodes.end() && it->t < t + timeTolerance; ++it) {
+    if (it->isValid && std::abs(it->dt - dt) < timeTolerance && it->x.size() == x.size() && it->u.size() == u.size() &&
+        (it->x - x).lpNorm<Eigen::Infinity>() < settings_.relinearizationTolerance &&
+        (it->u - u).lpNorm<Eigen::Infinity>() < settings_.relinearizationTolerance) {
+      return &(*it);
+    }
+  }
+  return nullptr;
+}
+
+void SqpSolver::computePerformance(const std::vector<AnnotatedTime>& time, const vector_t& initState, const std::vector<vector_array_t>& x,
+                                   const std::vector<vector_array_t>& u, std::vector<std::vector<Metrics>>& metrics,
+                                   std::vector<PerformanceIndex>& totalPerformance) {
+  OCS2_TRACE_SCOPE("SqpSolver::computePerformance");
   // Problem size
   const int N = static_cast<int>(time.size()) - 1;
-  metrics.resize(N + 1);
+  const int numTrajectories = static_cast<int>(x.size());
+  metrics.resize(numTrajectories);
+  for (auto& trajectoryMetrics : metrics) {
+    trajectoryMetrics.resize(N + 1);
+  }
 
-  std::vector<PerformanceIndex> performance(settings_.nThreads, PerformanceIndex());
-  std::atomic_int timeIndex{0};
+  // performance[workerId * numTrajectories + k] accumulates the contribution of a worker to trajectory k
+  auto& performance = workspace_.performance;
+  performance.assign(settings_.nThreads * numTrajectories, PerformanceIndex());
+  std::atomic_int nodeIndex{0};
   auto parallelTask = [&](int workerId) {
     // Get worker specific resources
     OptimalControlProblem& ocpDefinition = ocpDefinitions_[workerId];
 
-    int i = timeIndex++;
-    while (i < N) {
-      if (time[i].event == AnnotatedTime::Event::PreEvent) {
+    int j = nodeIndex++;
+    while (j < numTrajectories * (N + 1)) {
+      const int k = j / (N + 1);
+      const int i = j % (N + 1);
+      auto& workerPerformance = performance[workerId * numTrajectories + k];
+      if (i == N) {
+        // Terminal node
+        const scalar_t tN = getIntervalStart(time[N]);
+        metrics[k][N] = multiple_shooting::computeTerminalMetrics(ocpDefinition, tN, x[k][N]);
+        workerPerformance += toPerformanceIndex(metrics[k][N]);
+      } else if (time[i].event == AnnotatedTime::Event::PreEvent) {
         // Event node
-        metrics[i] = multiple_shooting::computeEventMetrics(ocpDefinition, time[i].time, x[i], x[i + 1]);
-        performance[workerId] += toPerformanceIndex(metrics[i]);
+        metrics[k][i] = multiple_shooting::computeEventMetrics(ocpDefinition, time[i].time, x[k][i], x[k][i + 1]);
+        workerPerformance += toPerformanceIndex(metrics[k][i]);
       } else {
         // Normal, intermediate node
         const scalar_t ti = getIntervalStart(time[i]);
         const scalar_t dt = getIntervalDuration(time[i], time[i + 1]);
-        metrics[i] = multiple_shooting::computeIntermediateMetrics(ocpDefinition, discretizer_, ti, dt, x[i], x[i + 1], u[i]);
-        performance[workerId] += toPerformanceIndex(metrics[i], dt);
+        metrics[k][i] = multiple_shooting::computeIntermediateMetrics(ocpDefinition, discretizer_, ti, dt, x[k][i], x[k][i + 1], u[k][i]);
+        workerPerformance += toPerformanceIndex(metrics[k][i], dt);
       }
 
-      i = timeIndex++;
-    }
-
-    if (i == N) {  // Only one worker will execute this
-      const scalar_t tN = getIntervalStart(time[N]);
-      metrics[N] = multiple_shooting::computeTerminalMetrics(ocpDefinition, tN, x[N]);
-      performance[workerId] += toPerformanceIndex(metrics[N]);
+      j = nodeIndex++;
     }
   };
   runParallel(std::move(parallelTask));
 
-  // Account for initial state in performance
-  const vector_t initDynamicsViolation = initState - x.front();
-  metrics.front().dynamicsViolation += initDynamicsViolation;
-  performance.front().dynamicsViolationSSE += initDynamicsViolation.squaredNorm();
+  totalPerformance.assign(numTrajectories, PerformanceIndex());
+  for (int k = 0; k < numTrajectories; ++k) {
+    auto& trajectoryPerformance = totalPerformance[k];
 
-  // Sum performance of the threads
-  PerformanceIndex totalPerformance = std::accumulate(std::next(performance.begin()), performance.end(), performance.front());
-  totalPerformance.merit = totalPerformance.cost + totalPerformance.equalityLagrangian + totalPerformance.inequalityLagrangian;
-  return totalPerformance;
+    // Sum performance of the threads
+    for (int w = 0; w < settings_.nThreads; ++w) {
+      trajectoryPerformance += performance[w * numTrajectories + k];
+    }
+
+    // Account for initial state in performance
+    metrics[k].front().dynamicsViolation += initState - x[k].front();
+    trajectoryPerformance.dynamicsViolationSSE += (initState - x[k].front()).squaredNorm();
+
+    trajectoryPerformance.merit =
+        trajectoryPerformance.cost + trajectoryPerformance.equalityLagrangian + trajectoryPerformance.inequalityLagrangian;
+  }
 }
 
 sqp::StepInfo SqpSolver::takeStep(const PerformanceIndex& baseline, const std::vector<AnnotatedTime>& timeDiscretization,
                                   const vector_t& initState, const OcpSubproblemSolution& subproblemSolution, vector_array_t& x,
                                   vector_array_t& u, std::vector<Metrics>& metrics) {
+  OCS2_TRACE_SCOPE("SqpSolver::linesearch");
   using StepType = FilterLinesearch::StepType;
 
   /*
@@ -490,59 +842,81 @@ sqp::StepInfo SqpSolver::takeStep(const PerformanceIndex& baseline, const std::v
   const auto deltaUnorm = multiple_shooting::trajectoryNorm(du);
   const auto deltaXnorm = multiple_shooting::trajectoryNorm(dx);
 
-  scalar_t alpha = 1.0;
-  vector_array_t xNew(x.size());
-  vector_array_t uNew(u.size());
-  std::vector<Metrics> metricsNew(metrics.size());
-  do {
-    // Compute step
-    multiple_shooting::incrementTrajectory(u, du, alpha, uNew);
-    multiple_shooting::incrementTrajectory(x, dx, alpha, xNew);
+  // Backtracking sequence alpha = 1, alpha_decay, alpha_decay^2, ... The linesearch terminates when alpha drops below alpha_min or when the
+  // primal step becomes too small, which prevents going all the way to alpha_min.
+  const auto isTooSmallStep = [&](scalar_t alpha) {
+    return alpha * deltaXnorm < settings_.deltaTol && alpha * deltaUnorm < settings_.deltaTol;
+  };
+  const size_t batchSize = std::max(settings_.linesearchBatchSize, size_t(1));
 
-    // Compute cost and constraints
-    const PerformanceIndex performanceNew = computePerformance(timeDiscretization, initState, xNew, uNew, metricsNew);
-
-    // Step acceptance and record step type
-    bool stepAccepted;
-    StepType stepType;
-    std::tie(stepAccepted, stepType) =
-        filterLinesearch_.acceptStep(baseline, performanceNew, alpha * subproblemSolution.armijoDescentMetric);
-
-    if (settings_.printLinesearch) {
-      std::cerr << "Step size: " << alpha << ", Step Type: " << toString(stepType)
-                << (stepAccepted ? std::string{" (Accepted)"} : std::string{" (Rejected)"}) << "\n";
-      std::cerr << "|dx| = " << alpha * deltaXnorm << "\t|du| = " << alpha * deltaUnorm << "\n";
-      std::cerr << performanceNew << "\n";
-    }
+  // The candidate trajectories are kept in the workspace, such that their memory is reused across iterations
+  auto& alphas = workspace_.stepSizes;
+  auto& xNew = workspace_.xNew;
+  auto& uNew = workspace_.uNew;
+  auto& metricsNew = workspace_.metricsNew;
+  auto& performanceNew = workspace_.performanceNew;
 
-    if (stepAccepted) {  // Return if step accepted
-      x = std::move(xNew);
-      u = std::move(uNew);
-      metrics = std::move(metricsNew);
-
-      // Prepare step info
-      sqp::StepInfo stepInfo;
-      stepInfo.stepSize = alpha;
-      stepInfo.stepType = stepType;
-      stepInfo.dx_norm = alpha * deltaXnorm;
-      stepInfo.du_norm = alpha * deltaUnorm;
-      stepInfo.performanceAfterStep = performanceNew;
-      stepInfo.totalConstraintViolationAfterStep = FilterLinesearch::totalConstraintViolation(performanceNew);
-      return stepInfo;
-
-    } else {  // Try smaller step
+  scalar_t alpha = 1.0;
+  bool continueLinesearch = true;
+  while (continueLinesearch) {
+    // The next step sizes of the sequence are evaluated concurrently
+    alphas.clear();
+    do {
+      alphas.push_back(alpha);
       alpha *= settings_.alpha_decay;
+      continueLinesearch = alpha >= settings_.alpha_min && !isTooSmallStep(alpha);
+    } while (continueLinesearch && alphas.size() < batchSize);
+
+    // Compute steps
+    xNew.resize(alphas.size());
+    uNew.resize(alphas.size());
+    for (int k = 0; k < alphas.size(); ++k) {
+      xNew[k].resize(x.size());
+      uNew[k].resize(u.size());
+      multiple_shooting::incrementTrajectory(u, du, alphas[k], uNew[k]);
+      multiple_shooting::incrementTrajectory(x, dx, alphas[k], xNew[k]);
+    }
 
-      // Detect too small step size during back-tracking to escape early. Prevents going all the way to alpha_min
-      if (alpha * deltaXnorm < settings_.deltaTol && alpha * deltaUnorm < settings_.deltaTol) {
-        if (settings_.printLinesearch) {
-          std::cerr << "Exiting linesearch early due to too small primal steps |dx|: " << alpha * deltaXnorm
-                    << ", and or |du|: " << alpha * deltaUnorm << " are below deltaTol: " << settings_.deltaTol << "\n";
-        }
-        break;
+    // Compute cost and constraints
+    computePerformance(timeDiscretization, initState, xNew, uNew, metricsNew, performanceNew);
+
+    // Take the largest accepted step
+    for (int k = 0; k < alphas.size(); ++k) {
+      // Step acceptance and record step type
+      bool stepAccepted;
+      StepType stepType;
+      std::tie(stepAccepted, stepType) =
+          filterLinesearch_.acceptStep(baseline, performanceNew[k], alphas[k] * subproblemSolution.armijoDescentMetric);
+
+      if (settings_.printLinesearch) {
+        std::cerr << "Step size: " << alphas[k] << ", Step Type: " << toString(stepType)
+                  << (stepAccepted ? std::string{" (Accepted)"} : std::string{" (Rejected)"}) << "\n";
+        std::cerr << "|dx| = " << alphas[k] * deltaXnorm << "\t|du| = " << alphas[k] * deltaUnorm << "\n";
+        std::cerr << performanceNew[k] << "\n";
+      }
+
+      if (stepAccepted) {  // Return if step accepted, the previous trajectories become the memory of the next candidate
+        x.swap(xNew[k]);
+        u.swap(uNew[k]);
+        metrics.swap(metricsNew[k]);
+
+        // Prepare step info
+        sqp::StepInfo stepInfo;
+        stepInfo.stepSize = alphas[k];
+        stepInfo.stepType = stepType;
+        stepInfo.dx_norm = alphas[k] * deltaXnorm;
+        stepInfo.du_norm = alphas[k] * deltaUnorm;
+        stepInfo.performanceAfterStep = performanceNew[k];
+        stepInfo.totalConstraintViolationAfterStep = FilterLinesearch::totalConstraintViolation(performanceNew[k]);
+        return stepInfo;
       }
     }
-  } while (alpha >= settings_.alpha_min);
+  }
+
+  if (settings_.printLinesearch && alpha >= settings_.alpha_min) {
+    std::cerr << "Exiting linesearch early due to too small primal steps |dx|: " << alpha * deltaXnorm
+              << ", and or |du|: " << alpha * deltaUnorm << " are below deltaTol: " << settings_.deltaTol << "\n";
+  }
 
   // Alpha_min reached -> Don't take a step
   sqp::StepInfo stepInfo;
@@ -31,7 +31,10 @@ OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 
 #include "ocs2_sqp/SqpSolver.h"
 
+#include <ocs2_core/constraint/LinearStateConstraint.h>
+#include <ocs2_core/constraint/LinearStateInputConstraint.h>
 #include <ocs2_core/initialization/DefaultInitializer.h>
+#include <ocs2_core/misc/LinearInterpolation.h>
 
 #include <ocs2_oc/test/circular_kinematics.h>
 
@@ -141,3 +144,263 @@ TEST(test_circular_kinematics, solve_EqConstraints_inQPSubproblem) {
     ASSERT_TRUE(u.isApprox(primalSolution.controllerPtr_->computeInput(t, x)));
   }
 }
+
+TEST(test_circular_kinematics, solve_linesearchBatch) {
+  // optimal control problem
+  ocs2::OptimalControlProblem problem = ocs2::createCircularKinematicsProblem("/tmp/ocs2/sqp_test_generated");
+
+  // Initializer
+  ocs2::DefaultInitializer zeroInitializer(2);
+
+  // Solver settings
+  ocs2::sqp::Settings settings;
+  settings.dt = 0.01;
+  settings.sqpIteration = 20;
+  settings.projectStateInputEqualityConstraints = true;
+  settings.useFeedbackPolicy = true;
+  settings.printSolverStatistics = false;
+  settings.printSolverStatus = false;
+  settings.printLinesearch = false;
+  settings.nThreads = 3;
+
+  // Additional problem definitions
+  const ocs2::scalar_t startTime = 0.0;
+  const ocs2::scalar_t finalTime = 1.0;
+  const ocs2::vector_t initState = (ocs2::vector_t(2) << 1.0, 0.0).finished();  // radius 1.0
+
+  // Solve with sequential and batched linesearch
+  auto solve = [&](size_t linesearchBatchSize) {
+    auto batchSettings = settings;
+    batchSettings.linesearchBatchSize = linesearchBatchSize;
+    ocs2::SqpSolver solver(batchSettings, problem, zeroInitializer);
+    solver.run(startTime, initState, finalTime);
+    return std::make_pair(solver.primalSolution(finalTime), solver.getIterationsLog());
+  };
+  const auto sequential = solve(1);
+  const auto batched = solve(3);
+
+  // The batched linesearch accepts the same steps
+  ASSERT_EQ(sequential.second.size(), batched.second.size());
+  for (int i = 0; i < sequential.second.size(); i++) {
+    ASSERT_NEAR(sequential.second[i].merit, batched.second[i].merit, 1e-9);
+  }
+  for (int i = 0; i < sequential.first.timeTrajectory_.size(); i++) {
+    ASSERT_TRUE(sequential.first.stateTrajectory_[i].isApprox(batched.first.stateTrajectory_[i]));
+    ASSERT_TRUE(sequential.first.inputTrajectory_[i].isApprox(batched.first.inputTrajectory_[i]));
+  }
+}
+
+TEST(test_circular_kinematics, solve_projected_EqConstraints_HardIneqConstraints) {
+  // optimal control problem
+  ocs2::OptimalControlProblem problem = ocs2::createCircularKinematicsProblem("/tmp/ocs2/sqp_test_generated");
+
+  // inequality constraints: umin <= u <= umax, xmin <= x
+  const ocs2::vector_t umin = (ocs2::vector_t(2) << -0.5, -0.5).finished();
+  const ocs2::vector_t umax = (ocs2::vector_t(2) << 0.5, 0.5).finished();
+  const ocs2::vector_t xmin = (ocs2::vector_t(2) << -0.5, -0.5).finished();
+  {
+    const ocs2::vector_t e = (ocs2::vector_t(4) << -umin, umax).finished();
+    const ocs2::matrix_t C = ocs2::matrix_t::Zero(4, 2);
+    const ocs2::matrix_t D = (ocs2::matrix_t(4, 2) << ocs2::matrix_t::Identity(2, 2), -ocs2::matrix_t::Identity(2, 2)).finished();
+    problem.inequalityConstraintPtr->add("ubound", std::make_unique<ocs2::LinearStateInputConstraint>(e, C, D));
+  }
+  problem.stateInequalityConstraintPtr->add("xbound", std::make_unique<ocs2::LinearStateConstraint>(-xmin, ocs2::matrix_t::Identity(2, 2)));
+  problem.finalInequalityConstraintPtr->add("xbound", std::make_unique<ocs2::LinearStateConstraint>(-xmin, ocs2::matrix_t::Identity(2, 2)));
+
+  // Initializer
+  ocs2::DefaultInitializer zeroInitializer(2);
+
+  // Solver settings
+  ocs2::sqp::Settings settings;
+  settings.dt = 0.01;
+  settings.sqpIteration = 20;
+  settings.projectStateInputEqualityConstraints = true;
+  settings.useHardInequalityConstraints = true;  // <- true to pass the inequality constraints to the QP
+  settings.useFeedbackPolicy = true;
+  settings.printSolverStatistics = false;
+  settings.printSolverStatus = false;
+  settings.printLinesearch = false;
+  settings.nThreads = 1;
+
+  // Additional problem definitions
+  const ocs2::scalar_t startTime = 0.0;
+  const ocs2::scalar_t finalTime = 1.0;
+  const ocs2::vector_t initState = (ocs2::vector_t(2) << 1.0, 0.0).finished();  // radius 1.0
+
+  // Solve
+  ocs2::SqpSolver solver(settings, problem, zeroInitializer);
+  solver.run(startTime, initState, finalTime);
+
+  const auto primalSolution = solver.primalSolution(finalTime);
+
+  // Check initial condition
+  ASSERT_TRUE(primalSolution.stateTrajectory_.front().isApprox(initState));
+  ASSERT_DOUBLE_EQ(primalSolution.timeTrajectory_.front(), startTime);
+  ASSERT_DOUBLE_EQ(primalSolution.timeTrajectory_.back(), finalTime);
+
+  // Check constraint satisfaction. The constraints are linear, such that they are satisfied by every QP solution.
+  const auto performance = solver.getPerformanceIndeces();
+  ASSERT_LT(performance.dynamicsViolationSSE, 1e-6);
+  ASSERT_LT(performance.equalityConstraintsSSE, 1e-6);
+  ASSERT_LT(performance.inequalityConstraintsSSE, 1e-12);
+  for (const auto& x : primalSolution.stateTrajectory_) {
+    ASSERT_GT((x - xmin).minCoeff(), -1e-6);
+  }
+  for (const auto& u : primalSolution.inputTrajectory_) {
+    if (u.size() > 0) {
+      ASSERT_GT((u - umin).minCoeff(), -1e-6);
+      ASSERT_GT((umax - u).minCoeff(), -1e-6);
+    }
+  }
+}
+
+TEST(test_circular_kinematics, solve_HardIneqConstraints_warmStartMpc) {
+  // optimal control problem
+  ocs2::OptimalControlProblem problem = ocs2::createCircularKinematicsProblem("/tmp/ocs2/sqp_test_generated");
+
+  // inequality constraints: umin <= u <= umax
+  const ocs2::vector_t umin = (ocs2::vector_t(2) << -0.5, -0.5).finished();
+  const ocs2::vector_t umax = (ocs2::vector_t(2) << 0.5, 0.5).finished();
+  {
+    const ocs2::vector_t e = (ocs2::vector_t(4) << -umin, umax).finished();
+    const ocs2::matrix_t C = ocs2::matrix_t::Zero(4, 2);
+    const ocs2::matrix_t D = (ocs2::matrix_t(4, 2) << ocs2::matrix_t::Identity(2, 2), -ocs2::matrix_t::Identity(2, 2)).finished();
+    problem.inequalityConstraintPtr->add("ubound", std::make_unique<ocs2::LinearStateInputConstraint>(e, C, D));
+  }
+
+  // Initializer
+  ocs2::DefaultInitializer zeroInitializer(2);
+
+  // Solver settings
+  ocs2::sqp::Settings settings;
+  settings.dt = 0.01;
+  settings.sqpIteration = 5;
+  settings.projectStateInputEqualityConstraints = true;
+  settings.useHardInequalityConstraints = true;
+  settings.printSolverStatistics = false;
+  settings.printSolverStatus = false;
+  settings.printLinesearch = false;
+  settings.nThreads = 1;
+
+  // Run a few MPC cycles on a receding horizon, starting each cycle from the predicted state of the previous one
+  const ocs2::scalar_t horizon = 1.0;
+  const ocs2::scalar_t mpcPeriod = 0.05;
+  auto runMpc = [&](int warmStart, std::vector<ocs2::PrimalSolution>& solutions) {
+    auto solverSettings = settings;
+    solverSettings.hpipmSettings.warm_start = warmStart;
+    ocs2::SqpSolver solver(solverSettings, problem, zeroInitializer);
+    ocs2::vector_t state = (ocs2::vector_t(2) << 1.0, 0.0).finished();  // radius 1.0
+    for (int i = 0; i < 5; i++) {
+      const ocs2::scalar_t startTime = i * mpcPeriod;
+      solver.run(startTime, state, startTime + horizon);
+      solutions.push_back(solver.primalSolution(startTime + horizon));
+      state = ocs2::LinearInterpolation::interpolate(startTime + mpcPeriod, solutions.back().timeTrajectory_,
+                                                     solutions.back().stateTrajectory_);
+    }
+    return solver.getNumQpIterations();
+  };
+  std::vector<ocs2::PrimalSolution> coldSolutions, warmSolutions;
+  const auto coldQpIterations = runMpc(0, coldSolutions);
+  const auto warmQpIterations = runMpc(2, warmSolutions);
+
+  // Warm starting changes the initial guess of the QP solver, not the solution
+  ASSERT_LE(warmQpIterations, coldQpIterations);
+  for (int i = 0; i < coldSolutions.size(); i++) {
+    const auto& cold = coldSolutions[i];
+    const auto& warm = warmSolutions[i];
+    ASSERT_EQ(cold.timeTrajectory_.size(), warm.timeTrajectory_.size());
+    for (int k = 0; k < cold.timeTrajectory_.size(); k++) {
+      ASSERT_LT((cold.stateTrajectory_[k] - warm.stateTrajectory_[k]).norm(), 1e-6);
+      ASSERT_LT((cold.inputTrajectory_[k] - warm.inputTrajectory_[k]).norm(), 1e-6);
+    }
+  }
+}
+
+TEST(test_circular_kinematics, solve_HardIneqConstraints_violatedInitialState) {
+  // optimal control problem
+  ocs2::OptimalControlProblem problem = ocs2::createCircularKinematicsProblem("/tmp/ocs2/sqp_test_generated");
+
+  // inequality constraints: xmin <= x
+  const ocs2::vector_t xmin = (ocs2::vector_t(2) << -0.5, -0.5).finished();
+  problem.stateInequalityConstraintPtr->add("xbound", std::make_unique<ocs2::LinearStateConstraint>(-xmin, ocs2::matrix_t::Identity(2, 2)));
+
+  // Initializer
+  ocs2::DefaultInitializer zeroInitializer(2);
+
+  // Solver settings
+  ocs2::sqp::Settings settings;
+  settings.dt = 0.01;
+  settings.sqpIteration = 20;
+  settings.projectStateInputEqualityConstraints = true;
+  settings.useHardInequalityConstraints = true;
+  settings.printSolverStatistics = false;
+  settings.printSolverStatus = false;
+  settings.printLinesearch = false;
+  settings.nThreads = 1;
+
+  // The measured state slightly violates the state constraint, which can not be changed by the solver
+  const ocs2::scalar_t startTime = 0.0;
+  const ocs2::scalar_t finalTime = 1.0;
+  const ocs2::vector_t initState = (ocs2::vector_t(2) << 0.86, -0.501).finished();
+
+  // Solve
+  ocs2::SqpSolver solver(settings, problem, zeroInitializer);
+  ASSERT_NO_THROW(solver.run(startTime, initState, finalTime));
+
+  // The constraint is satisfied from the second node on
+  const auto primalSolution = solver.primalSolution(finalTime);
+  ASSERT_TRUE(primalSolution.stateTrajectory_.front().isApprox(initState));
+  for (int i = 1; i < primalSolution.stateTrajectory_.size(); i++) {
+    ASSERT_GT((primalSolution.stateTrajectory_[i] - xmin).minCoeff(), -1e-6);
+  }
+}
+
+TEST(test_circular_kinematics, solve_timeBudget) {
+  // optimal control problem
+  ocs2::OptimalControlProblem problem = ocs2::createCircularKinematicsProblem("/tmp/sqp_test_generated");
+
+  // Initializer
+  ocs2::DefaultInitializer zeroInitializer(2);
+
+  // Solver settings
+  ocs2::sqp::Settings settings;
+  settings.dt = 0.01;
+  settings.sqpIteration = 20;
+  settings.projectStateInputEqualityConstraints = true;
+  settings.printSolverStatistics = false;
+  settings.printSolverStatus = false;
+  settings.printLinesearch = false;
+  settings.nThreads = 1;
+
+  // Additional problem definitions
+  const ocs2::scalar_t startTime = 0.0;
+  const ocs2::scalar_t finalTime = 1.0;
+  const ocs2::vector_t initState = (ocs2::vector_t(2) << 1.0, 0.0).finished();  // radius 1.0
+
+  // Without a time budget, the solver iterates until convergence
+  ocs2::SqpSolver solver(settings, problem, zeroInitializer);
+  solver.run(startTime, initState, finalTime);
+  const auto numIterations = solver.getIterationsLog().size();
+  ASSERT_GT(numIterations, 1);
+  ASSERT_FALSE(solver.getPerformanceIndeces().earlyExit);
+  ASSERT_FALSE(solver.getPerformanceIndeces().deadlineMissed);
+
+  // A budget that is exhausted after the first iteration: the solver exits early with the first iterate
+  solver.reset();
+  solver.setTimeBudget(1e-9);
+  solver.run(startTime, initState, finalTime);
+  ASSERT_EQ(solver.getIterationsLog().size(), 1);
+  ASSERT_TRUE(solver.getPerformanceIndeces().earlyExit);
+  ASSERT_TRUE(solver.getPerformanceIndeces().deadlineMissed);
+  const auto primalSolution = solver.primalSolution(finalTime);
+  ASSERT_TRUE(primalSolution.stateTrajectory_.front().isApprox(initState));
+  ASSERT_DOUBLE_EQ(primalSolution.timeTrajectory_.back(), finalTime);
+
+  // A generous budget does not change the solution
+  solver.reset();
+  solver.setTimeBudget(1e3);
+  solver.run(startTime, initState, finalTime);
+  ASSERT_EQ(solver.getIterationsLog().size(), numIterations);
+  ASSERT_FALSE(solver.getPerformanceIndeces().earlyExit);
+  ASSERT_FALSE(solver.getPerformanceIndeces().deadlineMissed);
+}
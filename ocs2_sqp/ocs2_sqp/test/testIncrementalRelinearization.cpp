@@ -0,0 +1,190 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "ocs2_sqp/SqpSolver.h"
+
+#include <ocs2_core/initialization/DefaultInitializer.h>
+
+#include <ocs2_oc/synchronized_module/ReferenceManager.h>
+#include <ocs2_oc/test/circular_kinematics.h>
+#include <ocs2_oc/test/testProblemsGeneration.h>
+
+namespace {
+
+class IncrementalRelinearizationTest : public testing::Test {
+ protected:
+  static constexpr int n = 3;
+  static constexpr int m = 2;
+  static constexpr ocs2::scalar_t tol = 1e-9;
+  static constexpr ocs2::scalar_t horizon = 1.0;
+  static constexpr size_t numIntermediateNodes = 20;  // horizon / settings.dt
+
+  IncrementalRelinearizationTest() : initializer(m) {
+    // Linear quadratic problem: the derivatives are the same everywhere, such that reusing them does not change the solution
+    const auto dynamics = ocs2::getRandomDynamics(n, m);
+    const auto cost = ocs2::getRandomCost(n, m);
+    problem.dynamicsPtr = ocs2::getOcs2Dynamics(dynamics);
+    problem.costPtr->add("intermediateCost", ocs2::getOcs2Cost(cost));
+    problem.finalCostPtr->add("finalCost", ocs2::getOcs2StateCost(cost));
+    problem.equalityConstraintPtr->add("equalityConstraint", ocs2::getOcs2Constraints(ocs2::getRandomConstraints(n, m, 1)));
+
+    ocs2::TargetTrajectories targetTrajectories({0.0}, {ocs2::vector_t::Ones(n)}, {ocs2::vector_t::Ones(m)});
+    referenceManagerPtr = std::make_shared<ocs2::ReferenceManager>(targetTrajectories);
+    problem.targetTrajectoriesPtr = &referenceManagerPtr->getTargetTrajectories();
+
+    settings.dt = 0.05;
+    settings.sqpIteration = 10;
+    settings.printSolverStatistics = false;
+    settings.printSolverStatus = false;
+    settings.printLinesearch = false;
+    settings.enableLogging = false;
+    settings.nThreads = 2;
+  }
+
+  /** Solves the problem from scratch without incremental relinearization */
+  ocs2::PrimalSolution solveReference(ocs2::scalar_t initTime, const ocs2::vector_t& initState) {
+    ocs2::SqpSolver solver(settings, problem, initializer);
+    solver.setReferenceManager(referenceManagerPtr);
+    solver.run(initTime, initState, initTime + horizon);
+    return solver.primalSolution(initTime + horizon);
+  }
+
+  void compare(const ocs2::PrimalSolution& lhs, const ocs2::PrimalSolution& rhs) {
+    ASSERT_EQ(lhs.timeTrajectory_.size(), rhs.timeTrajectory_.size());
+    for (int i = 0; i < lhs.timeTrajectory_.size(); i++) {
+      ASSERT_DOUBLE_EQ(lhs.timeTrajectory_[i], rhs.timeTrajectory_[i]);
+      ASSERT_TRUE(lhs.stateTrajectory_[i].isApprox(rhs.stateTrajectory_[i], tol));
+      ASSERT_TRUE(lhs.inputTrajectory_[i].isApprox(rhs.inputTrajectory_[i], tol));
+    }
+  }
+
+  ocs2::OptimalControlProblem problem;
+  ocs2::DefaultInitializer initializer;
+  std::shared_ptr<ocs2::ReferenceManager> referenceManagerPtr;
+  ocs2::sqp::Settings settings;
+};
+
+constexpr int IncrementalRelinearizationTest::n;
+constexpr int IncrementalRelinearizationTest::m;
+constexpr ocs2::scalar_t IncrementalRelinearizationTest::tol;
+constexpr ocs2::scalar_t IncrementalRelinearizationTest::horizon;
+constexpr size_t IncrementalRelinearizationTest::numIntermediateNodes;
+
+}  // namespace
+
+TEST_F(IncrementalRelinearizationTest, reuseAcrossProblems) {
+  const ocs2::vector_t initState = ocs2::vector_t::Random(n);
+  const ocs2::vector_t nextState = ocs2::vector_t::Random(n);
+  const ocs2::scalar_t nextTime = 2.0 * settings.dt;  // the time discretizations overlap
+
+  auto incrementalSettings = settings;
+  incrementalSettings.useIncrementalRelinearization = true;
+  incrementalSettings.relinearizationTolerance = 1e10;  // reuse every node that is found in the cache
+  ocs2::SqpSolver solver(incrementalSettings, problem, initializer);
+  solver.setReferenceManager(referenceManagerPtr);
+
+  solver.run(0.0, initState, horizon);
+  compare(solver.primalSolution(horizon), solveReference(0.0, initState));
+  // All nodes are linearized by the first QP and reused by the following ones
+  ASSERT_GT(solver.getNumIterations(), 1);
+  ASSERT_EQ(solver.getNumLinearizedNodes(), numIntermediateNodes);
+  ASSERT_EQ(solver.getNumReusedNodes(), (solver.getNumIterations() - 1) * numIntermediateNodes);
+
+  solver.run(nextTime, nextState, nextTime + horizon);
+  compare(solver.primalSolution(nextTime + horizon), solveReference(nextTime, nextState));
+  // Only the two nodes beyond the previous horizon are new
+  ASSERT_EQ(solver.getNumLinearizedNodes(), numIntermediateNodes + 2);
+  ASSERT_EQ(solver.getNumReusedNodes(), solver.getNumIterations() * numIntermediateNodes - solver.getNumLinearizedNodes());
+}
+
+TEST_F(IncrementalRelinearizationTest, referenceChange) {
+  const ocs2::vector_t initState = ocs2::vector_t::Random(n);
+
+  auto incrementalSettings = settings;
+  incrementalSettings.useIncrementalRelinearization = true;
+  incrementalSettings.relinearizationTolerance = 1e10;
+  ocs2::SqpSolver solver(incrementalSettings, problem, initializer);
+  solver.setReferenceManager(referenceManagerPtr);
+  solver.run(0.0, initState, horizon);
+
+  // A new target invalidates the cached gradients of the cost
+  const size_t numLinearizedNodes = solver.getNumLinearizedNodes();
+  referenceManagerPtr->setTargetTrajectories(
+      ocs2::TargetTrajectories({0.0}, {ocs2::vector_t::Random(n)}, {ocs2::vector_t::Random(m)}));
+  solver.run(0.0, initState, horizon);
+  compare(solver.primalSolution(horizon), solveReference(0.0, initState));
+  ASSERT_EQ(solver.getNumLinearizedNodes(), numLinearizedNodes + numIntermediateNodes);
+}
+
+TEST(IncrementalRelinearizationNonlinearTest, circularKinematics) {
+  ocs2::OptimalControlProblem problem = ocs2::createCircularKinematicsProblem("/tmp/ocs2/sqp_test_generated");
+  ocs2::DefaultInitializer zeroInitializer(2);
+
+  ocs2::sqp::Settings settings;
+  settings.dt = 0.01;
+  settings.sqpIteration = 50;
+  settings.deltaTol = 1e-8;
+  settings.printSolverStatistics = false;
+  settings.printSolverStatus = false;
+  settings.printLinesearch = false;
+  settings.enableLogging = false;
+  settings.nThreads = 2;
+
+  const ocs2::scalar_t startTime = 0.0;
+  const ocs2::scalar_t finalTime = 1.0;
+  const ocs2::vector_t initState = (ocs2::vector_t(2) << 1.0, 0.0).finished();  // radius 1.0
+
+  ocs2::SqpSolver referenceSolver(settings, problem, zeroInitializer);
+  referenceSolver.run(startTime, initState, finalTime);
+  const auto referenceSolution = referenceSolver.primalSolution(finalTime);
+
+  // The derivatives are reused once the iterates move less than the tolerance, i.e. close to convergence
+  settings.useIncrementalRelinearization = true;
+  settings.relinearizationTolerance = 1e-2;
+  ocs2::SqpSolver solver(settings, problem, zeroInitializer);
+  solver.run(startTime, initState, finalTime);
+  const auto solution = solver.primalSolution(finalTime);
+  const size_t numIntermediateNodes = solution.timeTrajectory_.size() - 1;
+  ASSERT_GT(solver.getNumReusedNodes(), 0);
+  ASSERT_EQ(solver.getNumLinearizedNodes() + solver.getNumReusedNodes(), solver.getNumIterations() * numIntermediateNodes);
+
+  // The zeroth-order terms are exact, such that the solution only deviates by the error of the reused derivatives
+  const ocs2::scalar_t tol = 1e-4;
+  const auto& performance = solver.getPerformanceIndeces();
+  ASSERT_LT(performance.dynamicsViolationSSE, 1e-6);
+  ASSERT_LT(performance.equalityConstraintsSSE, 1e-6);
+  ASSERT_NEAR(performance.cost, referenceSolver.getPerformanceIndeces().cost, tol);
+  ASSERT_EQ(solution.timeTrajectory_.size(), referenceSolution.timeTrajectory_.size());
+  for (int i = 0; i < solution.timeTrajectory_.size(); i++) {
+    ASSERT_TRUE(solution.stateTrajectory_[i].isApprox(referenceSolution.stateTrajectory_[i], tol));
+    ASSERT_TRUE(solution.inputTrajectory_[i].isApprox(referenceSolution.inputTrajectory_[i], tol));
+  }
+}
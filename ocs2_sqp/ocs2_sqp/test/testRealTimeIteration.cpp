@@ -0,0 +1,181 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "ocs2_sqp/SqpSolver.h"
+
+#include <ocs2_core/initialization/DefaultInitializer.h>
+
+#include <ocs2_oc/synchronized_module/ReferenceManager.h>
+#include <ocs2_oc/test/testProblemsGeneration.h>
+
+namespace {
+
+class RealTimeIterationTest : public testing::Test {
+ protected:
+  static constexpr int n = 3;
+  static constexpr int m = 2;
+  static constexpr ocs2::scalar_t tol = 1e-9;
+  static constexpr ocs2::scalar_t horizon = 1.0;
+
+  RealTimeIterationTest() : initializer(m) {
+    // Linear quadratic problem: a single SQP step solves it exactly from any linearization point
+    const auto dynamics = ocs2::getRandomDynamics(n, m);
+    const auto cost = ocs2::getRandomCost(n, m);
+    problem.dynamicsPtr = ocs2::getOcs2Dynamics(dynamics);
+    problem.costPtr->add("intermediateCost", ocs2::getOcs2Cost(cost));
+    problem.finalCostPtr->add("finalCost", ocs2::getOcs2StateCost(cost));
+
+    ocs2::TargetTrajectories targetTrajectories({0.0}, {ocs2::vector_t::Ones(n)}, {ocs2::vector_t::Ones(m)});
+    referenceManagerPtr = std::make_shared<ocs2::ReferenceManager>(targetTrajectories);
+    problem.targetTrajectoriesPtr = &referenceManagerPtr->getTargetTrajectories();
+
+    settings.dt = 0.05;
+    settings.sqpIteration = 10;
+    settings.printSolverStatistics = false;
+    settings.printSolverStatus = false;
+    settings.printLinesearch = false;
+    settings.enableLogging = false;
+    settings.nThreads = 2;
+  }
+
+  /** Solves the problem from scratch without real-time iterations */
+  ocs2::PrimalSolution solveReference(ocs2::scalar_t initTime, const ocs2::vector_t& initState) {
+    ocs2::SqpSolver solver(settings, problem, initializer);
+    solver.setReferenceManager(referenceManagerPtr);
+    solver.run(initTime, initState, initTime + horizon);
+    return solver.primalSolution(initTime + horizon);
+  }
+
+  void compare(const ocs2::PrimalSolution& lhs, const ocs2::PrimalSolution& rhs) {
+    ASSERT_EQ(lhs.timeTrajectory_.size(), rhs.timeTrajectory_.size());
+    for (int i = 0; i < lhs.timeTrajectory_.size(); i++) {
+      ASSERT_DOUBLE_EQ(lhs.timeTrajectory_[i], rhs.timeTrajectory_[i]);
+      ASSERT_TRUE(lhs.stateTrajectory_[i].isApprox(rhs.stateTrajectory_[i], tol));
+      ASSERT_TRUE(lhs.inputTrajectory_[i].isApprox(rhs.inputTrajectory_[i], tol));
+      const auto t = lhs.timeTrajectory_[i];
+      const auto& x = lhs.stateTrajectory_[i];
+      ASSERT_TRUE(lhs.controllerPtr_->computeInput(t, x).isApprox(rhs.controllerPtr_->computeInput(t, x), tol));
+    }
+  }
+
+  ocs2::OptimalControlProblem problem;
+  ocs2::DefaultInitializer initializer;
+  std::shared_ptr<ocs2::ReferenceManager> referenceManagerPtr;
+  ocs2::sqp::Settings settings;
+};
+
+constexpr int RealTimeIterationTest::n;
+constexpr int RealTimeIterationTest::m;
+constexpr ocs2::scalar_t RealTimeIterationTest::tol;
+constexpr ocs2::scalar_t RealTimeIterationTest::horizon;
+
+}  // namespace
+
+TEST_F(RealTimeIterationTest, preparedFeedback) {
+  const ocs2::vector_t initState = ocs2::vector_t::Random(n);
+  const ocs2::vector_t nextState = ocs2::vector_t::Random(n);
+  const ocs2::scalar_t nextTime = 0.1;
+
+  auto rtiSettings = settings;
+  rtiSettings.useRealTimeIteration = true;
+  ocs2::SqpSolver solver(rtiSettings, problem, initializer);
+  solver.setReferenceManager(referenceManagerPtr);
+
+  // First call runs the full SQP, then prepare and solve the next problem with a single QP
+  solver.run(0.0, initState, horizon);
+  solver.prepareRealTimeIteration(nextTime, nextTime + horizon);
+  solver.run(nextTime, nextState, nextTime + horizon);
+
+  ASSERT_EQ(solver.getIterationsLog().size(), 1);
+  compare(solver.primalSolution(nextTime + horizon), solveReference(nextTime, nextState));
+}
+
+TEST_F(RealTimeIterationTest, unpreparedFeedback) {
+  const ocs2::vector_t initState = ocs2::vector_t::Random(n);
+  const ocs2::vector_t nextState = ocs2::vector_t::Random(n);
+  const ocs2::scalar_t nextTime = 0.3;
+
+  auto rtiSettings = settings;
+  rtiSettings.useRealTimeIteration = true;
+  ocs2::SqpSolver solver(rtiSettings, problem, initializer);
+  solver.setReferenceManager(referenceManagerPtr);
+
+  // The preparation was done for the wrong time such that the feedback phase has to linearize again
+  solver.run(0.0, initState, horizon);
+  solver.prepareRealTimeIteration(0.1, 0.1 + horizon);
+  solver.run(nextTime, nextState, nextTime + horizon);
+
+  ASSERT_EQ(solver.getIterationsLog().size(), 1);
+  compare(solver.primalSolution(nextTime + horizon), solveReference(nextTime, nextState));
+}
+
+TEST_F(RealTimeIterationTest, targetChangeAfterPreparation) {
+  const ocs2::vector_t initState = ocs2::vector_t::Random(n);
+  const ocs2::vector_t nextState = ocs2::vector_t::Random(n);
+  const ocs2::scalar_t nextTime = 0.1;
+
+  auto rtiSettings = settings;
+  rtiSettings.useRealTimeIteration = true;
+  ocs2::SqpSolver solver(rtiSettings, problem, initializer);
+  solver.setReferenceManager(referenceManagerPtr);
+
+  // A new target arrives between the preparation and the feedback phase, such that the prepared QP is outdated
+  solver.run(0.0, initState, horizon);
+  solver.prepareRealTimeIteration(nextTime, nextTime + horizon);
+  referenceManagerPtr->setTargetTrajectories(
+      ocs2::TargetTrajectories({0.0}, {ocs2::vector_t::Random(n)}, {ocs2::vector_t::Random(m)}));
+  solver.run(nextTime, nextState, nextTime + horizon);
+
+  ASSERT_EQ(solver.getIterationsLog().size(), 1);
+  compare(solver.primalSolution(nextTime + horizon), solveReference(nextTime, nextState));
+}
+
+TEST_F(RealTimeIterationTest, measuredInitTime) {
+  const ocs2::vector_t initState = ocs2::vector_t::Random(n);
+  const ocs2::vector_t nextState = ocs2::vector_t::Random(n);
+  const ocs2::scalar_t preparedTime = 0.1;
+  const ocs2::scalar_t nextTime = preparedTime + 0.5 * settings.dt;
+
+  auto rtiSettings = settings;
+  rtiSettings.useRealTimeIteration = true;
+  ocs2::SqpSolver solver(rtiSettings, problem, initializer);
+  solver.setReferenceManager(referenceManagerPtr);
+
+  // The measurement arrives later than expected, the prepared QP is reused but the solution starts at the measured time
+  solver.run(0.0, initState, horizon);
+  solver.prepareRealTimeIteration(preparedTime, preparedTime + horizon);
+  solver.run(nextTime, nextState, nextTime + horizon);
+
+  const auto primalSolution = solver.primalSolution(nextTime + horizon);
+  ASSERT_DOUBLE_EQ(primalSolution.timeTrajectory_.front(), nextTime);
+  ASSERT_DOUBLE_EQ(primalSolution.timeTrajectory_[1], preparedTime + settings.dt);
+  ASSERT_TRUE(primalSolution.stateTrajectory_.front().isApprox(nextState, tol));
+}
@@ -0,0 +1,99 @@
+/******************************************************************************
+Copyright (c) 2020, Farbod Farshidian. All rights reserved.
+
+Redistribution and use in source and binary forms, with or without
+modification, are permitted provided that the following conditions are met:
+
+* Redistributions of source code must retain the above copyright notice, this
+  list of conditions and the following disclaimer.
+
+* Redistributions in binary form must reproduce the above copyright notice,
+  this list of conditions and the following disclaimer in the documentation
+  and/or other materials provided with the distribution.
+
+* Neither the name of the copyright holder nor the names of its
+  contributors may be used to endorse or promote products derived from
+  this software without specific prior written permission.
+
+THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE
+FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL
+DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR
+SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER
+CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY,
+OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE
+OF THIS SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+******************************************************************************/
+
+#include <gtest/gtest.h>
+
+#include "ocs2_sqp/SqpSolver.h"
+
+#include <ocs2_core/initialization/DefaultInitializer.h>
+#include <ocs2_core/test/AllocationCounter.h>
+
+#include <ocs2_oc/synchronized_module/ReferenceManager.h>
+#include <ocs2_oc/test/testProblemsGeneration.h>
+
+/*
+ * The feedback phase of a real-time iteration only solves the prepared QP and updates the solution. The model approximations of the
+ * preparation phase return by value and are therefore not part of the allocation-free path.
+ */
+TEST(test_sqp_allocations, real_time_iteration_feedback) {
+  constexpr int n = 3;
+  constexpr int m = 2;
+  constexpr ocs2::scalar_t horizon = 1.0;
+  constexpr ocs2::scalar_t initTime = 0.1;
+
+  // Linear quadratic problem
+  ocs2::OptimalControlProblem problem;
+  const auto dynamics = ocs2::getRandomDynamics(n, m);
+  const auto cost = ocs2::getRandomCost(n, m);
+  problem.dynamicsPtr = ocs2::getOcs2Dynamics(dynamics);
+  problem.costPtr->add("intermediateCost", ocs2::getOcs2Cost(cost));
+  problem.finalCostPtr->add("finalCost", ocs2::getOcs2StateCost(cost));
+
+  ocs2::TargetTrajectories targetTrajectories({0.0}, {ocs2::vector_t::Ones(n)}, {ocs2::vector_t::Ones(m)});
+  auto referenceManagerPtr = std::make_shared<ocs2::ReferenceManager>(targetTrajectories);
+  problem.targetTrajectoriesPtr = &referenceManagerPtr->getTargetTrajectories();
+
+  ocs2::sqp::Settings settings;
+  settings.dt = 0.05;
+  settings.sqpIteration = 10;
+  settings.useRealTimeIteration = true;
+  settings.useFeedbackPolicy = false;
+  settings.createValueFunction = false;
+  settings.printSolverStatistics = false;
+  settings.printSolverStatus = false;
+  settings.printLinesearch = false;
+  settings.enableLogging = false;
+  settings.nThreads = 2;
+
+  ocs2::DefaultInitializer initializer(m);
+  ocs2::SqpSolver solver(settings, problem, initializer);
+  solver.setReferenceManager(referenceManagerPtr);
+
+  // Warm-up: the full solve and the first real-time iterations size the memory
+  ocs2::vector_t initState = ocs2::vector_t::Random(n);
+  solver.run(initTime, initState, initTime + horizon);
+  for (int i = 0; i < 2; i++) {
+    solver.prepareRealTimeIteration(initTime, initTime + horizon);
+    solver.run(initTime, initState, initTime + horizon);
+  }
+
+  // Following feedback phases on the same time grid reuse the memory
+  for (int i = 0; i < 3; i++) {
+    initState.setRandom();
+    solver.prepareRealTimeIteration(initTime, initTime + horizon);
+    const size_t allocationsBefore = ocs2::getAllocationCount();
+    solver.run(initTime, initState, initTime + horizon);
+    const size_t numAllocations = ocs2::getAllocationCount() - allocationsBefore;
+    ASSERT_EQ(numAllocations, 0);
+  }
+
+  // The feedback phase still solves the problem: a single step is exact for a linear quadratic problem
+  const auto solution = solver.primalSolution(initTime + horizon);
+  ASSERT_TRUE(solution.stateTrajectory_.front().isApprox(initState));
+}
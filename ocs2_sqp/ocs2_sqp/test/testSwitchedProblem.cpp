@@ -94,7 +94,7 @@ class SwitchedConstraint : public StateInputConstraint {
   std::vector<std::unique_ptr<ocs2::StateInputConstraint>> subsystemConstraintsPtr_;
 };
 
-std::pair<PrimalSolution, std::vector<PerformanceIndex>> solveWithEventTime(scalar_t eventTime) {
+std::pair<PrimalSolution, std::vector<PerformanceIndex>> solveWithEventTime(scalar_t eventTime, bool useParallelRiccati = false) {
   constexpr int n = 3;
   constexpr int m = 2;
 
@@ -130,6 +130,7 @@ std::pair<PrimalSolution, std::vector<PerformanceIndex>> solveWithEventTime(scal
   settings.dt = 0.05;
   settings.sqpIteration = 20;
   settings.projectStateInputEqualityConstraints = true;
+  settings.useParallelRiccati = useParallelRiccati;
   settings.printSolverStatistics = true;
   settings.printSolverStatus = true;
   settings.printLinesearch = true;
@@ -267,3 +268,26 @@ TEST(test_switched_problem, event_at_end) {
     t_check += dt_check;
   }
 }
+
+TEST(test_switched_problem, parallel_riccati) {
+  // The parallel Riccati recursion solves the same QP subproblems as HPIPM.
+  const ocs2::scalar_t eventTime = 0.1875;
+  const double tol = 1e-8;
+  std::srand(0);
+  const auto hpipmSolution = ocs2::solveWithEventTime(eventTime);
+  std::srand(0);
+  const auto riccatiSolution = ocs2::solveWithEventTime(eventTime, true);
+
+  ASSERT_EQ(hpipmSolution.second.size(), riccatiSolution.second.size());
+  const auto& hpipmPrimalSolution = hpipmSolution.first;
+  const auto& riccatiPrimalSolution = riccatiSolution.first;
+  ASSERT_EQ(hpipmPrimalSolution.timeTrajectory_, riccatiPrimalSolution.timeTrajectory_);
+  for (int i = 0; i < hpipmPrimalSolution.timeTrajectory_.size(); i++) {
+    const auto t = hpipmPrimalSolution.timeTrajectory_[i];
+    const auto& x = hpipmPrimalSolution.stateTrajectory_[i];
+    ASSERT_TRUE(x.isApprox(riccatiPrimalSolution.stateTrajectory_[i], tol));
+    ASSERT_TRUE(hpipmPrimalSolution.inputTrajectory_[i].isApprox(riccatiPrimalSolution.inputTrajectory_[i], tol));
+    ASSERT_TRUE(
+        hpipmPrimalSolution.controllerPtr_->computeInput(t, x).isApprox(riccatiPrimalSolution.controllerPtr_->computeInput(t, x), tol));
+  }
+}